@@ -15,6 +15,7 @@ FBaseSplineComputeShader::FBaseSplineComputeShader(
 	: FGlobalShader(Initializer)
 {
 	InSplineControlPointData.Bind(Initializer.ParameterMap, TEXT("InSplineControlPointData"));
+	InSplineLevelData.Bind(Initializer.ParameterMap, TEXT("InSplineLevelData"));
 	InSplineSegmentData.Bind(Initializer.ParameterMap, TEXT("InSplineSegmentData"));
 	InSplineData.Bind(Initializer.ParameterMap, TEXT("InSplineData"));
 	OutMeshVertexData.Bind(Initializer.ParameterMap, TEXT("OutMeshVertexData"));
@@ -36,6 +37,7 @@ void FBaseSplineComputeShader::SetUniformBuffers(
 
 void FBaseSplineComputeShader::SetBuffers(FRHICommandList& RHICmdList,
 										  FShaderResourceViewRHIRef InSplineControlPointBufferSRV,
+										  FShaderResourceViewRHIRef InSplineLevelBufferSRV,
 										  FShaderResourceViewRHIRef InSplineSegmentBufferSRV,
 										  FShaderResourceViewRHIRef InSplineBufferSRV,
 										  FUnorderedAccessViewRHIRef OutMeshVertexBufferUAV)
@@ -47,6 +49,11 @@ void FBaseSplineComputeShader::SetBuffers(FRHICommandList& RHICmdList,
 												  InSplineControlPointData.GetBaseIndex(),  //
 												  InSplineControlPointBufferSRV);
 
+	if (InSplineLevelData.IsBound())
+		RHICmdList.SetShaderResourceViewParameter(ComputeShaderRHI,				 //
+												  InSplineLevelData.GetBaseIndex(),  //
+												  InSplineLevelBufferSRV);
+
 	if (InSplineSegmentData.IsBound())
 		RHICmdList.SetShaderResourceViewParameter(ComputeShaderRHI,					   //
 												  InSplineSegmentData.GetBaseIndex(),  //
@@ -69,6 +76,10 @@ void FBaseSplineComputeShader::UnbindBuffers(FRHICommandList& RHICmdList)
 		RHICmdList.SetShaderResourceViewParameter(
 			ComputeShaderRHI, InSplineControlPointData.GetBaseIndex(), FShaderResourceViewRHIRef());
 
+	if (InSplineLevelData.IsBound())
+		RHICmdList.SetShaderResourceViewParameter(
+			ComputeShaderRHI, InSplineLevelData.GetBaseIndex(), FShaderResourceViewRHIRef());
+
 	if (InSplineSegmentData.IsBound())
 		RHICmdList.SetShaderResourceViewParameter(
 			ComputeShaderRHI, InSplineSegmentData.GetBaseIndex(), FShaderResourceViewRHIRef());
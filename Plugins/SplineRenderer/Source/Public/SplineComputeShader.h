@@ -11,6 +11,7 @@ BEGIN_UNIFORM_BUFFER_STRUCT(FSplineComputeShaderUniformParameters, )
 DECLARE_UNIFORM_BUFFER_STRUCT_MEMBER(float, WorldSize)
 DECLARE_UNIFORM_BUFFER_STRUCT_MEMBER(float, Width)
 DECLARE_UNIFORM_BUFFER_STRUCT_MEMBER(uint32, NumSides)
+DECLARE_UNIFORM_BUFFER_STRUCT_MEMBER(float, TransitionAlpha)
 END_UNIFORM_BUFFER_STRUCT(FSplineComputeShaderUniformParameters)
 
 typedef TUniformBufferRef<FSplineComputeShaderUniformParameters>
@@ -20,6 +21,7 @@ class SPLINERENDERER_API FBaseSplineComputeShader : public FGlobalShader
 {
 private:
 	FShaderResourceParameter InSplineControlPointData;
+	FShaderResourceParameter InSplineLevelData;
 	FShaderResourceParameter InSplineSegmentData;
 	FShaderResourceParameter InSplineData;
 
@@ -49,6 +51,7 @@ public:
 	{
 		bool bShaderHasOutdatedParams = FGlobalShader::Serialize(Ar);
 		Ar << InSplineControlPointData;
+		Ar << InSplineLevelData;
 		Ar << InSplineSegmentData;
 		Ar << InSplineData;
 		Ar << OutMeshVertexData;
@@ -60,6 +63,7 @@ public:
 
 	void SetBuffers(FRHICommandList& RHICmdList,
 					FShaderResourceViewRHIRef InSplineControlPointBufferSRV,
+					FShaderResourceViewRHIRef InSplineLevelBufferSRV,
 					FShaderResourceViewRHIRef InSplineSegmentBufferSRV,
 					FShaderResourceViewRHIRef InSplineBufferSRV,
 					FUnorderedAccessViewRHIRef OutMeshVertexBufferUAV);
@@ -0,0 +1,214 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVAdjacency.h"
+
+#include "KWTask.h"
+
+FIGVAdjacency::FIGVAdjacency()
+	: Offsets(), Degrees(), Capacities(), NeighborIdxs(), EdgeIdxs(), NumUnused(0)
+{
+}
+
+void FIGVAdjacency::Build(int32 const NumNodes, TArray<int32> const& SourceIdxs,
+						  TArray<int32> const& TargetIdxs)
+{
+	int32 const NumEdges = SourceIdxs.Num();
+	check(TargetIdxs.Num() == NumEdges);
+
+	Degrees.SetNumZeroed(NumNodes);
+	int32* const DegreeData = Degrees.GetData();
+
+	static int32 const NumEdgesPerTask = 16384;
+
+	FGraphEventArray Tasks;
+	for (int32 BeginEdgeIdx = 0; BeginEdgeIdx < NumEdges; BeginEdgeIdx += NumEdgesPerTask)
+	{
+		int32 const EndEdgeIdx = FMath::Min(BeginEdgeIdx + NumEdgesPerTask, NumEdges);
+		Tasks.Add(FKWTask<>::ConstructAndDispatchWhenReady(
+			[&SourceIdxs, &TargetIdxs, DegreeData, BeginEdgeIdx, EndEdgeIdx]() {
+				for (int32 EdgeIdx = BeginEdgeIdx; EdgeIdx < EndEdgeIdx; EdgeIdx++)
+				{
+					FPlatformAtomics::InterlockedIncrement(&DegreeData[SourceIdxs[EdgeIdx]]);
+					FPlatformAtomics::InterlockedIncrement(&DegreeData[TargetIdxs[EdgeIdx]]);
+				}
+			}));
+	}
+	FTaskGraphInterface::Get().WaitUntilTasksComplete(Tasks);
+
+	Offsets.SetNumUninitialized(NumNodes);
+	int32 Offset = 0;
+	for (int32 NodeIdx = 0; NodeIdx < NumNodes; NodeIdx++)
+	{
+		Offsets[NodeIdx] = Offset;
+		Offset += Degrees[NodeIdx];
+	}
+	check(Offset == NumEdges * 2);
+
+	Capacities = Degrees;
+	NeighborIdxs.SetNumUninitialized(NumEdges * 2);
+	EdgeIdxs.SetNumUninitialized(NumEdges * 2);
+	NumUnused = 0;
+
+	// Filled on this thread, so that the rows are in edge order regardless of scheduling.
+	TArray<int32> Cursors = Offsets;
+
+	for (int32 EdgeIdx = 0; EdgeIdx < NumEdges; EdgeIdx++)
+	{
+		int32 const SourceIdx = SourceIdxs[EdgeIdx];
+		int32 const TargetIdx = TargetIdxs[EdgeIdx];
+
+		int32 const SourceCursor = Cursors[SourceIdx]++;
+		NeighborIdxs[SourceCursor] = TargetIdx;
+		EdgeIdxs[SourceCursor] = EdgeIdx;
+
+		int32 const TargetCursor = Cursors[TargetIdx]++;
+		NeighborIdxs[TargetCursor] = SourceIdx;
+		EdgeIdxs[TargetCursor] = EdgeIdx;
+	}
+}
+
+void FIGVAdjacency::AddNode()
+{
+	Offsets.Add(NeighborIdxs.Num());
+	Degrees.Add(0);
+	Capacities.Add(0);
+}
+
+void FIGVAdjacency::RemoveNodeAtSwap(int32 const NodeIdx)
+{
+	check(Degrees[NodeIdx] == 0);
+
+	int32 const LastNodeIdx = Num() - 1;
+	if (NodeIdx != LastNodeIdx)
+	{
+		TArrayView<int32 const> const Edges = GetEdges(LastNodeIdx);
+		TArrayView<int32 const> const Neighbors = GetNeighbors(LastNodeIdx);
+		for (int32 Idx = 0; Idx < Edges.Num(); Idx++)
+		{
+			int32 const NeighborIdx = Neighbors[Idx];
+			NeighborIdxs[FindInRow(NeighborIdx, Edges[Idx])] = NodeIdx;
+		}
+	}
+
+	NumUnused += Capacities[NodeIdx];
+
+	Offsets.RemoveAtSwap(NodeIdx, 1, false);
+	Degrees.RemoveAtSwap(NodeIdx, 1, false);
+	Capacities.RemoveAtSwap(NodeIdx, 1, false);
+
+	CompactIfRequired();
+}
+
+void FIGVAdjacency::AddEdge(int32 const SourceIdx, int32 const TargetIdx, int32 const EdgeIdx)
+{
+	AddToRow(SourceIdx, TargetIdx, EdgeIdx);
+	AddToRow(TargetIdx, SourceIdx, EdgeIdx);
+}
+
+void FIGVAdjacency::RemoveEdge(int32 const SourceIdx, int32 const TargetIdx, int32 const EdgeIdx)
+{
+	RemoveFromRow(SourceIdx, EdgeIdx);
+	RemoveFromRow(TargetIdx, EdgeIdx);
+}
+
+void FIGVAdjacency::RenameEdge(int32 const SourceIdx, int32 const TargetIdx,
+							   int32 const OldEdgeIdx, int32 const NewEdgeIdx)
+{
+	EdgeIdxs[FindInRow(SourceIdx, OldEdgeIdx)] = NewEdgeIdx;
+	EdgeIdxs[FindInRow(TargetIdx, OldEdgeIdx)] = NewEdgeIdx;
+}
+
+int32 FIGVAdjacency::FindInRow(int32 const NodeIdx, int32 const EdgeIdx) const
+{
+	for (int32 Idx = Offsets[NodeIdx], End = Idx + Degrees[NodeIdx]; Idx < End; Idx++)
+	{
+		if (EdgeIdxs[Idx] == EdgeIdx) return Idx;
+	}
+
+	checkNoEntry();
+	return INDEX_NONE;
+}
+
+void FIGVAdjacency::AddToRow(int32 const NodeIdx, int32 const NeighborIdx, int32 const EdgeIdx)
+{
+	int32 const Degree = Degrees[NodeIdx];
+
+	if (Degree == Capacities[NodeIdx])
+	{
+		int32 const OldOffset = Offsets[NodeIdx];
+		int32 const NewCapacity = FMath::Max(4, Degree * 2);
+		int32 const NewOffset = NeighborIdxs.AddUninitialized(NewCapacity);
+		EdgeIdxs.AddUninitialized(NewCapacity);
+
+		FMemory::Memcpy(&NeighborIdxs[NewOffset], &NeighborIdxs[OldOffset], sizeof(int32) * Degree);
+		FMemory::Memcpy(&EdgeIdxs[NewOffset], &EdgeIdxs[OldOffset], sizeof(int32) * Degree);
+
+		NumUnused += Capacities[NodeIdx];
+		Offsets[NodeIdx] = NewOffset;
+		Capacities[NodeIdx] = NewCapacity;
+	}
+
+	int32 const Idx = Offsets[NodeIdx] + Degree;
+	NeighborIdxs[Idx] = NeighborIdx;
+	EdgeIdxs[Idx] = EdgeIdx;
+	Degrees[NodeIdx]++;
+
+	CompactIfRequired();
+}
+
+void FIGVAdjacency::RemoveFromRow(int32 const NodeIdx, int32 const EdgeIdx)
+{
+	int32 const Idx = FindInRow(NodeIdx, EdgeIdx);
+	int32 const LastIdx = Offsets[NodeIdx] + Degrees[NodeIdx] - 1;
+
+	NeighborIdxs[Idx] = NeighborIdxs[LastIdx];
+	EdgeIdxs[Idx] = EdgeIdxs[LastIdx];
+	Degrees[NodeIdx]--;
+}
+
+void FIGVAdjacency::CompactIfRequired()
+{
+	if (NumUnused * 2 > NeighborIdxs.Num()) Compact();
+}
+
+void FIGVAdjacency::Compact()
+{
+	TArray<int32> NewNeighborIdxs;
+	TArray<int32> NewEdgeIdxs;
+	NewNeighborIdxs.Reserve(NeighborIdxs.Num() - NumUnused);
+	NewEdgeIdxs.Reserve(EdgeIdxs.Num() - NumUnused);
+
+	// Rows keep their capacity, so that a growing node does not move again right away.
+	for (int32 NodeIdx = 0, NumNodes = Num(); NodeIdx < NumNodes; NodeIdx++)
+	{
+		int32 const Offset = Offsets[NodeIdx];
+		int32 const Degree = Degrees[NodeIdx];
+
+		Offsets[NodeIdx] = NewNeighborIdxs.Num();
+		NewNeighborIdxs.Append(NeighborIdxs.GetData() + Offset, Degree);
+		NewEdgeIdxs.Append(EdgeIdxs.GetData() + Offset, Degree);
+		NewNeighborIdxs.AddUninitialized(Capacities[NodeIdx] - Degree);
+		NewEdgeIdxs.AddUninitialized(Capacities[NodeIdx] - Degree);
+	}
+
+	NeighborIdxs = MoveTemp(NewNeighborIdxs);
+	EdgeIdxs = MoveTemp(NewEdgeIdxs);
+	NumUnused = 0;
+}
+
+void FIGVAdjacency::Empty()
+{
+	Offsets.Empty();
+	Degrees.Empty();
+	Capacities.Empty();
+	NeighborIdxs.Empty();
+	EdgeIdxs.Empty();
+	NumUnused = 0;
+}
+
+uint32 FIGVAdjacency::GetAllocatedSize() const
+{
+	return Offsets.GetAllocatedSize() + Degrees.GetAllocatedSize() +
+		   Capacities.GetAllocatedSize() + NeighborIdxs.GetAllocatedSize() +
+		   EdgeIdxs.GetAllocatedSize();
+}
@@ -0,0 +1,74 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "CoreMinimal.h"
+
+// Node adjacency in compressed sparse row form. The neighbors of node i and the edges connecting
+// them are Degrees[i] elements from Offsets[i] of NeighborIdxs and EdgeIdxs. Indices stay valid
+// when AIGVGraphActor::Nodes or Edges reallocate, unlike pointers into them.
+//
+// Build lays the rows out back to back in edge order. Incremental edits add to a row in place
+// while it has capacity, and otherwise move it to the end with twice the capacity. The rows are
+// packed again once more than half of the arrays is left behind by moved or removed rows.
+struct IMSVGRAPHVIS_API FIGVAdjacency
+{
+	TArray<int32> Offsets;
+	TArray<int32> Degrees;
+	TArray<int32> Capacities;
+	TArray<int32> NeighborIdxs;
+	TArray<int32> EdgeIdxs;
+
+	int32 NumUnused;  // Elements of NeighborIdxs and EdgeIdxs outside of the capacity of any row
+
+public:
+	FIGVAdjacency();
+
+	// Degrees are counted in parallel, the rows are filled in edge order.
+	void Build(int32 const NumNodes, TArray<int32> const& SourceIdxs,
+			   TArray<int32> const& TargetIdxs);
+
+	// Incremental edits, see AIGVGraphActor. AddNode appends an empty row. RemoveNodeAtSwap
+	// takes a node without edges, and renames the last node to NodeIdx in the rows of its
+	// neighbors. RenameEdge replaces an edge index in the rows of its endpoints.
+	void AddNode();
+	void RemoveNodeAtSwap(int32 const NodeIdx);
+	void AddEdge(int32 const SourceIdx, int32 const TargetIdx, int32 const EdgeIdx);
+	void RemoveEdge(int32 const SourceIdx, int32 const TargetIdx, int32 const EdgeIdx);
+	void RenameEdge(int32 const SourceIdx, int32 const TargetIdx, int32 const OldEdgeIdx,
+					int32 const NewEdgeIdx);
+
+	void Empty();
+
+	uint32 GetAllocatedSize() const;
+
+	FORCEINLINE int32 Num() const
+	{
+		return Offsets.Num();
+	}
+
+	FORCEINLINE int32 GetDegree(int32 const NodeIdx) const
+	{
+		return Degrees[NodeIdx];
+	}
+
+	FORCEINLINE TArrayView<int32 const> GetNeighbors(int32 const NodeIdx) const
+	{
+		return TArrayView<int32 const>(NeighborIdxs.GetData() + Offsets[NodeIdx],
+									   Degrees[NodeIdx]);
+	}
+
+	FORCEINLINE TArrayView<int32 const> GetEdges(int32 const NodeIdx) const
+	{
+		return TArrayView<int32 const>(EdgeIdxs.GetData() + Offsets[NodeIdx], Degrees[NodeIdx]);
+	}
+
+protected:
+	int32 FindInRow(int32 const NodeIdx, int32 const EdgeIdx) const;
+	void AddToRow(int32 const NodeIdx, int32 const NeighborIdx, int32 const EdgeIdx);
+	void RemoveFromRow(int32 const NodeIdx, int32 const EdgeIdx);
+
+	void CompactIfRequired();
+	void Compact();
+};
@@ -0,0 +1,107 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVArena.h"
+
+// Spare room of a block allocated without Reserve
+SIZE_T const FIGVArena::MinBlockSize = 1024 * 1024;
+
+FIGVArena::FIGVArena()
+	: Blocks(),
+	  CurrentBlockUsed(0),
+	  NumAllocations(0),
+	  UsedSize(0),
+	  AllocatedSize(0),
+	  PeakAllocatedSize(0)
+{
+}
+
+FIGVArena::~FIGVArena()
+{
+	Empty();
+}
+
+void FIGVArena::Reserve(SIZE_T const NumBytes)
+{
+	if (NumBytes == 0) return;
+	if (Blocks.Num() > 0 && CurrentBlockUsed + NumBytes <= Blocks.Last().Size) return;
+
+	AddBlock(NumBytes);
+}
+
+void* FIGVArena::Allocate(SIZE_T const NumBytes)
+{
+	SIZE_T const AlignedNumBytes = Align(NumBytes, Alignment);
+	if (AlignedNumBytes == 0) return nullptr;
+
+	if (Blocks.Num() == 0 || CurrentBlockUsed + AlignedNumBytes > Blocks.Last().Size)
+	{
+		AddBlock(FMath::Max(AlignedNumBytes, MinBlockSize));
+	}
+
+	void* const Result = Blocks.Last().Data + CurrentBlockUsed;
+	CurrentBlockUsed += AlignedNumBytes;
+
+	NumAllocations++;
+	UsedSize += AlignedNumBytes;
+	return Result;
+}
+
+void FIGVArena::AddBlock(SIZE_T const NumBytes)
+{
+	FBlock Block;
+	Block.Data = static_cast<uint8*>(FMemory::Malloc(NumBytes, Alignment));
+	Block.Size = NumBytes;
+	Blocks.Add(Block);
+
+	CurrentBlockUsed = 0;
+	AllocatedSize += NumBytes;
+	PeakAllocatedSize = FMath::Max(PeakAllocatedSize, AllocatedSize);
+}
+
+void FIGVArena::Empty()
+{
+	for (FBlock const& Block : Blocks)
+	{
+		FMemory::Free(Block.Data);
+	}
+	Blocks.Empty();
+
+	CurrentBlockUsed = 0;
+	NumAllocations = 0;
+	UsedSize = 0;
+	AllocatedSize = 0;
+}
+
+int32 FIGVArena::GetNumAllocations() const
+{
+	return NumAllocations;
+}
+
+int32 FIGVArena::GetNumBlocks() const
+{
+	return Blocks.Num();
+}
+
+SIZE_T FIGVArena::GetUsedSize() const
+{
+	return UsedSize;
+}
+
+SIZE_T FIGVArena::GetAllocatedSize() const
+{
+	return AllocatedSize + Blocks.GetAllocatedSize();
+}
+
+SIZE_T FIGVArena::GetPeakAllocatedSize() const
+{
+	return PeakAllocatedSize;
+}
+
+FString FIGVArena::ToString() const
+{
+	auto MB = [](SIZE_T const Bytes) { return double(Bytes) / (1024.0 * 1024.0); };
+
+	return FString::Printf(
+		TEXT("%d allocations, %.2f MB used of %.2f MB in %d blocks, peak %.2f MB"),
+		NumAllocations, MB(UsedSize), MB(AllocatedSize), Blocks.Num(), MB(PeakAllocatedSize));
+}
@@ -0,0 +1,172 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Linear allocator for the children of the clusters of a graph, see FIGVCluster::Children. Edge
+// data lives in FIGVEdgeStore and node adjacency in FIGVAdjacency instead. Arrays are carved out
+// of a few large blocks sized from the cluster counts known at load time, and are never freed on
+// their own: Empty releases every block at once. Not thread-safe; arrays are allocated on the game
+// thread.
+class IMSVGRAPHVIS_API FIGVArena
+{
+public:
+	// Every allocation is rounded up to this, so ArraySize predicts Reserve exactly.
+	static SIZE_T const Alignment = 8;
+
+	FIGVArena();
+	~FIGVArena();
+
+	FIGVArena(FIGVArena const&) = delete;
+	FIGVArena& operator=(FIGVArena const&) = delete;
+
+	template <typename T>
+	static SIZE_T ArraySize(int32 const Num)
+	{
+		static_assert(alignof(T) <= Alignment, "FIGVArena does not support over-aligned types");
+		return Align(sizeof(T) * Num, Alignment);
+	}
+
+	// Makes sure the next NumBytes are allocated from a single block
+	void Reserve(SIZE_T const NumBytes);
+
+	void* Allocate(SIZE_T const NumBytes);
+
+	void Empty();
+
+	int32 GetNumAllocations() const;
+	int32 GetNumBlocks() const;
+	SIZE_T GetUsedSize() const;
+	SIZE_T GetAllocatedSize() const;
+	SIZE_T GetPeakAllocatedSize() const;
+
+	FString ToString() const;
+
+protected:
+	struct FBlock
+	{
+		uint8* Data;
+		SIZE_T Size;
+	};
+
+	static SIZE_T const MinBlockSize;
+
+	TArray<FBlock> Blocks;
+	SIZE_T CurrentBlockUsed;
+
+	int32 NumAllocations;
+	SIZE_T UsedSize;
+	SIZE_T AllocatedSize;
+	SIZE_T PeakAllocatedSize;
+
+	void AddBlock(SIZE_T const NumBytes);
+};
+
+// Array in an FIGVArena, sized at setup. Copying an arena array copies the view, not the
+// elements; use CopyFrom for the elements. Elements are value-initialized and never destructed,
+// so T has to be trivially destructible.
+//
+// Incremental graph edits may still Add to an array: it moves to a twice larger allocation of the
+// arena when full, and the old one stays unused until the arena is emptied.
+template <typename T>
+class TIGVArenaArray
+{
+public:
+	TIGVArenaArray() : Data(nullptr), ArrayNum(0), ArrayMax(0)
+	{
+	}
+
+	TIGVArenaArray(FIGVArena& Arena, int32 const InNum)
+		: Data(static_cast<T*>(Arena.Allocate(FIGVArena::ArraySize<T>(InNum)))),
+		  ArrayNum(InNum),
+		  ArrayMax(InNum)
+	{
+		static_assert(TIsTriviallyDestructible<T>::Value,
+					  "TIGVArenaArray elements are never destructed");
+
+		for (int32 Idx = 0; Idx < ArrayNum; Idx++)
+		{
+			new (Data + Idx) T();
+		}
+	}
+
+	FORCEINLINE int32 Num() const
+	{
+		return ArrayNum;
+	}
+
+	FORCEINLINE bool IsValidIndex(int32 const Idx) const
+	{
+		return Idx >= 0 && Idx < ArrayNum;
+	}
+
+	FORCEINLINE T* GetData() const
+	{
+		return Data;
+	}
+
+	FORCEINLINE T& operator[](int32 const Idx) const
+	{
+		checkSlow(IsValidIndex(Idx));
+		return Data[Idx];
+	}
+
+	FORCEINLINE T& Last() const
+	{
+		check(ArrayNum > 0);
+		return Data[ArrayNum - 1];
+	}
+
+	void CopyFrom(TIGVArenaArray const& Other) const
+	{
+		check(Other.ArrayNum == ArrayNum);
+		FMemory::Memcpy(Data, Other.Data, sizeof(T) * ArrayNum);
+	}
+
+	int32 Find(T const& Item) const
+	{
+		for (int32 Idx = 0; Idx < ArrayNum; Idx++)
+		{
+			if (Data[Idx] == Item) return Idx;
+		}
+		return INDEX_NONE;
+	}
+
+	void Add(FIGVArena& Arena, T const& Item)
+	{
+		if (ArrayNum == ArrayMax)
+		{
+			ArrayMax = FMath::Max(4, ArrayMax * 2);
+			T* const NewData = static_cast<T*>(Arena.Allocate(FIGVArena::ArraySize<T>(ArrayMax)));
+			if (ArrayNum > 0) FMemory::Memcpy(NewData, Data, sizeof(T) * ArrayNum);
+			Data = NewData;
+		}
+
+		new (Data + ArrayNum) T(Item);
+		ArrayNum++;
+	}
+
+	// The last element takes the place of the removed one.
+	void RemoveAtSwap(int32 const Idx)
+	{
+		check(IsValidIndex(Idx));
+		Data[Idx] = Data[ArrayNum - 1];
+		ArrayNum--;
+	}
+
+	FORCEINLINE T* begin() const
+	{
+		return Data;
+	}
+
+	FORCEINLINE T* end() const
+	{
+		return Data + ArrayNum;
+	}
+
+private:
+	T* Data;
+	int32 ArrayNum;
+	int32 ArrayMax;
+};
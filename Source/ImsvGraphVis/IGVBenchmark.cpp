@@ -0,0 +1,496 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVBenchmark.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "FileHelper.h"
+#include "HAL/FileManager.h"
+#include "Paths.h"
+
+#include "KWJson.h"
+
+#include "IGVData.h"
+#include "IGVEdgeMeshComponent.h"
+#include "IGVGraphActor.h"
+#include "IGVLog.h"
+#include "IGVMemoryUsage.h"
+#include "IGVNodeActor.h"
+#include "IGVTreemapLayout.h"
+
+FIGVBenchmarkRun::FIGVBenchmarkRun()
+	: Stages(), PeakUsedPhysical(0), GraphCPUMemory(0), GraphGPUMemory(0)
+{
+}
+
+double FIGVBenchmarkRun::TotalSeconds() const
+{
+	double Seconds = 0.0;
+	for (FIGVBenchmarkStage const& Stage : Stages)
+	{
+		Seconds += Stage.Seconds;
+	}
+	return Seconds;
+}
+
+FIGVBenchmarkStage const* FIGVBenchmarkRun::FindStage(FString const& Name) const
+{
+	return Stages.FindByPredicate(
+		[&Name](FIGVBenchmarkStage const& Stage) { return Stage.Name == Name; });
+}
+
+float const FIGVBenchmark::TransitionDeltaTime = 1.f / 90.f;
+int32 const FIGVBenchmark::NumEditsPerStage = 100;
+
+FIGVBenchmark::FIGVBenchmark(FIGVSyntheticGraphParams const& InGraphParams, int32 const InNumRuns)
+	: Name(FString::Printf(TEXT("%s-%d"), FIGVSyntheticGraphParams::TypeName(InGraphParams.Type),
+						   InGraphParams.NumNodes)),
+	  GraphParams(InGraphParams),
+	  DataFilePath(),
+	  NumRuns(FMath::Max(InNumRuns, 1)),
+	  bPoolNodeActors(true),
+	  NumNodes(InGraphParams.NumNodes),
+	  NumEdges(0),
+	  NumClusters(0),
+	  GenerateSeconds(0.0),
+	  Runs()
+{
+}
+
+FIGVBenchmark::FIGVBenchmark(FString const& InDataFilePath, int32 const InNumRuns)
+	: Name(FPaths::GetBaseFilename(FPaths::GetBaseFilename(InDataFilePath))),  // *.igv.json
+	  GraphParams(),
+	  DataFilePath(InDataFilePath),
+	  NumRuns(FMath::Max(InNumRuns, 1)),
+	  bPoolNodeActors(true),
+	  NumNodes(0),
+	  NumEdges(0),
+	  NumClusters(0),
+	  GenerateSeconds(0.0),
+	  Runs()
+{
+}
+
+double FIGVBenchmark::ToMB(uint64 const Bytes)
+{
+	return double(Bytes) / (1024.0 * 1024.0);
+}
+
+TArray<FString> FIGVBenchmark::FindDataFilePaths()
+{
+	TArray<FString> DataFilePaths;
+	IFileManager::Get().FindFiles(DataFilePaths, *UIGVData::DefaultDataDirPath(),
+								  TEXT(".igv.json"));
+	DataFilePaths.Sort();
+	for (FString& DataFilePath : DataFilePaths)
+	{
+		DataFilePath = FPaths::Combine(*UIGVData::DefaultDataDirPath(), *DataFilePath);
+	}
+	return DataFilePaths;
+}
+
+TArray<int32> FIGVBenchmark::SuiteNumEdges()
+{
+	TArray<int32> NumEdgesList;
+	NumEdgesList.Add(100000);
+	NumEdgesList.Add(1000000);
+	return NumEdgesList;
+}
+
+int32 FIGVBenchmark::NumNodesForEdges(FIGVSyntheticGraphParams const& Params,
+									  int32 const NumEdges)
+{
+	float const AverageDegree =
+		Params.Type == EIGVSyntheticGraph::Grid ? 4.f : Params.AverageDegree;
+	return FMath::CeilToInt(NumEdges * 2.f / AverageDegree);
+}
+
+FString FIGVBenchmark::DefaultBudgetsFilePath()
+{
+	return FPaths::Combine(*FPaths::GameConfigDir(), TEXT("IGVBenchmarkBudgets.json"));
+}
+
+UWorld* FIGVBenchmark::CreateWorld()
+{
+	UWorld* const World = UWorld::CreateWorld(EWorldType::Game, false);
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	return World;
+}
+
+void FIGVBenchmark::DestroyWorld(UWorld* const World)
+{
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+TSubclassOf<AIGVGraphActor> FIGVBenchmark::LoadGraphActorClass()
+{
+	// The blueprint provides the node actor class and the materials used by the application.
+	UClass* const Class =
+		LoadClass<AIGVGraphActor>(nullptr, TEXT("/Game/Blueprints/BP_GraphActor.BP_GraphActor_C"));
+	if (Class != nullptr) return Class;
+
+	IGV_LOG_S(Warning, TEXT("BP_GraphActor not found, using AIGVGraphActor"));
+	return AIGVGraphActor::StaticClass();
+}
+
+bool FIGVBenchmark::IsSynthetic() const
+{
+	return DataFilePath.IsEmpty();
+}
+
+bool FIGVBenchmark::LoadJson(FString& OutJsonStr)
+{
+	double const StartTime = FPlatformTime::Seconds();
+
+	if (IsSynthetic())
+	{
+		FIGVSyntheticGraph Graph(GraphParams);
+		if (!SerializeJson(Graph.Generate(), OutJsonStr))
+		{
+			IGV_LOG_S(Error, TEXT("Unable to serialize a synthetic graph"));
+			return false;
+		}
+	}
+	else if (!FFileHelper::LoadFileToString(OutJsonStr, *DataFilePath))
+	{
+		IGV_LOG_S(Error, TEXT("Unable to read %s"), *DataFilePath);
+		return false;
+	}
+
+	GenerateSeconds = FPlatformTime::Seconds() - StartTime;
+	return true;
+}
+
+bool FIGVBenchmark::Run(UWorld* const World, TSubclassOf<AIGVGraphActor> const GraphActorClass)
+{
+	FString JsonStr;
+	if (!LoadJson(JsonStr)) return false;
+
+	AIGVGraphActor* const GraphActor = World->SpawnActor<AIGVGraphActor>(GraphActorClass);
+	if (GraphActor == nullptr)
+	{
+		IGV_LOG_S(Error, TEXT("Unable to spawn %s"), *GetNameSafe(*GraphActorClass));
+		return false;
+	}
+
+	if (GraphActor->NodeActorClass == nullptr)
+	{
+		GraphActor->NodeActorClass = AIGVNodeActor::StaticClass();
+	}
+	if (!bPoolNodeActors) GraphActor->NodeActorPoolSlack = 0.f;
+
+	// CPU side only, see the class comment
+	for (UIGVEdgeMeshComponent* const Component :
+		 {GraphActor->DefaultEdgeGroupMeshComponent, GraphActor->HighlightedEdgeGroupMeshComponent,
+		  GraphActor->RemainedEdgeGroupMeshComponent})
+	{
+		if (Component->IsRegistered()) Component->UnregisterComponent();
+	}
+
+	bool bSucceeded = true;
+	Runs.Reset();
+
+	for (int32 RunIdx = 0; RunIdx < NumRuns && bSucceeded; RunIdx++)
+	{
+		bSucceeded = RunOnce(GraphActor, JsonStr, Runs[Runs.AddDefaulted()]);
+
+		IGV_LOG(Log, TEXT("Run %d/%d: %.3f s"), RunIdx + 1, NumRuns, Runs.Last().TotalSeconds());
+	}
+
+	GraphActor->Destroy();
+	return bSucceeded;
+}
+
+bool FIGVBenchmark::RunOnce(AIGVGraphActor* const GraphActor, FString const& JsonStr,
+							FIGVBenchmarkRun& OutRun)
+{
+	auto RunStage = [&OutRun](TCHAR const* const Name, TFunctionRef<void()> Function) {
+		double const StartTime = FPlatformTime::Seconds();
+		Function();
+		double const Seconds = FPlatformTime::Seconds() - StartTime;
+
+		OutRun.Stages.Emplace(
+			FIGVBenchmarkStage{Name, Seconds, FPlatformMemory::GetStats().UsedPhysical});
+	};
+
+	TSharedPtr<FJsonObject> GraphJsonObj = MakeShareable(new FJsonObject());
+	bool bParsed = false;
+	RunStage(TEXT("ParseJson"), [&]() { bParsed = DeserializeJson(JsonStr, GraphJsonObj); });
+	if (!bParsed)
+	{
+		IGV_LOG_S(Error, TEXT("Unable to deserialize a synthetic graph"));
+		return false;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> const& NodeJsonObjs = GraphJsonObj->GetArrayField(TEXT("nodes"));
+	TArray<TSharedPtr<FJsonValue>> const& EdgeJsonObjs = GraphJsonObj->GetArrayField(TEXT("links"));
+	TArray<TSharedPtr<FJsonValue>> const& ClusterJsonObjs =
+		GraphJsonObj->GetArrayField(TEXT("clusters"));
+
+	RunStage(TEXT("SpawnNodes"), [&]() { UIGVData::DeserializeNodes(NodeJsonObjs, GraphActor); });
+	RunStage(TEXT("DeserializeEdges"),
+			 [&]() { UIGVData::DeserializeEdges(EdgeJsonObjs, GraphActor); });
+	RunStage(TEXT("DeserializeClusters"),
+			 [&]() { UIGVData::DeserializeClusters(ClusterJsonObjs, GraphActor); });
+	GraphJsonObj.Reset();
+
+	RunStage(TEXT("SetupNodes"), [&]() { GraphActor->SetupNodes(); });
+	RunStage(TEXT("SetupEdges"), [&]() { GraphActor->SetupEdges(); });
+	RunStage(TEXT("SetupClusters"), [&]() { GraphActor->SetupClusters(); });
+	RunStage(TEXT("UpdateColors"), [&]() { GraphActor->UpdateColors(); });
+	RunStage(TEXT("TreemapLayout"), [&]() {
+		GraphActor->UpdatePlanarExtent();
+		FIGVTreemapLayout Layout(GraphActor);
+		Layout.Compute();
+	});
+	RunStage(TEXT("Projection"), [&]() { GraphActor->NormalizeNodePosition(); });
+	RunStage(TEXT("SplineControlPoints"), [&]() { GraphActor->UpdateSplineControlPoints(); });
+	RunStage(TEXT("EdgeMeshes"), [&]() { GraphActor->SetupEdgeMeshes(); });
+
+	NumNodes = GraphActor->Nodes.Num();
+	NumEdges = GraphActor->Edges.Num();
+	NumClusters = GraphActor->Clusters.Num();
+
+	FIGVMemoryUsage const MemoryUsage(GraphActor);
+	OutRun.GraphCPUMemory = MemoryUsage.TotalCPU();
+	OutRun.GraphGPUMemory = MemoryUsage.TotalGPU();
+
+	FIGVAdjacency const& Adjacency = GraphActor->Adjacency;
+	AIGVNodeActor* HubNode = nullptr;
+	for (AIGVNodeActor* const Node : GraphActor->Nodes)
+	{
+		if (HubNode == nullptr ||
+			Adjacency.GetDegree(Node->Idx) > Adjacency.GetDegree(HubNode->Idx))
+		{
+			HubNode = Node;
+		}
+	}
+
+	if (HubNode != nullptr)
+	{
+		RunStage(TEXT("Highlight"), [&]() {
+			HubNode->BeginHighlighted();
+			RunTransition(GraphActor);
+		});
+		RunStage(TEXT("Unhighlight"), [&]() {
+			HubNode->EndHighlighted();
+			RunTransition(GraphActor);
+		});
+	}
+
+	// A full rebuild of every group, as after a layout change
+	RunStage(TEXT("EdgeMeshUpdate"), [&]() {
+		GraphActor->DefaultEdgeGroupMeshComponent->Update();
+		GraphActor->HighlightedEdgeGroupMeshComponent->Update();
+		GraphActor->RemainedEdgeGroupMeshComponent->Update();
+	});
+
+	RunEditStages(GraphActor, RunStage, OutRun);
+
+	RunStage(TEXT("EmptyGraph"), [&]() { GraphActor->EmptyGraph(); });
+
+	// Spawned node actors are only released by the garbage collector.
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	OutRun.PeakUsedPhysical = FPlatformMemory::GetStats().PeakUsedPhysical;
+	return true;
+}
+
+void FIGVBenchmark::RunEditStages(AIGVGraphActor* const GraphActor, FRunStageFunction RunStage,
+								  FIGVBenchmarkRun const& Run) const
+{
+	TArray<int32> ParentClusterIdxs;
+	for (FIGVCluster const& Cluster : GraphActor->Clusters)
+	{
+		if (Cluster.Height == 1) ParentClusterIdxs.Add(Cluster.Idx);
+	}
+
+	if (GraphActor->Nodes.Num() < 2 || ParentClusterIdxs.Num() < 2)
+	{
+		IGV_LOG(Log, TEXT("Graph too small for incremental edits"));
+		return;
+	}
+
+	// The same edits in every run of a graph
+	FRandomStream Random(GraphActor->Nodes.Num());
+
+	auto RandomNodeIdx = [&]() { return Random.RandHelper(GraphActor->Nodes.Num()); };
+	auto RandomParentClusterIdx = [&](int32 const ExcludedIdx) {
+		int32 const Idx = Random.RandHelper(ParentClusterIdxs.Num());
+		return ParentClusterIdxs[Idx] != ExcludedIdx
+				   ? ParentClusterIdxs[Idx]
+				   : ParentClusterIdxs[(Idx + 1) % ParentClusterIdxs.Num()];
+	};
+
+	// Every stage ends with the edge meshes up to date, including a full rebuild of the default
+	// mesh once too much of it is left unused by the patches.
+	auto RunEditStage = [&](TCHAR const* const Name, TFunctionRef<void()> Edit) {
+		RunStage(Name, [&]() {
+			for (int32 EditIdx = 0; EditIdx < NumEditsPerStage; EditIdx++)
+			{
+				Edit();
+			}
+
+			do
+			{
+				GraphActor->UpdateEdgeMeshes();
+			} while (GraphActor->bUpdateDefaultEdgeMeshRequired ||
+					 GraphActor->DefaultEdgeGroupMeshComponent->IsIncrementalUpdateInProgress());
+		});
+
+		IGV_LOG(Log, TEXT("%s: %.3f ms per edit"), Name,
+				Run.Stages.Last().Seconds * 1000.0 / NumEditsPerStage);
+	};
+
+	RunEditStage(TEXT("AddEdges"), [&]() {
+		int32 const NumNodes = GraphActor->Nodes.Num();
+		int32 const SourceIdx = RandomNodeIdx();
+		int32 const TargetIdx = (SourceIdx + 1 + Random.RandHelper(NumNodes - 1)) % NumNodes;
+		GraphActor->AddEdge(SourceIdx, TargetIdx);
+	});
+	RunEditStage(TEXT("RemoveEdges"), [&]() {
+		GraphActor->RemoveEdge(Random.RandHelper(GraphActor->Edges.Num()));
+	});
+	RunEditStage(TEXT("MoveNodes"), [&]() {
+		AIGVNodeActor const* const Node = GraphActor->Nodes[RandomNodeIdx()];
+		int32 const ParentIdx = GraphActor->Clusters[Node->ClusterIdx].ParentIdx;
+		GraphActor->MoveNode(Node->Idx, RandomParentClusterIdx(ParentIdx));
+	});
+	RunEditStage(TEXT("AddRemoveNodes"), [&]() {
+		GraphActor->AddNode(TEXT("Added"), RandomParentClusterIdx(INDEX_NONE));
+		GraphActor->RemoveNode(RandomNodeIdx());
+	});
+}
+
+void FIGVBenchmark::RunTransition(AIGVGraphActor* const GraphActor) const
+{
+	do
+	{
+		GraphActor->TransitionManager.Tick(TransitionDeltaTime);
+		GraphActor->UpdateEdgeMeshes();
+	} while (GraphActor->TransitionManager.IsActive() ||
+			 GraphActor->DefaultEdgeGroupMeshComponent->IsIncrementalUpdateInProgress());
+}
+
+double FIGVBenchmark::MinSeconds(FString const& StageName) const
+{
+	double Seconds = TNumericLimits<double>::Max();
+	for (FIGVBenchmarkRun const& Run : Runs)
+	{
+		FIGVBenchmarkStage const* const Stage = Run.FindStage(StageName);
+		if (Stage) Seconds = FMath::Min(Seconds, Stage->Seconds);
+	}
+	return Seconds;
+}
+
+double FIGVBenchmark::MeanSeconds(FString const& StageName) const
+{
+	double Seconds = 0.0;
+	int32 Num = 0;
+	for (FIGVBenchmarkRun const& Run : Runs)
+	{
+		FIGVBenchmarkStage const* const Stage = Run.FindStage(StageName);
+		if (Stage)
+		{
+			Seconds += Stage->Seconds;
+			Num++;
+		}
+	}
+	return Num > 0 ? Seconds / Num : 0.0;
+}
+
+TSharedRef<FJsonObject> FIGVBenchmark::ToJson() const
+{
+	TSharedRef<FJsonObject> GraphJsonObj = MakeShareable(new FJsonObject());
+	GraphJsonObj->SetStringField(TEXT("name"), Name);
+	GraphJsonObj->SetNumberField(TEXT("numNodes"), NumNodes);
+	GraphJsonObj->SetNumberField(TEXT("numEdges"), NumEdges);
+	GraphJsonObj->SetNumberField(TEXT("numClusters"), NumClusters);
+	if (IsSynthetic())
+	{
+		GraphJsonObj->SetStringField(TEXT("type"),
+									 FIGVSyntheticGraphParams::TypeName(GraphParams.Type));
+		GraphJsonObj->SetNumberField(TEXT("averageDegree"), GraphParams.AverageDegree);
+		GraphJsonObj->SetNumberField(TEXT("branching"), GraphParams.Branching);
+		GraphJsonObj->SetNumberField(TEXT("depth"), GraphParams.Depth);
+		GraphJsonObj->SetNumberField(TEXT("locality"), GraphParams.Locality);
+		GraphJsonObj->SetNumberField(TEXT("seed"), GraphParams.Seed);
+	}
+	else
+	{
+		GraphJsonObj->SetStringField(TEXT("file"), DataFilePath);
+	}
+
+	TArray<TSharedPtr<FJsonValue>> RunJsonObjs;
+	for (FIGVBenchmarkRun const& Run : Runs)
+	{
+		TArray<TSharedPtr<FJsonValue>> StageJsonObjs;
+		for (FIGVBenchmarkStage const& Stage : Run.Stages)
+		{
+			TSharedRef<FJsonObject> StageJsonObj = MakeShareable(new FJsonObject());
+			StageJsonObj->SetStringField(TEXT("name"), Stage.Name);
+			StageJsonObj->SetNumberField(TEXT("seconds"), Stage.Seconds);
+			StageJsonObj->SetNumberField(TEXT("usedPhysicalMB"), ToMB(Stage.UsedPhysical));
+			StageJsonObjs.Add(MakeShareable(new FJsonValueObject(StageJsonObj)));
+		}
+
+		TSharedRef<FJsonObject> RunJsonObj = MakeShareable(new FJsonObject());
+		RunJsonObj->SetArrayField(TEXT("stages"), StageJsonObjs);
+		RunJsonObj->SetNumberField(TEXT("totalSeconds"), Run.TotalSeconds());
+		RunJsonObj->SetNumberField(TEXT("peakUsedPhysicalMB"), ToMB(Run.PeakUsedPhysical));
+		RunJsonObj->SetNumberField(TEXT("graphCPUMemoryMB"), ToMB(Run.GraphCPUMemory));
+		RunJsonObj->SetNumberField(TEXT("graphGPUMemoryMB"), ToMB(Run.GraphGPUMemory));
+		RunJsonObjs.Add(MakeShareable(new FJsonValueObject(RunJsonObj)));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> SummaryJsonObjs;
+	if (Runs.Num() > 0)
+	{
+		for (FIGVBenchmarkStage const& Stage : Runs[0].Stages)
+		{
+			TSharedRef<FJsonObject> StageJsonObj = MakeShareable(new FJsonObject());
+			StageJsonObj->SetStringField(TEXT("name"), Stage.Name);
+			StageJsonObj->SetNumberField(TEXT("minSeconds"), MinSeconds(Stage.Name));
+			StageJsonObj->SetNumberField(TEXT("meanSeconds"), MeanSeconds(Stage.Name));
+			SummaryJsonObjs.Add(MakeShareable(new FJsonValueObject(StageJsonObj)));
+		}
+	}
+
+	TSharedRef<FJsonObject> BenchmarkJsonObj = MakeShareable(new FJsonObject());
+	BenchmarkJsonObj->SetObjectField(TEXT("graph"), GraphJsonObj);
+	BenchmarkJsonObj->SetNumberField(TEXT("generateSeconds"), GenerateSeconds);
+	BenchmarkJsonObj->SetBoolField(TEXT("poolNodeActors"), bPoolNodeActors);
+	BenchmarkJsonObj->SetArrayField(TEXT("runs"), RunJsonObjs);
+	BenchmarkJsonObj->SetArrayField(TEXT("summary"), SummaryJsonObjs);
+	return BenchmarkJsonObj;
+}
+
+FString FIGVBenchmark::CsvHeader()
+{
+	return TEXT("graph,nodes,edges,clusters,run,stage,seconds,used_physical_mb,")
+		   TEXT("peak_used_physical_mb\n");
+}
+
+FString FIGVBenchmark::ToCsv() const
+{
+	FString Csv;
+	for (int32 RunIdx = 0; RunIdx < Runs.Num(); RunIdx++)
+	{
+		FIGVBenchmarkRun const& Run = Runs[RunIdx];
+		for (FIGVBenchmarkStage const& Stage : Run.Stages)
+		{
+			Csv += FString::Printf(TEXT("%s,%d,%d,%d,%d,%s,%f,%f,%f\n"), *Name, NumNodes, NumEdges,
+								   NumClusters, RunIdx, *Stage.Name, Stage.Seconds,
+								   ToMB(Stage.UsedPhysical), ToMB(Run.PeakUsedPhysical));
+		}
+	}
+	return Csv;
+}
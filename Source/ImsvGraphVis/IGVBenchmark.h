@@ -0,0 +1,109 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "Core.h"
+#include "Json.h"
+
+#include "IGVSyntheticGraph.h"
+
+struct IMSVGRAPHVIS_API FIGVBenchmarkStage
+{
+	FString Name;
+	double Seconds;
+	uint64 UsedPhysical;  // Process memory after the stage, in bytes
+};
+
+struct IMSVGRAPHVIS_API FIGVBenchmarkRun
+{
+	TArray<FIGVBenchmarkStage> Stages;
+
+	uint64 PeakUsedPhysical;  // Process peak so far, in bytes
+	uint64 GraphCPUMemory;	// See FIGVMemoryUsage
+	uint64 GraphGPUMemory;
+
+	FIGVBenchmarkRun();
+
+	double TotalSeconds() const;
+	FIGVBenchmarkStage const* FindStage(FString const& Name) const;
+};
+
+// Loads a graph into a graph actor several times, running each stage of AIGVGraphActor::SetupGraph
+// on its own and timing it, followed by a highlight transition in and out of the node with the
+// most edges. Edge meshes are generated on the CPU only; the edge mesh components are
+// unregistered, so no scene proxy or compute shader is involved and the benchmark runs with
+// -nullrhi.
+class IMSVGRAPHVIS_API FIGVBenchmark
+{
+public:
+	FString const Name;  // Budget key, see FIGVBenchmarkBudgets
+
+	FIGVSyntheticGraphParams const GraphParams;  // Unused for datasets
+	FString const DataFilePath;					 // Empty for synthetic graphs
+
+	int32 const NumRuns;
+
+	// Runs after the first reuse the node actors of the previous one, see
+	// AIGVGraphActor::NodeActorPool. Disabled to compare.
+	bool bPoolNodeActors;
+
+	int32 NumNodes;
+	int32 NumEdges;
+	int32 NumClusters;
+	double GenerateSeconds;  // Or reading the file
+
+	TArray<FIGVBenchmarkRun> Runs;
+
+	// Frame time of the simulated highlight transitions
+	static float const TransitionDeltaTime;
+	// Incremental edits timed together in each edit stage
+	static int32 const NumEditsPerStage;
+
+public:
+	FIGVBenchmark(FIGVSyntheticGraphParams const& InGraphParams, int32 const InNumRuns);
+	FIGVBenchmark(FString const& InDataFilePath, int32 const InNumRuns);
+
+	static double ToMB(uint64 const Bytes);
+
+	// The regression suite, checked by the IGV.Benchmark automation tests: every dataset in
+	// UIGVData::DefaultDataDirPath, and synthetic graphs of the default generator with these edges
+	static TArray<FString> FindDataFilePaths();
+	static TArray<int32> SuiteNumEdges();
+	// Every edge adds two to the degree sum, and a grid node has four neighbors.
+	static int32 NumNodesForEdges(FIGVSyntheticGraphParams const& Params, int32 const NumEdges);
+
+	static FString DefaultBudgetsFilePath();
+
+	// A game world without a viewport, for the commandlet and the automation tests
+	static class UWorld* CreateWorld();
+	static void DestroyWorld(class UWorld* const World);
+	static TSubclassOf<class AIGVGraphActor> LoadGraphActorClass();
+
+	bool IsSynthetic() const;
+
+	bool Run(class UWorld* const World, TSubclassOf<class AIGVGraphActor> const GraphActorClass);
+
+	double MinSeconds(FString const& StageName) const;
+	double MeanSeconds(FString const& StageName) const;
+
+	TSharedRef<FJsonObject> ToJson() const;
+
+	static FString CsvHeader();
+	FString ToCsv() const;
+
+protected:
+	bool LoadJson(FString& OutJsonStr);
+
+	bool RunOnce(class AIGVGraphActor* const GraphActor, FString const& JsonStr,
+				 FIGVBenchmarkRun& OutRun);
+
+	// Ticks the transition manager and edge meshes at TransitionDeltaTime until both settle
+	void RunTransition(class AIGVGraphActor* const GraphActor) const;
+
+	typedef TFunctionRef<void(TCHAR const* const, TFunctionRef<void()>)> FRunStageFunction;
+
+	// Random edge additions and removals, node moves between clusters, and node additions and
+	// removals, NumEditsPerStage each with the edge meshes updated once at the end
+	void RunEditStages(class AIGVGraphActor* const GraphActor, FRunStageFunction RunStage,
+					   FIGVBenchmarkRun const& Run) const;
+};
@@ -0,0 +1,162 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVBenchmarkBudgets.h"
+
+#include "FileHelper.h"
+
+#include "KWJson.h"
+
+#include "IGVBenchmark.h"
+#include "IGVLog.h"
+
+FIGVBenchmarkBudgets::FIGVBenchmarkBudgets()
+	: TimeTolerance(1.5f), MemoryTolerance(1.1f), Graphs()
+{
+}
+
+bool FIGVBenchmarkBudgets::Load(FString const& FilePath)
+{
+	FString JsonStr;
+	TSharedPtr<FJsonObject> JsonObj = MakeShareable(new FJsonObject());
+	if (!FFileHelper::LoadFileToString(JsonStr, *FilePath) || !DeserializeJson(JsonStr, JsonObj))
+	{
+		IGV_LOG_S(Error, TEXT("Unable to read budgets from %s"), *FilePath);
+		return false;
+	}
+
+	double Value;
+	if (JsonObj->TryGetNumberField(TEXT("timeTolerance"), Value)) TimeTolerance = Value;
+	if (JsonObj->TryGetNumberField(TEXT("memoryTolerance"), Value)) MemoryTolerance = Value;
+
+	Graphs.Reset();
+
+	TSharedPtr<FJsonObject> const* GraphsJsonObj;
+	if (!JsonObj->TryGetObjectField(TEXT("graphs"), GraphsJsonObj)) return true;
+
+	for (auto const& GraphPair : (*GraphsJsonObj)->Values)
+	{
+		TSharedPtr<FJsonObject> const GraphJsonObj = GraphPair.Value->AsObject();
+		if (!GraphJsonObj.IsValid()) continue;
+
+		FGraphBudget& Budget = Graphs.Add(GraphPair.Key);
+		Budget.PeakUsedPhysicalMB = GraphJsonObj->GetNumberField(TEXT("peakUsedPhysicalMB"));
+		Budget.GraphCPUMemoryMB = GraphJsonObj->GetNumberField(TEXT("graphCPUMemoryMB"));
+		Budget.GraphGPUMemoryMB = GraphJsonObj->GetNumberField(TEXT("graphGPUMemoryMB"));
+
+		TSharedPtr<FJsonObject> const* StagesJsonObj;
+		if (GraphJsonObj->TryGetObjectField(TEXT("stages"), StagesJsonObj))
+		{
+			for (auto const& StagePair : (*StagesJsonObj)->Values)
+			{
+				Budget.StageSeconds.Add(StagePair.Key, StagePair.Value->AsNumber());
+			}
+		}
+	}
+
+	IGV_LOG(Log, TEXT("Loaded budgets of %d graphs from %s"), Graphs.Num(), *FilePath);
+	return true;
+}
+
+bool FIGVBenchmarkBudgets::Save(FString const& FilePath) const
+{
+	TSharedRef<FJsonObject> GraphsJsonObj = MakeShareable(new FJsonObject());
+	for (auto const& GraphPair : Graphs)
+	{
+		FGraphBudget const& Budget = GraphPair.Value;
+
+		TSharedRef<FJsonObject> StagesJsonObj = MakeShareable(new FJsonObject());
+		for (auto const& StagePair : Budget.StageSeconds)
+		{
+			StagesJsonObj->SetNumberField(StagePair.Key, StagePair.Value);
+		}
+
+		TSharedRef<FJsonObject> GraphJsonObj = MakeShareable(new FJsonObject());
+		GraphJsonObj->SetObjectField(TEXT("stages"), StagesJsonObj);
+		GraphJsonObj->SetNumberField(TEXT("peakUsedPhysicalMB"), Budget.PeakUsedPhysicalMB);
+		GraphJsonObj->SetNumberField(TEXT("graphCPUMemoryMB"), Budget.GraphCPUMemoryMB);
+		GraphJsonObj->SetNumberField(TEXT("graphGPUMemoryMB"), Budget.GraphGPUMemoryMB);
+		GraphsJsonObj->SetObjectField(GraphPair.Key, GraphJsonObj);
+	}
+
+	TSharedRef<FJsonObject> JsonObj = MakeShareable(new FJsonObject());
+	JsonObj->SetNumberField(TEXT("timeTolerance"), TimeTolerance);
+	JsonObj->SetNumberField(TEXT("memoryTolerance"), MemoryTolerance);
+	JsonObj->SetObjectField(TEXT("graphs"), GraphsJsonObj);
+
+	FString JsonStr;
+	if (!SerializeJson(JsonObj, JsonStr) || !FFileHelper::SaveStringToFile(JsonStr, *FilePath))
+	{
+		IGV_LOG_S(Error, TEXT("Unable to write budgets to %s"), *FilePath);
+		return false;
+	}
+	return true;
+}
+
+void FIGVBenchmarkBudgets::Record(FIGVBenchmark const& Benchmark)
+{
+	if (Benchmark.Runs.Num() == 0) return;
+
+	FGraphBudget& Budget = Graphs.Add(Benchmark.Name);
+	Budget.StageSeconds.Reset();
+	Budget.PeakUsedPhysicalMB = 0.0;
+	Budget.GraphCPUMemoryMB = 0.0;
+	Budget.GraphGPUMemoryMB = 0.0;
+
+	for (FIGVBenchmarkStage const& Stage : Benchmark.Runs[0].Stages)
+	{
+		Budget.StageSeconds.Add(Stage.Name, Benchmark.MinSeconds(Stage.Name));
+	}
+
+	for (FIGVBenchmarkRun const& Run : Benchmark.Runs)
+	{
+		Budget.PeakUsedPhysicalMB =
+			FMath::Max(Budget.PeakUsedPhysicalMB, FIGVBenchmark::ToMB(Run.PeakUsedPhysical));
+		Budget.GraphCPUMemoryMB =
+			FMath::Max(Budget.GraphCPUMemoryMB, FIGVBenchmark::ToMB(Run.GraphCPUMemory));
+		Budget.GraphGPUMemoryMB =
+			FMath::Max(Budget.GraphGPUMemoryMB, FIGVBenchmark::ToMB(Run.GraphGPUMemory));
+	}
+}
+
+bool FIGVBenchmarkBudgets::Check(FIGVBenchmark const& Benchmark,
+								 TArray<FString>& OutFailures) const
+{
+	FGraphBudget const* const Budget = Graphs.Find(Benchmark.Name);
+	if (Budget == nullptr || Benchmark.Runs.Num() == 0)
+	{
+		IGV_LOG(Warning, TEXT("%s: no budget"), *Benchmark.Name);
+		return true;
+	}
+
+	int32 const NumFailures = OutFailures.Num();
+
+	// The fastest run is the least affected by other processes.
+	for (auto const& StagePair : Budget->StageSeconds)
+	{
+		CheckValue(Benchmark.Name, *StagePair.Key, Benchmark.MinSeconds(StagePair.Key),
+				   StagePair.Value, TimeTolerance, OutFailures);
+	}
+
+	// The process peak includes the graphs benchmarked before, so it is only comparable when
+	// budgets are recorded with -Suite, which runs the graphs in the order of the tests.
+	FIGVBenchmarkRun const& Run = Benchmark.Runs.Last();
+	CheckValue(Benchmark.Name, TEXT("PeakUsedPhysicalMB"),
+			   FIGVBenchmark::ToMB(Run.PeakUsedPhysical), Budget->PeakUsedPhysicalMB,
+			   MemoryTolerance, OutFailures);
+	CheckValue(Benchmark.Name, TEXT("GraphCPUMemoryMB"), FIGVBenchmark::ToMB(Run.GraphCPUMemory),
+			   Budget->GraphCPUMemoryMB, MemoryTolerance, OutFailures);
+	CheckValue(Benchmark.Name, TEXT("GraphGPUMemoryMB"), FIGVBenchmark::ToMB(Run.GraphGPUMemory),
+			   Budget->GraphGPUMemoryMB, MemoryTolerance, OutFailures);
+
+	return OutFailures.Num() == NumFailures;
+}
+
+void FIGVBenchmarkBudgets::CheckValue(FString const& Name, TCHAR const* const What,
+									  double const Value, double const Budget,
+									  float const Tolerance, TArray<FString>& OutFailures) const
+{
+	if (Budget <= 0.0 || Value <= Budget * Tolerance) return;
+
+	OutFailures.Add(FString::Printf(TEXT("%s: %s %g exceeds the budget %g (x%g)"), *Name, What,
+									Value, Budget, Tolerance));
+}
@@ -0,0 +1,48 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "Core.h"
+#include "Json.h"
+
+// Time and memory budgets of FIGVBenchmark, keyed by FIGVBenchmark::Name. Budgets are recorded
+// by the IGVBenchmark commandlet on the reference machine and checked by the IGV.Benchmark
+// automation tests, so a regression fails a test instead of showing up on the headset.
+//
+// {"timeTolerance": 1.5, "memoryTolerance": 1.1,
+//  "graphs": {"karate": {"stages": {"SetupClusters": 0.0012, ...}, "graphCPUMemoryMB": 0.4, ...}}}
+class IMSVGRAPHVIS_API FIGVBenchmarkBudgets
+{
+public:
+	// Allowed ratio of a measurement to its budget
+	float TimeTolerance;
+	float MemoryTolerance;
+
+public:
+	FIGVBenchmarkBudgets();
+
+	bool Load(FString const& FilePath);
+	bool Save(FString const& FilePath) const;
+
+	// Replaces the budgets of the benchmarked graph by its measurements
+	void Record(class FIGVBenchmark const& Benchmark);
+
+	// Returns false and describes each exceeded budget in OutFailures. Graphs and stages without a
+	// budget pass.
+	bool Check(class FIGVBenchmark const& Benchmark, TArray<FString>& OutFailures) const;
+
+protected:
+	struct FGraphBudget
+	{
+		TMap<FString, double> StageSeconds;  // Fastest of the runs
+		double PeakUsedPhysicalMB;			 // Largest of the runs
+		double GraphCPUMemoryMB;
+		double GraphGPUMemoryMB;
+	};
+
+	TMap<FString, FGraphBudget> Graphs;
+
+	void CheckValue(FString const& Name, TCHAR const* const What, double const Value,
+					double const Budget, float const Tolerance,
+					TArray<FString>& OutFailures) const;
+};
@@ -0,0 +1,206 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVBenchmarkCommandlet.h"
+
+#include "FileHelper.h"
+#include "Paths.h"
+
+#include "KWJson.h"
+
+#include "IGVBenchmark.h"
+#include "IGVBenchmarkBudgets.h"
+#include "IGVData.h"
+#include "IGVGraphActor.h"
+#include "IGVLog.h"
+
+UIGVBenchmarkCommandlet::UIGVBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UIGVBenchmarkCommandlet::Main(FString const& Params)
+{
+	FIGVSyntheticGraphParams GraphParams;
+
+	FString TypeStr;
+	if (FParse::Value(*Params, TEXT("Generator="), TypeStr))
+	{
+		if (!FIGVSyntheticGraphParams::ParseType(TypeStr, GraphParams.Type))
+		{
+			IGV_LOG_S(Error, TEXT("Unknown generator: %s (sbm, powerlaw or grid)"), *TypeStr);
+			return 1;
+		}
+	}
+
+	FParse::Value(*Params, TEXT("AvgDegree="), GraphParams.AverageDegree);
+	FParse::Value(*Params, TEXT("Branching="), GraphParams.Branching);
+	FParse::Value(*Params, TEXT("Depth="), GraphParams.Depth);
+	FParse::Value(*Params, TEXT("Locality="), GraphParams.Locality);
+	FParse::Value(*Params, TEXT("Seed="), GraphParams.Seed);
+
+	int32 NumRuns = 3;
+	FParse::Value(*Params, TEXT("Runs="), NumRuns);
+
+	// The graphs of the IGV.Benchmark automation tests, to record their budgets
+	bool const bSuite = FParse::Param(*Params, TEXT("Suite"));
+
+	TArray<FString> DataFilePaths;
+	FString DatasetsStr;
+	if (FParse::Value(*Params, TEXT("Datasets="), DatasetsStr, false))
+	{
+		TArray<FString> DatasetNames;
+		DatasetsStr.ParseIntoArray(DatasetNames, TEXT(","));
+		for (FString const& DatasetName : DatasetNames)
+		{
+			DataFilePaths.Add(FPaths::Combine(*UIGVData::DefaultDataDirPath(),
+											  *(DatasetName + TEXT(".igv.json"))));
+		}
+	}
+	else if (bSuite || FParse::Param(*Params, TEXT("Datasets")))
+	{
+		DataFilePaths = FIGVBenchmark::FindDataFilePaths();
+	}
+
+	TArray<int32> NumNodesList = ParseIntList(Params, TEXT("Nodes="));
+
+	TArray<int32> NumEdgesList = ParseIntList(Params, TEXT("Edges="));
+	if (NumEdgesList.Num() == 0 && bSuite)
+	{
+		NumEdgesList = FIGVBenchmark::SuiteNumEdges();
+	}
+	for (int32 const NumEdges : NumEdgesList)
+	{
+		NumNodesList.Add(FIGVBenchmark::NumNodesForEdges(GraphParams, NumEdges));
+	}
+
+	if (NumNodesList.Num() == 0 && DataFilePaths.Num() == 0)
+	{
+		NumNodesList.Add(GraphParams.NumNodes);
+	}
+
+	TArray<TSharedPtr<FIGVBenchmark>> Benchmarks;
+	for (FString const& DataFilePath : DataFilePaths)
+	{
+		Benchmarks.Add(MakeShareable(new FIGVBenchmark(DataFilePath, NumRuns)));
+	}
+	for (int32 const NumNodes : NumNodesList)
+	{
+		GraphParams.NumNodes = NumNodes;
+		Benchmarks.Add(MakeShareable(new FIGVBenchmark(GraphParams, NumRuns)));
+	}
+
+	bool const bPoolNodeActors = !FParse::Param(*Params, TEXT("NoNodeActorPool"));
+	for (TSharedPtr<FIGVBenchmark> const& Benchmark : Benchmarks)
+	{
+		Benchmark->bPoolNodeActors = bPoolNodeActors;
+	}
+
+	FString const TypeName = FIGVSyntheticGraphParams::TypeName(GraphParams.Type);
+	FString const OutputDirPath = FPaths::Combine(*FPaths::GameSavedDir(), TEXT("Benchmark/"));
+
+	FString JsonFilePath =
+		FPaths::Combine(*OutputDirPath, *FString::Printf(TEXT("IGVBenchmark-%s.json"), *TypeName));
+	FParse::Value(*Params, TEXT("Json="), JsonFilePath);
+
+	FString CsvFilePath;
+	FParse::Value(*Params, TEXT("Csv="), CsvFilePath);
+
+	FString BudgetsFilePath = FIGVBenchmark::DefaultBudgetsFilePath();
+	FParse::Value(*Params, TEXT("Budgets="), BudgetsFilePath);
+
+	// Other graphs keep their budgets.
+	bool const bRecordBudgets = FParse::Param(*Params, TEXT("RecordBudgets"));
+	FIGVBenchmarkBudgets Budgets;
+	if (bRecordBudgets && FPaths::FileExists(BudgetsFilePath))
+	{
+		if (!Budgets.Load(BudgetsFilePath)) return 1;
+	}
+
+	TSubclassOf<AIGVGraphActor> const GraphActorClass = FIGVBenchmark::LoadGraphActorClass();
+	UWorld* const World = FIGVBenchmark::CreateWorld();
+
+	TArray<TSharedPtr<FJsonValue>> BenchmarkJsonObjs;
+	FString Csv = FIGVBenchmark::CsvHeader();
+	bool bSucceeded = true;
+
+	for (TSharedPtr<FIGVBenchmark> const& Benchmark : Benchmarks)
+	{
+		IGV_LOG(Display, TEXT("Benchmark: %s"), *Benchmark->Name);
+
+		if (!Benchmark->Run(World, GraphActorClass))
+		{
+			bSucceeded = false;
+			break;
+		}
+
+		double MinTotalSeconds = TNumericLimits<double>::Max();
+		for (FIGVBenchmarkRun const& Run : Benchmark->Runs)
+		{
+			MinTotalSeconds = FMath::Min(MinTotalSeconds, Run.TotalSeconds());
+		}
+
+		IGV_LOG(Display, TEXT("Nodes=%d Edges=%d Clusters=%d Total=%.3f s (min of %d runs)"),
+				Benchmark->NumNodes, Benchmark->NumEdges, Benchmark->NumClusters,
+				MinTotalSeconds, NumRuns);
+
+		BenchmarkJsonObjs.Add(MakeShareable(new FJsonValueObject(Benchmark->ToJson())));
+		Csv += Benchmark->ToCsv();
+
+		if (bRecordBudgets) Budgets.Record(*Benchmark);
+	}
+
+	FIGVBenchmark::DestroyWorld(World);
+
+	if (!bSucceeded) return 1;
+
+	TSharedRef<FJsonObject> JsonObj = MakeShareable(new FJsonObject());
+	JsonObj->SetArrayField(TEXT("benchmarks"), BenchmarkJsonObjs);
+
+	FString JsonStr;
+	if (!SerializeJson(JsonObj, JsonStr) || !FFileHelper::SaveStringToFile(JsonStr, *JsonFilePath))
+	{
+		IGV_LOG_S(Error, TEXT("Unable to write %s"), *JsonFilePath);
+		return 1;
+	}
+	IGV_LOG(Display, TEXT("Wrote %s"), *JsonFilePath);
+
+	if (!CsvFilePath.IsEmpty())
+	{
+		if (!FFileHelper::SaveStringToFile(Csv, *CsvFilePath))
+		{
+			IGV_LOG_S(Error, TEXT("Unable to write %s"), *CsvFilePath);
+			return 1;
+		}
+		IGV_LOG(Display, TEXT("Wrote %s"), *CsvFilePath);
+	}
+
+	if (bRecordBudgets)
+	{
+		if (!Budgets.Save(BudgetsFilePath)) return 1;
+		IGV_LOG(Display, TEXT("Recorded budgets to %s"), *BudgetsFilePath);
+	}
+
+	return 0;
+}
+
+TArray<int32> UIGVBenchmarkCommandlet::ParseIntList(FString const& Params,
+													TCHAR const* const Key) const
+{
+	TArray<int32> Values;
+
+	FString ValuesStr;
+	if (FParse::Value(*Params, Key, ValuesStr, false))
+	{
+		TArray<FString> ValueStrs;
+		ValuesStr.ParseIntoArray(ValueStrs, TEXT(","));
+		for (FString const& Str : ValueStrs)
+		{
+			Values.Add(FCString::Atoi(*Str));
+		}
+	}
+
+	return Values;
+}
@@ -0,0 +1,27 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "Core.h"
+
+#include "IGVBenchmarkCommandlet.generated.h"
+
+// Headless graph loading benchmark, see README.md. Budgets are recorded here and checked by the
+// IGV.Benchmark automation tests.
+//
+// UE4Editor-Cmd ImsvGraphVis.uproject -run=IGVBenchmark -nullrhi -Generator=sbm -Nodes=1000,10000
+// UE4Editor-Cmd ImsvGraphVis.uproject -run=IGVBenchmark -nullrhi -Suite -RecordBudgets
+UCLASS()
+class IMSVGRAPHVIS_API UIGVBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UIGVBenchmarkCommandlet();
+
+	virtual int32 Main(FString const& Params) override;
+
+protected:
+	TArray<int32> ParseIntList(FString const& Params, TCHAR const* const Key) const;
+};
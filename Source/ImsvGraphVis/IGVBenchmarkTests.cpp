@@ -0,0 +1,95 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "Paths.h"
+
+#include "IGVBenchmark.h"
+#include "IGVBenchmarkBudgets.h"
+#include "IGVGraphActor.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Checks the regression suite of FIGVBenchmark against the budgets recorded by the IGVBenchmark
+// commandlet, one test per graph:
+//
+// UE4Editor-Cmd ImsvGraphVis.uproject -nullrhi -unattended -ExecCmds="Automation RunTests IGV;Quit"
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FIGVBenchmarkBudgetsTest, "IGV.Benchmark.Budgets",
+								  EAutomationTestFlags::ApplicationContextMask |
+									  EAutomationTestFlags::PerfFilter)
+
+// The default of the commandlet, with which the budgets are recorded
+static int32 const NumBenchmarkRuns = 3;
+
+// A synthetic graph is given by its number of edges, a dataset by its file.
+static TSharedPtr<FIGVBenchmark> MakeBenchmark(FString const& Parameters)
+{
+	if (!Parameters.IsNumeric())
+	{
+		return MakeShareable(new FIGVBenchmark(Parameters, NumBenchmarkRuns));
+	}
+
+	int32 const NumEdges = FCString::Atoi(*Parameters);
+	FIGVSyntheticGraphParams GraphParams;
+	GraphParams.NumNodes = FIGVBenchmark::NumNodesForEdges(GraphParams, NumEdges);
+	return MakeShareable(new FIGVBenchmark(GraphParams, NumBenchmarkRuns));
+}
+
+void FIGVBenchmarkBudgetsTest::GetTests(TArray<FString>& OutBeautifiedNames,
+										TArray<FString>& OutTestCommands) const
+{
+	for (FString const& DataFilePath : FIGVBenchmark::FindDataFilePaths())
+	{
+		OutTestCommands.Add(DataFilePath);
+	}
+	for (int32 const NumEdges : FIGVBenchmark::SuiteNumEdges())
+	{
+		OutTestCommands.Add(FString::FromInt(NumEdges));
+	}
+
+	for (FString const& Command : OutTestCommands)
+	{
+		OutBeautifiedNames.Add(MakeBenchmark(Command)->Name);
+	}
+}
+
+bool FIGVBenchmarkBudgetsTest::RunTest(FString const& Parameters)
+{
+	FString const BudgetsFilePath = FIGVBenchmark::DefaultBudgetsFilePath();
+	if (!FPaths::FileExists(BudgetsFilePath))
+	{
+		AddError(FString::Printf(TEXT("No budgets at %s, record them with the IGVBenchmark "
+									  "commandlet and -Suite -RecordBudgets"),
+								 *BudgetsFilePath));
+		return false;
+	}
+
+	FIGVBenchmarkBudgets Budgets;
+	if (!Budgets.Load(BudgetsFilePath))
+	{
+		AddError(FString::Printf(TEXT("Unable to read budgets from %s"), *BudgetsFilePath));
+		return false;
+	}
+
+	TSharedPtr<FIGVBenchmark> const Benchmark = MakeBenchmark(Parameters);
+
+	UWorld* const World = FIGVBenchmark::CreateWorld();
+	bool const bSucceeded = Benchmark->Run(World, FIGVBenchmark::LoadGraphActorClass());
+	FIGVBenchmark::DestroyWorld(World);
+
+	if (!bSucceeded)
+	{
+		AddError(FString::Printf(TEXT("%s: benchmark failed"), *Benchmark->Name));
+		return false;
+	}
+
+	TArray<FString> Failures;
+	Budgets.Check(*Benchmark, Failures);
+	for (FString const& Failure : Failures)
+	{
+		AddError(Failure);
+	}
+
+	return Failures.Num() == 0;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
@@ -17,7 +17,10 @@ FIGVCluster::FIGVCluster(AIGVGraphActor* const InGraphActor)
 	  Parent(nullptr),
 	  Children(),
 	  Node(nullptr),
-	  NumDescendantNodes(0)
+	  NumDescendantNodes(0),
+	  bIsCollapsed(false),
+	  TreemapRect(ForceInitToZero),
+	  TreemapWeight(0.f)
 {
 }
 
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 
+#include "IGVArena.h"
+
 #include "IGVCluster.generated.h"
 
 USTRUCT()
@@ -33,10 +35,16 @@ public:
 	FVector Pos3D;
 
 	FIGVCluster* Parent;
-	TArray<FIGVCluster*> Children;
+	TIGVArenaArray<FIGVCluster*> Children;  // Allocated by AIGVGraphActor::SetupClusters
 	class AIGVNodeActor* Node;
 	int32 NumDescendantNodes;
 
+	bool bIsCollapsed;  // Drawn as a meta-node, see FIGVSemanticZoom
+
+	// Kept from the last treemap layout, so that a subtree can be laid out again on its own
+	FBox2D TreemapRect;
+	float TreemapWeight;
+
 public:
 	FIGVCluster() = default;
 	FIGVCluster(class AIGVGraphActor* const InGraphActor);
@@ -69,6 +77,8 @@ public:
 	bool IsLeaf() const;
 
 	void SetPos2D(FVector2D const& P);
+	// After AIGVGraphActor::UpdateNodeTransforms, which waits for the edge mesh tasks reading
+	// the positions
 	void SetPosNonLeaf();
 
 	float DefaultLevel() const;
@@ -11,6 +11,7 @@
 #include "IGVGraphActor.h"
 #include "IGVLog.h"
 #include "IGVNodeActor.h"
+#include "IGVStats.h"
 
 FString UIGVData::DefaultDataDirPath()
 {
@@ -62,16 +63,28 @@ void UIGVData::LoadFile(FString const& FilePath, AIGVGraphActor* const GraphActo
 	FString const Filename = FPaths::GetCleanFilename(FilePath);
 	IGV_LOG_S(Log, TEXT("Load File: %s"), *Filename);
 
-	FString JsonStr;
-	FFileHelper::LoadFileToString(JsonStr, *FilePath);
-
 	TSharedPtr<FJsonObject> JsonObj = MakeShareable(new FJsonObject());
-	if (!DeserializeJson(JsonStr, JsonObj))
 	{
-		IGV_LOG_S(Error, TEXT("Unable to deserialize JSON file: %s"), *JsonStr);
-		return;
+		SCOPE_CYCLE_COUNTER(STAT_IGV_ParseJson);
+
+		FString JsonStr;
+		FFileHelper::LoadFileToString(JsonStr, *FilePath);
+
+		if (!DeserializeJson(JsonStr, JsonObj))
+		{
+			IGV_LOG_S(Error, TEXT("Unable to deserialize JSON file: %s"), *JsonStr);
+			return;
+		}
+	}
+
+	if (JsonObj->HasField(TEXT("steps")))
+	{
+		DeserializeTemporalGraph(JsonObj, GraphActor);
+	}
+	else
+	{
+		DeserializeGraph(JsonObj, GraphActor);
 	}
-	DeserializeGraph(JsonObj, GraphActor);
 }
 
 void UIGVData::DeserializeGraph(TSharedPtr<FJsonObject> GraphJsonObj,
@@ -112,24 +125,52 @@ void UIGVData::DeserializeGraph(TSharedPtr<FJsonObject> GraphJsonObj,
 	GraphActor->SetupGraph();
 }
 
+void UIGVData::DeserializeTemporalGraph(TSharedPtr<FJsonObject> TemporalJsonObj,
+										AIGVGraphActor* const GraphActor)
+{
+	TSharedPtr<FJsonObject> const* GraphJsonObj;
+	if (!TemporalJsonObj->TryGetObjectField(TEXT("graph"), GraphJsonObj))
+	{
+		IGV_LOG_S(Error, TEXT("Unable to get graph json object"));
+		return;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> const* StepJsonObjs;
+	if (!TemporalJsonObj->TryGetArrayField(TEXT("steps"), StepJsonObjs))
+	{
+		IGV_LOG_S(Error, TEXT("Unable to get step json objects"));
+		return;
+	}
+
+	DeserializeGraph(*GraphJsonObj, GraphActor);
+	if (GraphActor == nullptr || GraphActor->RootCluster == nullptr) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_IGV_ParseJson);
+
+	FIGVTemporalDataset Dataset;
+	if (Dataset.Deserialize(*StepJsonObjs, GraphActor))
+	{
+		GraphActor->TemporalPlayer.Setup(MoveTemp(Dataset));
+	}
+}
+
 void UIGVData::DeserializeNodes(TArray<TSharedPtr<FJsonValue>> const& NodeJsonObjs,
 								AIGVGraphActor* const GraphActor)
 {
-	UWorld* const World = GraphActor->GetWorld();
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.Owner = GraphActor;
-	SpawnParams.Instigator = GraphActor->Instigator;
+	SCOPE_CYCLE_COUNTER(STAT_IGV_SpawnNodes);
 
 	for (TSharedPtr<FJsonValue> const& JsonVal : NodeJsonObjs)
 	{
 		TSharedPtr<FJsonObject> const NodeJsonObj = JsonVal->AsObject();
 
-		AIGVNodeActor* const NodeActor = World->SpawnActor<AIGVNodeActor>(
-			GraphActor->NodeActorClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
-		NodeActor->AttachToActor(GraphActor, FAttachmentTransformRules::KeepRelativeTransform);
-		NodeActor->Init(GraphActor);
+		// Finished once the layout has placed it, see AIGVGraphActor::NormalizeNodePosition
+		AIGVNodeActor* const NodeActor = GraphActor->SpawnNodeActor(true);
 		GraphActor->Nodes.Add(NodeActor);
 
+		// Interned instead of deserialized into the node
+		FString Label;
+		if (NodeJsonObj->TryGetStringField(TEXT("label"), Label)) NodeActor->SetText(Label);
+
 		if (!JsonObjectToUObject(NodeJsonObj.ToSharedRef(), NodeActor))
 		{
 			IGV_LOG_S(Error, TEXT("Unable to deserialize a cluster"));
@@ -140,6 +181,8 @@ void UIGVData::DeserializeNodes(TArray<TSharedPtr<FJsonValue>> const& NodeJsonOb
 void UIGVData::DeserializeEdges(TArray<TSharedPtr<FJsonValue>> const& EdgeJsonObjs,
 								AIGVGraphActor* const GraphActor)
 {
+	SCOPE_CYCLE_COUNTER(STAT_IGV_ParseJson);
+
 	for (TSharedPtr<FJsonValue> const& JsonVal : EdgeJsonObjs)
 	{
 		TSharedPtr<FJsonObject> const EdgeJsonObj = JsonVal->AsObject();
@@ -157,6 +200,8 @@ void UIGVData::DeserializeEdges(TArray<TSharedPtr<FJsonValue>> const& EdgeJsonOb
 void UIGVData::DeserializeClusters(TArray<TSharedPtr<FJsonValue>> const& ClusterJsonObjs,
 								   AIGVGraphActor* const GraphActor)
 {
+	SCOPE_CYCLE_COUNTER(STAT_IGV_ParseJson);
+
 	for (TSharedPtr<FJsonValue> const& JsonVal : ClusterJsonObjs)
 	{
 		TSharedPtr<FJsonObject> const ClusterJsonObj = JsonVal->AsObject();
@@ -26,7 +26,10 @@ public:
 	static void DeserializeGraph(TSharedPtr<FJsonObject> GraphJsonObj,
 								 class AIGVGraphActor* const GraphActor);
 
-private:
+	// A .igvt.json file: a graph and the steps of a FIGVTemporalDataset
+	static void DeserializeTemporalGraph(TSharedPtr<FJsonObject> TemporalJsonObj,
+										 class AIGVGraphActor* const GraphActor);
+
 	static void DeserializeNodes(TArray<TSharedPtr<FJsonValue>> const& NodeJsonObjs,
 								 class AIGVGraphActor* const GraphActor);
 
@@ -0,0 +1,459 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVDeltaIngestion.h"
+
+#include "Common/TcpSocketBuilder.h"
+#include "GenericPlatformFile.h"
+#include "HAL/RunnableThread.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+#include "Paths.h"
+#include "PlatformFilemanager.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+#include "IGVGraphActor.h"
+#include "IGVLog.h"
+#include "IGVNodeActor.h"
+#include "IGVStats.h"
+
+int32 const FIGVDeltaIngestion::MaxPendingDeltas = 65536;
+
+static int32 const IGVDeltaReadSize = 65536;
+static int32 const IGVDeltaMaxLineLength = 4096;
+static float const IGVDeltaPollInterval = .01f;  // in seconds
+
+FIGVDeltaIngestion::FIGVDeltaIngestion()
+	: GraphActor(nullptr),
+	  Source(),
+	  FilePath(),
+	  Port(INDEX_NONE),
+	  Thread(nullptr),
+	  bStopRequested(false),
+	  PendingBatch(),
+	  PartialLine(),
+	  AppliedBatch(),
+	  NumApplied(0),
+	  NodesByLabel(),
+	  NodesByLabelNumNodes(INDEX_NONE),
+	  bNodesByLabelRebuilt(false)
+{
+}
+
+FIGVDeltaIngestion::~FIGVDeltaIngestion()
+{
+	End();
+}
+
+void FIGVDeltaIngestion::Init(AIGVGraphActor* const InGraphActor)
+{
+	GraphActor = InGraphActor;
+}
+
+bool FIGVDeltaIngestion::Begin(FString const& InSource)
+{
+	End();
+
+	Source = InSource;
+	if (InSource.StartsWith(TEXT("tcp:")))
+	{
+		if (!ParsePort(InSource, Port))
+		{
+			IGV_LOG_S(Error, TEXT("Invalid port in %s"), *InSource);
+			return false;
+		}
+		FilePath.Reset();
+	}
+	else
+	{
+		Port = INDEX_NONE;
+		FilePath = ResolveFilePath(InSource);
+	}
+
+	bStopRequested = false;
+	PartialLine.Reset();
+	NodesByLabelNumNodes = INDEX_NONE;
+
+	Thread = FRunnableThread::Create(this, TEXT("IGVDeltaIngestion"), 0, TPri_BelowNormal);
+	if (Thread == nullptr)
+	{
+		IGV_LOG_S(Error, TEXT("Unable to create the ingestion thread"));
+		return false;
+	}
+
+	IGV_LOG(Log, TEXT("Ingesting deltas from %s"),
+			Port != INDEX_NONE ? *FString::Printf(TEXT("127.0.0.1:%d"), Port) : *FilePath);
+	return true;
+}
+
+void FIGVDeltaIngestion::End()
+{
+	if (Thread == nullptr) return;
+
+	// Calls Stop and waits for Run to return
+	Thread->Kill(true);
+	delete Thread;
+	Thread = nullptr;
+
+	int32 const NumDiscarded = PendingBatch.NumPending() + AppliedBatch.Num() - NumApplied;
+	PendingBatch.Reset();
+	AppliedBatch.Reset();
+	NumApplied = 0;
+	NodesByLabel.Empty();
+	SET_DWORD_STAT(STAT_IGV_NumPendingDeltas, 0);
+
+	IGV_LOG(Log, TEXT("Stopped ingesting deltas from %s, %d discarded"), *Source, NumDiscarded);
+}
+
+void FIGVDeltaIngestion::Tick()
+{
+	// Deltas wait in the batches until there is a graph to apply them to.
+	if (GraphActor == nullptr || GraphActor->RootCluster == nullptr) return;
+
+	if (NumApplied == AppliedBatch.Num())
+	{
+		AppliedBatch.Reset();
+		NumApplied = 0;
+
+		FScopeLock Lock(&PendingBatchCriticalSection);
+		Exchange(AppliedBatch, PendingBatch);
+	}
+
+	SET_DWORD_STAT(STAT_IGV_NumPendingDeltas, AppliedBatch.Num() - NumApplied);
+	if (NumApplied == AppliedBatch.Num()) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_IGV_DeltaIngestion);
+
+	double const BudgetSeconds = GraphActor->DeltaIngestionBudget / 1000.0;
+	bool const bBudgeted = BudgetSeconds > 0.0;
+	double const EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+
+	bNodesByLabelRebuilt = false;
+	while (NumApplied < AppliedBatch.Num())
+	{
+		FIGVDelta const& Delta = AppliedBatch.Deltas[NumApplied++];
+		if (Delta.Type == EIGVDeltaType::None) continue;
+
+		if (Apply(Delta))
+		{
+			INC_DWORD_STAT(STAT_IGV_NumDeltasApplied);
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_IGV_NumDeltasDropped);
+			IGV_LOG(Verbose, TEXT("Dropped delta: %s"), *Delta.ToString());
+		}
+
+		if (bBudgeted && FPlatformTime::Seconds() > EndTime) break;
+	}
+}
+
+uint32 FIGVDeltaIngestion::Run()
+{
+	if (Port != INDEX_NONE)
+	{
+		ReadSocket();
+	}
+	else
+	{
+		ReadFile();
+	}
+	return 0;
+}
+
+void FIGVDeltaIngestion::Stop()
+{
+	bStopRequested = true;
+}
+
+FString FIGVDeltaIngestion::DefaultDirPath()
+{
+	return FPaths::Combine(*FPaths::GameSavedDir(), TEXT("Deltas/"));
+}
+
+FString FIGVDeltaIngestion::ResolveFilePath(FString const& FileName)
+{
+	FString FilePath = FPaths::IsRelative(FileName)
+						   ? FPaths::Combine(*DefaultDirPath(), *FileName)
+						   : FileName;
+	if (FPaths::GetExtension(FilePath).IsEmpty())
+	{
+		FilePath += TEXT(".igvdelta");
+	}
+	return FilePath;
+}
+
+bool FIGVDeltaIngestion::ParsePort(FString const& Source, int32& OutPort)
+{
+	FString const PortString = Source.Mid(4);
+	if (!Source.StartsWith(TEXT("tcp:")) || !PortString.IsNumeric()) return false;
+
+	OutPort = FCString::Atoi(*PortString);
+	return OutPort > 0 && OutPort <= 65535;
+}
+
+void FIGVDeltaIngestion::ReadFile()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TUniquePtr<IFileHandle> File;
+	int64 Offset = 0;
+
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(IGVDeltaReadSize);
+
+	while (!bStopRequested)
+	{
+		// The file may not exist yet, and is shared with its writer.
+		if (!File.IsValid()) File.Reset(PlatformFile.OpenRead(*FilePath, true));
+
+		if (!File.IsValid() || IsBackedUp())
+		{
+			FPlatformProcess::Sleep(IGVDeltaPollInterval);
+			continue;
+		}
+
+		int64 const Size = File->Size();
+		if (Size < Offset)
+		{
+			IGV_LOG(Warning, TEXT("%s was truncated, reading it from the start"), *FilePath);
+			Offset = 0;
+			PartialLine.Reset();
+		}
+
+		if (Size == Offset)
+		{
+			FPlatformProcess::Sleep(IGVDeltaPollInterval);
+			continue;
+		}
+
+		int64 const NumBytes = FMath::Min<int64>(Size - Offset, Buffer.Num());
+		if (!File->Seek(Offset) || !File->Read(Buffer.GetData(), NumBytes))
+		{
+			File.Reset();
+			continue;
+		}
+
+		Offset += NumBytes;
+		ReceiveBytes(Buffer.GetData(), int32(NumBytes));
+	}
+}
+
+void FIGVDeltaIngestion::ReadSocket()
+{
+	ISocketSubsystem* const SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	FSocket* const Listener = FTcpSocketBuilder(TEXT("IGVDeltaIngestion"))
+								  .AsReusable()
+								  .BoundToAddress(FIPv4Address(127, 0, 0, 1))
+								  .BoundToPort(Port)
+								  .Listening(1)
+								  .Build();
+	if (Listener == nullptr)
+	{
+		IGV_LOG_S(Error, TEXT("Unable to listen on port %d"), Port);
+		return;
+	}
+
+	FTimespan const PollInterval = FTimespan::FromSeconds(IGVDeltaPollInterval);
+	FSocket* Connection = nullptr;
+
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(IGVDeltaReadSize);
+
+	while (!bStopRequested)
+	{
+		// One producer at a time
+		if (Connection == nullptr)
+		{
+			bool bHasPendingConnection = false;
+			if (Listener->WaitForPendingConnection(bHasPendingConnection, PollInterval) &&
+				bHasPendingConnection)
+			{
+				Connection = Listener->Accept(TEXT("IGVDeltaIngestion Connection"));
+				PartialLine.Reset();
+				if (Connection) IGV_LOG(Log, TEXT("Producer connected on port %d"), Port);
+			}
+			continue;
+		}
+
+		// Unread data fills the receive window, which blocks the producer.
+		if (IsBackedUp())
+		{
+			FPlatformProcess::Sleep(IGVDeltaPollInterval);
+			continue;
+		}
+
+		if (!Connection->Wait(ESocketWaitConditions::WaitForRead, PollInterval)) continue;
+
+		// Readable without data once the producer has closed the connection
+		int32 NumBytes = 0;
+		if (!Connection->Recv(Buffer.GetData(), Buffer.Num(), NumBytes) || NumBytes == 0)
+		{
+			IGV_LOG(Log, TEXT("Producer disconnected from port %d"), Port);
+			Connection->Close();
+			SocketSubsystem->DestroySocket(Connection);
+			Connection = nullptr;
+			continue;
+		}
+
+		ReceiveBytes(Buffer.GetData(), NumBytes);
+	}
+
+	if (Connection)
+	{
+		Connection->Close();
+		SocketSubsystem->DestroySocket(Connection);
+	}
+	Listener->Close();
+	SocketSubsystem->DestroySocket(Listener);
+}
+
+void FIGVDeltaIngestion::ReceiveBytes(uint8 const* const Bytes, int32 const NumBytes)
+{
+	PartialLine.Append(reinterpret_cast<ANSICHAR const*>(Bytes), NumBytes);
+
+	// Parsed before taking the lock, which Tick waits for
+	TArray<FIGVDelta> Deltas;
+	int32 LineBegin = 0;
+	for (int32 Idx = 0; Idx < PartialLine.Num(); Idx++)
+	{
+		if (PartialLine[Idx] != '\n') continue;
+
+		int32 const LineLength = Idx - LineBegin;
+		FUTF8ToTCHAR const Line(PartialLine.GetData() + LineBegin, LineLength);
+		LineBegin = Idx + 1;
+
+		FIGVDelta Delta;
+		if (Delta.Parse(FString(Line.Length(), Line.Get())))
+		{
+			Deltas.Add(MoveTemp(Delta));
+		}
+		else if (LineLength > 0)
+		{
+			IGV_LOG(Verbose, TEXT("Skipped line: %s"),
+					*FString(Line.Length(), Line.Get()).TrimTrailing());
+		}
+	}
+	PartialLine.RemoveAt(0, LineBegin, false);
+
+	if (PartialLine.Num() > IGVDeltaMaxLineLength)
+	{
+		IGV_LOG(Warning, TEXT("Skipped %d bytes without a line break"), PartialLine.Num());
+		PartialLine.Reset();
+	}
+
+	if (Deltas.Num() == 0) return;
+
+	int32 NumCoalesced = 0;
+	{
+		FScopeLock Lock(&PendingBatchCriticalSection);
+		for (FIGVDelta& Delta : Deltas)
+		{
+			NumCoalesced += PendingBatch.Add(MoveTemp(Delta));
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_IGV_NumDeltasReceived, Deltas.Num());
+	INC_DWORD_STAT_BY(STAT_IGV_NumDeltasCoalesced, NumCoalesced);
+}
+
+bool FIGVDeltaIngestion::IsBackedUp()
+{
+	FScopeLock Lock(&PendingBatchCriticalSection);
+	return PendingBatch.Num() >= MaxPendingDeltas;
+}
+
+bool FIGVDeltaIngestion::Apply(FIGVDelta const& Delta)
+{
+	if (Delta.Type == EIGVDeltaType::AddNode)
+	{
+		if (FindNode(Delta.Label) != nullptr) return false;
+
+		int32 const NodeIdx = GraphActor->AddNode(Delta.Label, Delta.ClusterIdx);
+		if (NodeIdx == INDEX_NONE) return false;
+
+		NodesByLabel.Add(Delta.Label, GraphActor->Nodes[NodeIdx]);
+		NodesByLabelNumNodes = GraphActor->Nodes.Num();
+		return true;
+	}
+
+	AIGVNodeActor* const Node = FindNode(Delta.Label);
+	if (Node == nullptr) return false;
+
+	switch (Delta.Type)
+	{
+		case EIGVDeltaType::RemoveNode:
+			NodesByLabel.Remove(Delta.Label);
+			if (!GraphActor->RemoveNode(Node->Idx)) return false;
+			NodesByLabelNumNodes = GraphActor->Nodes.Num();
+			return true;
+
+		case EIGVDeltaType::MoveNode:
+			return GraphActor->MoveNode(Node->Idx, Delta.ClusterIdx);
+
+		case EIGVDeltaType::SetNodeColor:
+			return GraphActor->SetNodeColor(Node->Idx, Delta.Color);
+
+		case EIGVDeltaType::SetNodeLabel:
+			if (FindNode(Delta.OtherLabel) != nullptr) return false;
+			NodesByLabel.Remove(Delta.Label);
+			NodesByLabel.Add(Delta.OtherLabel, Node);
+			return GraphActor->SetNodeLabel(Node->Idx, Delta.OtherLabel);
+
+		case EIGVDeltaType::AddEdge:
+		case EIGVDeltaType::RemoveEdge:
+		{
+			AIGVNodeActor* const OtherNode = FindNode(Delta.OtherLabel);
+			if (OtherNode == nullptr) return false;
+
+			if (Delta.Type == EIGVDeltaType::AddEdge)
+			{
+				return GraphActor->AddEdge(Node->Idx, OtherNode->Idx) != INDEX_NONE;
+			}
+
+			int32 const EdgeIdx = GraphActor->FindEdge(Node->Idx, OtherNode->Idx);
+			return EdgeIdx != INDEX_NONE && GraphActor->RemoveEdge(EdgeIdx);
+		}
+
+		default:
+			return false;
+	}
+}
+
+AIGVNodeActor* FIGVDeltaIngestion::FindNode(FString const& Label)
+{
+	// Rebuilt if the graph was changed by other means, at most once per tick
+	if (NodesByLabelNumNodes != GraphActor->Nodes.Num()) RebuildNodesByLabel();
+
+	TWeakObjectPtr<AIGVNodeActor> const* Found = NodesByLabel.Find(Label);
+	AIGVNodeActor* Node = Found ? Found->Get() : nullptr;
+	if (Found == nullptr || IsCurrent(Node, Label)) return Node;
+
+	if (bNodesByLabelRebuilt) return nullptr;
+	RebuildNodesByLabel();
+
+	Found = NodesByLabel.Find(Label);
+	Node = Found ? Found->Get() : nullptr;
+	return IsCurrent(Node, Label) ? Node : nullptr;
+}
+
+bool FIGVDeltaIngestion::IsCurrent(AIGVNodeActor const* const Node, FString const& Label) const
+{
+	TArray<AIGVNodeActor*> const& Nodes = GraphActor->Nodes;
+	return Node != nullptr && Nodes.IsValidIndex(Node->Idx) && Nodes[Node->Idx] == Node &&
+		   Node->GetLabel() == Label;
+}
+
+void FIGVDeltaIngestion::RebuildNodesByLabel()
+{
+	NodesByLabel.Reset();
+	NodesByLabel.Reserve(GraphActor->Nodes.Num());
+
+	// The first node of a duplicate label is the one named by the stream.
+	for (AIGVNodeActor* const Node : GraphActor->Nodes)
+	{
+		FString const Label = Node->GetLabel();
+		if (!NodesByLabel.Contains(Label)) NodesByLabel.Add(Label, Node);
+	}
+
+	NodesByLabelNumNodes = GraphActor->Nodes.Num();
+	bNodesByLabelRebuilt = true;
+}
@@ -0,0 +1,89 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+
+#include "IGVDeltaStream.h"
+
+// Applies a live stream of deltas (see IGVDeltaStream.h) to the graph through the incremental
+// edits of AIGVGraphActor. The stream is read from a TCP connection on the loopback interface or
+// from an append-only file that is tailed as it grows.
+//
+// A reader thread parses the stream and coalesces it into a pending batch. Each frame, Tick
+// takes the pending batch once the previous one is done, and applies it for up to
+// AIGVGraphActor::DeltaIngestionBudget; the rest carries over to the next frame, while newer
+// deltas keep coalescing on the reader thread. Once MaxPendingDeltas are pending the reader
+// stops reading, so a TCP producer blocks on a full receive window and a file is read later.
+class IMSVGRAPHVIS_API FIGVDeltaIngestion : public FRunnable
+{
+public:
+	static int32 const MaxPendingDeltas;
+
+public:
+	FIGVDeltaIngestion();
+	virtual ~FIGVDeltaIngestion();
+
+	void Init(class AIGVGraphActor* const InGraphActor);
+
+	// "tcp:<port>" listens on 127.0.0.1, anything else is resolved by ResolveFilePath
+	bool Begin(FString const& InSource);
+	// Pending deltas are discarded
+	void End();
+
+	FORCEINLINE bool IsRunning() const
+	{
+		return Thread != nullptr;
+	}
+
+	// Game thread
+	void Tick();
+
+	// Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// End FRunnable interface
+
+	static FString DefaultDirPath();
+	static FString ResolveFilePath(FString const& FileName);
+	static bool ParsePort(FString const& Source, int32& OutPort);
+
+protected:
+	class AIGVGraphActor* GraphActor;
+
+	FString Source;
+	FString FilePath;
+	int32 Port;  // INDEX_NONE for a file
+
+	class FRunnableThread* Thread;
+	FThreadSafeBool bStopRequested;
+
+	// Written by the reader thread, taken by Tick
+	FIGVDeltaBatch PendingBatch;
+	FCriticalSection PendingBatchCriticalSection;
+
+	// Bytes after the last complete line, reader thread only
+	TArray<ANSICHAR> PartialLine;
+
+	// Taken from PendingBatch, applied up to NumApplied
+	FIGVDeltaBatch AppliedBatch;
+	int32 NumApplied;
+
+	TMap<FString, TWeakObjectPtr<class AIGVNodeActor>> NodesByLabel;
+	int32 NodesByLabelNumNodes;  // Nodes.Num() of the graph NodesByLabel is in sync with
+	bool bNodesByLabelRebuilt;   // In this tick
+
+	// Reader thread
+	void ReadFile();
+	void ReadSocket();
+	void ReceiveBytes(uint8 const* const Bytes, int32 const NumBytes);
+	bool IsBackedUp();
+
+	// Game thread
+	bool Apply(FIGVDelta const& Delta);
+	class AIGVNodeActor* FindNode(FString const& Label);
+	bool IsCurrent(class AIGVNodeActor const* const Node, FString const& Label) const;
+	void RebuildNodesByLabel();
+};
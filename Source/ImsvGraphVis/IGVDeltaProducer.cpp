@@ -0,0 +1,320 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVDeltaProducer.h"
+
+#include "Common/TcpSocketBuilder.h"
+#include "FileManager.h"
+#include "HAL/RunnableThread.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+#include "IGVDeltaIngestion.h"
+#include "IGVGraphActor.h"
+#include "IGVLog.h"
+#include "IGVNodeActor.h"
+
+static int32 const IGVDeltaProducerMaxDeltasPerChunk = 4096;
+static float const IGVDeltaProducerPollInterval = .005f;	// in seconds
+static float const IGVDeltaProducerConnectInterval = .5f;  // in seconds
+
+static bool IsNameable(FString const& Label)
+{
+	if (Label.IsEmpty()) return false;
+	for (TCHAR const Char : Label)
+	{
+		if (FChar::IsWhitespace(Char)) return false;
+	}
+	return true;
+}
+
+FIGVDeltaProducer::FIGVDeltaProducer(AIGVGraphActor const* const GraphActor,
+									 FString const& InTarget, float const InDeltasPerSecond,
+									 float const InDuration, int32 const Seed)
+	: Target(InTarget),
+	  Port(INDEX_NONE),
+	  DeltasPerSecond(InDeltasPerSecond),
+	  Duration(InDuration),
+	  Random(Seed),
+	  Labels(),
+	  ParentClusterIdxs(),
+	  ClusterIdxs(),
+	  EdgeLabelIdxs(),
+	  NumAddedNodes(0),
+	  Thread(nullptr),
+	  bStopRequested(false),
+	  bFinished(false)
+{
+	if (!FIGVDeltaIngestion::ParsePort(Target, Port))
+	{
+		Port = INDEX_NONE;
+		Target = FIGVDeltaIngestion::ResolveFilePath(Target);
+	}
+
+	// As FIGVDeltaIngestion, names the first node of a duplicate label
+	TSet<FString> UsedLabels;
+	TArray<int32> LabelIdxs;
+	LabelIdxs.Init(INDEX_NONE, GraphActor->Nodes.Num());
+	for (AIGVNodeActor const* const Node : GraphActor->Nodes)
+	{
+		FString const Label = Node->GetLabel();
+		if (!IsNameable(Label) || UsedLabels.Contains(Label)) continue;
+
+		UsedLabels.Add(Label);
+		LabelIdxs[Node->Idx] = Labels.Add(Label);
+		ParentClusterIdxs.Add(GraphActor->Clusters[Node->ClusterIdx].ParentIdx);
+	}
+
+	for (FIGVCluster const& Cluster : GraphActor->Clusters)
+	{
+		if (Cluster.Height == 1) ClusterIdxs.Add(Cluster.Idx);
+	}
+
+	FIGVEdgeStore const& EdgeStore = GraphActor->EdgeStore;
+	for (int32 EdgeIdx = 0; EdgeIdx < EdgeStore.Num(); EdgeIdx++)
+	{
+		int32 const SourceLabelIdx = LabelIdxs[EdgeStore.SourceIdxs[EdgeIdx]];
+		int32 const TargetLabelIdx = LabelIdxs[EdgeStore.TargetIdxs[EdgeIdx]];
+		if (SourceLabelIdx != INDEX_NONE && TargetLabelIdx != INDEX_NONE)
+		{
+			EdgeLabelIdxs.Emplace(SourceLabelIdx, TargetLabelIdx);
+		}
+	}
+}
+
+FIGVDeltaProducer::~FIGVDeltaProducer()
+{
+	End();
+}
+
+bool FIGVDeltaProducer::Begin()
+{
+	if (ClusterIdxs.Num() == 0)
+	{
+		IGV_LOG_S(Error, TEXT("Unable to produce deltas for a graph without clusters"));
+		return false;
+	}
+
+	if (DeltasPerSecond <= 0.f)
+	{
+		IGV_LOG_S(Error, TEXT("Unable to produce %.1f deltas per second"), DeltasPerSecond);
+		return false;
+	}
+
+	Thread = FRunnableThread::Create(this, TEXT("IGVDeltaProducer"), 0, TPri_BelowNormal);
+	if (Thread == nullptr)
+	{
+		IGV_LOG_S(Error, TEXT("Unable to create the producer thread"));
+		return false;
+	}
+
+	IGV_LOG(Log, TEXT("Producing %.0f deltas per second to %s"), DeltasPerSecond, *Target);
+	return true;
+}
+
+void FIGVDeltaProducer::End()
+{
+	if (Thread == nullptr) return;
+
+	Thread->Kill(true);
+	delete Thread;
+	Thread = nullptr;
+}
+
+uint32 FIGVDeltaProducer::Run()
+{
+	ISocketSubsystem* const SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	FSocket* Socket = nullptr;
+	TUniquePtr<FArchive> File;
+
+	if (Port != INDEX_NONE)
+	{
+		FIPv4Endpoint const Endpoint(FIPv4Address(127, 0, 0, 1), Port);
+		while (!bStopRequested && Socket == nullptr)
+		{
+			Socket = FTcpSocketBuilder(TEXT("IGVDeltaProducer")).Build();
+			if (Socket && Socket->Connect(*Endpoint.ToInternetAddr()))
+			{
+				// Sends wait for the receive window of a backed up ingestion.
+				Socket->SetNonBlocking(true);
+				break;
+			}
+
+			if (Socket) SocketSubsystem->DestroySocket(Socket);
+			Socket = nullptr;
+			FPlatformProcess::Sleep(IGVDeltaProducerConnectInterval);
+		}
+	}
+	else
+	{
+		File.Reset(IFileManager::Get().CreateFileWriter(*Target,
+														FILEWRITE_Append | FILEWRITE_AllowRead));
+		if (!File.IsValid()) IGV_LOG_S(Error, TEXT("Unable to write %s"), *Target);
+	}
+
+	double const StartTime = FPlatformTime::Seconds();
+	int64 NumProduced = 0;
+	FString Chunk;
+
+	while (!bStopRequested && (Socket != nullptr || File.IsValid()))
+	{
+		double const Elapsed = FPlatformTime::Seconds() - StartTime;
+		if (Duration > 0.f && Elapsed >= Duration) break;
+
+		int64 const NumDue = FMath::Min<int64>(int64(Elapsed * DeltasPerSecond) - NumProduced,
+											   IGVDeltaProducerMaxDeltasPerChunk);
+		if (NumDue <= 0)
+		{
+			FPlatformProcess::Sleep(IGVDeltaProducerPollInterval);
+			continue;
+		}
+
+		Chunk.Reset();
+		for (int64 Idx = 0; Idx < NumDue; Idx++)
+		{
+			Chunk += MakeDelta().ToString();
+			Chunk += TEXT("\n");
+		}
+
+		FTCHARToUTF8 const Utf8(*Chunk);
+		uint8 const* const Bytes = reinterpret_cast<uint8 const*>(Utf8.Get());
+		if (Socket)
+		{
+			if (!Send(Socket, Bytes, Utf8.Length())) break;
+		}
+		else
+		{
+			File->Serialize(const_cast<uint8*>(Bytes), Utf8.Length());
+			File->Flush();
+		}
+		NumProduced += NumDue;
+	}
+
+	IGV_LOG(Log, TEXT("Produced %lld deltas in %.1f s"), NumProduced,
+			FPlatformTime::Seconds() - StartTime);
+
+	if (Socket)
+	{
+		Socket->Close();
+		SocketSubsystem->DestroySocket(Socket);
+	}
+	File.Reset();
+
+	bFinished = true;
+	return 0;
+}
+
+void FIGVDeltaProducer::Stop()
+{
+	bStopRequested = true;
+}
+
+FIGVDelta FIGVDeltaProducer::MakeDelta()
+{
+	FIGVDelta Delta;
+	float const Roll = Random.FRand();
+	int32 const NumLabels = Labels.Num();
+
+	// Mostly edge changes, as in a stream of interactions between fixed entities
+	if (Roll < .35f && NumLabels >= 2)
+	{
+		int32 const SourceLabelIdx = Random.RandHelper(NumLabels);
+		int32 TargetLabelIdx = Random.RandHelper(NumLabels - 1);
+		if (TargetLabelIdx >= SourceLabelIdx) TargetLabelIdx++;
+
+		Delta.Type = EIGVDeltaType::AddEdge;
+		Delta.Label = Labels[SourceLabelIdx];
+		Delta.OtherLabel = Labels[TargetLabelIdx];
+		EdgeLabelIdxs.Emplace(SourceLabelIdx, TargetLabelIdx);
+	}
+	else if (Roll < .65f && EdgeLabelIdxs.Num() > 0)
+	{
+		int32 const Idx = Random.RandHelper(EdgeLabelIdxs.Num());
+		Delta.Type = EIGVDeltaType::RemoveEdge;
+		Delta.Label = Labels[EdgeLabelIdxs[Idx].Key];
+		Delta.OtherLabel = Labels[EdgeLabelIdxs[Idx].Value];
+		EdgeLabelIdxs.RemoveAtSwap(Idx);
+	}
+	else if (Roll < .8f && NumLabels > 0)
+	{
+		Delta.Type = EIGVDeltaType::SetNodeColor;
+		Delta.Label = Labels[Random.RandHelper(NumLabels)];
+		Delta.Color = FLinearColor::MakeFromHSV8(uint8(Random.RandHelper(256)), 128, 192);
+	}
+	else if (Roll < .9f && NumLabels > 0 && ClusterIdxs.Num() > 1)
+	{
+		int32 const LabelIdx = Random.RandHelper(NumLabels);
+		int32 Idx = Random.RandHelper(ClusterIdxs.Num());
+		if (ClusterIdxs[Idx] == ParentClusterIdxs[LabelIdx]) Idx = (Idx + 1) % ClusterIdxs.Num();
+
+		Delta.Type = EIGVDeltaType::MoveNode;
+		Delta.Label = Labels[LabelIdx];
+		Delta.ClusterIdx = ClusterIdxs[Idx];
+		ParentClusterIdxs[LabelIdx] = Delta.ClusterIdx;
+	}
+	else if (Roll < .95f || NumLabels < 3)
+	{
+		Delta.Type = EIGVDeltaType::AddNode;
+		Delta.Label = FString::Printf(TEXT("delta%d-%d"), Random.GetInitialSeed(),
+										  NumAddedNodes++);
+		Delta.ClusterIdx = ClusterIdxs[Random.RandHelper(ClusterIdxs.Num())];
+		Labels.Add(Delta.Label);
+		ParentClusterIdxs.Add(Delta.ClusterIdx);
+	}
+	else
+	{
+		int32 const LabelIdx = Random.RandHelper(NumLabels);
+		Delta.Type = EIGVDeltaType::RemoveNode;
+		Delta.Label = Labels[LabelIdx];
+		RemoveLabel(LabelIdx);
+	}
+
+	return Delta;
+}
+
+void FIGVDeltaProducer::RemoveLabel(int32 const LabelIdx)
+{
+	// The last label takes the index of the removed one, and its node loses its edges.
+	int32 const LastLabelIdx = Labels.Num() - 1;
+	Labels.RemoveAtSwap(LabelIdx, 1, false);
+	ParentClusterIdxs.RemoveAtSwap(LabelIdx, 1, false);
+
+	for (int32 Idx = EdgeLabelIdxs.Num() - 1; Idx >= 0; Idx--)
+	{
+		TPair<int32, int32>& Edge = EdgeLabelIdxs[Idx];
+		if (Edge.Key == LabelIdx || Edge.Value == LabelIdx)
+		{
+			EdgeLabelIdxs.RemoveAtSwap(Idx, 1, false);
+			continue;
+		}
+		if (Edge.Key == LastLabelIdx) Edge.Key = LabelIdx;
+		if (Edge.Value == LastLabelIdx) Edge.Value = LabelIdx;
+	}
+}
+
+bool FIGVDeltaProducer::Send(FSocket* const Socket, uint8 const* Bytes, int32 NumBytes)
+{
+	ISocketSubsystem* const SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	FTimespan const PollInterval = FTimespan::FromSeconds(IGVDeltaProducerPollInterval);
+
+	while (NumBytes > 0)
+	{
+		if (bStopRequested) return false;
+
+		int32 NumSent = 0;
+		if (Socket->Send(Bytes, NumBytes, NumSent))
+		{
+			Bytes += NumSent;
+			NumBytes -= NumSent;
+			if (NumSent > 0) continue;
+		}
+		else if (SocketSubsystem->GetLastErrorCode() != SE_EWOULDBLOCK)
+		{
+			IGV_LOG(Log, TEXT("Ingestion disconnected from port %d"), Port);
+			return false;
+		}
+
+		Socket->Wait(ESocketWaitConditions::WaitForWrite, PollInterval);
+	}
+	return true;
+}
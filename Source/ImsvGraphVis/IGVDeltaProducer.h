@@ -0,0 +1,60 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+
+#include "IGVDeltaStream.h"
+
+// Stand-in for an external producer of a delta stream, to exercise FIGVDeltaIngestion locally.
+// Writes random deltas on its own thread at a fixed rate to a file or to a TCP port on
+// 127.0.0.1, see FIGVDeltaIngestion::Begin for the target format. The deltas are consistent
+// with a snapshot of the graph taken on construction: only existing edges are removed, nodes
+// are moved between clusters of height 1, and added nodes are named "delta<seed>-<n>". Nodes
+// whose labels contain white space cannot be named in the stream and are left alone.
+class IMSVGRAPHVIS_API FIGVDeltaProducer : public FRunnable
+{
+public:
+	FIGVDeltaProducer(class AIGVGraphActor const* const GraphActor, FString const& InTarget,
+					  float const InDeltasPerSecond, float const InDuration, int32 const Seed);
+	virtual ~FIGVDeltaProducer();
+
+	bool Begin();
+	void End();
+
+	FORCEINLINE bool IsRunning() const
+	{
+		return Thread != nullptr && !bFinished;
+	}
+
+	// Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// End FRunnable interface
+
+protected:
+	FString Target;
+	int32 Port;  // INDEX_NONE for a file
+	float DeltasPerSecond;
+	float Duration;  // in seconds, runs until stopped if zero or less
+
+	FRandomStream Random;
+
+	// Snapshot of the graph, updated by the deltas produced
+	TArray<FString> Labels;
+	TArray<int32> ParentClusterIdxs;  // Per label
+	TArray<int32> ClusterIdxs;		  // Of height 1
+	TArray<TPair<int32, int32>> EdgeLabelIdxs;
+	int32 NumAddedNodes;
+
+	class FRunnableThread* Thread;
+	FThreadSafeBool bStopRequested;
+	FThreadSafeBool bFinished;
+
+	FIGVDelta MakeDelta();
+	void RemoveLabel(int32 const LabelIdx);
+
+	bool Send(class FSocket* const Socket, uint8 const* Bytes, int32 NumBytes);
+};
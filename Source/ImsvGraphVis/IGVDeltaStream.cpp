@@ -0,0 +1,222 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVDeltaStream.h"
+
+FIGVDelta::FIGVDelta()
+	: Type(EIGVDeltaType::None),
+	  Label(),
+	  OtherLabel(),
+	  ClusterIdx(INDEX_NONE),
+	  Color(FLinearColor::White)
+{
+}
+
+bool FIGVDelta::Parse(FString const& Line)
+{
+	TArray<FString> Fields;
+	Line.ParseIntoArrayWS(Fields);
+	if (Fields.Num() < 2 || Fields[0].StartsWith(TEXT("#"))) return false;
+
+	FString const& Op = Fields[0];
+	int32 NumFields = 3;
+	if (Op == TEXT("an"))
+	{
+		Type = EIGVDeltaType::AddNode;
+	}
+	else if (Op == TEXT("rn"))
+	{
+		Type = EIGVDeltaType::RemoveNode;
+		NumFields = 2;
+	}
+	else if (Op == TEXT("mn"))
+	{
+		Type = EIGVDeltaType::MoveNode;
+	}
+	else if (Op == TEXT("cn"))
+	{
+		Type = EIGVDeltaType::SetNodeColor;
+	}
+	else if (Op == TEXT("ln"))
+	{
+		Type = EIGVDeltaType::SetNodeLabel;
+	}
+	else if (Op == TEXT("ae"))
+	{
+		Type = EIGVDeltaType::AddEdge;
+	}
+	else if (Op == TEXT("re"))
+	{
+		Type = EIGVDeltaType::RemoveEdge;
+	}
+	else
+	{
+		return false;
+	}
+
+	if (Fields.Num() != NumFields) return false;
+
+	Label = MoveTemp(Fields[1]);
+	OtherLabel.Reset();
+	switch (Type)
+	{
+		case EIGVDeltaType::AddNode:
+		case EIGVDeltaType::MoveNode:
+			if (!Fields[2].IsNumeric()) return false;
+			ClusterIdx = FCString::Atoi(*Fields[2]);
+			break;
+		case EIGVDeltaType::SetNodeColor:
+			if (Fields[2].Len() != 6 && Fields[2].Len() != 8) return false;
+			Color = FLinearColor(FColor::FromHex(Fields[2]));
+			break;
+		case EIGVDeltaType::SetNodeLabel:
+		case EIGVDeltaType::AddEdge:
+		case EIGVDeltaType::RemoveEdge:
+			OtherLabel = MoveTemp(Fields[2]);
+			break;
+		default:
+			break;
+	}
+	return true;
+}
+
+FString FIGVDelta::ToString() const
+{
+	switch (Type)
+	{
+		case EIGVDeltaType::AddNode:
+			return FString::Printf(TEXT("an %s %d"), *Label, ClusterIdx);
+		case EIGVDeltaType::RemoveNode:
+			return FString::Printf(TEXT("rn %s"), *Label);
+		case EIGVDeltaType::MoveNode:
+			return FString::Printf(TEXT("mn %s %d"), *Label, ClusterIdx);
+		case EIGVDeltaType::SetNodeColor:
+			return FString::Printf(TEXT("cn %s %s"), *Label,
+								   *Color.ToFColor(true).ToHex().Left(6));
+		case EIGVDeltaType::SetNodeLabel:
+			return FString::Printf(TEXT("ln %s %s"), *Label, *OtherLabel);
+		case EIGVDeltaType::AddEdge:
+			return FString::Printf(TEXT("ae %s %s"), *Label, *OtherLabel);
+		case EIGVDeltaType::RemoveEdge:
+			return FString::Printf(TEXT("re %s %s"), *Label, *OtherLabel);
+		default:
+			return FString();
+	}
+}
+
+FIGVDeltaBatch::FIGVDeltaBatch()
+	: Deltas(),
+	  NumCoalesced(0),
+	  AddedNodes(),
+	  MovedNodes(),
+	  ColoredNodes(),
+	  AddedEdges(),
+	  RemovedEdges()
+{
+}
+
+int32 FIGVDeltaBatch::Add(FIGVDelta&& Delta)
+{
+	// Assumes a consistent stream, e.g. that an edge is only removed if it exists.
+	switch (Delta.Type)
+	{
+		case EIGVDeltaType::AddNode:
+			ForgetNode(Delta.Label);
+			AddedNodes.Add(Delta.Label, Deltas.Num());
+			break;
+
+		case EIGVDeltaType::RemoveNode:
+		{
+			int32 NumMerged = 0;
+			if (CancelPending(MovedNodes, Delta.Label)) NumMerged++;
+			if (CancelPending(ColoredNodes, Delta.Label)) NumMerged++;
+
+			// Edge keys may name an earlier node of the same label from now on.
+			AddedEdges.Reset();
+			RemovedEdges.Reset();
+
+			if (CancelPending(AddedNodes, Delta.Label)) return NumMerged + 2;
+
+			Deltas.Add(MoveTemp(Delta));
+			return NumMerged;
+		}
+
+		case EIGVDeltaType::MoveNode:
+		case EIGVDeltaType::SetNodeColor:
+		{
+			TMap<FString, int32>& Pending =
+				Delta.Type == EIGVDeltaType::MoveNode ? MovedNodes : ColoredNodes;
+			if (int32 const* const DeltaIdx = Pending.Find(Delta.Label))
+			{
+				Deltas[*DeltaIdx] = MoveTemp(Delta);
+				return 1;
+			}
+			Pending.Add(Delta.Label, Deltas.Num());
+			break;
+		}
+
+		case EIGVDeltaType::SetNodeLabel:
+			ForgetNode(Delta.Label);
+			ForgetNode(Delta.OtherLabel);
+			AddedEdges.Reset();
+			RemovedEdges.Reset();
+			break;
+
+		case EIGVDeltaType::AddEdge:
+		case EIGVDeltaType::RemoveEdge:
+		{
+			bool const bAdd = Delta.Type == EIGVDeltaType::AddEdge;
+			FString Key = MakeEdgeKey(Delta.Label, Delta.OtherLabel);
+			if (CancelPending(bAdd ? RemovedEdges : AddedEdges, Key)) return 2;
+			(bAdd ? AddedEdges : RemovedEdges).Add(MoveTemp(Key), Deltas.Num());
+			break;
+		}
+
+		default:
+			return 0;
+	}
+
+	Deltas.Add(MoveTemp(Delta));
+	return 0;
+}
+
+void FIGVDeltaBatch::Reset()
+{
+	Deltas.Reset();
+	NumCoalesced = 0;
+	AddedNodes.Reset();
+	MovedNodes.Reset();
+	ColoredNodes.Reset();
+	AddedEdges.Reset();
+	RemovedEdges.Reset();
+}
+
+void FIGVDeltaBatch::Cancel(int32 const DeltaIdx)
+{
+	FIGVDelta& Delta = Deltas[DeltaIdx];
+	Delta.Type = EIGVDeltaType::None;
+	Delta.Label.Empty();
+	Delta.OtherLabel.Empty();
+	NumCoalesced++;
+}
+
+bool FIGVDeltaBatch::CancelPending(TMap<FString, int32>& Pending, FString const& Key)
+{
+	int32 DeltaIdx;
+	if (!Pending.RemoveAndCopyValue(Key, DeltaIdx)) return false;
+
+	Cancel(DeltaIdx);
+	return true;
+}
+
+void FIGVDeltaBatch::ForgetNode(FString const& Label)
+{
+	// Later deltas of the label are kept after the pending ones instead of merged into them.
+	AddedNodes.Remove(Label);
+	MovedNodes.Remove(Label);
+	ColoredNodes.Remove(Label);
+}
+
+FString FIGVDeltaBatch::MakeEdgeKey(FString const& Label, FString const& OtherLabel)
+{
+	return Label < OtherLabel ? Label + TEXT("\n") + OtherLabel : OtherLabel + TEXT("\n") + Label;
+}
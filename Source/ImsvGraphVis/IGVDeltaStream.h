@@ -0,0 +1,93 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// One line per delta, fields separated by white space, '#' starts a comment line. Nodes are
+// named by their labels, which must not contain white space; indices are not stable under the
+// incremental edits of AIGVGraphActor.
+//
+//   an <label> <cluster>     add a node to a cluster of height 1
+//   rn <label>               remove a node and its edges
+//   mn <label> <cluster>     move a node to another cluster of height 1
+//   cn <label> <RRGGBB>      set the color of a node
+//   ln <label> <new label>   rename a node
+//   ae <label> <label>       add an edge
+//   re <label> <label>       remove an edge, in either direction
+namespace EIGVDeltaType
+{
+enum Type : uint8
+{
+	None,  // Coalesced away
+	AddNode,
+	RemoveNode,
+	MoveNode,
+	SetNodeColor,
+	SetNodeLabel,
+	AddEdge,
+	RemoveEdge
+};
+}
+
+struct IMSVGRAPHVIS_API FIGVDelta
+{
+	EIGVDeltaType::Type Type;
+	FString Label;
+	FString OtherLabel;  // Edge target or new label
+	int32 ClusterIdx;
+	FLinearColor Color;
+
+public:
+	FIGVDelta();
+
+	// False for empty, comment or malformed lines
+	bool Parse(FString const& Line);
+	FString ToString() const;
+};
+
+// Deltas received but not applied yet. Add merges a delta with the pending ones of the same
+// node or edge, so that a burst costs no more than its net effect once it reaches the game
+// thread: a move or color replaces the pending one, an edge added and removed again cancels
+// out, and removing a node drops its pending moves and colors, or the node altogether if it was
+// added in the same batch. Merged deltas are set to None in place, the order of the rest is kept.
+class IMSVGRAPHVIS_API FIGVDeltaBatch
+{
+public:
+	TArray<FIGVDelta> Deltas;
+
+public:
+	FIGVDeltaBatch();
+
+	// Returns the number of deltas coalesced away by this one
+	int32 Add(FIGVDelta&& Delta);
+	void Reset();
+
+	// Including the ones set to None
+	FORCEINLINE int32 Num() const
+	{
+		return Deltas.Num();
+	}
+
+	FORCEINLINE int32 NumPending() const
+	{
+		return Deltas.Num() - NumCoalesced;
+	}
+
+protected:
+	int32 NumCoalesced;
+
+	// Index of the pending delta of each kind, by label or by edge key
+	TMap<FString, int32> AddedNodes;
+	TMap<FString, int32> MovedNodes;
+	TMap<FString, int32> ColoredNodes;
+	TMap<FString, int32> AddedEdges;
+	TMap<FString, int32> RemovedEdges;
+
+	void Cancel(int32 const DeltaIdx);
+	bool CancelPending(TMap<FString, int32>& Pending, FString const& Key);
+	void ForgetNode(FString const& Label);
+
+	// Independent of the direction of the edge
+	static FString MakeEdgeKey(FString const& Label, FString const& OtherLabel);
+};
@@ -3,23 +3,21 @@
 #include "IGVEdge.h"
 
 #include "IGVCluster.h"
+#include "IGVEdgeStore.h"
 #include "IGVGraphActor.h"
 #include "IGVLog.h"
 #include "IGVNodeActor.h"
 
 FIGVEdge::FIGVEdge(AIGVGraphActor* const InGraphActor)
 	: GraphActor(InGraphActor),
+	  Idx(INDEX_NONE),
 	  SourceIdx(-1),
 	  TargetIdx(-1),
 	  SourceNode(nullptr),
 	  TargetNode(nullptr),
 	  LowestCommonAncestor(nullptr),
-	  Clusters(),
-	  ClusterLevels(),
-	  SplineControlPointData(),
-	  MeshData(),
-	  RenderGroup(EIGVEdgeRenderGroup::Default),
-	  bUpdateMeshRequired(false)
+	  LowestCommonAncestorIdxInClusters(INDEX_NONE),
+	  TransitionIdx(INDEX_NONE)
 {
 }
 
@@ -28,7 +26,7 @@ FString FIGVEdge::ToString() const
 	return FString::Printf(TEXT("SourceIdx=%d TargetIdx=%d"), SourceIdx, TargetIdx);
 }
 
-void FIGVEdge::SetupClusters()
+void FIGVEdge::FindLowestCommonAncestor()
 {
 	TArray<int32> const& SourceAncIdxs = SourceNode->AncIdxs;
 	TArray<int32> const& TargetAncIdxs = TargetNode->AncIdxs;
@@ -40,10 +38,10 @@ void FIGVEdge::SetupClusters()
 	// Find the lowest common ancestor in the clustering hierarchy
 	int32 LCAIdx = GraphActor->RootCluster->Idx;
 	int32 LCAIdxInAncs = 0;
-	for (int32 Idx = 0, Num = SourceAncIdxs.Num(); Idx < Num; Idx++)
+	for (int32 AncIdx = 0, Num = SourceAncIdxs.Num(); AncIdx < Num; AncIdx++)
 	{
-		int32 const SourceAncestorIdx = SourceAncIdxs[Idx];
-		int32 const TargetAncestorIdx = TargetAncIdxs[Idx];
+		int32 const SourceAncestorIdx = SourceAncIdxs[AncIdx];
+		int32 const TargetAncestorIdx = TargetAncIdxs[AncIdx];
 		if (SourceAncestorIdx == TargetAncestorIdx)
 		{
 			LCAIdx = SourceAncestorIdx;
@@ -54,141 +52,227 @@ void FIGVEdge::SetupClusters()
 	LowestCommonAncestor = &GraphActor->Clusters[LCAIdx];
 	check(LowestCommonAncestor->Idx == LCAIdx);
 
+	// The path goes up the source ancestors and down the target ancestors.
+	LowestCommonAncestorIdxInClusters = LCAIdxInAncs;
+}
+
+int32 FIGVEdge::NumClusters() const
+{
+	return LowestCommonAncestorIdxInClusters * 2 + 1;
+}
+
+void FIGVEdge::SetupClusters()
+{
+	check(LowestCommonAncestor != nullptr);
+
+	FIGVEdgeStore& Store = GetStore();
+	TArrayView<FIGVCluster*> const Clusters = Store.GetPathClusters(Idx);
+	check(Clusters.Num() == NumClusters());
+
+	TArray<int32> const& SourceAncIdxs = SourceNode->AncIdxs;
+	TArray<int32> const& TargetAncIdxs = TargetNode->AncIdxs;
+	int32 const LCAIdxInAncs = LowestCommonAncestorIdxInClusters;
+
 	// Get the path in the clustering hierarchy
-	for (int32 Idx = 0; Idx < LCAIdxInAncs; Idx++)
+	int32 ClusterIdx = 0;
+	for (int32 AncIdx = 0; AncIdx < LCAIdxInAncs; AncIdx++)
 	{
-		Clusters.Add(&GraphActor->Clusters[SourceAncIdxs[Idx]]);
+		Clusters[ClusterIdx++] = &GraphActor->Clusters[SourceAncIdxs[AncIdx]];
 	}
-	LowestCommonAncestorIdxInClusters = Clusters.Num();
-	Clusters.Add(LowestCommonAncestor);
-	for (int32 Idx = LCAIdxInAncs - 1; Idx >= 0; Idx--)
+	Clusters[ClusterIdx++] = LowestCommonAncestor;
+	for (int32 AncIdx = LCAIdxInAncs - 1; AncIdx >= 0; AncIdx--)
 	{
-		Clusters.Add(&GraphActor->Clusters[TargetAncIdxs[Idx]]);
+		Clusters[ClusterIdx++] = &GraphActor->Clusters[TargetAncIdxs[AncIdx]];
 	}
+	check(ClusterIdx == Clusters.Num());
 
 	UpdateDefaultClusterLevels();
-	ClusterLevels = ClusterLevelsBeforeTransition = ClusterLevelsAfterTransition =
-		ClusterLevelsDefault;
 
-	// Debug
-	TArray<FString> ClusterStrs;
-	for (FIGVCluster* const Cluster : Clusters)
+	int32 const LevelsSize = sizeof(float) * Clusters.Num();
+	FMemory::Memcpy(Store.GetPathLevelsBeforeTransition(Idx).GetData(),
+					Store.GetPathLevelsDefault(Idx).GetData(), LevelsSize);
+	FMemory::Memcpy(Store.GetPathLevelsAfterTransition(Idx).GetData(),
+					Store.GetPathLevelsDefault(Idx).GetData(), LevelsSize);
+
+	// Debug. AIGVGraphActor::SetupClusters logs a summary of all paths.
+	if (IGV_LOG_ACTIVE(VeryVerbose))
 	{
-		ClusterStrs.Add(FString::FromInt(Cluster->Idx));
+		TArray<FString> ClusterStrs;
+		for (FIGVCluster* const Cluster : Clusters)
+		{
+			ClusterStrs.Add(FString::FromInt(Cluster->Idx));
+		}
+
+		IGV_LOG(VeryVerbose, TEXT("LowestCommonAncestor.Idx=%d Clusters=[%s] Source=%s Target=%s"),
+				LowestCommonAncestor->Idx, *FString::Join(ClusterStrs, TEXT(" ")),
+				*SourceNode->ToString(), *TargetNode->ToString());
 	}
+}
 
-	IGV_LOG(Log, TEXT("LowestCommonAncestor.Idx=%d Clusters=[%s] Source=%s Target=%s"), LCAIdx,
-			*FString::Join(ClusterStrs, TEXT(" ")), *SourceNode->ToString(),
-			*TargetNode->ToString());
+FIGVEdgeStore& FIGVEdge::GetStore() const
+{
+	return GraphActor->EdgeStore;
 }
 
 void FIGVEdge::UpdateDefaultClusterLevels()
 {
-	ClusterLevelsDefault.Reset();
-	for (FIGVCluster* const Cluster : Clusters)
+	FIGVEdgeStore& Store = GetStore();
+	TArrayView<FIGVCluster*> const Clusters = Store.GetPathClusters(Idx);
+	TArrayView<float> const ClusterLevelsDefault = Store.GetPathLevelsDefault(Idx);
+
+	for (int32 PathIdx = 0, Num = Clusters.Num(); PathIdx < Num; PathIdx++)
 	{
-		ClusterLevelsDefault.Emplace(Cluster->DefaultLevel());
+		ClusterLevelsDefault[PathIdx] = Clusters[PathIdx]->DefaultLevel();
 	}
 }
 
-void FIGVEdge::UpdateSplineControlPoints()
+int32 FIGVEdge::NumSplineControlPoints() const
 {
-	UpdateSplineControlPointsImpl(ClusterLevels, SourceNode->LevelScale, TargetNode->LevelScale);
+	// Source, target, and the path in the clustering hierarchy excluding the root
+	return NumClusters() + 2 - (LowestCommonAncestor->IsRoot() ? 1 : 0);
 }
 
-void FIGVEdge::UpdateDefaultSplineControlPoints()
+void FIGVEdge::UpdateSplineControlPoints()
 {
-	UpdateDefaultClusterLevels();
-	UpdateSplineControlPointsImpl(ClusterLevelsDefault, GraphActor->DefaultLevelScale,
-								  GraphActor->DefaultLevelScale);
+	FIGVEdgeStore& Store = GetStore();
+
+	UpdateSplineControlPointsImpl();
+	UpdateSplineLevelsImpl(
+		Store.GetPathLevelsBeforeTransition(Idx), Store.GetPathLevelsAfterTransition(Idx),
+		FIGVEdgeSplineLevelData{SourceNode->LevelScaleBeforeTransition,
+								SourceNode->LevelScaleAfterTransition},
+		FIGVEdgeSplineLevelData{TargetNode->LevelScaleBeforeTransition,
+								TargetNode->LevelScaleAfterTransition});
 }
 
-void FIGVEdge::UpdateSplineControlPointsImpl(TArray<float> const& InClusterLevels,
-											 float const SourceLevelScale,
-											 float const TargetLevelScale)
+void FIGVEdge::GetDefaultSplineControlPoints(FIGVEdgeSplineControlPointData* const OutControlPoints,
+											 FIGVEdgeSplineLevelData* const OutLevels) const
 {
-	SplineControlPointData.Reset();
+	TArrayView<FIGVCluster*> const Clusters = GetStore().GetPathClusters(Idx);
+	float const DefaultLevelScale = GraphActor->DefaultLevelScale;
+	int32 ControlPointIdx = 0;
 
-	SplineControlPointData.Emplace(
-		FIGVEdgeSplineControlPointData{SourceNode->Pos3D, SourceLevelScale, 0.0});
+	OutControlPoints[ControlPointIdx] = FIGVEdgeSplineControlPointData{SourceNode->Pos3D, 0.0};
+	OutLevels[ControlPointIdx] = FIGVEdgeSplineLevelData{DefaultLevelScale, DefaultLevelScale};
+	ControlPointIdx++;
 
-	for (int32 Idx = 0, NumPath = Clusters.Num(); Idx < NumPath; Idx++)
+	for (int32 PathIdx = 0, NumPath = Clusters.Num(); PathIdx < NumPath; PathIdx++)
 	{
-		FIGVCluster* const Cluster = Clusters[Idx];
+		FIGVCluster const* const Cluster = Clusters[PathIdx];
 
 		if (!Cluster->IsRoot())
 		{
-			float const Alpha = float(Idx + 1) / float(NumPath + 1);
-			SplineControlPointData.Emplace(
-				FIGVEdgeSplineControlPointData{Cluster->Pos3D, InClusterLevels[Idx], Alpha});
+			float const Alpha = float(PathIdx + 1) / float(NumPath + 1);
+			float const Level = Cluster->DefaultLevel();
+			OutControlPoints[ControlPointIdx] =
+				FIGVEdgeSplineControlPointData{Cluster->Pos3D, Alpha};
+			OutLevels[ControlPointIdx] = FIGVEdgeSplineLevelData{Level, Level};
+			ControlPointIdx++;
 		}
 	}
 
-	SplineControlPointData.Emplace(
-		FIGVEdgeSplineControlPointData{TargetNode->Pos3D, TargetLevelScale, 1.0});
-}
+	OutControlPoints[ControlPointIdx] = FIGVEdgeSplineControlPointData{TargetNode->Pos3D, 1.0};
+	OutLevels[ControlPointIdx] = FIGVEdgeSplineLevelData{DefaultLevelScale, DefaultLevelScale};
+	ControlPointIdx++;
 
-float FIGVEdge::BundlingStrength() const
-{
-	// TODO: individual BundlingStrength
-	return GraphActor->EdgeBundlingStrength;
+	check(ControlPointIdx == NumSplineControlPoints());
 }
 
-bool FIGVEdge::HasHighlightedNode() const
+void FIGVEdge::UpdateSplineControlPointsImpl()
 {
-	return (SourceNode->bIsHighlighted || TargetNode->bIsHighlighted);
+	FIGVEdgeStore& Store = GetStore();
+	TArrayView<FIGVCluster*> const Clusters = Store.GetPathClusters(Idx);
+	TArrayView<FIGVEdgeSplineControlPointData> const SplineControlPointData =
+		Store.GetControlPoints(Idx);
+	int32 ControlPointIdx = 0;
+
+	SplineControlPointData[ControlPointIdx++] =
+		FIGVEdgeSplineControlPointData{SourceNode->Pos3D, 0.0};
+
+	for (int32 PathIdx = 0, NumPath = Clusters.Num(); PathIdx < NumPath; PathIdx++)
+	{
+		FIGVCluster* const Cluster = Clusters[PathIdx];
+
+		if (!Cluster->IsRoot())
+		{
+			float const Alpha = float(PathIdx + 1) / float(NumPath + 1);
+			SplineControlPointData[ControlPointIdx++] =
+				FIGVEdgeSplineControlPointData{Cluster->Pos3D, Alpha};
+		}
+	}
+
+	SplineControlPointData[ControlPointIdx++] =
+		FIGVEdgeSplineControlPointData{TargetNode->Pos3D, 1.0};
+
+	check(ControlPointIdx == SplineControlPointData.Num());
 }
 
-bool FIGVEdge::HasNeighborHighlightedNode() const
+void FIGVEdge::UpdateSplineLevelsImpl(TArrayView<float> const InClusterLevelsBeforeTransition,
+									  TArrayView<float> const InClusterLevelsAfterTransition,
+									  FIGVEdgeSplineLevelData const& SourceLevel,
+									  FIGVEdgeSplineLevelData const& TargetLevel)
 {
-	return (SourceNode->HasHighlightedNeighbor() || TargetNode->HasHighlightedNeighbor());
+	FIGVEdgeStore& Store = GetStore();
+	TArrayView<FIGVCluster*> const Clusters = Store.GetPathClusters(Idx);
+	TArrayView<FIGVEdgeSplineLevelData> const SplineLevelData = Store.GetControlPointLevels(Idx);
+	int32 ControlPointIdx = 0;
+
+	SplineLevelData[ControlPointIdx++] = SourceLevel;
+
+	for (int32 PathIdx = 0, NumPath = Clusters.Num(); PathIdx < NumPath; PathIdx++)
+	{
+		if (!Clusters[PathIdx]->IsRoot())
+		{
+			SplineLevelData[ControlPointIdx++] =
+				FIGVEdgeSplineLevelData{InClusterLevelsBeforeTransition[PathIdx],
+										InClusterLevelsAfterTransition[PathIdx]};
+		}
+	}
+
+	SplineLevelData[ControlPointIdx++] = TargetLevel;
+
+	check(ControlPointIdx == SplineLevelData.Num());
 }
 
-bool FIGVEdge::HasBothHighlightedNodes() const
+float FIGVEdge::BundlingStrength() const
 {
-	return (SourceNode->bIsHighlighted && TargetNode->bIsHighlighted);
+	// TODO: individual BundlingStrength
+	return GraphActor->EdgeBundlingStrength;
 }
 
-bool FIGVEdge::IsDefaultRenderGroup() const
+void FIGVEdge::InitHighlightState()
 {
-	return !(bInTransition || HasHighlightedNode() || HasNeighborHighlightedNode());
+	FIGVEdgeStore& Store = GetStore();
+	Store.SetEndpointHighlightState(Idx, SourceIdx, SourceNode->bIsHighlighted,
+									SourceNode->HasHighlightedNeighbor());
+	Store.SetEndpointHighlightState(Idx, TargetIdx, TargetNode->bIsHighlighted,
+									TargetNode->HasHighlightedNeighbor());
 }
 
-bool FIGVEdge::IsHighlightedRenderGroup() const
+bool FIGVEdge::HasHighlightedNode() const
 {
-	return HasBothHighlightedNodes() || (HasHighlightedNode() && HasNeighborHighlightedNode());
+	return GetStore().HasHighlightState(Idx, EIGVEdgeHighlight::Highlighted);
 }
 
-bool FIGVEdge::IsRemainedRenderGroup() const
+bool FIGVEdge::HasNeighborHighlightedNode() const
 {
-	return !(IsDefaultRenderGroup() || IsHighlightedRenderGroup());
+	return GetStore().HasHighlightState(Idx, EIGVEdgeHighlight::NeighborHighlighted);
 }
 
-void FIGVEdge::UpdateRenderGroup()
+bool FIGVEdge::HasBothHighlightedNodes() const
 {
-	if (IsHighlightedRenderGroup())
-	{
-		RenderGroup = EIGVEdgeRenderGroup::Highlighted;
-	}
-	else if (IsDefaultRenderGroup())
-	{
-		RenderGroup = EIGVEdgeRenderGroup::Default;
-	}
-	else
-	{
-		RenderGroup = EIGVEdgeRenderGroup::Remained;
-	}
+	return GetStore().HasAllHighlightStates(Idx, EIGVEdgeHighlight::Highlighted);
 }
 
 void FIGVEdge::BeginTransition()
 {
-	ClusterLevelsBeforeTransition = ClusterLevels;
+	FIGVEdgeStore& Store = GetStore();
+	TArrayView<FIGVCluster*> const Clusters = Store.GetPathClusters(Idx);
+	TArrayView<float> const ClusterLevelsAfterTransition = Store.GetPathLevelsAfterTransition(Idx);
 
 	float const SouceLevelScaleAfterTransition = SourceNode->LevelScaleAfterTransition;
 	float const TargetLevelScaleAfterTransition = TargetNode->LevelScaleAfterTransition;
 
-	ClusterLevelsAfterTransition.Reset();
-
 	if (HasHighlightedNode() || HasNeighborHighlightedNode())
 	{
 		float const HighlightedLevelScaleOfLowestCommonAncestor =
@@ -196,47 +280,60 @@ void FIGVEdge::BeginTransition()
 				? GraphActor->HighlightedLevelScale
 				: GraphActor->DefaultLevelScale + GraphActor->ClusterLevelOffset;
 
-		for (int32 Idx = 0; Idx < LowestCommonAncestorIdxInClusters; Idx++)
+		for (int32 PathIdx = 0; PathIdx < LowestCommonAncestorIdxInClusters; PathIdx++)
 		{
-			ClusterLevelsAfterTransition.Emplace(FMath::Lerp(
+			ClusterLevelsAfterTransition[PathIdx] = FMath::Lerp(
 				SouceLevelScaleAfterTransition, HighlightedLevelScaleOfLowestCommonAncestor,
-				float(Idx + 1) / float(LowestCommonAncestorIdxInClusters + 1)));
+				float(PathIdx + 1) / float(LowestCommonAncestorIdxInClusters + 1));
 		}
 
-		ClusterLevelsAfterTransition.Emplace(HighlightedLevelScaleOfLowestCommonAncestor);
+		ClusterLevelsAfterTransition[LowestCommonAncestorIdxInClusters] =
+			HighlightedLevelScaleOfLowestCommonAncestor;
 
-		for (int32 Idx = LowestCommonAncestorIdxInClusters + 1, Num = ClusterLevels.Num();
-			 Idx < Num; Idx++)
+		for (int32 PathIdx = LowestCommonAncestorIdxInClusters + 1, Num = Clusters.Num();
+			 PathIdx < Num; PathIdx++)
 		{
-			ClusterLevelsAfterTransition.Emplace(FMath::Lerp(
+			ClusterLevelsAfterTransition[PathIdx] = FMath::Lerp(
 				HighlightedLevelScaleOfLowestCommonAncestor, TargetLevelScaleAfterTransition,
-				float(Idx - LowestCommonAncestorIdxInClusters) /
-					float(Num - LowestCommonAncestorIdxInClusters)));
+				float(PathIdx - LowestCommonAncestorIdxInClusters) /
+					float(Num - LowestCommonAncestorIdxInClusters));
 		}
 	}
 	else
 	{
-		for (FIGVCluster* const Cluster : Clusters)
+		for (int32 PathIdx = 0, Num = Clusters.Num(); PathIdx < Num; PathIdx++)
 		{
-			ClusterLevelsAfterTransition.Emplace(Cluster->DefaultLevel());
+			ClusterLevelsAfterTransition[PathIdx] = Clusters[PathIdx]->DefaultLevel();
 		}
 	}
 }
 
-void FIGVEdge::OnHighlightTransitionTimelineUpdate(ETimelineDirection::Type const Direction,
-												   float const Alpha)
+void FIGVEdge::RebaseTransition(float const Alpha)
 {
-	bInTransition = true;
-	bUpdateMeshRequired = true;
+	FIGVEdgeStore& Store = GetStore();
+	TArrayView<float> const ClusterLevelsBeforeTransition =
+		Store.GetPathLevelsBeforeTransition(Idx);
+	TArrayView<float> const ClusterLevelsAfterTransition = Store.GetPathLevelsAfterTransition(Idx);
 
-	for (int32 Idx = 0, Num = ClusterLevels.Num(); Idx < Num; Idx++)
+	for (int32 PathIdx = 0, Num = ClusterLevelsBeforeTransition.Num(); PathIdx < Num; PathIdx++)
 	{
-		ClusterLevels[Idx] = FMath::Lerp(ClusterLevelsBeforeTransition[Idx],
-										 ClusterLevelsAfterTransition[Idx], Alpha);
+		ClusterLevelsBeforeTransition[PathIdx] =
+			FMath::Lerp(ClusterLevelsBeforeTransition[PathIdx],
+						ClusterLevelsAfterTransition[PathIdx], Alpha);
 	}
+
+	Store.SetFlags(Idx, EIGVEdgeFlags::UpdateMeshRequired);
 }
 
-void FIGVEdge::OnHighlightTransitionTimelineFinished(ETimelineDirection::Type const Direction)
+void FIGVEdge::EndTransition()
 {
-	bInTransition = false;
+	FIGVEdgeStore& Store = GetStore();
+	TArrayView<float> const ClusterLevelsAfterTransition = Store.GetPathLevelsAfterTransition(Idx);
+
+	FMemory::Memcpy(Store.GetPathLevelsBeforeTransition(Idx).GetData(),
+					ClusterLevelsAfterTransition.GetData(),
+					sizeof(float) * ClusterLevelsAfterTransition.Num());
+
+	Store.ClearFlags(Idx, EIGVEdgeFlags::InTransition);
+	Store.SetFlags(Idx, EIGVEdgeFlags::UpdateMeshRequired);
 }
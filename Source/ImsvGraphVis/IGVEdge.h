@@ -2,10 +2,9 @@
 
 #pragma once
 
-#include "Components/TimelineComponent.h"
+#include "Containers/ArrayView.h"
 #include "CoreMinimal.h"
 
-#include "IGVEdgeMeshData.h"
 #include "IGVEdgeSplineData.h"
 
 #include "IGVEdge.generated.h"
@@ -18,6 +17,8 @@ struct IMSVGRAPHVIS_API FIGVEdge
 public:
 	class AIGVGraphActor* GraphActor;
 
+	int32 Idx;  // Index in AIGVGraphActor::Edges and AIGVGraphActor::EdgeStore
+
 	UPROPERTY(VisibleAnywhere, SaveGame, Category = ImmersiveGraphVisualization)
 	int32 SourceIdx;
 
@@ -27,20 +28,13 @@ public:
 	class AIGVNodeActor* SourceNode;
 	class AIGVNodeActor* TargetNode;
 
+	// The cluster path, its levels and the spline control points are in the pools of
+	// AIGVGraphActor::EdgeStore, as are the highlight state, the render group and the per-frame
+	// flags.
 	struct FIGVCluster* LowestCommonAncestor;
-	TArray<struct FIGVCluster*> Clusters;
 	int32 LowestCommonAncestorIdxInClusters;
 
-	TArray<float> ClusterLevels;
-	TArray<float> ClusterLevelsDefault;
-	TArray<float> ClusterLevelsBeforeTransition;
-	TArray<float> ClusterLevelsAfterTransition;
-	TArray<FIGVEdgeSplineControlPointData> SplineControlPointData;
-	FIGVEdgeMeshData MeshData;
-
-	EIGVEdgeRenderGroup::Type RenderGroup;
-	bool bInTransition;
-	bool bUpdateMeshRequired;
+	int32 TransitionIdx;  // Index in FIGVTransitionManager, INDEX_NONE if not in transition
 
 public:
 	FIGVEdge() = default;
@@ -48,32 +42,47 @@ public:
 
 	FString ToString() const;
 
+	// Sets LowestCommonAncestor and LowestCommonAncestorIdxInClusters, so that the path lengths
+	// are known before FIGVEdgeStore::SetupPaths
+	void FindLowestCommonAncestor();
+	int32 NumClusters() const;
+
 	void SetupClusters();
 
 public:
 	void UpdateDefaultClusterLevels();
 
+	int32 NumSplineControlPoints() const;
+
 	void UpdateSplineControlPoints();
-	void UpdateDefaultSplineControlPoints();
+
+	// Writes NumSplineControlPoints() control points and levels of the default render group
+	// without touching the edge store, so it is safe to run alongside UpdateSplineControlPoints.
+	void GetDefaultSplineControlPoints(FIGVEdgeSplineControlPointData* const OutControlPoints,
+									   FIGVEdgeSplineLevelData* const OutLevels) const;
 
 protected:
-	void UpdateSplineControlPointsImpl(TArray<float> const& InClusterLevels,
-									   float const SourceLevelScale, float const TargetLevelScale);
+	struct FIGVEdgeStore& GetStore() const;
+
+	void UpdateSplineControlPointsImpl();
+	void UpdateSplineLevelsImpl(TArrayView<float> const InClusterLevelsBeforeTransition,
+								TArrayView<float> const InClusterLevelsAfterTransition,
+								FIGVEdgeSplineLevelData const& SourceLevel,
+								FIGVEdgeSplineLevelData const& TargetLevel);
 
 public:
 	float BundlingStrength() const;
 
+	// Sets the highlight state from the endpoints, for an edge added to a graph that may have
+	// highlighted nodes. The state is kept by the endpoints from then on.
+	void InitHighlightState();
+
+	// From the highlight state in the edge store, without reading the endpoints
 	bool HasHighlightedNode() const;
 	bool HasNeighborHighlightedNode() const;
 	bool HasBothHighlightedNodes() const;
 
-	bool IsDefaultRenderGroup() const;
-	bool IsHighlightedRenderGroup() const;
-	bool IsRemainedRenderGroup() const;
-	void UpdateRenderGroup();
-
 	void BeginTransition();
-	void OnHighlightTransitionTimelineUpdate(ETimelineDirection::Type const Direction,
-											 float const Alpha);
-	void OnHighlightTransitionTimelineFinished(ETimelineDirection::Type const Direction);
+	void RebaseTransition(float const Alpha);
+	void EndTransition();
 };
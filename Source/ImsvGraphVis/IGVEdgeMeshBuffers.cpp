@@ -0,0 +1,237 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVEdgeMeshBuffers.h"
+
+void FIGVEdgeMeshSpans::Reset()
+{
+	ControlPoints.Reset();
+	Segments.Reset();
+	Splines.Reset();
+	MeshIndices.Reset();
+}
+
+void FIGVEdgeMeshSpans::Append(FIGVEdgeMeshSpans const& Other)
+{
+	auto AppendSpans = [](TArray<FIGVEdgeMeshSpan>& Spans, TArray<FIGVEdgeMeshSpan> const& Others) {
+		for (FIGVEdgeMeshSpan const& Span : Others)
+		{
+			Add(Spans, Span.Begin, Span.End);
+		}
+	};
+
+	AppendSpans(ControlPoints, Other.ControlPoints);
+	AppendSpans(Segments, Other.Segments);
+	AppendSpans(Splines, Other.Splines);
+	AppendSpans(MeshIndices, Other.MeshIndices);
+}
+
+void FIGVEdgeMeshSpans::Add(TArray<FIGVEdgeMeshSpan>& Spans, int32 const Begin, int32 const End)
+{
+	if (Begin >= End) return;
+
+	if (Spans.Num() > 0 && Spans.Last().End == Begin)
+	{
+		Spans.Last().End = End;
+	}
+	else
+	{
+		Spans.Add(FIGVEdgeMeshSpan{Begin, End});
+	}
+}
+
+uint32 FIGVEdgeMeshSpans::GetAllocatedSize() const
+{
+	return ControlPoints.GetAllocatedSize() + Segments.GetAllocatedSize() +
+		   Splines.GetAllocatedSize() + MeshIndices.GetAllocatedSize();
+}
+
+FIGVEdgeMeshCapacity::FIGVEdgeMeshCapacity()
+	: NumControlPoints(0), NumSegments(0), NumSplines(0), NumMeshVertices(0), NumMeshIndices(0)
+{
+}
+
+bool FIGVEdgeMeshCapacity::operator==(FIGVEdgeMeshCapacity const& Other) const
+{
+	return NumControlPoints == Other.NumControlPoints && NumSegments == Other.NumSegments &&
+		   NumSplines == Other.NumSplines && NumMeshVertices == Other.NumMeshVertices &&
+		   NumMeshIndices == Other.NumMeshIndices;
+}
+
+bool FIGVEdgeMeshCapacity::operator!=(FIGVEdgeMeshCapacity const& Other) const
+{
+	return !(*this == Other);
+}
+
+FIGVEdgeMeshBuffers::FIGVEdgeMeshBuffers()
+	: SplineControlPointData(),
+	  SplineLevelData(),
+	  SplineSegmentData(),
+	  SplineData(),
+	  NumMeshVertices(0),
+	  NumMeshIndices(0),
+	  MeshIndices(),
+	  MeshRanges(),
+	  NumUnusedMeshVertices(0),
+	  BundleMeshRange(),
+	  BundledEdges(),
+	  Capacity(),
+	  Version(0),
+	  BaseVersion(0),
+	  PatchedSpans()
+{
+}
+
+void FIGVEdgeMeshBuffers::Reset()
+{
+	SplineControlPointData.Reset();
+	SplineLevelData.Reset();
+	SplineSegmentData.Reset();
+	SplineData.Reset();
+	MeshIndices.Reset();
+	MeshRanges.Reset();
+
+	NumMeshVertices = 0;
+	NumMeshIndices = 0;
+	NumUnusedMeshVertices = 0;
+	BundleMeshRange = FIGVEdgeMeshRange();
+	BundledEdges.Reset();
+
+	Capacity = FIGVEdgeMeshCapacity();
+	Version = 0;
+	BaseVersion = 0;
+	PatchedSpans.Reset();
+}
+
+void FIGVEdgeMeshBuffers::Empty()
+{
+	SplineControlPointData.Empty();
+	SplineLevelData.Empty();
+	SplineSegmentData.Empty();
+	SplineData.Empty();
+	MeshIndices.Empty();
+	MeshRanges.Empty();
+
+	NumMeshVertices = 0;
+	NumMeshIndices = 0;
+	NumUnusedMeshVertices = 0;
+	BundleMeshRange = FIGVEdgeMeshRange();
+	BundledEdges.Empty();
+
+	Capacity = FIGVEdgeMeshCapacity();
+	Version = 0;
+	BaseVersion = 0;
+	PatchedSpans = FIGVEdgeMeshSpans();
+}
+
+void FIGVEdgeMeshBuffers::Reserve(int32 const NumControlPoints, int32 const NumSegments,
+								  int32 const NumSplines, int32 const NumIndices)
+{
+	SplineControlPointData.Reserve(NumControlPoints);
+	SplineLevelData.Reserve(NumControlPoints);
+	SplineSegmentData.Reserve(NumSegments);
+	SplineData.Reserve(NumSplines);
+	MeshIndices.Reserve(NumIndices);
+}
+
+void FIGVEdgeMeshBuffers::SetCapacity(float const Slack)
+{
+	auto WithSlack = [Slack](int32 const Num) { return Num + FMath::CeilToInt(Num * Slack); };
+
+	Capacity.NumControlPoints = WithSlack(SplineControlPointData.Num());
+	Capacity.NumSegments = WithSlack(SplineSegmentData.Num());
+	Capacity.NumSplines = WithSlack(SplineData.Num());
+	Capacity.NumMeshVertices = WithSlack(NumMeshVertices);
+	Capacity.NumMeshIndices = WithSlack(MeshIndices.Num());
+}
+
+bool FIGVEdgeMeshBuffers::IsInCapacity() const
+{
+	return SplineControlPointData.Num() <= Capacity.NumControlPoints &&
+		   SplineSegmentData.Num() <= Capacity.NumSegments &&
+		   SplineData.Num() <= Capacity.NumSplines &&
+		   NumMeshVertices <= Capacity.NumMeshVertices &&
+		   MeshIndices.Num() <= Capacity.NumMeshIndices;
+}
+
+template <typename ElementType>
+static void CopyArray(TArray<ElementType>& Out, TArray<ElementType> const& In, int32 const Capacity,
+					  TArray<FIGVEdgeMeshSpan> const* const Spans)
+{
+	if (Spans == nullptr)
+	{
+		Out.Reset(FMath::Max(Capacity, In.Num()));
+		Out.Append(In);
+		return;
+	}
+
+	// Earlier versions only ever grow.
+	check(Out.Num() <= In.Num());
+	Out.Reserve(FMath::Max(Capacity, In.Num()));
+	Out.SetNumUninitialized(In.Num(), false);
+
+	for (FIGVEdgeMeshSpan const& Span : *Spans)
+	{
+		FMemory::Memcpy(Out.GetData() + Span.Begin, In.GetData() + Span.Begin,
+						sizeof(ElementType) * (Span.End - Span.Begin));
+	}
+}
+
+void FIGVEdgeMeshBuffers::CopyFrom(FIGVEdgeMeshBuffers const& Other,
+								   FIGVEdgeMeshSpans const* const Spans)
+{
+	FIGVEdgeMeshCapacity const& C = Other.Capacity;
+	CopyArray(SplineControlPointData, Other.SplineControlPointData, C.NumControlPoints,
+			  Spans ? &Spans->ControlPoints : nullptr);
+	CopyArray(SplineLevelData, Other.SplineLevelData, C.NumControlPoints,
+			  Spans ? &Spans->ControlPoints : nullptr);
+	CopyArray(SplineSegmentData, Other.SplineSegmentData, C.NumSegments,
+			  Spans ? &Spans->Segments : nullptr);
+	CopyArray(SplineData, Other.SplineData, C.NumSplines, Spans ? &Spans->Splines : nullptr);
+	CopyArray(MeshIndices, Other.MeshIndices, C.NumMeshIndices,
+			  Spans ? &Spans->MeshIndices : nullptr);
+
+	NumMeshVertices = Other.NumMeshVertices;
+	NumMeshIndices = Other.NumMeshIndices;
+
+	// The per-edge state is changed in place by edge additions and removals, so it is copied
+	// as a whole.
+	MeshRanges = Other.MeshRanges;
+	NumUnusedMeshVertices = Other.NumUnusedMeshVertices;
+	BundleMeshRange = Other.BundleMeshRange;
+	BundledEdges = Other.BundledEdges;
+
+	Capacity = Other.Capacity;
+}
+
+FIGVEdgeMeshSpans FIGVEdgeMeshBuffers::GetAllSpans() const
+{
+	FIGVEdgeMeshSpans Spans;
+	FIGVEdgeMeshSpans::Add(Spans.ControlPoints, 0, SplineControlPointData.Num());
+	FIGVEdgeMeshSpans::Add(Spans.Segments, 0, SplineSegmentData.Num());
+	FIGVEdgeMeshSpans::Add(Spans.Splines, 0, SplineData.Num());
+	FIGVEdgeMeshSpans::Add(Spans.MeshIndices, 0, MeshIndices.Num());
+	return Spans;
+}
+
+uint32 FIGVEdgeMeshBuffers::GetAllocatedSize() const
+{
+	return SplineControlPointData.GetAllocatedSize() + SplineLevelData.GetAllocatedSize() +
+		   SplineSegmentData.GetAllocatedSize() + SplineData.GetAllocatedSize() +
+		   MeshIndices.GetAllocatedSize() + MeshRanges.GetAllocatedSize() +
+		   BundledEdges.GetAllocatedSize() + PatchedSpans.GetAllocatedSize();
+}
+
+uint32 FIGVEdgeMeshBuffers::GetGPUSize() const
+{
+	return sizeof(FIGVEdgeSplineControlPointData) * Capacity.NumControlPoints +
+		   sizeof(FIGVEdgeSplineLevelData) * Capacity.NumControlPoints +
+		   sizeof(FIGVEdgeSplineSegmentData) * Capacity.NumSegments +
+		   sizeof(FIGVEdgeSplineData) * Capacity.NumSplines +
+		   sizeof(FDynamicMeshVertex) * Capacity.NumMeshVertices +
+		   sizeof(int32) * Capacity.NumMeshIndices;
+}
+
+uint32 FIGVEdgeMeshDrawState::GetAllocatedSize() const
+{
+	return MeshRanges.GetAllocatedSize();
+}
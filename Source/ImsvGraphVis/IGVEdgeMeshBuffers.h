@@ -0,0 +1,129 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "KWMeshElement.h"
+
+#include "IGVEdgeMeshData.h"
+#include "IGVEdgeSplineData.h"
+
+// Elements [Begin, End) of one of the arrays of FIGVEdgeMeshBuffers
+struct FIGVEdgeMeshSpan
+{
+	int32 Begin;
+	int32 End;
+};
+
+// The elements of a frame written by UIGVEdgeMeshComponent::PatchEdges
+struct IMSVGRAPHVIS_API FIGVEdgeMeshSpans
+{
+	TArray<FIGVEdgeMeshSpan> ControlPoints;  // Also of SplineLevelData
+	TArray<FIGVEdgeMeshSpan> Segments;
+	TArray<FIGVEdgeMeshSpan> Splines;
+	TArray<FIGVEdgeMeshSpan> MeshIndices;
+
+	void Reset();
+	void Append(FIGVEdgeMeshSpans const& Other);
+
+	// Extends the last span instead if the new one follows it
+	static void Add(TArray<FIGVEdgeMeshSpan>& Spans, int32 const Begin, int32 const End);
+
+	uint32 GetAllocatedSize() const;
+};
+
+// Number of elements of the GPU buffers a frame is uploaded to
+struct IMSVGRAPHVIS_API FIGVEdgeMeshCapacity
+{
+	int32 NumControlPoints;  // Also of SplineLevelData
+	int32 NumSegments;
+	int32 NumSplines;
+	int32 NumMeshVertices;
+	int32 NumMeshIndices;
+
+	FIGVEdgeMeshCapacity();
+
+	bool operator==(FIGVEdgeMeshCapacity const& Other) const;
+	bool operator!=(FIGVEdgeMeshCapacity const& Other) const;
+};
+
+// Input of the spline compute shader and the index buffer of an edge render group. A frame of
+// buffers is filled by UIGVEdgeMeshComponent, and is immutable once handed to the scene proxy but
+// for the per-edge state below, which only the game thread reads.
+struct IMSVGRAPHVIS_API FIGVEdgeMeshBuffers
+{
+	TArray<FIGVEdgeSplineControlPointData> SplineControlPointData;
+	TArray<FIGVEdgeSplineLevelData> SplineLevelData;
+	TArray<FIGVEdgeSplineSegmentData> SplineSegmentData;
+	TArray<FIGVEdgeSplineData> SplineData;
+
+	int32 NumMeshVertices;
+	int32 NumMeshIndices;
+
+	FMeshIndexArray MeshIndices;
+
+	// Default group only. The range of each edge in these buffers, by edge index. The component
+	// keeps it in step with edges added to or removed from the graph, and the ranges of removed or
+	// re-laid out edges are counted as unused.
+	TArray<FIGVEdgeMeshRange> MeshRanges;
+	int32 NumUnusedMeshVertices;
+
+	// Default group only. The edge bundles are laid out together after the edges of a full update,
+	// and the edges drawn as part of them are marked by edge index. Bundles only change with a
+	// full update, so the frame shown until then keeps its own.
+	FIGVEdgeMeshRange BundleMeshRange;
+	TBitArray<> BundledEdges;
+
+	// The GPU buffers have room for the edges appended by UIGVEdgeMeshComponent::PatchEdges until
+	// the next full update, in the default group. A frame outgrowing them needs a new scene proxy.
+	FIGVEdgeMeshCapacity Capacity;
+
+	// Numbers the frames shown by the component. A patched frame is a later version of the frame
+	// of the same full update it was copied from. Zero until shown.
+	uint32 Version;
+	// Default group only. A patched frame of a scene proxy that was last sent the frame of
+	// BaseVersion, which only uploads the spans patched since. Zero to upload the whole frame.
+	uint32 BaseVersion;
+	FIGVEdgeMeshSpans PatchedSpans;
+
+	FIGVEdgeMeshBuffers();
+
+	void Reset();
+	void Empty();
+	void Reserve(int32 const NumControlPoints, int32 const NumSegments, int32 const NumSplines,
+				 int32 const NumIndices);
+
+	// Of the current size and Slack times more
+	void SetCapacity(float const Slack);
+	bool IsInCapacity() const;
+
+	// Copies Other with room for its capacity, except for the versions. If Spans is given, this
+	// frame is an earlier version of Other, and only these spans of the arrays are copied.
+	void CopyFrom(FIGVEdgeMeshBuffers const& Other, FIGVEdgeMeshSpans const* const Spans);
+
+	// All elements, for a whole upload
+	FIGVEdgeMeshSpans GetAllSpans() const;
+
+	uint32 GetAllocatedSize() const;
+
+	// Size of the structured, vertex and index buffers created from these buffers on the GPU
+	uint32 GetGPUSize() const;
+};
+
+typedef TSharedPtr<FIGVEdgeMeshBuffers, ESPMode::ThreadSafe> FIGVEdgeMeshBuffersPtr;
+typedef TSharedPtr<FIGVEdgeMeshBuffers const, ESPMode::ThreadSafe> FIGVEdgeMeshBuffersConstPtr;
+
+// Default group only. The ranges of the edges drawn from the shown buffers, in edge order. Taken
+// from the edge store on the game thread whenever the render group or the semantic zoom state of
+// an edge changes, and handed to the scene proxy, which never reads the store.
+struct IMSVGRAPHVIS_API FIGVEdgeMeshDrawState
+{
+	TArray<FIGVEdgeMeshRange> MeshRanges;
+
+	uint32 GetAllocatedSize() const;
+};
+
+typedef TSharedPtr<FIGVEdgeMeshDrawState, ESPMode::ThreadSafe> FIGVEdgeMeshDrawStatePtr;
+typedef TSharedPtr<FIGVEdgeMeshDrawState const, ESPMode::ThreadSafe>
+	FIGVEdgeMeshDrawStateConstPtr;
@@ -5,11 +5,15 @@
 #include "KWColorSpace.h"
 #include "KWTask.h"
 
+#include "IGVCluster.h"
 #include "IGVEdge.h"
 #include "IGVEdgeMeshSceneProxy.h"
+#include "IGVEdgeStore.h"
 #include "IGVGraphActor.h"
 #include "IGVLog.h"
 #include "IGVNodeActor.h"
+#include "IGVStats.h"
+#include "IGVTrace.h"
 
 UMaterialInterface* GetEdgeMaterial()
 {
@@ -18,16 +22,27 @@ UMaterialInterface* GetEdgeMaterial()
 	return MaterialAsset.Succeeded() ? MaterialAsset.Object->GetMaterial() : nullptr;
 }
 
+float const UIGVEdgeMeshComponent::PatchSlack = 0.25f;
+
 UIGVEdgeMeshComponent::UIGVEdgeMeshComponent()
 	: GraphActor(nullptr),
 	  RenderGroup(EIGVEdgeRenderGroup::Default),
-	  SplineControlPointData(),
-	  SplineSegmentData(),
-	  SplineData(),
-	  NumMeshVertices(0),
-	  NumMeshIndices(0),
-	  MeshIndices(),
-	  MaterialInstance(nullptr)
+	  Buffers(nullptr),
+	  DrawState(nullptr),
+	  TransitionAlpha(1.f),
+	  MaterialInstance(nullptr),
+	  BufferRing(),
+	  PendingBuffers(nullptr),
+	  BufferRingAllocatedSize(0),
+	  PendingTasks(),
+	  NextEdgeIdx(0),
+	  bIncrementalUpdateInProgress(false),
+	  bUpdateDrawStateRequired(false),
+	  Patches(),
+	  LastVersion(0),
+	  LayoutVersion(0),
+	  SentVersion(0),
+	  PendingBundles()
 {
 	PrimaryComponentTick.bCanEverTick = false;
 	PrimaryComponentTick.bStartWithTickEnabled = false;
@@ -49,10 +64,11 @@ void UIGVEdgeMeshComponent::Init(AIGVGraphActor* const InGraphActor,
 
 void UIGVEdgeMeshComponent::Setup()
 {
-	SplineControlPointData.Empty();
-	SplineSegmentData.Empty();
-	SplineData.Empty();
-	MeshIndices.Empty();
+	CancelIncrementalUpdate();
+
+	// Drop the buffers sized for the previous graph. The shown ones are released on swap.
+	BufferRing.Empty();
+	UpdateBufferMemoryStat();
 
 	if (RenderGroup == EIGVEdgeRenderGroup::Highlighted)
 	{
@@ -69,137 +85,855 @@ int32 GetVertexIdx(int32 const NumSides, int32 const AlongIdx, int32 const Aroun
 
 void UIGVEdgeMeshComponent::Update()
 {
-	SplineControlPointData.Reset();
-	SplineSegmentData.Reset();
-	SplineData.Reset();
-	MeshIndices.Reset();
+	BeginIncrementalUpdate();
+	TickIncrementalUpdate(0.0);
+	check(!bIncrementalUpdateInProgress);
+}
 
-	NumMeshVertices = 0;
-	NumMeshIndices = 0;
+void UIGVEdgeMeshComponent::BeginIncrementalUpdate()
+{
+	// Tasks of a previous update may still write to PendingBuffers
+	CancelIncrementalUpdate();
 
-	uint32 const NumSides = GraphActor->EdgeNumSides;
-	uint32 const NumSegmentSamples = GraphActor->EdgeSplineResolution;
+	PendingBuffers = AcquireBuffers();
+	PendingBuffers->Reset();
+	if (RenderGroup == EIGVEdgeRenderGroup::Default)
+	{
+		PendingBuffers->MeshRanges.AddDefaulted(GraphActor->EdgeStore.Num());
+		CollectEdgeBundles();
+	}
+	ReservePendingBuffers();
+
+	NextEdgeIdx = 0;
+	bIncrementalUpdateInProgress = true;
+}
+
+bool UIGVEdgeMeshComponent::TickIncrementalUpdate(double const BudgetSeconds)
+{
+	if (!bIncrementalUpdateInProgress) return true;
+
+	bool const bBudgeted = BudgetSeconds > 0.0;
+
+	// Do not wait for the workers. The current mesh is shown until they are done.
+	if (bBudgeted && !ArePendingTasksComplete()) return false;
+
+	// Edges are laid out on the game thread in chunks, and the chunks are filled by the workers.
+	static int32 const NumEdgesPerTask = 256;
+
+	double const EndTime = FPlatformTime::Seconds() + BudgetSeconds;
+	int32 const NumEdges = GetNumCandidateEdges();
+
+	while (NextEdgeIdx < NumEdges)
+	{
+		int32 const EndEdgeIdx = FMath::Min(NextEdgeIdx + NumEdgesPerTask, NumEdges);
+		DispatchPendingEdges(NextEdgeIdx, EndEdgeIdx);
+		NextEdgeIdx = EndEdgeIdx;
+
+		if (bBudgeted && FPlatformTime::Seconds() > EndTime) return false;
+	}
+
+	if (bBudgeted)
+	{
+		if (!ArePendingTasksComplete()) return false;
+	}
+	else
+	{
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(PendingTasks);
+	}
+	PendingTasks.Reset();
 
-	for (FIGVEdge& Edge : GraphActor->Edges)
+	// Once no task writes into the buffers, so that they can grow
+	if (PendingBundles.Num() > 0)
 	{
-		if (!(RenderGroup == EIGVEdgeRenderGroup::Default || Edge.RenderGroup == RenderGroup))
-			continue;
+		LayOutEdgeBundles(*PendingBuffers);
+		PendingBundles.Reset();
+	}
 
-		uint32 const BeginControlPointIdx = SplineControlPointData.Num();
-		uint32 const EdgeMeshVertexBufferOffset = NumMeshVertices;
-		uint32 const EdgeMeshIndexBufferOffset = NumMeshIndices;
-		uint32 const SplineIdx = SplineData.Num();
+	check(PendingBuffers->NumMeshIndices == PendingBuffers->MeshIndices.Num());
 
-		uint32 const NumSplineControlPoints = Edge.SplineControlPointData.Num();
-		SplineControlPointData.AddUninitialized(NumSplineControlPoints + 4);
+	// Room for the edges appended by patches until the next full update
+	PendingBuffers->SetCapacity(RenderGroup == EIGVEdgeRenderGroup::Default ? PatchSlack : 0.f);
+	PendingBuffers->Version = ++LastVersion;
+	LayoutVersion = LastVersion;
+	Patches.Reset();
 
-		// NumSplineControlPoints + 3 - 2. Degree - First and Last Control Point
-		uint32 const NumSplineSegments = NumSplineControlPoints + 1;
+	// Handed to the new scene proxy by reference
+	Buffers = PendingBuffers;
+	PendingBuffers = nullptr;
+	bIncrementalUpdateInProgress = false;
 
-		for (uint32 SegmentIdx = 0; SegmentIdx < NumSplineSegments; SegmentIdx++)
+	UpdateBufferMemoryStat();
+	MarkRenderStateDirty();
+
+	if (RenderGroup == EIGVEdgeRenderGroup::Default)
+	{
+		MarkDrawStateDirty();
+		UpdateDrawState();
+	}
+
+	return true;
+}
+
+void UIGVEdgeMeshComponent::CancelIncrementalUpdate()
+{
+	FTaskGraphInterface::Get().WaitUntilTasksComplete(PendingTasks);
+	PendingTasks.Reset();
+
+	PendingBuffers = nullptr;
+	PendingBundles.Reset();
+	bIncrementalUpdateInProgress = false;
+}
+
+bool UIGVEdgeMeshComponent::IsIncrementalUpdateInProgress() const
+{
+	return bIncrementalUpdateInProgress;
+}
+
+void UIGVEdgeMeshComponent::WaitForPendingTasks()
+{
+	// Called for every moved node
+	if (PendingTasks.Num() == 0) return;
+
+	FTaskGraphInterface::Get().WaitUntilTasksComplete(PendingTasks);
+	PendingTasks.Reset();
+}
+
+int32 UIGVEdgeMeshComponent::GetNumCandidateEdges() const
+{
+	FIGVEdgeStore const& Store = GraphActor->EdgeStore;
+	return RenderGroup == EIGVEdgeRenderGroup::Default
+			   ? Store.Num()
+			   : Store.GetRenderGroupEdgeIdxs(RenderGroup).Num();
+}
+
+int32 UIGVEdgeMeshComponent::GetCandidateEdgeIdx(int32 const CandidateIdx) const
+{
+	return RenderGroup == EIGVEdgeRenderGroup::Default
+			   ? CandidateIdx
+			   : GraphActor->EdgeStore.GetRenderGroupEdgeIdxs(RenderGroup)[CandidateIdx];
+}
+
+bool UIGVEdgeMeshComponent::IsInRenderGroup(FIGVEdgeMeshBuffers const& Frame,
+											int32 const EdgeIdx) const
+{
+	// Every edge but the bundled ones is in the buffers of the default group. See
+	// FIGVEdgeMeshSceneProxy.
+	if (RenderGroup == EIGVEdgeRenderGroup::Default)
+	{
+		return !Frame.BundledEdges[EdgeIdx];
+	}
+	FIGVEdgeStore const& Store = GraphActor->EdgeStore;
+	return Store.RenderGroups[EdgeIdx] == RenderGroup &&
+		   !Store.HasFlags(EdgeIdx, EIGVEdgeFlags::Aggregated);
+}
+
+FIGVEdgeMeshBuffersPtr UIGVEdgeMeshComponent::AcquireBuffers()
+{
+	auto FindUnused = [&]() -> FIGVEdgeMeshBuffersPtr {
+		for (FIGVEdgeMeshBuffersPtr const& Entry : BufferRing)
 		{
-			uint32 const SegmentMeshVertexBufferOffset = NumMeshVertices;
-			uint32 const SegmentMeshIndexBufferOffset = NumMeshIndices;
-
-			SplineSegmentData.Emplace(
-				FIGVEdgeSplineSegmentData{SplineIdx,						  //
-										  BeginControlPointIdx + SegmentIdx,  //
-										  NumSegmentSamples,				  //
-										  SegmentMeshVertexBufferOffset,	  //
-										  SegmentMeshIndexBufferOffset});
-
-			uint32 const NumSegmentMeshIndices =
-				(NumSegmentSamples - 1) * NumSides * 6;  // Two Triangles
-			MeshIndices.AddUninitialized(NumSegmentMeshIndices);
-
-			NumMeshVertices += NumSides * NumSegmentSamples;
-			NumMeshIndices += NumSegmentMeshIndices;  // Two Triangles
+			// Only referenced by the ring. Nobody else can add a reference, so this is stable
+			// against the render thread releasing its own.
+			if (Entry.GetSharedReferenceCount() == 1) return Entry;
 		}
+		return nullptr;
+	};
 
-		AIGVNodeActor const& SourceNode = *Edge.SourceNode;
-		AIGVNodeActor const& TargetNode = *Edge.TargetNode;
-		SplineData.Emplace(
-			FIGVEdgeSplineData{SourceNode.Pos3D,									 //
-							   TargetNode.Pos3D,									 //
-							   UKWColorSpace::RGBtoHCL(SourceNode.Color),			 //
-							   UKWColorSpace::RGBtoHCL(TargetNode.Color),			 //
-							   Edge.BundlingStrength(),								 //
-							   BeginControlPointIdx,								 //
-							   SplineControlPointData.Num() - BeginControlPointIdx,  //
-							   EdgeMeshVertexBufferOffset});
-
-		FIGVEdgeMeshData& MeshData = Edge.MeshData;
-		MeshData.VertexBufferOffset[RenderGroup] = EdgeMeshVertexBufferOffset;
-		MeshData.VertexBufferSize[RenderGroup] = NumMeshVertices - EdgeMeshVertexBufferOffset;
-		MeshData.IndexBufferOffset[RenderGroup] = EdgeMeshIndexBufferOffset;
-		MeshData.IndexBufferSize[RenderGroup] = NumMeshIndices - EdgeMeshIndexBufferOffset;
-	}
-
-	FGraphEventArray Tasks;
-	uint32 SplineIdx = 0;
-	for (FIGVEdge& Edge : GraphActor->Edges)
-	{
-		if (!(RenderGroup == EIGVEdgeRenderGroup::Default || Edge.RenderGroup == RenderGroup))
-			continue;
-
-		FIGVEdgeSplineData& Spline = SplineData[SplineIdx];
-		SplineIdx++;
-
-		Tasks.Add(FKWTask<>::ConstructAndDispatchWhenReady([&] {
-			auto const& ControlPoints = Edge.SplineControlPointData;
-
-			uint32 const I = Spline.BeginControlPointIdx;
-			uint32 const J = I + Spline.NumControlPoints - 1;
-
-			SplineControlPointData[I] = SplineControlPointData[I + 1] = ControlPoints[0];
-			FMemory::Memcpy(&SplineControlPointData[I + 2], ControlPoints.GetData(),
-							sizeof(FIGVEdgeSplineControlPointData) * ControlPoints.Num());
-			SplineControlPointData[J - 1] = SplineControlPointData[J] = ControlPoints.Last();
-		}));
+	FIGVEdgeMeshBuffersPtr Result = FindUnused();
+	if (Result.IsValid()) return Result;
+
+	if (BufferRing.Num() < MaxNumBuffers)
+	{
+		BufferRing.Add(FIGVEdgeMeshBuffersPtr(new FIGVEdgeMeshBuffers()));
+		return BufferRing.Last();
+	}
+
+	// The render thread is more than a frame behind and still holds the others.
+	IGV_LOG(Verbose, TEXT("Waiting for the render thread to release edge mesh buffers"));
+	FlushRenderingCommands();
+
+	Result = FindUnused();
+	check(Result.IsValid());
+	return Result;
+}
+
+void UIGVEdgeMeshComponent::CopyShownBuffers(FIGVEdgeMeshBuffers& Out) const
+{
+	// Laid out by the same full update, the frame only misses the patches since its version.
+	FIGVEdgeMeshSpans Spans;
+	bool const bIsEarlierVersion = Out.Version != 0 && CollectPatchedSpans(Out.Version, Spans);
+
+	Out.CopyFrom(*Buffers, bIsEarlierVersion ? &Spans : nullptr);
+}
+
+bool UIGVEdgeMeshComponent::CollectPatchedSpans(uint32 const SinceVersion,
+												FIGVEdgeMeshSpans& OutSpans) const
+{
+	// Versions are consecutive from the full update on, one patch each.
+	if (!Buffers.IsValid() || SinceVersion < LayoutVersion || SinceVersion >= Buffers->Version)
+	{
+		return false;
 	}
+	if (Patches.Num() == 0 || Patches[0].Version > SinceVersion + 1) return false;
 
-	for (FIGVEdgeSplineSegmentData& Segment : SplineSegmentData)
+	for (FPatch const& Patch : Patches)
 	{
-		Tasks.Add(FKWTask<>::ConstructAndDispatchWhenReady([&] {
-			uint32 const SegmentMeshVertexBufferOffset = Segment.MeshVertexBufferOffset;
-			uint32 const SegmentMeshIndexBufferOffset = Segment.MeshIndexBufferOffset;
+		if (Patch.Version > SinceVersion) OutSpans.Append(Patch.Spans);
+	}
+	return true;
+}
+
+void UIGVEdgeMeshComponent::UpdateBufferMemoryStat()
+{
+	uint32 const AllocatedSize = GetCPUMemorySize();
+
+	DEC_MEMORY_STAT_BY(STAT_IGV_EdgeMeshBufferMemory, BufferRingAllocatedSize);
+	INC_MEMORY_STAT_BY(STAT_IGV_EdgeMeshBufferMemory, AllocatedSize);
+	BufferRingAllocatedSize = AllocatedSize;
+}
+
+void UIGVEdgeMeshComponent::ReservePendingBuffers()
+{
+	// Reserved up front since tasks write into the buffers while further edges are appended.
+	int32 NumControlPoints = 0;
+	int32 NumSegments = 0;
+	int32 NumSplines = 0;
+	CountSplines(*PendingBuffers, 0, GetNumCandidateEdges(), NumControlPoints, NumSegments,
+				 NumSplines);
+
+	for (FEdgeBundle const& Bundle : PendingBundles)
+	{
+		int32 const NumSplineControlPoints =
+			GraphActor->Clusters[Bundle.LowestCommonAncestorIdx].IsRoot() ? 2 : 3;
+		NumControlPoints += NumSplineControlPoints + 4;
+		NumSegments += NumSplineControlPoints + 1;
+		NumSplines++;
+	}
+
+	PendingBuffers->Reserve(NumControlPoints, NumSegments, NumSplines,
+						   NumSegments * GetNumSegmentMeshIndices());
+}
+
+void UIGVEdgeMeshComponent::CountSplines(FIGVEdgeMeshBuffers const& Frame,
+										 int32 const BeginEdgeIdx, int32 const EndEdgeIdx,
+										 int32& OutNumControlPoints, int32& OutNumSegments,
+										 int32& OutNumSplines) const
+{
+	FIGVEdgeStore const& Store = GraphActor->EdgeStore;
+	for (int32 CandidateIdx = BeginEdgeIdx; CandidateIdx < EndEdgeIdx; CandidateIdx++)
+	{
+		int32 const EdgeIdx = GetCandidateEdgeIdx(CandidateIdx);
+		if (!IsInRenderGroup(Frame, EdgeIdx)) continue;
+
+		int32 const NumSplineControlPoints = Store.GetNumControlPoints(EdgeIdx);
+		OutNumControlPoints += NumSplineControlPoints + 4;
+		OutNumSegments += NumSplineControlPoints + 1;
+		OutNumSplines++;
+	}
+}
+
+int32 UIGVEdgeMeshComponent::GetNumSegmentMeshIndices() const
+{
+	return (GraphActor->EdgeSplineResolution - 1) * GraphActor->EdgeNumSides * 6;
+}
+
+void UIGVEdgeMeshComponent::DispatchPendingEdges(int32 const BeginEdgeIdx,
+												 int32 const EndEdgeIdx)
+{
+	SCOPE_CYCLE_COUNTER(STAT_IGV_EdgeMeshLayout);
+	IGV_TRACE_SCOPE("Edge Mesh Layout");
+	INC_DWORD_STAT_BY(STAT_IGV_NumDefaultEdgesLaidOut,
+					  RenderGroup == EIGVEdgeRenderGroup::Default ? EndEdgeIdx - BeginEdgeIdx : 0);
+
+	FIGVEdgeMeshBuffers& Out = *PendingBuffers;
+
+	int32 NumControlPoints = 0;
+	int32 NumSegments = 0;
+	int32 NumSplines = 0;
+	CountSplines(Out, BeginEdgeIdx, EndEdgeIdx, NumControlPoints, NumSegments, NumSplines);
+
+	// Edges edited since the update began may need more than reserved. The buffers only grow
+	// once no task writes into them, for the edges left at once.
+	if (Out.SplineControlPointData.Num() + NumControlPoints > Out.SplineControlPointData.Max() ||
+		Out.SplineSegmentData.Num() + NumSegments > Out.SplineSegmentData.Max() ||
+		Out.SplineData.Num() + NumSplines > Out.SplineData.Max() ||
+		Out.MeshIndices.Num() + NumSegments * GetNumSegmentMeshIndices() > Out.MeshIndices.Max())
+	{
+		WaitForPendingTasks();
+
+		NumControlPoints = NumSegments = NumSplines = 0;
+		CountSplines(Out, BeginEdgeIdx, GetNumCandidateEdges(), NumControlPoints, NumSegments,
+					 NumSplines);
+		Out.Reserve(Out.SplineControlPointData.Num() + NumControlPoints,
+					Out.SplineSegmentData.Num() + NumSegments, Out.SplineData.Num() + NumSplines,
+					Out.MeshIndices.Num() + NumSegments * GetNumSegmentMeshIndices());
+	}
+
+	int32 const BeginSplineIdx = Out.SplineData.Num();
+	int32 const BeginSegmentIdx = Out.SplineSegmentData.Num();
+
+	for (int32 CandidateIdx = BeginEdgeIdx; CandidateIdx < EndEdgeIdx; CandidateIdx++)
+	{
+		int32 const EdgeIdx = GetCandidateEdgeIdx(CandidateIdx);
+		if (IsInRenderGroup(Out, EdgeIdx)) LayOutEdge(Out, EdgeIdx);
+	}
+
+	check(Out.SplineControlPointData.Num() <= Out.SplineControlPointData.Max());
+	check(Out.MeshIndices.Num() <= Out.MeshIndices.Max());
+
+	int32 const EndSegmentIdx = Out.SplineSegmentData.Num();
+	if (BeginSegmentIdx == EndSegmentIdx) return;
+
+	PendingTasks.Add(FKWTask<>::ConstructAndDispatchWhenReady(
+		[this, Frame = PendingBuffers, BeginEdgeIdx, EndEdgeIdx, BeginSplineIdx, BeginSegmentIdx,
+		 EndSegmentIdx]() {
+			IGV_TRACE_SCOPE("Edge Mesh Task");
+
+			FIGVEdgeMeshBuffers& Out = *Frame;
 
-			uint32 Idx = 0;
-			for (uint32 SampleIdx = 0; SampleIdx < Segment.NumSamples - 1; SampleIdx++)
 			{
-				for (uint32 SideIdx = 0; SideIdx < NumSides; SideIdx++)
+				SCOPE_CYCLE_COUNTER(STAT_IGV_ControlPointUpdate);
+
+				int32 SplineIdx = BeginSplineIdx;
+				for (int32 CandidateIdx = BeginEdgeIdx; CandidateIdx < EndEdgeIdx; CandidateIdx++)
 				{
-					uint32 const TopLeft =
-						SegmentMeshVertexBufferOffset + GetVertexIdx(NumSides, SampleIdx, SideIdx);
-					uint32 const BottomLeft = SegmentMeshVertexBufferOffset +
-											  GetVertexIdx(NumSides, SampleIdx, SideIdx + 1);
-					uint32 const TopRight = SegmentMeshVertexBufferOffset +
-											GetVertexIdx(NumSides, SampleIdx + 1, SideIdx);
-					uint32 const BottomRight = SegmentMeshVertexBufferOffset +
-											   GetVertexIdx(NumSides, SampleIdx + 1, SideIdx + 1);
-
-					MeshIndices[SegmentMeshIndexBufferOffset + Idx] = TopLeft;
-					MeshIndices[SegmentMeshIndexBufferOffset + Idx + 1] = BottomLeft;
-					MeshIndices[SegmentMeshIndexBufferOffset + Idx + 2] = TopRight;
-
-					MeshIndices[SegmentMeshIndexBufferOffset + Idx + 3] = TopRight;
-					MeshIndices[SegmentMeshIndexBufferOffset + Idx + 4] = BottomLeft;
-					MeshIndices[SegmentMeshIndexBufferOffset + Idx + 5] = BottomRight;
-
-					Idx += 6;
+					int32 const EdgeIdx = GetCandidateEdgeIdx(CandidateIdx);
+					if (!IsInRenderGroup(Out, EdgeIdx)) continue;
+
+					FillSplineControlPoints(Out, EdgeIdx, Out.SplineData[SplineIdx]);
+					SplineIdx++;
+				}
+			}
+
+			{
+				SCOPE_CYCLE_COUNTER(STAT_IGV_IndexBuild);
+
+				for (int32 SegmentIdx = BeginSegmentIdx; SegmentIdx < EndSegmentIdx; SegmentIdx++)
+				{
+					FillSegmentMeshIndices(Out, Out.SplineSegmentData[SegmentIdx]);
 				}
 			}
 		}));
+}
+
+bool UIGVEdgeMeshComponent::ArePendingTasksComplete() const
+{
+	for (FGraphEventRef const& Task : PendingTasks)
+	{
+		if (!Task->IsComplete()) return false;
 	}
-	FTaskGraphInterface::Get().WaitUntilTasksComplete(Tasks);
+	return true;
+}
+
+bool UIGVEdgeMeshComponent::PatchEdges(TArray<int32> const& EdgeIdxs)
+{
+	check(RenderGroup == EIGVEdgeRenderGroup::Default);
 
-	check(NumMeshIndices == MeshIndices.Num());
+	if (!Buffers.IsValid() || bIncrementalUpdateInProgress) return false;
+	if (Buffers->NumUnusedMeshVertices * 2 > Buffers->NumMeshVertices) return false;
 
-	MarkRenderStateDirty();
+	SCOPE_CYCLE_COUNTER(STAT_IGV_EdgeMeshLayout);
+	IGV_TRACE_SCOPE("Edge Mesh Patch");
+	INC_DWORD_STAT_BY(STAT_IGV_NumDefaultEdgesLaidOut, EdgeIdxs.Num());
+
+	// The shown buffers may still be read by the render thread, so the edits go to another frame.
+	FIGVEdgeMeshBuffersPtr const NewBuffers = AcquireBuffers();
+	CopyShownBuffers(*NewBuffers);
+	FIGVEdgeMeshBuffers& Out = *NewBuffers;
+
+	// Of the appended edges
+	int32 const BeginControlPointIdx = Out.SplineControlPointData.Num();
+	int32 const BeginSegmentIdx = Out.SplineSegmentData.Num();
+	int32 const BeginSplineIdx = Out.SplineData.Num();
+	int32 const BeginMeshIndexIdx = Out.MeshIndices.Num();
+
+	FIGVEdgeMeshSpans Spans;
+
+	FIGVEdgeStore& Store = GraphActor->EdgeStore;
+
+	for (int32 const EdgeIdx : EdgeIdxs)
+	{
+		// Bundles are formed again by the next full update. Until then, an edge stays in its
+		// bundle as long as it spans the bundle height.
+		if (Out.BundledEdges[EdgeIdx])
+		{
+			if (GraphActor->Edges[EdgeIdx].LowestCommonAncestor->Height >= GetMinBundleHeight())
+			{
+				continue;
+			}
+			Out.BundledEdges[EdgeIdx] = false;
+		}
+
+		FIGVEdgeMeshRange const& MeshRange = Out.MeshRanges[EdgeIdx];
+		uint32 const NumControlPoints = Store.GetNumControlPoints(EdgeIdx) + 4;
+
+		bool const bHasRange =
+			MeshRange.IndexBufferSize > 0 && Out.SplineData.IsValidIndex(MeshRange.SplineIdx);
+		if (bHasRange && Out.SplineData[MeshRange.SplineIdx].NumControlPoints == NumControlPoints)
+		{
+			FIGVEdgeSplineData& Spline = Out.SplineData[MeshRange.SplineIdx];
+			Spline = MakeSplineData(EdgeIdx, Spline.BeginControlPointIdx, Spline.NumControlPoints,
+									Spline.MeshVertexBufferOffset);
+
+			FIGVEdgeMeshSpans::Add(Spans.Splines, MeshRange.SplineIdx, MeshRange.SplineIdx + 1);
+			FIGVEdgeMeshSpans::Add(Spans.ControlPoints, Spline.BeginControlPointIdx,
+								   Spline.BeginControlPointIdx + Spline.NumControlPoints);
+		}
+		else
+		{
+			if (bHasRange) Out.NumUnusedMeshVertices += MeshRange.VertexBufferSize;
+			LayOutEdge(Out, EdgeIdx);
+		}
+
+		FillSplineControlPoints(Out, EdgeIdx, Out.SplineData[MeshRange.SplineIdx]);
+	}
+
+	for (int32 SegmentIdx = BeginSegmentIdx; SegmentIdx < Out.SplineSegmentData.Num(); SegmentIdx++)
+	{
+		FillSegmentMeshIndices(Out, Out.SplineSegmentData[SegmentIdx]);
+	}
+
+	check(Out.NumMeshIndices == Out.MeshIndices.Num());
+
+	FIGVEdgeMeshSpans::Add(Spans.ControlPoints, BeginControlPointIdx,
+						   Out.SplineControlPointData.Num());
+	FIGVEdgeMeshSpans::Add(Spans.Segments, BeginSegmentIdx, Out.SplineSegmentData.Num());
+	FIGVEdgeMeshSpans::Add(Spans.Splines, BeginSplineIdx, Out.SplineData.Num());
+	FIGVEdgeMeshSpans::Add(Spans.MeshIndices, BeginMeshIndexIdx, Out.MeshIndices.Num());
+
+	Out.Version = ++LastVersion;
+	Patches.Add(FPatch{Out.Version, MoveTemp(Spans)});
+	if (Patches.Num() > MaxNumPatches) Patches.RemoveAt(0);
+
+	// Appended edges that do not fit into the GPU buffers need a new scene proxy, which uploads
+	// the whole frame. Otherwise the current one only uploads the spans patched since the frame
+	// it was last sent.
+	bool const bIsInCapacity = Out.IsInCapacity();
+	if (!bIsInCapacity) Out.SetCapacity(PatchSlack);
+
+	Buffers = NewBuffers;
+
+	Out.PatchedSpans.Reset();
+	Out.BaseVersion =
+		bIsInCapacity && CollectPatchedSpans(SentVersion, Out.PatchedSpans) ? SentVersion : 0;
+
+	UpdateBufferMemoryStat();
+	MarkDrawStateDirty();
+	UpdateDrawState();
+
+	if (!bIsInCapacity) MarkRenderStateDirty();
 
-	// IGV_LOG(Log, TEXT("UIGVEdgeMeshComponent::Update (%s) NumSplineSegmentData=%d"),
-	// 		*UEnum::GetValueAsString(TEXT("ImsvGraphVis.EIGVEdgeRenderGroup"), RenderGroup),
-	// 		SplineSegmentData.Num());
+	return true;
+}
+
+void UIGVEdgeMeshComponent::AddEdge()
+{
+	check(RenderGroup == EIGVEdgeRenderGroup::Default);
+
+	auto AddEdgeTo = [](FIGVEdgeMeshBuffers* const Frame) {
+		if (Frame == nullptr) return;
+
+		Frame->MeshRanges.AddDefaulted();
+		Frame->BundledEdges.Add(false);
+	};
+
+	AddEdgeTo(Buffers.Get());
+	AddEdgeTo(PendingBuffers.Get());
+}
+
+void UIGVEdgeMeshComponent::RemoveEdge(int32 const EdgeIdx)
+{
+	check(RenderGroup == EIGVEdgeRenderGroup::Default);
+
+	// The per-edge state follows the edge indices, in the shown buffers too. The render thread
+	// only reads the draw state taken from them.
+	auto RemoveEdgeFrom = [EdgeIdx](FIGVEdgeMeshBuffers* const Frame) {
+		if (Frame == nullptr || !Frame->MeshRanges.IsValidIndex(EdgeIdx)) return;
+
+		FIGVEdgeMeshRange const& MeshRange = Frame->MeshRanges[EdgeIdx];
+		if (MeshRange.IndexBufferSize > 0)
+		{
+			Frame->NumUnusedMeshVertices += MeshRange.VertexBufferSize;
+		}
+		Frame->MeshRanges.RemoveAtSwap(EdgeIdx, 1, false);
+
+		// A bundle keeps the cross-section of the removed edge until the next full update.
+		int32 const LastEdgeIdx = Frame->BundledEdges.Num() - 1;
+		Frame->BundledEdges[EdgeIdx] = bool(Frame->BundledEdges[LastEdgeIdx]);
+		Frame->BundledEdges.RemoveAt(LastEdgeIdx);
+	};
+
+	RemoveEdgeFrom(Buffers.Get());
+	RemoveEdgeFrom(PendingBuffers.Get());
+	MarkDrawStateDirty();
+}
+
+void UIGVEdgeMeshComponent::MarkDrawStateDirty()
+{
+	bUpdateDrawStateRequired = true;
+}
+
+void UIGVEdgeMeshComponent::UpdateDrawState()
+{
+	check(RenderGroup == EIGVEdgeRenderGroup::Default);
+
+	if (!bUpdateDrawStateRequired || !Buffers.IsValid()) return;
+	bUpdateDrawStateRequired = false;
+
+	// Recycled once the scene proxy no longer refers to it, as the buffers are
+	if (!DrawState.IsValid() || DrawState.GetSharedReferenceCount() > 1)
+	{
+		DrawState = FIGVEdgeMeshDrawStatePtr(new FIGVEdgeMeshDrawState());
+	}
+
+	FIGVEdgeStore const& Store = GraphActor->EdgeStore;
+	TArray<FIGVEdgeMeshRange> const& MeshRanges = Buffers->MeshRanges;
+	TArray<FIGVEdgeMeshRange>& DrawnMeshRanges = DrawState->MeshRanges;
+	check(MeshRanges.Num() == Store.Num());
+	DrawnMeshRanges.Reset();
+
+	// Edges merged by the semantic zoom stay in the buffers, but are not drawn.
+	for (int32 EdgeIdx = 0, NumEdges = Store.Num(); EdgeIdx < NumEdges; EdgeIdx++)
+	{
+		if (Store.RenderGroups[EdgeIdx] == RenderGroup &&
+			!Store.HasFlags(EdgeIdx, EIGVEdgeFlags::Aggregated) &&
+			MeshRanges[EdgeIdx].IndexBufferSize > 0)
+		{
+			DrawnMeshRanges.Add(MeshRanges[EdgeIdx]);
+		}
+	}
+
+	UpdateBufferMemoryStat();
+	MarkRenderDynamicDataDirty();
+}
+
+void UIGVEdgeMeshComponent::LayOutEdge(FIGVEdgeMeshBuffers& Out, int32 const EdgeIdx) const
+{
+	FIGVEdgeStore const& Store = GraphActor->EdgeStore;
+
+	uint32 const BeginControlPointIdx = Out.SplineControlPointData.Num();
+	uint32 const EdgeMeshVertexBufferOffset = Out.NumMeshVertices;
+	uint32 const EdgeMeshIndexBufferOffset = Out.NumMeshIndices;
+	uint32 const SplineIdx = Out.SplineData.Num();
+
+	LayOutSpline(Out, SplineIdx, Store.GetNumControlPoints(EdgeIdx));
+
+	Out.SplineData.Emplace(MakeSplineData(EdgeIdx, BeginControlPointIdx,
+										  Out.SplineControlPointData.Num() - BeginControlPointIdx,
+										  EdgeMeshVertexBufferOffset));
+
+	if (RenderGroup != EIGVEdgeRenderGroup::Default) return;
+
+	FIGVEdgeMeshRange& MeshRange = Out.MeshRanges[EdgeIdx];
+	MeshRange.SplineIdx = SplineIdx;
+	MeshRange.VertexBufferOffset = EdgeMeshVertexBufferOffset;
+	MeshRange.VertexBufferSize = Out.NumMeshVertices - EdgeMeshVertexBufferOffset;
+	MeshRange.IndexBufferOffset = EdgeMeshIndexBufferOffset;
+	MeshRange.IndexBufferSize = Out.NumMeshIndices - EdgeMeshIndexBufferOffset;
+}
+
+void UIGVEdgeMeshComponent::LayOutSpline(FIGVEdgeMeshBuffers& Out, uint32 const SplineIdx,
+										 uint32 const NumSplineControlPoints) const
+{
+	uint32 const NumSides = GraphActor->EdgeNumSides;
+	uint32 const NumSegmentSamples = GraphActor->EdgeSplineResolution;
+
+	uint32 const BeginControlPointIdx = Out.SplineControlPointData.Num();
+	Out.SplineControlPointData.AddUninitialized(NumSplineControlPoints + 4);
+	Out.SplineLevelData.AddUninitialized(NumSplineControlPoints + 4);
+
+	// NumSplineControlPoints + 3 - 2. Degree - First and Last Control Point
+	uint32 const NumSplineSegments = NumSplineControlPoints + 1;
+
+	for (uint32 SegmentIdx = 0; SegmentIdx < NumSplineSegments; SegmentIdx++)
+	{
+		uint32 const SegmentMeshVertexBufferOffset = Out.NumMeshVertices;
+		uint32 const SegmentMeshIndexBufferOffset = Out.NumMeshIndices;
+
+		Out.SplineSegmentData.Emplace(
+			FIGVEdgeSplineSegmentData{SplineIdx,						  //
+									  BeginControlPointIdx + SegmentIdx,  //
+									  NumSegmentSamples,				  //
+									  SegmentMeshVertexBufferOffset,	  //
+									  SegmentMeshIndexBufferOffset});
+
+		uint32 const NumSegmentMeshIndices =
+			(NumSegmentSamples - 1) * NumSides * 6;  // Two Triangles
+		Out.MeshIndices.AddUninitialized(NumSegmentMeshIndices);
+
+		Out.NumMeshVertices += NumSides * NumSegmentSamples;
+		Out.NumMeshIndices += NumSegmentMeshIndices;  // Two Triangles
+	}
+}
+
+int32 UIGVEdgeMeshComponent::GetMinBundleHeight() const
+{
+	// The children of a cluster of height 1 are nodes, so their edges are not bundled.
+	int32 const Height = GraphActor->EdgeBundleLODHeight;
+	return Height > 0 ? FMath::Max(2, Height) : MAX_int32;
+}
+
+void UIGVEdgeMeshComponent::CollectEdgeBundles()
+{
+	check(RenderGroup == EIGVEdgeRenderGroup::Default);
+
+	PendingBundles.Reset();
+
+	FIGVEdgeStore& Store = GraphActor->EdgeStore;
+	TArray<FIGVEdge> const& Edges = GraphActor->Edges;
+	int32 const NumEdges = Store.Num();
+
+	// Applied with the pending buffers, the shown ones keep drawing the edges as before.
+	TBitArray<>& BundledEdges = PendingBuffers->BundledEdges;
+	BundledEdges.Init(false, NumEdges);
+	int32 const MinHeight = GetMinBundleHeight();
+
+	TMap<uint64, int32> BundleIdxsByClusters;
+	TArray<int32> EdgeBundleIdxs;
+	EdgeBundleIdxs.Init(INDEX_NONE, NumEdges);
+
+	for (int32 EdgeIdx = 0; EdgeIdx < NumEdges; EdgeIdx++)
+	{
+		FIGVEdge const& Edge = Edges[EdgeIdx];
+		if (Edge.LowestCommonAncestor->Height < MinHeight) continue;
+
+		// The path goes up the source ancestors and down the target ancestors.
+		TArrayView<FIGVCluster*> const Path = Store.GetPathClusters(EdgeIdx);
+		int32 const LCAIdxInPath = Edge.LowestCommonAncestorIdxInClusters;
+		int32 SourceClusterIdx = Path[LCAIdxInPath - 1]->Idx;
+		int32 TargetClusterIdx = Path[LCAIdxInPath + 1]->Idx;
+		AIGVNodeActor const* SourceNode = Edge.SourceNode;
+		AIGVNodeActor const* TargetNode = Edge.TargetNode;
+
+		// Undirected, from the cluster of the lower index
+		if (SourceClusterIdx > TargetClusterIdx)
+		{
+			Swap(SourceClusterIdx, TargetClusterIdx);
+			Swap(SourceNode, TargetNode);
+		}
+
+		uint64 const Key = (uint64(SourceClusterIdx) << 32) | uint32(TargetClusterIdx);
+		int32 const* const FoundBundleIdx = BundleIdxsByClusters.Find(Key);
+		int32 const BundleIdx = FoundBundleIdx != nullptr
+									? *FoundBundleIdx
+									: BundleIdxsByClusters.Add(Key, PendingBundles.Num());
+
+		if (FoundBundleIdx == nullptr)
+		{
+			PendingBundles.Add(FEdgeBundle{SourceClusterIdx,							//
+										   TargetClusterIdx,							//
+										   Edge.LowestCommonAncestor->Idx,			//
+										   UKWColorSpace::RGBtoHCL(SourceNode->Color),  //
+										   UKWColorSpace::RGBtoHCL(TargetNode->Color),  //
+										   0});
+		}
+
+		PendingBundles[BundleIdx].NumEdges++;
+		EdgeBundleIdxs[EdgeIdx] = BundleIdx;
+	}
+
+	// A bundle of a single edge is drawn as the edge.
+	int32 NumBundledEdges = 0;
+	for (int32 EdgeIdx = 0; EdgeIdx < NumEdges; EdgeIdx++)
+	{
+		int32 const BundleIdx = EdgeBundleIdxs[EdgeIdx];
+		if (BundleIdx == INDEX_NONE || PendingBundles[BundleIdx].NumEdges < 2) continue;
+
+		BundledEdges[EdgeIdx] = true;
+		NumBundledEdges++;
+	}
+
+	PendingBundles.RemoveAllSwap([](FEdgeBundle const& Bundle) { return Bundle.NumEdges < 2; },
+								 false);
+
+	SET_DWORD_STAT(STAT_IGV_NumEdgeBundles, PendingBundles.Num());
+	SET_DWORD_STAT(STAT_IGV_NumBundledEdges, NumBundledEdges);
+
+	if (PendingBundles.Num() > 0)
+	{
+		IGV_LOG(Verbose, TEXT("%d of %d edges drawn as %d bundles"), NumBundledEdges, NumEdges,
+				PendingBundles.Num());
+	}
+}
+
+void UIGVEdgeMeshComponent::LayOutEdgeBundles(FIGVEdgeMeshBuffers& Out) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_IGV_EdgeMeshLayout);
+	IGV_TRACE_SCOPE("Edge Bundle Layout");
+
+	TArray<FIGVCluster> const& Clusters = GraphActor->Clusters;
+
+	FIGVEdgeMeshRange& BundleMeshRange = Out.BundleMeshRange;
+	BundleMeshRange.SplineIdx = Out.SplineData.Num();
+	BundleMeshRange.VertexBufferOffset = Out.NumMeshVertices;
+	BundleMeshRange.IndexBufferOffset = Out.NumMeshIndices;
+	int32 const BeginSegmentIdx = Out.SplineSegmentData.Num();
+
+	for (FEdgeBundle const& Bundle : PendingBundles)
+	{
+		FIGVCluster const& Source = Clusters[Bundle.SourceClusterIdx];
+		FIGVCluster const& Target = Clusters[Bundle.TargetClusterIdx];
+		FIGVCluster const& Ancestor = Clusters[Bundle.LowestCommonAncestorIdx];
+
+		uint32 const BeginControlPointIdx = Out.SplineControlPointData.Num();
+		uint32 const MeshVertexBufferOffset = Out.NumMeshVertices;
+		uint32 const SplineIdx = Out.SplineData.Num();
+		uint32 const NumSplineControlPoints = Ancestor.IsRoot() ? 2 : 3;
+		LayOutSpline(Out, SplineIdx, NumSplineControlPoints);
+
+		// As an edge from one cluster to the other, see FIGVEdge::GetDefaultSplineControlPoints
+		FIGVEdgeSplineControlPointData* const ControlPoints =
+			&Out.SplineControlPointData[BeginControlPointIdx + 2];
+		FIGVEdgeSplineLevelData* const Levels = &Out.SplineLevelData[BeginControlPointIdx + 2];
+		int32 ControlPointIdx = 0;
+
+		ControlPoints[ControlPointIdx] = FIGVEdgeSplineControlPointData{Source.Pos3D, 0.f};
+		Levels[ControlPointIdx++] =
+			FIGVEdgeSplineLevelData{Source.DefaultLevel(), Source.DefaultLevel()};
+
+		if (!Ancestor.IsRoot())
+		{
+			ControlPoints[ControlPointIdx] = FIGVEdgeSplineControlPointData{Ancestor.Pos3D, .5f};
+			Levels[ControlPointIdx++] =
+				FIGVEdgeSplineLevelData{Ancestor.DefaultLevel(), Ancestor.DefaultLevel()};
+		}
+
+		ControlPoints[ControlPointIdx] = FIGVEdgeSplineControlPointData{Target.Pos3D, 1.f};
+		Levels[ControlPointIdx++] =
+			FIGVEdgeSplineLevelData{Target.DefaultLevel(), Target.DefaultLevel()};
+
+		// Of the cross-section of the edges together
+		Out.SplineData.Emplace(FIGVEdgeSplineData{Source.Pos3D,					//
+												  Target.Pos3D,					//
+												  Bundle.SourceColor_HCL,			//
+												  Bundle.TargetColor_HCL,			//
+												  GraphActor->EdgeBundlingStrength,  //
+												  BeginControlPointIdx,			//
+												  NumSplineControlPoints + 4,		//
+												  MeshVertexBufferOffset,			//
+												  FMath::Sqrt(float(Bundle.NumEdges))});
+		ClampSplineControlPoints(Out, Out.SplineData.Last());
+	}
+
+	for (int32 SegmentIdx = BeginSegmentIdx; SegmentIdx < Out.SplineSegmentData.Num(); SegmentIdx++)
+	{
+		FillSegmentMeshIndices(Out, Out.SplineSegmentData[SegmentIdx]);
+	}
+
+	BundleMeshRange.VertexBufferSize = Out.NumMeshVertices - BundleMeshRange.VertexBufferOffset;
+	BundleMeshRange.IndexBufferSize = Out.NumMeshIndices - BundleMeshRange.IndexBufferOffset;
+}
+
+FIGVEdgeSplineData UIGVEdgeMeshComponent::MakeSplineData(
+	int32 const EdgeIdx, uint32 const BeginControlPointIdx, uint32 const NumControlPoints,
+	uint32 const MeshVertexBufferOffset) const
+{
+	FIGVEdgeStore const& Store = GraphActor->EdgeStore;
+	AIGVNodeActor const& SourceNode = *GraphActor->Nodes[Store.SourceIdxs[EdgeIdx]];
+	AIGVNodeActor const& TargetNode = *GraphActor->Nodes[Store.TargetIdxs[EdgeIdx]];
+
+	return FIGVEdgeSplineData{SourceNode.Pos3D,							   //
+							  TargetNode.Pos3D,							   //
+							  UKWColorSpace::RGBtoHCL(SourceNode.Color),	   //
+							  UKWColorSpace::RGBtoHCL(TargetNode.Color),	   //
+							  GraphActor->Edges[EdgeIdx].BundlingStrength(),  //
+							  BeginControlPointIdx,						   //
+							  NumControlPoints,							   //
+							  MeshVertexBufferOffset,						   //
+							  1.f};
+}
+
+void UIGVEdgeMeshComponent::FillSplineControlPoints(FIGVEdgeMeshBuffers& Out,
+													int32 const EdgeIdx,
+													FIGVEdgeSplineData const& Spline) const
+{
+	TArray<FIGVEdgeSplineControlPointData>& ControlPoints = Out.SplineControlPointData;
+	TArray<FIGVEdgeSplineLevelData>& Levels = Out.SplineLevelData;
+
+	uint32 const I = Spline.BeginControlPointIdx;
+
+	if (RenderGroup == EIGVEdgeRenderGroup::Default)
+	{
+		GraphActor->Edges[EdgeIdx].GetDefaultSplineControlPoints(&ControlPoints[I + 2],
+																 &Levels[I + 2]);
+	}
+	else
+	{
+		FIGVEdgeStore& Store = GraphActor->EdgeStore;
+		int32 const ControlPointOffset = Store.ControlPointOffsets[EdgeIdx];
+		int32 const NumControlPoints = Store.GetNumControlPoints(EdgeIdx);
+
+		FMemory::Memcpy(&ControlPoints[I + 2], &Store.ControlPoints[ControlPointOffset],
+						sizeof(FIGVEdgeSplineControlPointData) * NumControlPoints);
+		FMemory::Memcpy(&Levels[I + 2], &Store.ControlPointLevels[ControlPointOffset],
+						sizeof(FIGVEdgeSplineLevelData) * NumControlPoints);
+	}
+
+	ClampSplineControlPoints(Out, Spline);
+}
+
+void UIGVEdgeMeshComponent::ClampSplineControlPoints(FIGVEdgeMeshBuffers& Out,
+													 FIGVEdgeSplineData const& Spline)
+{
+	TArray<FIGVEdgeSplineControlPointData>& ControlPoints = Out.SplineControlPointData;
+	TArray<FIGVEdgeSplineLevelData>& Levels = Out.SplineLevelData;
+
+	uint32 const I = Spline.BeginControlPointIdx;
+	uint32 const J = I + Spline.NumControlPoints - 1;
+
+	ControlPoints[I] = ControlPoints[I + 1] = ControlPoints[I + 2];
+	ControlPoints[J - 1] = ControlPoints[J] = ControlPoints[J - 2];
+
+	Levels[I] = Levels[I + 1] = Levels[I + 2];
+	Levels[J - 1] = Levels[J] = Levels[J - 2];
+}
+
+void UIGVEdgeMeshComponent::FillSegmentMeshIndices(FIGVEdgeMeshBuffers& Out,
+												   FIGVEdgeSplineSegmentData const& Segment) const
+{
+	FMeshIndexArray& MeshIndices = Out.MeshIndices;
+
+	uint32 const NumSides = GraphActor->EdgeNumSides;
+	uint32 const SegmentMeshVertexBufferOffset = Segment.MeshVertexBufferOffset;
+	uint32 const SegmentMeshIndexBufferOffset = Segment.MeshIndexBufferOffset;
+
+	uint32 Idx = 0;
+	for (uint32 SampleIdx = 0; SampleIdx < Segment.NumSamples - 1; SampleIdx++)
+	{
+		for (uint32 SideIdx = 0; SideIdx < NumSides; SideIdx++)
+		{
+			uint32 const TopLeft =
+				SegmentMeshVertexBufferOffset + GetVertexIdx(NumSides, SampleIdx, SideIdx);
+			uint32 const BottomLeft =
+				SegmentMeshVertexBufferOffset + GetVertexIdx(NumSides, SampleIdx, SideIdx + 1);
+			uint32 const TopRight =
+				SegmentMeshVertexBufferOffset + GetVertexIdx(NumSides, SampleIdx + 1, SideIdx);
+			uint32 const BottomRight =
+				SegmentMeshVertexBufferOffset + GetVertexIdx(NumSides, SampleIdx + 1, SideIdx + 1);
+
+			MeshIndices[SegmentMeshIndexBufferOffset + Idx] = TopLeft;
+			MeshIndices[SegmentMeshIndexBufferOffset + Idx + 1] = BottomLeft;
+			MeshIndices[SegmentMeshIndexBufferOffset + Idx + 2] = TopRight;
+
+			MeshIndices[SegmentMeshIndexBufferOffset + Idx + 3] = TopRight;
+			MeshIndices[SegmentMeshIndexBufferOffset + Idx + 4] = BottomLeft;
+			MeshIndices[SegmentMeshIndexBufferOffset + Idx + 5] = BottomRight;
+
+			Idx += 6;
+		}
+	}
+}
+
+void UIGVEdgeMeshComponent::SetTransitionAlpha(float const Alpha)
+{
+	if (TransitionAlpha == Alpha) return;
+
+	TransitionAlpha = Alpha;
+
+	if (SceneProxy)
+	{
+		GetSceneProxy()->SendTransitionAlpha(TransitionAlpha);
+	}
 }
 
 FIGVEdgeMeshSceneProxy* UIGVEdgeMeshComponent::GetSceneProxy() const
@@ -207,11 +941,30 @@ FIGVEdgeMeshSceneProxy* UIGVEdgeMeshComponent::GetSceneProxy() const
 	return (FIGVEdgeMeshSceneProxy*)SceneProxy;
 }
 
+uint32 UIGVEdgeMeshComponent::GetCPUMemorySize() const
+{
+	uint32 Size = BufferRing.GetAllocatedSize();
+	for (FIGVEdgeMeshBuffersPtr const& Entry : BufferRing)
+	{
+		Size += sizeof(FIGVEdgeMeshBuffers) + Entry->GetAllocatedSize();
+	}
+	if (DrawState.IsValid()) Size += DrawState->GetAllocatedSize();
+	return Size;
+}
+
+uint32 UIGVEdgeMeshComponent::GetGPUMemorySize() const
+{
+	return Buffers.IsValid() ? Buffers->GetGPUSize() : 0;
+}
+
 void UIGVEdgeMeshComponent::SendRenderDynamicData_Concurrent()
 {
+	IGV_TRACE_SCOPE("SendRenderDynamicData");
+
 	if (SceneProxy)
 	{
 		GetSceneProxy()->SendRenderDynamicData();
+		if (Buffers.IsValid()) SentVersion = Buffers->Version;
 	}
 }
 
@@ -226,7 +979,27 @@ FBoxSphereBounds UIGVEdgeMeshComponent::CalcBounds(const FTransform& LocalToWorl
 
 FPrimitiveSceneProxy* UIGVEdgeMeshComponent::CreateSceneProxy()
 {
-	return SplineControlPointData.Num() > 0 ? new FIGVEdgeMeshSceneProxy(this) : nullptr;
+	if (!Buffers.IsValid() || Buffers->SplineControlPointData.Num() == 0) return nullptr;
+
+	SentVersion = Buffers->Version;
+	return new FIGVEdgeMeshSceneProxy(this);
+}
+
+void UIGVEdgeMeshComponent::BeginDestroy()
+{
+	CancelIncrementalUpdate();
+	BufferRing.Empty();
+	UpdateBufferMemoryStat();
+
+	Super::BeginDestroy();
+}
+
+void UIGVEdgeMeshComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetCPUMemorySize());
+	CumulativeResourceSize.AddDedicatedVideoMemoryBytes(GetGPUMemorySize());
 }
 
 void UIGVEdgeMeshComponent::SetHalo(bool const bValue)
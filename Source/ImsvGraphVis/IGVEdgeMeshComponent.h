@@ -7,6 +7,7 @@
 
 #include "KWMeshElement.h"
 
+#include "IGVEdgeMeshBuffers.h"
 #include "IGVEdgeMeshData.h"
 #include "IGVEdgeSplineData.h"
 
@@ -23,18 +24,68 @@ public:
 	UPROPERTY()
 	TEnumAsByte<EIGVEdgeRenderGroup::Type> RenderGroup;
 
-	TArray<FIGVEdgeSplineControlPointData> SplineControlPointData;
-	TArray<FIGVEdgeSplineSegmentData> SplineSegmentData;
-	TArray<FIGVEdgeSplineData> SplineData;
+	FIGVEdgeMeshBuffersPtr Buffers;      // Shown by the scene proxy
+	FIGVEdgeMeshDrawStatePtr DrawState;  // Of Buffers, default group only
 
-	int32 NumMeshIndices;
-	int32 NumMeshVertices;
-
-	FMeshIndexArray MeshIndices;
+	float TransitionAlpha;
 
 	UPROPERTY()
 	class UMaterialInstanceDynamic* MaterialInstance;
 
+protected:
+	// Buffers are recycled through a small ring. An entry is reused once neither the component
+	// nor a scene proxy refers to it anymore, so the game thread can fill the next frame while
+	// the render thread still consumes the current one.
+	static int32 const MaxNumBuffers = 3;
+	TArray<FIGVEdgeMeshBuffersPtr> BufferRing;
+
+	// An incremental update fills PendingBuffers over multiple frames while Buffers is still
+	// shown, and hands them over once all edges are processed.
+	FIGVEdgeMeshBuffersPtr PendingBuffers;
+	uint32 BufferRingAllocatedSize;  // Reported to STAT_IGV_EdgeMeshBufferMemory
+	FGraphEventArray PendingTasks;
+	int32 NextEdgeIdx;  // Of the candidate edges
+	bool bIncrementalUpdateInProgress;
+
+	bool bUpdateDrawStateRequired;
+
+	// Default group only. Room in the GPU buffers of a full update for the edges appended by
+	// PatchEdges, as a fraction of its size.
+	static float const PatchSlack;
+
+	// Default group only. The spans written by each patch since the last full update, oldest
+	// first. A recycled frame of the same full update copies only these from the shown frame,
+	// and the scene proxy only uploads those patched since the frame it was last sent.
+	struct FPatch
+	{
+		uint32 Version;  // Of the patched frame
+		FIGVEdgeMeshSpans Spans;
+	};
+
+	static int32 const MaxNumPatches = 8;
+	TArray<FPatch> Patches;
+	uint32 LastVersion;	// Given to a frame, see FIGVEdgeMeshBuffers::Version
+	uint32 LayoutVersion;  // Of the last full update
+	uint32 SentVersion;	// Of the frame last sent to the scene proxy
+
+	// Default group only. With AIGVGraphActor::EdgeBundleLODHeight, the edges running between
+	// the same two children of a high enough lowest common ancestor are drawn as a single tube
+	// from one child to the other instead of one by one. The cross-section of the tube is that of
+	// the edges together. The edges are marked in FIGVEdgeMeshBuffers::BundledEdges of the pending
+	// frame and left out of its mesh; highlighted and remained edges are still drawn one by one by
+	// their own groups.
+	struct FEdgeBundle
+	{
+		int32 SourceClusterIdx;
+		int32 TargetClusterIdx;
+		int32 LowestCommonAncestorIdx;
+		FVector SourceColor_HCL;  // Of the endpoints of the first edge
+		FVector TargetColor_HCL;
+		int32 NumEdges;
+	};
+
+	TArray<FEdgeBundle> PendingBundles;  // Laid out after the edges of an incremental update
+
 public:
 	UIGVEdgeMeshComponent();
 
@@ -44,8 +95,47 @@ public:
 	void Setup();
 	void Update();
 
+	void BeginIncrementalUpdate();
+	// Processes edges until BudgetSeconds of the game thread time is spent, or all edges if the
+	// budget is not positive. Returns true when the update is completed and shown.
+	bool TickIncrementalUpdate(double const BudgetSeconds);
+	void CancelIncrementalUpdate();
+	bool IsIncrementalUpdateInProgress() const;
+	// Waits for the tasks of an incremental update, which read the graph, before it is edited or
+	// nodes and clusters are moved. The update goes on afterward, and the edges edited meanwhile
+	// are patched in once it is shown. See AIGVGraphActor::BeginGraphEdit and SetPos3D of
+	// AIGVNodeActor.
+	void WaitForPendingTasks();
+
+	// Default group only. Lays out the given edges on top of a copy of the shown buffers instead
+	// of all edges, after incremental graph edits. An edge with as many control points as before
+	// is refilled in place, others are appended and leave their former range unused. Only the
+	// written spans are copied into a recycled frame and uploaded, and the scene proxy is kept as
+	// long as the appended edges fit into its buffers. Returns false if a full update is due
+	// instead: nothing is shown yet, an incremental update is in progress, or half of the shown
+	// mesh is unused.
+	bool PatchEdges(TArray<int32> const& EdgeIdxs);
+	// Default group only. Called for an edge added to the graph, which is laid out by the next
+	// patch or update, and for an edge removed from it, before the last edge takes its index.
+	void AddEdge();
+	void RemoveEdge(int32 const EdgeIdx);
+
+	// Default group only. The draw state is taken again by the next UpdateDrawState, after the
+	// render group or the semantic zoom state of an edge changed.
+	void MarkDrawStateDirty();
+	void UpdateDrawState();
+
+	// Re-generates the mesh with new interpolation alpha between the spline levels before and
+	// after transition without updating any spline data.
+	void SetTransitionAlpha(float const Alpha);
+
 	class FIGVEdgeMeshSceneProxy* GetSceneProxy() const;
 
+	// All frames in the ring, including the shown and the pending ones
+	uint32 GetCPUMemorySize() const;
+	// The shown frame as uploaded to the GPU
+	uint32 GetGPUMemorySize() const;
+
 	// Begin USceneComponent interface.
 	virtual void SendRenderDynamicData_Concurrent() override;
 	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
@@ -62,5 +152,57 @@ public:
 	}
 	// End UMeshComponent interface.
 
+	// Begin UObject interface.
+	virtual void BeginDestroy() override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+	// End UObject interface.
+
 	void SetHalo(bool const bValue);
+
+protected:
+	// Edges laid out by an update, in order: every edge for the default group, which draws all
+	// but the bundled ones, and the list of the render group in the edge store otherwise. The
+	// list is only read by the tasks of the other groups, whose updates are not incremental.
+	int32 GetNumCandidateEdges() const;
+	int32 GetCandidateEdgeIdx(int32 const CandidateIdx) const;
+	bool IsInRenderGroup(FIGVEdgeMeshBuffers const& Frame, int32 const EdgeIdx) const;
+
+	FIGVEdgeMeshBuffersPtr AcquireBuffers();
+	// Brings a frame up to date with the shown one, see Patches
+	void CopyShownBuffers(FIGVEdgeMeshBuffers& Out) const;
+	// Of the patches after the given version up to the shown frame. False if the frame of the
+	// version is of another full update, or some of the patches are no longer kept.
+	bool CollectPatchedSpans(uint32 const SinceVersion, FIGVEdgeMeshSpans& OutSpans) const;
+	void UpdateBufferMemoryStat();
+	void ReservePendingBuffers();
+	// Adds up the sizes of the splines of the candidate edges in the range, as laid out in Frame
+	void CountSplines(FIGVEdgeMeshBuffers const& Frame, int32 const BeginEdgeIdx,
+					  int32 const EndEdgeIdx, int32& OutNumControlPoints, int32& OutNumSegments,
+					  int32& OutNumSplines) const;
+	int32 GetNumSegmentMeshIndices() const;
+	void DispatchPendingEdges(int32 const BeginEdgeIdx, int32 const EndEdgeIdx);
+	bool ArePendingTasksComplete() const;
+
+	// Of the lowest common ancestor of a bundled edge, MAX_int32 if edges are not bundled
+	int32 GetMinBundleHeight() const;
+	// Marks the bundled edges of PendingBuffers from the edge paths, and fills PendingBundles.
+	void CollectEdgeBundles();
+	void LayOutEdgeBundles(FIGVEdgeMeshBuffers& Out) const;
+
+	// Appends the spline and segments of the edge, and sets its mesh range in the default group.
+	// Control points and indices are filled separately.
+	void LayOutEdge(FIGVEdgeMeshBuffers& Out, int32 const EdgeIdx) const;
+	// Appends the control points and segments of a spline of SplineIdx.
+	void LayOutSpline(FIGVEdgeMeshBuffers& Out, uint32 const SplineIdx,
+					  uint32 const NumSplineControlPoints) const;
+	FIGVEdgeSplineData MakeSplineData(int32 const EdgeIdx, uint32 const BeginControlPointIdx,
+									  uint32 const NumControlPoints,
+									  uint32 const MeshVertexBufferOffset) const;
+
+	void FillSplineControlPoints(FIGVEdgeMeshBuffers& Out, int32 const EdgeIdx,
+								 FIGVEdgeSplineData const& Spline) const;
+	void FillSegmentMeshIndices(FIGVEdgeMeshBuffers& Out,
+								FIGVEdgeSplineSegmentData const& Segment) const;
+	static void ClampSplineControlPoints(FIGVEdgeMeshBuffers& Out,
+										 FIGVEdgeSplineData const& Spline);
 };
@@ -2,19 +2,11 @@
 
 #include "IGVEdgeMeshData.h"
 
-FIGVEdgeMeshData::FIGVEdgeMeshData()
+FIGVEdgeMeshRange::FIGVEdgeMeshRange()
+	: SplineIdx(INDEX_NONE),
+	  VertexBufferOffset(0),
+	  VertexBufferSize(0),
+	  IndexBufferOffset(0),
+	  IndexBufferSize(0)
 {
-	VertexBufferOffset[EIGVEdgeRenderGroup::Default] = 0;
-	VertexBufferSize[EIGVEdgeRenderGroup::Default] = 0;
-	VertexBufferOffset[EIGVEdgeRenderGroup::Highlighted] = 0;
-	VertexBufferSize[EIGVEdgeRenderGroup::Highlighted] = 0;
-	VertexBufferOffset[EIGVEdgeRenderGroup::Remained] = 0;
-	VertexBufferSize[EIGVEdgeRenderGroup::Remained] = 0;
-
-	IndexBufferOffset[EIGVEdgeRenderGroup::Default] = 0;
-	IndexBufferSize[EIGVEdgeRenderGroup::Default] = 0;
-	IndexBufferOffset[EIGVEdgeRenderGroup::Highlighted] = 0;
-	IndexBufferSize[EIGVEdgeRenderGroup::Highlighted] = 0;
-	IndexBufferOffset[EIGVEdgeRenderGroup::Remained] = 0;
-	IndexBufferSize[EIGVEdgeRenderGroup::Remained] = 0;
 }
@@ -16,12 +16,14 @@ enum Type
 };
 }
 
-struct IMSVGRAPHVIS_API FIGVEdgeMeshData
+// Range of an edge in the mesh of one render group, see FIGVEdgeMeshBuffers::MeshRanges
+struct IMSVGRAPHVIS_API FIGVEdgeMeshRange
 {
-	int32 VertexBufferOffset[EIGVEdgeRenderGroup::NumGroups];
-	int32 VertexBufferSize[EIGVEdgeRenderGroup::NumGroups];
-	int32 IndexBufferOffset[EIGVEdgeRenderGroup::NumGroups];
-	int32 IndexBufferSize[EIGVEdgeRenderGroup::NumGroups];
+	int32 SplineIdx;  // In FIGVEdgeMeshBuffers::SplineData
+	int32 VertexBufferOffset;
+	int32 VertexBufferSize;
+	int32 IndexBufferOffset;
+	int32 IndexBufferSize;
 
-	FIGVEdgeMeshData();
+	FIGVEdgeMeshRange();
 };
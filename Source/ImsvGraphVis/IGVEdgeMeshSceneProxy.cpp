@@ -6,6 +6,8 @@
 #include "IGVEdgeMeshComponent.h"
 #include "IGVGraphActor.h"
 #include "IGVLog.h"
+#include "IGVStats.h"
+#include "IGVTrace.h"
 
 FIGVEdgeMeshVertexBuffer::FIGVEdgeMeshVertexBuffer(int32 const InNumElements)
 	: NumElements(InNumElements)
@@ -19,6 +21,54 @@ void FIGVEdgeMeshVertexBuffer::InitRHI()
 	VertexBufferRHI =
 		RHICreateVertexBuffer(NumElements * sizeof(FDynamicMeshVertex),
 							  BUF_UnorderedAccess | BUF_ByteAddressBuffer, CreateInfo);
+
+	INC_MEMORY_STAT_BY(STAT_IGV_EdgeMeshGPUMemory, NumElements * sizeof(FDynamicMeshVertex));
+}
+
+void FIGVEdgeMeshVertexBuffer::ReleaseRHI()
+{
+	DEC_MEMORY_STAT_BY(STAT_IGV_EdgeMeshGPUMemory, NumElements * sizeof(FDynamicMeshVertex));
+
+	FVertexBuffer::ReleaseRHI();
+}
+
+FIGVEdgeMeshIndexBuffer::FIGVEdgeMeshIndexBuffer(FIGVEdgeMeshBuffersConstPtr const& InBuffers)
+	: Buffers(InBuffers), NumElements(InBuffers->Capacity.NumMeshIndices)
+{
+}
+
+void FIGVEdgeMeshIndexBuffer::InitRHI()
+{
+	SCOPE_CYCLE_COUNTER(STAT_IGV_EdgeBufferUpload);
+
+	checkSlow(NumElements > 0);
+	FRHIResourceCreateInfo CreateInfo;
+	IndexBufferRHI = RHICreateIndexBuffer(sizeof(int32), NumElements * sizeof(int32), BUF_Static,
+										  CreateInfo);
+
+	BufferData(Buffers->GetAllSpans().MeshIndices);
+
+	INC_MEMORY_STAT_BY(STAT_IGV_EdgeMeshGPUMemory, NumElements * sizeof(int32));
+}
+
+void FIGVEdgeMeshIndexBuffer::BufferData(TArray<FIGVEdgeMeshSpan> const& Spans)
+{
+	for (FIGVEdgeMeshSpan const& Span : Spans)
+	{
+		check(Span.End <= NumElements);
+		uint32 const Size = (Span.End - Span.Begin) * sizeof(int32);
+		void* Buffer =
+			RHILockIndexBuffer(IndexBufferRHI, Span.Begin * sizeof(int32), Size, RLM_WriteOnly);
+		FMemory::Memcpy(Buffer, Buffers->MeshIndices.GetData() + Span.Begin, Size);
+		RHIUnlockIndexBuffer(IndexBufferRHI);
+	}
+}
+
+void FIGVEdgeMeshIndexBuffer::ReleaseRHI()
+{
+	DEC_MEMORY_STAT_BY(STAT_IGV_EdgeMeshGPUMemory, NumElements * sizeof(int32));
+
+	FIndexBuffer::ReleaseRHI();
 }
 
 void FIGVEdgeMeshVertexFactory::Init(FVertexBuffer* VertexBuffer)
@@ -69,24 +119,26 @@ FIGVEdgeMeshSceneProxy::FIGVEdgeMeshSceneProxy(UIGVEdgeMeshComponent* const Comp
 	  GraphActor(Component->GraphActor),
 	  RenderGroup(Component->RenderGroup),
 
-	  SplineControlPointData(Component->SplineControlPointData),
-	  SplineSegmentData(Component->SplineSegmentData),
-	  SplineData(Component->SplineData),
+	  Buffers(Component->Buffers),
+	  DrawState(Component->DrawState),
+	  Capacity(Component->Buffers->Capacity),
 
 	  InSplineControlPointBuffer(nullptr),
+	  InSplineLevelBuffer(nullptr),
 	  InSplineSegmentBuffer(nullptr),
 	  InSplineBuffer(nullptr),
 
 	  InSplineControlPointBufferSRV(nullptr),
+	  InSplineLevelBufferSRV(nullptr),
 	  InSplineSegmentBufferSRV(nullptr),
 	  InSplineBufferSRV(nullptr),
 	  OutMeshVertexBufferUAV(nullptr),
+	  StructuredBufferSize(0),
 
-	  bIsComputeShaderExecuting(false),
 	  bIsComputeShaderUnloading(false),
 
-	  VertexBuffer(Component->NumMeshVertices),
-	  IndexBuffer(Component->MeshIndices),
+	  VertexBuffer(Capacity.NumMeshVertices),
+	  IndexBuffer(Buffers),
 
 	  Material(Component->GetMaterial(0)),
 	  MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel())),
@@ -106,7 +158,7 @@ FIGVEdgeMeshSceneProxy::FIGVEdgeMeshSceneProxy(UIGVEdgeMeshComponent* const Comp
 		Material = UMaterial::GetDefaultMaterial(MD_Surface);
 	}
 
-	if (SplineControlPointData.Num() > 0)
+	if (Buffers->SplineControlPointData.Num() > 0)
 	{
 		ComputeMesh();
 	}
@@ -125,7 +177,9 @@ bool FIGVEdgeMeshSceneProxy::CanBeOccluded() const
 
 uint32 FIGVEdgeMeshSceneProxy::GetAllocatedSize() const
 {
-	return FPrimitiveSceneProxy::GetAllocatedSize();
+	// The frame is shared with the component, but is kept alive by this proxy as long as shown.
+	return FPrimitiveSceneProxy::GetAllocatedSize() +
+		   (Buffers.IsValid() ? Buffers->GetAllocatedSize() : 0);
 }
 
 uint32 FIGVEdgeMeshSceneProxy::GetMemoryFootprint() const
@@ -133,24 +187,70 @@ uint32 FIGVEdgeMeshSceneProxy::GetMemoryFootprint() const
 	return sizeof(*this) + GetAllocatedSize();
 }
 
-void FIGVEdgeMeshSceneProxy::SendRenderDynamicData()
+uint32 FIGVEdgeMeshSceneProxy::GetGPUMemorySize() const
 {
-	SplineControlPointData = IGVEdgeMeshComponent->SplineControlPointData;
-	SplineSegmentData = IGVEdgeMeshComponent->SplineSegmentData;
-	SplineData = IGVEdgeMeshComponent->SplineData;
-
-	// TODO: is this required code?
-	IndexBuffer.Indices = IGVEdgeMeshComponent->MeshIndices;
+	return VertexBuffer.NumElements * sizeof(FDynamicMeshVertex) +
+		   IndexBuffer.NumElements * sizeof(int32) + StructuredBufferSize;
+}
 
-	ENQUEUE_UNIQUE_RENDER_COMMAND_ONEPARAMETER(FSendIGVEdgeMeshSceneProxyDynamicData,
-											   FIGVEdgeMeshSceneProxy&, Self, *this,
-											   { Self.SendRenderDynamicData_RenderThread(); });
+void FIGVEdgeMeshSceneProxy::SendRenderDynamicData()
+{
+	// Buffers of a different capacity require a new proxy. See UIGVEdgeMeshComponent.
+	FIGVEdgeMeshBuffersConstPtr const& NewBuffers = IGVEdgeMeshComponent->Buffers;
+	if (!NewBuffers.IsValid() || NewBuffers->Capacity != Capacity) return;
+
+	// Handed over together, the draw state refers to the ranges of these buffers.
+	FIGVEdgeMeshDrawStateConstPtr const NewDrawState = IGVEdgeMeshComponent->DrawState;
+	ENQUEUE_UNIQUE_RENDER_COMMAND_FOURPARAMETER(
+		FSendIGVEdgeMeshSceneProxyDynamicData, FIGVEdgeMeshSceneProxy&, Self, *this,
+		FIGVEdgeMeshBuffersConstPtr, NewBuffers, NewBuffers, FIGVEdgeMeshDrawStateConstPtr,
+		NewDrawState, NewDrawState, FSplineComputeShaderUniformParameters, Parameters,
+		MakeSplineComputeShaderParameters(),
+		{ Self.SendRenderDynamicData_RenderThread(NewBuffers, NewDrawState, Parameters); });
+}
 
-	ComputeMesh();
+void FIGVEdgeMeshSceneProxy::SendRenderDynamicData_RenderThread(
+	FIGVEdgeMeshBuffersConstPtr const& NewBuffers,
+	FIGVEdgeMeshDrawStateConstPtr const& NewDrawState,
+	FSplineComputeShaderUniformParameters const& Parameters)
+{
+	IGV_TRACE_SCOPE("SendRenderDynamicData_RenderThread");
+
+	// Only the draw state changes with the render groups. Decided here rather than on the game
+	// thread, which may run a frame ahead: every frame of buffers is uploaded before it is drawn.
+	bool const bBuffersChanged = NewBuffers != Buffers;
+	// The GPU buffers hold the frame the new one was patched from, see
+	// UIGVEdgeMeshComponent::PatchEdges. Frames may be skipped, which upload as a whole.
+	bool const bIsPatched = bBuffersChanged && Buffers.IsValid() && NewBuffers->BaseVersion != 0 &&
+							NewBuffers->BaseVersion == Buffers->Version &&
+							InSplineControlPointBuffer != nullptr;
+
+	// The previous frame is released here, and can be reused by the component.
+	Buffers = NewBuffers;
+	DrawState = NewDrawState;
+
+	if (bIsPatched)
+	{
+		SplineComputeShaderUniformParameters = Parameters;
+		IndexBuffer.BufferData(Buffers->PatchedSpans.MeshIndices);
+		UploadBuffers_RenderThread(Buffers->PatchedSpans);
+		DispatchComputeShader_RenderThread();
+	}
+	else if (bBuffersChanged)
+	{
+		IndexBuffer.BufferData(Buffers->GetAllSpans().MeshIndices);
+		ComputeMesh_RenderThread(Parameters);
+	}
 }
 
-void FIGVEdgeMeshSceneProxy::SendRenderDynamicData_RenderThread()
+void FIGVEdgeMeshSceneProxy::SendTransitionAlpha(float const Alpha)
 {
+	ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
+		FSendIGVEdgeMeshTransitionAlpha, FIGVEdgeMeshSceneProxy*, Self, this, float const,
+		TransitionAlpha, Alpha, {
+			Self->SplineComputeShaderUniformParameters.TransitionAlpha = TransitionAlpha;
+			Self->DispatchComputeShader_RenderThread();
+		});
 }
 
 void FIGVEdgeMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
@@ -158,6 +258,8 @@ void FIGVEdgeMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneVie
 													uint32 VisibilityMap,
 													class FMeshElementCollector& Collector) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_IGV_BatchAssembly);
+
 	bool const bWireframe = AllowDebugViewmodes() && ViewFamily.EngineShowFlags.Wireframe;
 
 	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
@@ -170,23 +272,38 @@ void FIGVEdgeMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneVie
 			{
 				if (RenderGroup == EIGVEdgeRenderGroup::Default)
 				{
-					for (FIGVEdge& Edge : GraphActor->Edges)
+					TArray<FIGVEdgeMeshRange> const& MeshRanges = GetDrawnMeshRanges();
+
+					for (FIGVEdgeMeshRange const& MeshRange : MeshRanges)
 					{
-						if (Edge.RenderGroup == RenderGroup)
+						if (IsInBuffers(MeshRange))
 						{
 							FMeshBatch& Mesh = Collector.AllocateMesh();
 							SetMesh(Mesh, bWireframe);
-							SetMeshBatchElement(Mesh.Elements[0], &Edge.MeshData);
+							SetMeshBatchElement(Mesh.Elements[0], MeshRange);
 							Collector.AddMesh(ViewIndex, Mesh);
+							INC_DWORD_STAT(STAT_IGV_NumBatchElements);
 						}
 					}
+
+					// Bundled edges, see UIGVEdgeMeshComponent
+					if (IsInBuffers(Buffers->BundleMeshRange))
+					{
+						FMeshBatch& Mesh = Collector.AllocateMesh();
+						SetMesh(Mesh, bWireframe);
+						SetMeshBatchElement(Mesh.Elements[0], Buffers->BundleMeshRange);
+						Collector.AddMesh(ViewIndex, Mesh);
+						INC_DWORD_STAT(STAT_IGV_NumBatchElements);
+					}
 				}
 				else
 				{
 					FMeshBatch& Mesh = Collector.AllocateMesh();
-					if (SetMeshBatchElements(Mesh, bWireframe))
+					int32 const NumBatchElements = SetMeshBatchElements(Mesh, bWireframe);
+					if (NumBatchElements > 0)
 					{
 						Collector.AddMesh(ViewIndex, Mesh);
+						INC_DWORD_STAT_BY(STAT_IGV_NumBatchElements, NumBatchElements);
 					}
 				}
 			}
@@ -196,12 +313,16 @@ void FIGVEdgeMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneVie
 
 void FIGVEdgeMeshSceneProxy::DrawStaticElements(FStaticPrimitiveDrawInterface* PDI)
 {
+	SCOPE_CYCLE_COUNTER(STAT_IGV_BatchAssembly);
+
 	if (VertexBuffer.NumElements > 0)
 	{
 		FMeshBatch Mesh;
-		if (SetMeshBatchElements(Mesh, false) > 0)
+		int32 const NumBatchElements = SetMeshBatchElements(Mesh, false);
+		if (NumBatchElements > 0)
 		{
 			PDI->DrawMesh(Mesh, FLT_MAX);
+			INC_DWORD_STAT_BY(STAT_IGV_NumBatchElements, NumBatchElements);
 		}
 	}
 }
@@ -241,24 +362,31 @@ int32 FIGVEdgeMeshSceneProxy::SetMeshBatchElements(FMeshBatch& Mesh, bool const
 	{
 		FMeshBatchElement* BatchElement = nullptr;
 
-		for (FIGVEdge& Edge : GraphActor->Edges)
+		// Runs of consecutive drawn edges with adjacent ranges are merged into a single batch
+		// element. Ranges of patched edges are not adjacent to their neighbors.
+		for (FIGVEdgeMeshRange const& MeshRange : GetDrawnMeshRanges())
 		{
-			// if (Edge.bHidden) continue;
-			if (Edge.RenderGroup == RenderGroup)
+			if (IsInBuffers(MeshRange))
 			{
-				FIGVEdgeMeshData& MeshData = Edge.MeshData;
+				if (BatchElement != nullptr &&
+					BatchElement->FirstIndex + BatchElement->NumPrimitives * 3 !=
+						uint32(MeshRange.IndexBufferOffset))
+				{
+					BatchElement = nullptr;
+				}
 
 				if (BatchElement == nullptr)
 				{
 					BatchElement = (NumBatchElement > 0) ? (new (Mesh.Elements) FMeshBatchElement)
 														 : &Mesh.Elements[0];
-					SetMeshBatchElement(*BatchElement, &MeshData);
+					SetMeshBatchElement(*BatchElement, MeshRange);
 					NumBatchElement++;
 				}
 				else
 				{
-					BatchElement->NumPrimitives += MeshData.IndexBufferSize[RenderGroup] / 3;
-					BatchElement->MaxVertexIndex += MeshData.IndexBufferSize[RenderGroup];
+					BatchElement->NumPrimitives += MeshRange.IndexBufferSize / 3;
+					BatchElement->MaxVertexIndex =
+						MeshRange.VertexBufferOffset + MeshRange.VertexBufferSize - 1;
 				}
 			}
 			else
@@ -266,6 +394,14 @@ int32 FIGVEdgeMeshSceneProxy::SetMeshBatchElements(FMeshBatch& Mesh, bool const
 				BatchElement = nullptr;
 			}
 		}
+
+		if (IsInBuffers(Buffers->BundleMeshRange))
+		{
+			BatchElement = (NumBatchElement > 0) ? (new (Mesh.Elements) FMeshBatchElement)
+												 : &Mesh.Elements[0];
+			SetMeshBatchElement(*BatchElement, Buffers->BundleMeshRange);
+			NumBatchElement++;
+		}
 	}
 	else
 	{
@@ -283,16 +419,29 @@ int32 FIGVEdgeMeshSceneProxy::SetMeshBatchElements(FMeshBatch& Mesh, bool const
 }
 
 void FIGVEdgeMeshSceneProxy::SetMeshBatchElement(FMeshBatchElement& BatchElement,
-												 FIGVEdgeMeshData* const MeshData) const
+												 FIGVEdgeMeshRange const& MeshRange) const
 {
 	BatchElement.IndexBuffer = &IndexBuffer;
 	BatchElement.PrimitiveUniformBuffer = PrimitiveUniformBuffer;
 
-	BatchElement.FirstIndex = MeshData->IndexBufferOffset[RenderGroup];
-	BatchElement.NumPrimitives = MeshData->IndexBufferSize[RenderGroup] / 3;
-	BatchElement.MinVertexIndex = MeshData->VertexBufferOffset[RenderGroup];
-	BatchElement.MaxVertexIndex =
-		MeshData->VertexBufferOffset[RenderGroup] + MeshData->VertexBufferSize[RenderGroup] - 1;
+	BatchElement.FirstIndex = MeshRange.IndexBufferOffset;
+	BatchElement.NumPrimitives = MeshRange.IndexBufferSize / 3;
+	BatchElement.MinVertexIndex = MeshRange.VertexBufferOffset;
+	BatchElement.MaxVertexIndex = MeshRange.VertexBufferOffset + MeshRange.VertexBufferSize - 1;
+}
+
+TArray<FIGVEdgeMeshRange> const& FIGVEdgeMeshSceneProxy::GetDrawnMeshRanges() const
+{
+	static TArray<FIGVEdgeMeshRange> const NoMeshRanges;
+	return DrawState.IsValid() ? DrawState->MeshRanges : NoMeshRanges;
+}
+
+bool FIGVEdgeMeshSceneProxy::IsInBuffers(FIGVEdgeMeshRange const& MeshRange) const
+{
+	// The draw state is taken from the ranges of these buffers, see UIGVEdgeMeshComponent.
+	return MeshRange.IndexBufferSize > 0 &&
+		   MeshRange.IndexBufferOffset + MeshRange.IndexBufferSize <= IndexBuffer.NumElements &&
+		   MeshRange.VertexBufferOffset + MeshRange.VertexBufferSize <= VertexBuffer.NumElements;
 }
 
 void FIGVEdgeMeshSceneProxy::ReleaseBuffers()
@@ -302,6 +451,11 @@ void FIGVEdgeMeshSceneProxy::ReleaseBuffers()
 		InSplineControlPointBuffer.SafeRelease();
 	}
 
+	if (InSplineLevelBuffer != nullptr)
+	{
+		InSplineLevelBuffer.SafeRelease();
+	}
+
 	if (InSplineSegmentBuffer != nullptr)
 	{
 		InSplineSegmentBuffer.SafeRelease();
@@ -317,6 +471,11 @@ void FIGVEdgeMeshSceneProxy::ReleaseBuffers()
 		InSplineControlPointBufferSRV.SafeRelease();
 	}
 
+	if (InSplineLevelBufferSRV != nullptr)
+	{
+		InSplineLevelBufferSRV.SafeRelease();
+	}
+
 	if (InSplineSegmentBufferSRV != nullptr)
 	{
 		InSplineSegmentBufferSRV.SafeRelease();
@@ -331,27 +490,45 @@ void FIGVEdgeMeshSceneProxy::ReleaseBuffers()
 	{
 		OutMeshVertexBufferUAV.SafeRelease();
 	}
+
+	DEC_MEMORY_STAT_BY(STAT_IGV_EdgeMeshGPUMemory, StructuredBufferSize);
+	StructuredBufferSize = 0;
 }
 void FIGVEdgeMeshSceneProxy::CreateBuffers()
 {
 	uint32 const SplineControlPointBufferByteSize =
-		sizeof(FIGVEdgeSplineControlPointData) * SplineControlPointData.Num();
+		sizeof(FIGVEdgeSplineControlPointData) * Capacity.NumControlPoints;
+	uint32 const SplineLevelBufferByteSize =
+		sizeof(FIGVEdgeSplineLevelData) * Capacity.NumControlPoints;
 	uint32 const SplineSegmentBufferByteSize =
-		sizeof(FIGVEdgeSplineSegmentData) * SplineSegmentData.Num();
-	uint32 const SplineBufferByteSize = sizeof(FIGVEdgeSplineData) * SplineData.Num();
+		sizeof(FIGVEdgeSplineSegmentData) * Capacity.NumSegments;
+	uint32 const SplineBufferByteSize = sizeof(FIGVEdgeSplineData) * Capacity.NumSplines;
+
+	uint32 const LastStructuredBufferSize = StructuredBufferSize;
 
 	FRHIResourceCreateInfo CreateInfo;
 
 	if (!(InSplineControlPointBuffer != nullptr))
 	{
+		StructuredBufferSize += SplineControlPointBufferByteSize;
 		InSplineControlPointBuffer = RHICreateStructuredBuffer(
 			sizeof(FIGVEdgeSplineControlPointData), SplineControlPointBufferByteSize,
 			BUF_ShaderResource, CreateInfo);
 		InSplineControlPointBufferSRV = RHICreateShaderResourceView(InSplineControlPointBuffer);
 	}
 
+	if (!(InSplineLevelBuffer != nullptr))
+	{
+		StructuredBufferSize += SplineLevelBufferByteSize;
+		InSplineLevelBuffer =
+			RHICreateStructuredBuffer(sizeof(FIGVEdgeSplineLevelData), SplineLevelBufferByteSize,
+									  BUF_ShaderResource, CreateInfo);
+		InSplineLevelBufferSRV = RHICreateShaderResourceView(InSplineLevelBuffer);
+	}
+
 	if (!(InSplineSegmentBuffer != nullptr))
 	{
+		StructuredBufferSize += SplineSegmentBufferByteSize;
 		InSplineSegmentBuffer =
 			RHICreateStructuredBuffer(sizeof(FIGVEdgeSplineSegmentData),
 									  SplineSegmentBufferByteSize, BUF_ShaderResource, CreateInfo);
@@ -360,6 +537,7 @@ void FIGVEdgeMeshSceneProxy::CreateBuffers()
 
 	if (!(InSplineBuffer != nullptr))
 	{
+		StructuredBufferSize += SplineBufferByteSize;
 		InSplineBuffer = RHICreateStructuredBuffer(sizeof(FIGVEdgeSplineData), SplineBufferByteSize,
 												   BUF_ShaderResource, CreateInfo);
 		InSplineBufferSRV = RHICreateShaderResourceView(InSplineBuffer);
@@ -370,55 +548,74 @@ void FIGVEdgeMeshSceneProxy::CreateBuffers()
 		OutMeshVertexBufferUAV =
 			RHICreateUnorderedAccessView(VertexBuffer.VertexBufferRHI, PF_R32_UINT);
 	}
+
+	INC_MEMORY_STAT_BY(STAT_IGV_EdgeMeshGPUMemory,
+					   StructuredBufferSize - LastStructuredBufferSize);
 }
 
 void FIGVEdgeMeshSceneProxy::ComputeMesh()
 {
-	if (bIsComputeShaderUnloading || bIsComputeShaderExecuting)
-	{
-		return;
-	}
+	ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
+		FSendIGVEdgeMeshDynamicData, FIGVEdgeMeshSceneProxy&, Self, *this,
+		FSplineComputeShaderUniformParameters, Parameters, MakeSplineComputeShaderParameters(),
+		{ Self.ComputeMesh_RenderThread(Parameters); });
+}
 
-	bIsComputeShaderExecuting = true;
+FSplineComputeShaderUniformParameters
+FIGVEdgeMeshSceneProxy::MakeSplineComputeShaderParameters() const
+{
+	FSplineComputeShaderUniformParameters Parameters;
+	Parameters.WorldSize = GraphActor->GetSphereRadius();
+	Parameters.Width = GraphActor->EdgeWidth * 0.5;
+	Parameters.NumSides = GraphActor->EdgeNumSides;
+	Parameters.TransitionAlpha = IGVEdgeMeshComponent->TransitionAlpha;
+	return Parameters;
+}
 
-	SplineComputeShaderUniformParameters.WorldSize = GraphActor->GetSphereRadius();
-	SplineComputeShaderUniformParameters.Width = GraphActor->EdgeWidth * 0.5;
-	SplineComputeShaderUniformParameters.NumSides = GraphActor->EdgeNumSides;
+void FIGVEdgeMeshSceneProxy::ComputeMesh_RenderThread(
+	FSplineComputeShaderUniformParameters const& Parameters)
+{
+	check(IsInRenderingThread());
+	IGV_TRACE_SCOPE("ComputeMesh_RenderThread");
+
+	SplineComputeShaderUniformParameters = Parameters;
+
+	CreateBuffers();
+	UploadBuffers_RenderThread(Buffers->GetAllSpans());
+
+	DispatchComputeShader_RenderThread();
+}
 
-	ENQUEUE_UNIQUE_RENDER_COMMAND_ONEPARAMETER(FSendIGVEdgeMeshDynamicData, FIGVEdgeMeshSceneProxy&,
-											   Self, *this, { Self.ComputeMesh_RenderThread(); });
+// Writes the elements of the spans over the same elements of the structured buffer
+template <typename ElementType>
+static void UploadSpans(FStructuredBufferRHIRef const& BufferRHI,
+						TArray<ElementType> const& Elements, TArray<FIGVEdgeMeshSpan> const& Spans)
+{
+	for (FIGVEdgeMeshSpan const& Span : Spans)
+	{
+		uint32 const Size = (Span.End - Span.Begin) * sizeof(ElementType);
+		void* Buffer = RHILockStructuredBuffer(BufferRHI, Span.Begin * sizeof(ElementType), Size,
+											   RLM_WriteOnly);
+		FMemory::Memcpy(Buffer, Elements.GetData() + Span.Begin, Size);
+		RHIUnlockStructuredBuffer(BufferRHI);
+	}
 }
 
-void FIGVEdgeMeshSceneProxy::ComputeMesh_RenderThread()
+void FIGVEdgeMeshSceneProxy::UploadBuffers_RenderThread(FIGVEdgeMeshSpans const& Spans)
 {
 	check(IsInRenderingThread());
+	SCOPE_CYCLE_COUNTER(STAT_IGV_EdgeBufferUpload);
+	INC_DWORD_STAT(STAT_IGV_NumEdgeMeshUploads);
 
-	CreateBuffers();
+	UploadSpans(InSplineControlPointBuffer, Buffers->SplineControlPointData, Spans.ControlPoints);
+	UploadSpans(InSplineLevelBuffer, Buffers->SplineLevelData, Spans.ControlPoints);
+	UploadSpans(InSplineSegmentBuffer, Buffers->SplineSegmentData, Spans.Segments);
+	UploadSpans(InSplineBuffer, Buffers->SplineData, Spans.Splines);
+}
 
-	uint32 const SplineControlPointBufferByteSize =
-		sizeof(FIGVEdgeSplineControlPointData) * SplineControlPointData.Num();
-	uint32 const SplineSegmentBufferByteSize =
-		sizeof(FIGVEdgeSplineSegmentData) * SplineSegmentData.Num();
-	uint32 const SplineBufferByteSize = sizeof(FIGVEdgeSplineData) * SplineData.Num();
-
-	// Spline Control Points
-	void* SplineControlPointBuffer = RHILockStructuredBuffer(
-		InSplineControlPointBuffer, 0, SplineControlPointBufferByteSize, RLM_WriteOnly);
-	FMemory::Memcpy(SplineControlPointBuffer, SplineControlPointData.GetData(),
-					SplineControlPointBufferByteSize);
-	RHIUnlockStructuredBuffer(InSplineControlPointBuffer);
-
-	// Spline Segments
-	void* SplineSegmentBuffer = RHILockStructuredBuffer(InSplineSegmentBuffer, 0,
-														SplineSegmentBufferByteSize, RLM_WriteOnly);
-	FMemory::Memcpy(SplineSegmentBuffer, SplineSegmentData.GetData(), SplineSegmentBufferByteSize);
-	RHIUnlockStructuredBuffer(InSplineSegmentBuffer);
-
-	// Spline
-	void* SplineBuffer =
-		RHILockStructuredBuffer(InSplineBuffer, 0, SplineBufferByteSize, RLM_WriteOnly);
-	FMemory::Memcpy(SplineBuffer, SplineData.GetData(), SplineBufferByteSize);
-	RHIUnlockStructuredBuffer(InSplineBuffer);
+void FIGVEdgeMeshSceneProxy::DispatchComputeShader_RenderThread()
+{
+	check(IsInRenderingThread());
 
 	// Compute Shader
 	if (bIsComputeShaderUnloading)
@@ -427,17 +624,24 @@ void FIGVEdgeMeshSceneProxy::ComputeMesh_RenderThread()
 		return;
 	}
 
+	if (!(InSplineControlPointBuffer != nullptr))
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_IGV_ComputeDispatch);
+	IGV_TRACE_SCOPE("Compute Dispatch");
+	INC_DWORD_STAT(STAT_IGV_NumComputeDispatches);
+
 	FRHICommandListImmediate& RHICmdList = GRHICommandList.GetImmediateCommandList();
 
 	// TODO: Fix occasional crash
 	TShaderMapRef<FSplineComputeShader_Sphere> ComputeShader(
 		GetGlobalShaderMap(GraphActor->GetWorld()->Scene->GetFeatureLevel()));
 	RHICmdList.SetComputeShader(ComputeShader->GetComputeShader());
-	ComputeShader->SetBuffers(RHICmdList, InSplineControlPointBufferSRV, InSplineSegmentBufferSRV,
-							  InSplineBufferSRV, OutMeshVertexBufferUAV);
+	ComputeShader->SetBuffers(RHICmdList, InSplineControlPointBufferSRV, InSplineLevelBufferSRV,
+							  InSplineSegmentBufferSRV, InSplineBufferSRV, OutMeshVertexBufferUAV);
 	ComputeShader->SetUniformBuffers(RHICmdList, SplineComputeShaderUniformParameters);
-	DispatchComputeShader(RHICmdList, *ComputeShader, SplineSegmentData.Num(), 1, 1);
+	DispatchComputeShader(RHICmdList, *ComputeShader, Buffers->SplineSegmentData.Num(), 1, 1);
 	ComputeShader->UnbindBuffers(RHICmdList);
-
-	bIsComputeShaderExecuting = false;
 }
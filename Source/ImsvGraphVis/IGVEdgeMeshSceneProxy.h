@@ -5,6 +5,7 @@
 #include "KWMeshElement.h"
 #include "SplineComputeShader.h"
 
+#include "IGVEdgeMeshBuffers.h"
 #include "IGVEdgeMeshData.h"
 #include "IGVEdgeSplineData.h"
 
@@ -15,6 +16,23 @@ public:
 
 	FIGVEdgeMeshVertexBuffer(int32 const InNumElements);
 	virtual void InitRHI() override;
+	virtual void ReleaseRHI() override;
+};
+
+// Uploads the indices of the frame shown by the scene proxy without keeping a copy of its own.
+// Sized for the capacity of the frame, so patched spans are written in place.
+class IMSVGRAPHVIS_API FIGVEdgeMeshIndexBuffer : public FIndexBuffer
+{
+public:
+	FIGVEdgeMeshBuffersConstPtr const& Buffers;  // Of the scene proxy
+	int32 const NumElements;
+
+	FIGVEdgeMeshIndexBuffer(FIGVEdgeMeshBuffersConstPtr const& InBuffers);
+	virtual void InitRHI() override;
+	virtual void ReleaseRHI() override;
+
+	// Not dynamic, so the rest of the buffer keeps its indices
+	void BufferData(TArray<FIGVEdgeMeshSpan> const& Spans);
 };
 
 class IMSVGRAPHVIS_API FIGVEdgeMeshVertexFactory : public FLocalVertexFactory
@@ -31,26 +49,32 @@ public:
 	class AIGVGraphActor* GraphActor;
 	EIGVEdgeRenderGroup::Type const RenderGroup;
 
-	TArray<FIGVEdgeSplineControlPointData> SplineControlPointData;
-	TArray<FIGVEdgeSplineSegmentData> SplineSegmentData;
-	TArray<FIGVEdgeSplineData> SplineData;
+	// Shared with the component, never modified once shown
+	FIGVEdgeMeshBuffersConstPtr Buffers;
+	FIGVEdgeMeshDrawStateConstPtr DrawState;  // Default group only
+
+	// Of the GPU buffers. Later frames of another capacity need a new proxy.
+	FIGVEdgeMeshCapacity const Capacity;
 
 	FStructuredBufferRHIRef InSplineControlPointBuffer;
+	FStructuredBufferRHIRef InSplineLevelBuffer;
 	FStructuredBufferRHIRef InSplineSegmentBuffer;
 	FStructuredBufferRHIRef InSplineBuffer;
 
 	FShaderResourceViewRHIRef InSplineControlPointBufferSRV;
+	FShaderResourceViewRHIRef InSplineLevelBufferSRV;
 	FShaderResourceViewRHIRef InSplineSegmentBufferSRV;
 	FShaderResourceViewRHIRef InSplineBufferSRV;
 	FUnorderedAccessViewRHIRef OutMeshVertexBufferUAV;
+	uint32 StructuredBufferSize;  // Reported to STAT_IGV_EdgeMeshGPUMemory
 
+	// Render thread only, read from the graph actor with every upload
 	FSplineComputeShaderUniformParameters SplineComputeShaderUniformParameters;
 
-	bool bIsComputeShaderExecuting;
 	bool bIsComputeShaderUnloading;
 
 	FIGVEdgeMeshVertexBuffer VertexBuffer;
-	FResourceArrayIndexBuffer IndexBuffer;
+	FIGVEdgeMeshIndexBuffer IndexBuffer;
 	FIGVEdgeMeshVertexFactory VertexFactory;
 
 	UMaterialInterface* Material;
@@ -68,10 +92,18 @@ public:
 	virtual bool CanBeOccluded() const override;
 	uint32 GetAllocatedSize() const;
 	virtual uint32 GetMemoryFootprint() const override;
+	uint32 GetGPUMemorySize() const;
 
 public:
 	void SendRenderDynamicData();
-	void SendRenderDynamicData_RenderThread();
+	// Uploads and computes the new buffers if they are not the shown ones. Only the patched spans
+	// are uploaded if the new buffers were patched from the shown ones.
+	void SendRenderDynamicData_RenderThread(
+		FIGVEdgeMeshBuffersConstPtr const& NewBuffers,
+		FIGVEdgeMeshDrawStateConstPtr const& NewDrawState,
+		FSplineComputeShaderUniformParameters const& Parameters);
+
+	void SendTransitionAlpha(float const Alpha);
 
 	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
 										const FSceneViewFamily& ViewFamily, uint32 VisibilityMap,
@@ -81,13 +113,23 @@ public:
 
 	void SetMesh(FMeshBatch& Mesh, bool const bWireframe) const;
 	int32 SetMeshBatchElements(FMeshBatch& Mesh, bool const bWireframe) const;
+	TArray<FIGVEdgeMeshRange> const& GetDrawnMeshRanges() const;
+	bool IsInBuffers(FIGVEdgeMeshRange const& MeshRange) const;
 	void SetMeshBatchElement(FMeshBatchElement& BatchElement,
-							 FIGVEdgeMeshData* const MeshData) const;
+							 FIGVEdgeMeshRange const& MeshRange) const;
 
 private:
 	void ReleaseBuffers();
 	void CreateBuffers();
 
+	// Read on the game thread, and sent by value to the render thread
+	FSplineComputeShaderUniformParameters MakeSplineComputeShaderParameters() const;
+
+	// Of the buffers the proxy is created with
 	void ComputeMesh();
-	void ComputeMesh_RenderThread();
+	void ComputeMesh_RenderThread(FSplineComputeShaderUniformParameters const& Parameters);
+	// Writes the spans of the shown buffers over the structured buffers. They are not dynamic, so
+	// the rest keeps its contents.
+	void UploadBuffers_RenderThread(FIGVEdgeMeshSpans const& Spans);
+	void DispatchComputeShader_RenderThread();
 };
@@ -7,10 +7,17 @@
 struct IMSVGRAPHVIS_API FIGVEdgeSplineControlPointData
 {
 	FVector Position;
-	float Level;
 	float Knot;
 };
 
+// Levels are kept apart from positions so that a highlight transition only changes the
+// interpolation alpha of the compute shader instead of the control points themselves.
+struct IMSVGRAPHVIS_API FIGVEdgeSplineLevelData
+{
+	float LevelBeforeTransition;
+	float LevelAfterTransition;
+};
+
 struct IMSVGRAPHVIS_API FIGVEdgeSplineSegmentData
 {
 	uint32 SplineIdx;
@@ -30,4 +37,5 @@ struct IMSVGRAPHVIS_API FIGVEdgeSplineData
 	uint32 BeginControlPointIdx;
 	uint32 NumControlPoints;
 	uint32 MeshVertexBufferOffset;
+	float WidthScale;  // Of the uniform width, above 1 for edge bundles
 };
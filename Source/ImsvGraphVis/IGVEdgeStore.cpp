@@ -0,0 +1,388 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVEdgeStore.h"
+
+#include "IGVCluster.h"
+#include "IGVEdge.h"
+
+template <typename T>
+TArrayView<T> Slice(TArray<T>& Pool, TArray<int32> const& Offsets, TArray<int32> const& Nums,
+					int32 const EdgeIdx)
+{
+	return TArrayView<T>(Pool.GetData() + Offsets[EdgeIdx], Nums[EdgeIdx]);
+}
+
+// Copies the ranges of all edges into a new pool in edge order. Offsets are updated separately,
+// since several pools share them.
+template <typename T>
+void CompactPool(TArray<T>& Pool, TArray<int32> const& Offsets, TArray<int32> const& Nums,
+				 int32 const NumUsed)
+{
+	TArray<T> NewPool;
+	NewPool.Reserve(NumUsed);
+	for (int32 EdgeIdx = 0, NumEdges = Offsets.Num(); EdgeIdx < NumEdges; EdgeIdx++)
+	{
+		NewPool.Append(Pool.GetData() + Offsets[EdgeIdx], Nums[EdgeIdx]);
+	}
+	check(NewPool.Num() == NumUsed);
+	Pool = MoveTemp(NewPool);
+}
+
+int32 SetOffsets(TArray<int32>& Offsets, TArray<int32> const& Nums)
+{
+	int32 Offset = 0;
+	for (int32 EdgeIdx = 0, NumEdges = Nums.Num(); EdgeIdx < NumEdges; EdgeIdx++)
+	{
+		Offsets[EdgeIdx] = Offset;
+		Offset += Nums[EdgeIdx];
+	}
+	return Offset;
+}
+
+FIGVEdgeStore::FIGVEdgeStore()
+	: SourceIdxs(),
+	  TargetIdxs(),
+	  RenderGroups(),
+	  HighlightStates(),
+	  Flags(),
+	  RenderGroupListIdxs(),
+	  PathOffsets(),
+	  PathNums(),
+	  PathClusters(),
+	  PathLevelsDefault(),
+	  PathLevelsBeforeTransition(),
+	  PathLevelsAfterTransition(),
+	  ControlPointOffsets(),
+	  ControlPointNums(),
+	  ControlPoints(),
+	  ControlPointLevels(),
+	  NumUnusedPathClusters(0),
+	  NumUnusedControlPoints(0)
+{
+}
+
+int32 FIGVEdgeStore::Num() const
+{
+	return SourceIdxs.Num();
+}
+
+void FIGVEdgeStore::Setup(TArray<FIGVEdge> const& Edges)
+{
+	int32 const NumEdges = Edges.Num();
+
+	SourceIdxs.SetNumUninitialized(NumEdges);
+	TargetIdxs.SetNumUninitialized(NumEdges);
+	for (int32 EdgeIdx = 0; EdgeIdx < NumEdges; EdgeIdx++)
+	{
+		SourceIdxs[EdgeIdx] = Edges[EdgeIdx].SourceIdx;
+		TargetIdxs[EdgeIdx] = Edges[EdgeIdx].TargetIdx;
+	}
+
+	RenderGroups.Init(EIGVEdgeRenderGroup::Default, NumEdges);
+	HighlightStates.Init(EIGVEdgeHighlight::None, NumEdges);
+	Flags.Init(EIGVEdgeFlags::None, NumEdges);
+
+	for (int32 Group = 0; Group < EIGVEdgeRenderGroup::NumGroups; Group++)
+	{
+		RenderGroupEdgeIdxs[Group].Reset();
+	}
+
+	// Nothing is highlighted in a new graph.
+	TArray<int32>& DefaultEdgeIdxs = RenderGroupEdgeIdxs[EIGVEdgeRenderGroup::Default];
+	DefaultEdgeIdxs.SetNumUninitialized(NumEdges);
+	RenderGroupListIdxs.SetNumUninitialized(NumEdges);
+	for (int32 EdgeIdx = 0; EdgeIdx < NumEdges; EdgeIdx++)
+	{
+		DefaultEdgeIdxs[EdgeIdx] = EdgeIdx;
+		RenderGroupListIdxs[EdgeIdx] = EdgeIdx;
+	}
+}
+
+void FIGVEdgeStore::SetupPaths(TArray<FIGVEdge> const& Edges)
+{
+	int32 const NumEdges = Edges.Num();
+	check(NumEdges == Num());
+
+	PathNums.SetNumUninitialized(NumEdges);
+	ControlPointNums.SetNumUninitialized(NumEdges);
+	for (int32 EdgeIdx = 0; EdgeIdx < NumEdges; EdgeIdx++)
+	{
+		PathNums[EdgeIdx] = Edges[EdgeIdx].NumClusters();
+		ControlPointNums[EdgeIdx] = Edges[EdgeIdx].NumSplineControlPoints();
+	}
+
+	PathOffsets.SetNumUninitialized(NumEdges);
+	ControlPointOffsets.SetNumUninitialized(NumEdges);
+	int32 const NumPathClusters = SetOffsets(PathOffsets, PathNums);
+	int32 const NumControlPoints = SetOffsets(ControlPointOffsets, ControlPointNums);
+
+	// Filled by FIGVEdge::SetupClusters and UpdateSplineControlPoints
+	PathClusters.SetNumUninitialized(NumPathClusters);
+	PathLevelsDefault.SetNumUninitialized(NumPathClusters);
+	PathLevelsBeforeTransition.SetNumUninitialized(NumPathClusters);
+	PathLevelsAfterTransition.SetNumUninitialized(NumPathClusters);
+	ControlPoints.SetNumUninitialized(NumControlPoints);
+	ControlPointLevels.SetNumUninitialized(NumControlPoints);
+
+	NumUnusedPathClusters = 0;
+	NumUnusedControlPoints = 0;
+}
+
+int32 FIGVEdgeStore::Add(FIGVEdge const& Edge)
+{
+	int32 const EdgeIdx = SourceIdxs.Add(Edge.SourceIdx);
+	TargetIdxs.Add(Edge.TargetIdx);
+
+	RenderGroups.Add(EIGVEdgeRenderGroup::Default);
+	HighlightStates.Add(EIGVEdgeHighlight::None);
+	Flags.Add(EIGVEdgeFlags::None);
+	RenderGroupListIdxs.Add(INDEX_NONE);
+	AddToRenderGroup(EdgeIdx, EIGVEdgeRenderGroup::Default);
+
+	PathOffsets.Add(PathClusters.Num());
+	PathNums.Add(0);
+	ControlPointOffsets.Add(ControlPoints.Num());
+	ControlPointNums.Add(0);
+
+	check(EdgeIdx == Edge.Idx);
+	return EdgeIdx;
+}
+
+void FIGVEdgeStore::RemoveAtSwap(int32 const EdgeIdx)
+{
+	NumUnusedPathClusters += PathNums[EdgeIdx];
+	NumUnusedControlPoints += ControlPointNums[EdgeIdx];
+
+	// The last edge takes the index of the removed one in the list of its group too.
+	RemoveFromRenderGroup(EdgeIdx);
+	int32 const LastEdgeIdx = Num() - 1;
+	if (EdgeIdx != LastEdgeIdx)
+	{
+		RenderGroupEdgeIdxs[RenderGroups[LastEdgeIdx]][RenderGroupListIdxs[LastEdgeIdx]] = EdgeIdx;
+	}
+
+	SourceIdxs.RemoveAtSwap(EdgeIdx, 1, false);
+	TargetIdxs.RemoveAtSwap(EdgeIdx, 1, false);
+	RenderGroups.RemoveAtSwap(EdgeIdx, 1, false);
+	HighlightStates.RemoveAtSwap(EdgeIdx, 1, false);
+	Flags.RemoveAtSwap(EdgeIdx, 1, false);
+	RenderGroupListIdxs.RemoveAtSwap(EdgeIdx, 1, false);
+
+	PathOffsets.RemoveAtSwap(EdgeIdx, 1, false);
+	PathNums.RemoveAtSwap(EdgeIdx, 1, false);
+	ControlPointOffsets.RemoveAtSwap(EdgeIdx, 1, false);
+	ControlPointNums.RemoveAtSwap(EdgeIdx, 1, false);
+}
+
+void FIGVEdgeStore::Reserve(int32 const NumEdges)
+{
+	SourceIdxs.Reserve(NumEdges);
+	TargetIdxs.Reserve(NumEdges);
+	RenderGroups.Reserve(NumEdges);
+	HighlightStates.Reserve(NumEdges);
+	Flags.Reserve(NumEdges);
+	RenderGroupListIdxs.Reserve(NumEdges);
+
+	PathOffsets.Reserve(NumEdges);
+	PathNums.Reserve(NumEdges);
+	ControlPointOffsets.Reserve(NumEdges);
+	ControlPointNums.Reserve(NumEdges);
+}
+
+void FIGVEdgeStore::AllocatePath(int32 const EdgeIdx, int32 const NumPathClusters,
+								 int32 const NumControlPoints)
+{
+	if (PathNums[EdgeIdx] == NumPathClusters && ControlPointNums[EdgeIdx] == NumControlPoints)
+	{
+		return;
+	}
+
+	NumUnusedPathClusters += PathNums[EdgeIdx];
+	NumUnusedControlPoints += ControlPointNums[EdgeIdx];
+
+	PathOffsets[EdgeIdx] = PathClusters.Num();
+	PathNums[EdgeIdx] = NumPathClusters;
+	PathClusters.AddUninitialized(NumPathClusters);
+	PathLevelsDefault.AddUninitialized(NumPathClusters);
+	PathLevelsBeforeTransition.AddUninitialized(NumPathClusters);
+	PathLevelsAfterTransition.AddUninitialized(NumPathClusters);
+
+	ControlPointOffsets[EdgeIdx] = ControlPoints.Num();
+	ControlPointNums[EdgeIdx] = NumControlPoints;
+	ControlPoints.AddUninitialized(NumControlPoints);
+	ControlPointLevels.AddUninitialized(NumControlPoints);
+}
+
+void FIGVEdgeStore::SetEndpointHighlightState(int32 const EdgeIdx, int32 const NodeIdx,
+											  bool const bIsHighlighted,
+											  bool const bHasHighlightedNeighbor)
+{
+	bool const bIsSource = SourceIdxs[EdgeIdx] == NodeIdx;
+	check(bIsSource || TargetIdxs[EdgeIdx] == NodeIdx);
+
+	uint8 const HighlightedState =
+		bIsSource ? EIGVEdgeHighlight::SourceHighlighted : EIGVEdgeHighlight::TargetHighlighted;
+	uint8 const NeighborHighlightedState = bIsSource
+											   ? EIGVEdgeHighlight::SourceNeighborHighlighted
+											   : EIGVEdgeHighlight::TargetNeighborHighlighted;
+
+	uint8& State = HighlightStates[EdgeIdx];
+	State &= ~(HighlightedState | NeighborHighlightedState);
+	if (bIsHighlighted) State |= HighlightedState;
+	if (bHasHighlightedNeighbor) State |= NeighborHighlightedState;
+}
+
+bool FIGVEdgeStore::UpdateRenderGroup(int32 const EdgeIdx)
+{
+	EIGVEdgeRenderGroup::Type const Group = ClassifyRenderGroup(EdgeIdx);
+	if (Group == RenderGroups[EdgeIdx]) return false;
+
+	RemoveFromRenderGroup(EdgeIdx);
+	RenderGroups[EdgeIdx] = Group;
+	AddToRenderGroup(EdgeIdx, Group);
+	return true;
+}
+
+EIGVEdgeRenderGroup::Type FIGVEdgeStore::ClassifyRenderGroup(int32 const EdgeIdx) const
+{
+	bool const bHasHighlightedNode = HasHighlightState(EdgeIdx, EIGVEdgeHighlight::Highlighted);
+	bool const bHasNeighborHighlightedNode =
+		HasHighlightState(EdgeIdx, EIGVEdgeHighlight::NeighborHighlighted);
+
+	if (HasAllHighlightStates(EdgeIdx, EIGVEdgeHighlight::Highlighted) ||
+		(bHasHighlightedNode && bHasNeighborHighlightedNode))
+	{
+		return EIGVEdgeRenderGroup::Highlighted;
+	}
+
+	if (HasFlags(EdgeIdx, EIGVEdgeFlags::InTransition) || bHasHighlightedNode ||
+		bHasNeighborHighlightedNode)
+	{
+		return EIGVEdgeRenderGroup::Remained;
+	}
+
+	return EIGVEdgeRenderGroup::Default;
+}
+
+void FIGVEdgeStore::AddToRenderGroup(int32 const EdgeIdx, EIGVEdgeRenderGroup::Type const Group)
+{
+	RenderGroupListIdxs[EdgeIdx] = RenderGroupEdgeIdxs[Group].Add(EdgeIdx);
+}
+
+void FIGVEdgeStore::RemoveFromRenderGroup(int32 const EdgeIdx)
+{
+	TArray<int32>& EdgeIdxs = RenderGroupEdgeIdxs[RenderGroups[EdgeIdx]];
+	int32 const ListIdx = RenderGroupListIdxs[EdgeIdx];
+	check(EdgeIdxs[ListIdx] == EdgeIdx);
+
+	EdgeIdxs.RemoveAtSwap(ListIdx, 1, false);
+	if (EdgeIdxs.IsValidIndex(ListIdx))
+	{
+		RenderGroupListIdxs[EdgeIdxs[ListIdx]] = ListIdx;
+	}
+	RenderGroupListIdxs[EdgeIdx] = INDEX_NONE;
+}
+
+void FIGVEdgeStore::CompactIfRequired()
+{
+	if (NumUnusedPathClusters * 2 > PathClusters.Num() ||
+		NumUnusedControlPoints * 2 > ControlPoints.Num())
+	{
+		Compact();
+	}
+}
+
+void FIGVEdgeStore::Compact()
+{
+	int32 const NumPathClusters = PathClusters.Num() - NumUnusedPathClusters;
+	CompactPool(PathClusters, PathOffsets, PathNums, NumPathClusters);
+	CompactPool(PathLevelsDefault, PathOffsets, PathNums, NumPathClusters);
+	CompactPool(PathLevelsBeforeTransition, PathOffsets, PathNums, NumPathClusters);
+	CompactPool(PathLevelsAfterTransition, PathOffsets, PathNums, NumPathClusters);
+	SetOffsets(PathOffsets, PathNums);
+
+	int32 const NumControlPoints = ControlPoints.Num() - NumUnusedControlPoints;
+	CompactPool(ControlPoints, ControlPointOffsets, ControlPointNums, NumControlPoints);
+	CompactPool(ControlPointLevels, ControlPointOffsets, ControlPointNums, NumControlPoints);
+	SetOffsets(ControlPointOffsets, ControlPointNums);
+
+	NumUnusedPathClusters = 0;
+	NumUnusedControlPoints = 0;
+}
+
+void FIGVEdgeStore::Empty()
+{
+	SourceIdxs.Empty();
+	TargetIdxs.Empty();
+	RenderGroups.Empty();
+	HighlightStates.Empty();
+	Flags.Empty();
+	for (int32 Group = 0; Group < EIGVEdgeRenderGroup::NumGroups; Group++)
+	{
+		RenderGroupEdgeIdxs[Group].Empty();
+	}
+	RenderGroupListIdxs.Empty();
+
+	PathOffsets.Empty();
+	PathNums.Empty();
+	PathClusters.Empty();
+	PathLevelsDefault.Empty();
+	PathLevelsBeforeTransition.Empty();
+	PathLevelsAfterTransition.Empty();
+
+	ControlPointOffsets.Empty();
+	ControlPointNums.Empty();
+	ControlPoints.Empty();
+	ControlPointLevels.Empty();
+
+	NumUnusedPathClusters = 0;
+	NumUnusedControlPoints = 0;
+}
+
+uint32 FIGVEdgeStore::GetAllocatedSize() const
+{
+	uint32 Size = SourceIdxs.GetAllocatedSize() + TargetIdxs.GetAllocatedSize() +
+				  RenderGroups.GetAllocatedSize() + HighlightStates.GetAllocatedSize() +
+				  Flags.GetAllocatedSize() + RenderGroupListIdxs.GetAllocatedSize();
+	for (int32 Group = 0; Group < EIGVEdgeRenderGroup::NumGroups; Group++)
+	{
+		Size += RenderGroupEdgeIdxs[Group].GetAllocatedSize();
+	}
+
+	return Size + PathOffsets.GetAllocatedSize() + PathNums.GetAllocatedSize() +
+		   PathClusters.GetAllocatedSize() + PathLevelsDefault.GetAllocatedSize() +
+		   PathLevelsBeforeTransition.GetAllocatedSize() +
+		   PathLevelsAfterTransition.GetAllocatedSize() + ControlPointOffsets.GetAllocatedSize() +
+		   ControlPointNums.GetAllocatedSize() + ControlPoints.GetAllocatedSize() +
+		   ControlPointLevels.GetAllocatedSize();
+}
+
+TArrayView<FIGVCluster*> FIGVEdgeStore::GetPathClusters(int32 const EdgeIdx)
+{
+	return Slice(PathClusters, PathOffsets, PathNums, EdgeIdx);
+}
+
+TArrayView<float> FIGVEdgeStore::GetPathLevelsDefault(int32 const EdgeIdx)
+{
+	return Slice(PathLevelsDefault, PathOffsets, PathNums, EdgeIdx);
+}
+
+TArrayView<float> FIGVEdgeStore::GetPathLevelsBeforeTransition(int32 const EdgeIdx)
+{
+	return Slice(PathLevelsBeforeTransition, PathOffsets, PathNums, EdgeIdx);
+}
+
+TArrayView<float> FIGVEdgeStore::GetPathLevelsAfterTransition(int32 const EdgeIdx)
+{
+	return Slice(PathLevelsAfterTransition, PathOffsets, PathNums, EdgeIdx);
+}
+
+TArrayView<FIGVEdgeSplineControlPointData> FIGVEdgeStore::GetControlPoints(int32 const EdgeIdx)
+{
+	return Slice(ControlPoints, ControlPointOffsets, ControlPointNums, EdgeIdx);
+}
+
+TArrayView<FIGVEdgeSplineLevelData> FIGVEdgeStore::GetControlPointLevels(int32 const EdgeIdx)
+{
+	return Slice(ControlPointLevels, ControlPointOffsets, ControlPointNums, EdgeIdx);
+}
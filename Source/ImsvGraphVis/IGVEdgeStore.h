@@ -0,0 +1,177 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "CoreMinimal.h"
+
+#include "IGVEdgeMeshData.h"
+#include "IGVEdgeSplineData.h"
+
+namespace EIGVEdgeFlags
+{
+enum Type : uint8
+{
+	None = 0,
+	InTransition = 1 << 0,
+	UpdateMeshRequired = 1 << 1,
+	UpdateDefaultMeshRequired = 1 << 2,  // Patched into the default group mesh, see PatchEdges
+	Aggregated = 1 << 3  // Merged into a meta-edge or meta-node, see FIGVSemanticZoom
+};
+}
+
+// Highlight state of the endpoints of an edge, kept by AIGVNodeActor through its incident edges
+namespace EIGVEdgeHighlight
+{
+enum Type : uint8
+{
+	None = 0,
+	SourceHighlighted = 1 << 0,
+	TargetHighlighted = 1 << 1,
+	SourceNeighborHighlighted = 1 << 2,  // The source has a highlighted neighbor.
+	TargetNeighborHighlighted = 1 << 3,
+
+	Highlighted = SourceHighlighted | TargetHighlighted,
+	NeighborHighlighted = SourceNeighborHighlighted | TargetNeighborHighlighted
+};
+}
+
+// Per-edge data that is read or written every frame, as parallel arrays indexed by the edge
+// index, so that the per-frame loops over all edges are linear scans of a few small arrays.
+// FIGVEdge keeps the data only needed at load time.
+//
+// The variable-length data of an edge lives in flat pools: the cluster path of edge i is
+// PathNums[i] elements from PathOffsets[i] of PathClusters and the PathLevels* arrays, and its
+// spline is ControlPointNums[i] elements from ControlPointOffsets[i] of ControlPoints and
+// ControlPointLevels. SetupPaths lays the pools out in edge order. Incremental edits append the
+// ranges of new or re-routed edges instead, and Compact restores the layout once too much of the
+// pools is unused.
+//
+// The render group of an edge follows from its highlight state and its transition flag alone.
+// Every group also keeps the list of its edges, in no particular order, so that the meshes of the
+// highlighted and remained groups are laid out without a scan over all edges.
+struct IMSVGRAPHVIS_API FIGVEdgeStore
+{
+	TArray<int32> SourceIdxs;
+	TArray<int32> TargetIdxs;
+
+	TArray<uint8> RenderGroups;		// EIGVEdgeRenderGroup::Type
+	TArray<uint8> HighlightStates;  // EIGVEdgeHighlight::Type
+	TArray<uint8> Flags;			// EIGVEdgeFlags::Type
+
+	TArray<int32> RenderGroupEdgeIdxs[EIGVEdgeRenderGroup::NumGroups];
+	TArray<int32> RenderGroupListIdxs;  // Of each edge in the list of its render group
+
+	TArray<int32> PathOffsets;
+	TArray<int32> PathNums;
+	TArray<struct FIGVCluster*> PathClusters;
+	TArray<float> PathLevelsDefault;
+	TArray<float> PathLevelsBeforeTransition;
+	TArray<float> PathLevelsAfterTransition;  // Equal to the former if not in transition
+
+	TArray<int32> ControlPointOffsets;
+	TArray<int32> ControlPointNums;
+	TArray<FIGVEdgeSplineControlPointData> ControlPoints;
+	TArray<FIGVEdgeSplineLevelData> ControlPointLevels;
+
+	// Pool elements no longer in the range of any edge
+	int32 NumUnusedPathClusters;
+	int32 NumUnusedControlPoints;
+
+public:
+	FIGVEdgeStore();
+
+	int32 Num() const;
+
+	// Endpoints and per-frame state. Called by AIGVGraphActor::SetupEdges.
+	void Setup(TArray<struct FIGVEdge> const& Edges);
+	// Sizes the pools from the lowest common ancestors of the edges. Called by
+	// AIGVGraphActor::SetupClusters before FIGVEdge::SetupClusters.
+	void SetupPaths(TArray<struct FIGVEdge> const& Edges);
+
+	// Incremental edits, see AIGVGraphActor::AddEdge and RemoveEdge. Add appends an edge without
+	// a path, RemoveAtSwap moves the last edge into EdgeIdx.
+	int32 Add(struct FIGVEdge const& Edge);
+	void RemoveAtSwap(int32 const EdgeIdx);
+	void Reserve(int32 const NumEdges);
+
+	// Gives the edge ranges of the given sizes, to be filled by FIGVEdge::SetupClusters. The
+	// current ranges are kept if they have the same sizes, otherwise new ones are appended.
+	void AllocatePath(int32 const EdgeIdx, int32 const NumPathClusters,
+					  int32 const NumControlPoints);
+	// Lays the pools out in edge order again if more than half of them is unused
+	void CompactIfRequired();
+
+	// Sets the state of the endpoint NodeIdx, see AIGVNodeActor::UpdateEdgeHighlightStates. The
+	// render group follows with the next UpdateRenderGroup.
+	void SetEndpointHighlightState(int32 const EdgeIdx, int32 const NodeIdx,
+								   bool const bIsHighlighted, bool const bHasHighlightedNeighbor);
+	// Classifies the edge again, and moves it to the list of its new group. Called for the edges
+	// flagged EIGVEdgeFlags::UpdateMeshRequired, whose state may have changed. Returns true if
+	// the group changed.
+	bool UpdateRenderGroup(int32 const EdgeIdx);
+
+	void Empty();
+
+	uint32 GetAllocatedSize() const;
+
+	FORCEINLINE bool HasFlags(int32 const EdgeIdx, uint8 const InFlags) const
+	{
+		return (Flags[EdgeIdx] & InFlags) != 0;
+	}
+
+	FORCEINLINE void SetFlags(int32 const EdgeIdx, uint8 const InFlags)
+	{
+		Flags[EdgeIdx] |= InFlags;
+	}
+
+	FORCEINLINE void ClearFlags(int32 const EdgeIdx, uint8 const InFlags)
+	{
+		Flags[EdgeIdx] &= ~InFlags;
+	}
+
+	FORCEINLINE EIGVEdgeRenderGroup::Type GetRenderGroup(int32 const EdgeIdx) const
+	{
+		return EIGVEdgeRenderGroup::Type(RenderGroups[EdgeIdx]);
+	}
+
+	FORCEINLINE TArray<int32> const& GetRenderGroupEdgeIdxs(
+		EIGVEdgeRenderGroup::Type const Group) const
+	{
+		return RenderGroupEdgeIdxs[Group];
+	}
+
+	FORCEINLINE bool HasHighlightState(int32 const EdgeIdx, uint8 const InStates) const
+	{
+		return (HighlightStates[EdgeIdx] & InStates) != 0;
+	}
+
+	FORCEINLINE bool HasAllHighlightStates(int32 const EdgeIdx, uint8 const InStates) const
+	{
+		return (HighlightStates[EdgeIdx] & InStates) == InStates;
+	}
+
+	FORCEINLINE int32 GetNumPathClusters(int32 const EdgeIdx) const
+	{
+		return PathNums[EdgeIdx];
+	}
+
+	FORCEINLINE int32 GetNumControlPoints(int32 const EdgeIdx) const
+	{
+		return ControlPointNums[EdgeIdx];
+	}
+
+	TArrayView<struct FIGVCluster*> GetPathClusters(int32 const EdgeIdx);
+	TArrayView<float> GetPathLevelsDefault(int32 const EdgeIdx);
+	TArrayView<float> GetPathLevelsBeforeTransition(int32 const EdgeIdx);
+	TArrayView<float> GetPathLevelsAfterTransition(int32 const EdgeIdx);
+	TArrayView<FIGVEdgeSplineControlPointData> GetControlPoints(int32 const EdgeIdx);
+	TArrayView<FIGVEdgeSplineLevelData> GetControlPointLevels(int32 const EdgeIdx);
+
+protected:
+	void Compact();
+
+	EIGVEdgeRenderGroup::Type ClassifyRenderGroup(int32 const EdgeIdx) const;
+	void AddToRenderGroup(int32 const EdgeIdx, EIGVEdgeRenderGroup::Type const Group);
+	void RemoveFromRenderGroup(int32 const EdgeIdx);
+};
@@ -2,6 +2,7 @@
 
 #include "IGVGraphActor.h"
 
+#include "Components/LineBatchComponent.h"
 #include "Components/PostProcessComponent.h"
 #include "Components/SkyLightComponent.h"
 #include "Components/SphereComponent.h"
@@ -12,10 +13,15 @@
 #include "IGVData.h"
 #include "IGVEdgeMeshComponent.h"
 #include "IGVFunctionLibrary.h"
+#include "IGVLabelComponent.h"
 #include "IGVLog.h"
+#include "IGVMemoryUsage.h"
 #include "IGVNodeActor.h"
+#include "IGVNodeMeshComponent.h"
 #include "IGVPawn.h"
 #include "IGVPlayerController.h"
+#include "IGVStats.h"
+#include "IGVTrace.h"
 #include "IGVTreemapLayout.h"
 
 UMaterialInterface* GetOutlineMaterial()
@@ -29,8 +35,16 @@ AIGVGraphActor::AIGVGraphActor()
 	: Filename("lesmis.igv.json"),
 	  Nodes(),
 	  Edges(),
+	  EdgeStore(),
+	  Adjacency(),
+	  LabelPool(),
 	  Clusters(),
+	  RootCluster(nullptr),
+	  FreeClusterIdxs(),
+	  GraphArena(),
 	  PlanarExtent(1.f, 1.f),
+	  NormalizedBoundCenter(FVector2D::ZeroVector),
+	  NormalizedBoundExtent(1.f, 1.f),
 	  FieldOfView(90.f),
 	  AspectRatio(16.f / 9.f),
 	  ProjectionMode(EIGVProjection::Sphere_Stereographic_RadialWarping),
@@ -42,6 +56,13 @@ AIGVGraphActor::AIGVGraphActor()
 	  EdgeWidth(8.f),
 	  EdgeNumSides(4),
 	  EdgeBundlingStrength(.9f),
+	  EdgeMeshUpdateBudget(4.f),
+	  EdgeBundleLODHeight(0),
+	  DeltaIngestionBudget(2.f),
+	  TemporalEdgeSamplesPerStep(8),
+	  SemanticZoomFocusAngle(0.f),
+	  NodeActorPoolSlack(1.f),
+	  NodeActorPool(),
 	  ColorHueMin(0.f),
 	  ColorHueMax(210.f),
 	  ColorHueOffset(0.f),
@@ -54,10 +75,23 @@ AIGVGraphActor::AIGVGraphActor()
 	  DefaultLevelScale(1.f),
 	  HighlightedLevelScale(.5f),
 	  NeighborHighlightedLevelScale(.75f),
-	  bUpdateDefaultEdgeMeshRequired(true)
+	  HighlightTransitionDuration(.5f),
+	  HighlightTransitionCurve(nullptr),
+	  TransitionManager(),
+	  DeltaIngestion(),
+	  DeltaProducer(),
+	  TemporalPlayer(),
+	  SemanticZoom(),
+	  bUpdateDefaultEdgeMeshRequired(true),
+	  bUpdateHighlightedEdgeMeshesRequired(false)
 {
 	PrimaryActorTick.bCanEverTick = true;
 
+	TransitionManager.Init(this);
+	DeltaIngestion.Init(this);
+	TemporalPlayer.Init(this);
+	SemanticZoom.Init(this);
+
 	SphereComponent = CreateDefaultSubobject<USphereComponent>(TEXT("Sphere"));
 	RootComponent = SphereComponent;
 
@@ -90,6 +124,27 @@ AIGVGraphActor::AIGVGraphActor()
 	RemainedEdgeGroupMeshComponent->AttachToComponent(
 		RootComponent, FAttachmentTransformRules::KeepRelativeTransform);
 
+	MetaEdgeLineBatchComponent =
+		CreateDefaultSubobject<ULineBatchComponent>(TEXT("MetaEdgeLineBatchComponent"));
+	MetaEdgeLineBatchComponent->AttachToComponent(
+		RootComponent, FAttachmentTransformRules::KeepRelativeTransform);
+
+	NodeMeshComponent = CreateDefaultSubobject<UIGVNodeMeshComponent>(TEXT("NodeMeshComponent"));
+	NodeMeshComponent->Init(this, false);
+	NodeMeshComponent->AttachToComponent(RootComponent,
+										 FAttachmentTransformRules::KeepRelativeTransform);
+
+	HaloNodeMeshComponent =
+		CreateDefaultSubobject<UIGVNodeMeshComponent>(TEXT("HaloNodeMeshComponent"));
+	HaloNodeMeshComponent->Init(this, true);
+	HaloNodeMeshComponent->AttachToComponent(RootComponent,
+											 FAttachmentTransformRules::KeepRelativeTransform);
+
+	LabelComponent = CreateDefaultSubobject<UIGVLabelComponent>(TEXT("LabelComponent"));
+	LabelComponent->Init(this);
+	LabelComponent->AttachToComponent(RootComponent,
+									  FAttachmentTransformRules::KeepRelativeTransform);
+
 	SetSphereRadius(1000.0f);
 	ResetAmbientOcclusion();
 
@@ -122,33 +177,110 @@ void AIGVGraphActor::BeginPlay()
 
 	OutlineMaterialInstance = UMaterialInstanceDynamic::Create(GetOutlineMaterial(), this);
 
+	if (FParse::Param(FCommandLine::Get(), TEXT("IGVTrace")))
+	{
+		FIGVTracer::Get().Start();
+	}
+
 	if (!Filename.IsEmpty())
 	{
 		UIGVData::LoadFile(FPaths::Combine(UIGVData::DefaultDataDirPath(), Filename), this);
 	}
+
+	FString IngestSource;
+	if (FParse::Value(FCommandLine::Get(), TEXT("IGVIngest="), IngestSource))
+	{
+		DeltaIngestion.Begin(IngestSource);
+	}
+}
+
+void AIGVGraphActor::EndPlay(EEndPlayReason::Type const EndPlayReason)
+{
+	// The threads read the graph.
+	if (DeltaProducer.IsValid()) DeltaProducer->End();
+	DeltaIngestion.End();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AIGVGraphActor::Destroyed()
+{
+	// Attached, but not destroyed along with this actor
+	for (AIGVNodeActor* const Node : NodeActorPool)
+	{
+		if (!Node->IsPendingKill()) Node->Destroy();
+	}
+	NodeActorPool.Empty();
+
+	Super::Destroyed();
 }
 
 void AIGVGraphActor::Tick(float DeltaTime)
 {
+	IGV_TRACE_SCOPE("GraphActor Tick");
+
 	Super::Tick(DeltaTime);
 
 	UpdateInteraction();
+	DeltaIngestion.Tick();
+	TemporalPlayer.Tick(DeltaTime);
+	TransitionManager.Tick(DeltaTime);
+	SemanticZoom.Tick();
 	UpdateEdgeMeshes();
 }
 
+void AIGVGraphActor::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	// Node actors and edge mesh components report their own.
+	FIGVMemoryUsage const MemoryUsage(this);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(
+		MemoryUsage.Edges + MemoryUsage.Clusters + MemoryUsage.Arena + MemoryUsage.GraphState);
+}
+
 void AIGVGraphActor::EmptyGraph()
 {
+	TransitionManager.Reset();
+	TemporalPlayer.Reset();
+	SemanticZoom.Reset();
+	LabelComponent->Reset();
+	NodeMeshComponent->Reset();
+	HaloNodeMeshComponent->Reset();
+
+	// Pending mesh tasks read the graph
+	DefaultEdgeGroupMeshComponent->CancelIncrementalUpdate();
+	HighlightedEdgeGroupMeshComponent->CancelIncrementalUpdate();
+	RemainedEdgeGroupMeshComponent->CancelIncrementalUpdate();
+
+	// Kept for the next graph, trimmed by SetupGraph
 	for (AIGVNodeActor* Node : Nodes)
 	{
-		Node->Destroy();
+		ReleaseNodeActor(Node);
 	}
 	Nodes.Empty();
 	Edges.Empty();
+	EdgeStore.Empty();
+	Adjacency.Empty();
+	LabelPool.Empty();
 	Clusters.Empty();
+	RootCluster = nullptr;
+	FreeClusterIdxs.Empty();
+
+	// Everything that pointed into the arena is gone
+	IGV_LOG(Log, TEXT("Graph arena: %s"), *GraphArena.ToString());
+	GraphArena.Empty();
 
 	PickRayDistSortedNodes.Empty();
 	LastNearestNode = nullptr;
 	LastPickedNode = nullptr;
+
+	SET_DWORD_STAT(STAT_IGV_NumNodes, 0);
+	SET_DWORD_STAT(STAT_IGV_NumEdges, 0);
+	SET_DWORD_STAT(STAT_IGV_NumClusters, 0);
+	SET_DWORD_STAT(STAT_IGV_NumEdgeBundles, 0);
+	SET_DWORD_STAT(STAT_IGV_NumBundledEdges, 0);
+	UpdateMemoryStats();
 }
 
 void AIGVGraphActor::SetupGraph()
@@ -158,53 +290,102 @@ void AIGVGraphActor::SetupGraph()
 	SetupClusters();
 	UpdateColors();
 	UpdateTreemapLayout();
+	UpdateSplineControlPoints();
 	SetupEdgeMeshes();
+	TrimNodeActorPool();
+
+	SET_DWORD_STAT(STAT_IGV_NumNodes, Nodes.Num());
+	SET_DWORD_STAT(STAT_IGV_NumEdges, Edges.Num());
+	SET_DWORD_STAT(STAT_IGV_NumClusters, Clusters.Num());
+	UpdateMemoryStats();
+
+	IGV_LOG(Log, TEXT("Graph arena: %s"), *GraphArena.ToString());
 }
 
 void AIGVGraphActor::SetupNodes()
 {
 	for (AIGVNodeActor* const Node : Nodes)
 	{
-		Node->SetText(Node->Label);
+		// FIGVAdjacency and the edge endpoints index Nodes by Idx
+		check(Nodes.IsValidIndex(Node->Idx) && Nodes[Node->Idx] == Node);
+
 		PickRayDistSortedNodes.Add(Node);
 
-		IGV_LOG(Log, TEXT("Node: %s"), *Node->ToString());
+		IGV_LOG(Verbose, TEXT("Node: %s"), *Node->ToString());
 	}
+
+	IGV_LOG(Log, TEXT("%d nodes, %d distinct labels in %d characters"), Nodes.Num(),
+			LabelPool.Num(), LabelPool.Chars.Num());
 }
 
 void AIGVGraphActor::SetupEdges()
 {
-	for (FIGVEdge& Edge : Edges)
+	for (int32 EdgeIdx = 0; EdgeIdx < Edges.Num(); EdgeIdx++)
 	{
+		FIGVEdge& Edge = Edges[EdgeIdx];
+		Edge.Idx = EdgeIdx;
 		Edge.SourceNode = Nodes[Edge.SourceIdx];
 		Edge.TargetNode = Nodes[Edge.TargetIdx];
 
-		Edge.SourceNode->Edges.Add(&Edge);
-		Edge.TargetNode->Edges.Add(&Edge);
+		IGV_LOG(Verbose, TEXT("Edge: %s"), *Edge.ToString());
+	}
 
-		Edge.SourceNode->Neighbors.Add(Edge.TargetNode);
-		Edge.TargetNode->Neighbors.Add(Edge.SourceNode);
+	EdgeStore.Setup(Edges);
+	Adjacency.Build(Nodes.Num(), EdgeStore.SourceIdxs, EdgeStore.TargetIdxs);
 
-		IGV_LOG(Log, TEXT("Edge: %s"), *Edge.ToString());
+	if (IGV_LOG_ACTIVE(Log))
+	{
+		TArray<int32> Degrees;
+		for (int32 NodeIdx = 0; NodeIdx < Nodes.Num(); NodeIdx++)
+		{
+			Degrees.Add(Adjacency.GetDegree(NodeIdx));
+		}
+		IGV_LOG(Log, TEXT("%d edges, degree %s"), Edges.Num(), *SummarizeCounts(Degrees, 8));
 	}
 }
 
 void AIGVGraphActor::SetupClusters()
 {
+	SCOPE_CYCLE_COUNTER(STAT_IGV_SetupClusters);
+
 	RootCluster = &Clusters.Last();
 	check(RootCluster->ParentIdx == -1);
 
+	TArray<int32> NumChildren;
+	NumChildren.SetNumZeroed(Clusters.Num());
+	for (FIGVCluster const& Cluster : Clusters)
+	{
+		if (!Cluster.IsRoot()) NumChildren[Cluster.ParentIdx]++;
+	}
+
+	SIZE_T ClusterArenaSize = 0;
+	for (int32 const Num : NumChildren)
+	{
+		ClusterArenaSize += FIGVArena::ArraySize<FIGVCluster*>(Num);
+	}
+	GraphArena.Reserve(ClusterArenaSize);
+
+	for (int32 ClusterIdx = 0; ClusterIdx < Clusters.Num(); ClusterIdx++)
+	{
+		Clusters[ClusterIdx].Children =
+			TIGVArenaArray<FIGVCluster*>(GraphArena, NumChildren[ClusterIdx]);
+	}
+
+	// Reused as the fill cursor of each parent
+	FMemory::Memzero(NumChildren.GetData(), NumChildren.Num() * sizeof(int32));
+
 	for (FIGVCluster& Cluster : Clusters)
 	{
 		if (!Cluster.IsRoot())
 		{
 			Cluster.Parent = &Clusters[Cluster.ParentIdx];
-			Cluster.Parent->Children.Add(&Cluster);
+			Cluster.Parent->Children[NumChildren[Cluster.ParentIdx]++] = &Cluster;
 		}
 
 		if (Cluster.IsLeaf())
 		{
 			Cluster.Node = Nodes[Cluster.NodeIdx];
+			Cluster.Node->ClusterIdx = Cluster.Idx;
 		}
 	}
 
@@ -212,13 +393,658 @@ void AIGVGraphActor::SetupClusters()
 
 	for (FIGVCluster& Cluster : Clusters)
 	{
-		IGV_LOG(Log, TEXT("Cluster: %s"), *Cluster.ToString());
+		IGV_LOG(Verbose, TEXT("Cluster: %s"), *Cluster.ToString());
+	}
+
+	for (FIGVEdge& Edge : Edges)
+	{
+		Edge.FindLowestCommonAncestor();
 	}
 
+	EdgeStore.SetupPaths(Edges);
+
 	for (FIGVEdge& Edge : Edges)
 	{
 		Edge.SetupClusters();
 	}
+
+	if (IGV_LOG_ACTIVE(Log))
+	{
+		NumChildren.Reset();
+		for (FIGVCluster const& Cluster : Clusters)
+		{
+			if (!Cluster.IsLeaf()) NumChildren.Add(Cluster.Children.Num());
+		}
+
+		TArray<int32> PathLengths;
+		for (FIGVEdge const& Edge : Edges)
+		{
+			PathLengths.Add(Edge.NumClusters());
+		}
+
+		IGV_LOG(Log, TEXT("%d clusters, height %d, children %s"), Clusters.Num(),
+				RootCluster->Height, *SummarizeCounts(NumChildren, 8));
+		IGV_LOG(Log, TEXT("Edge cluster path length %s"), *SummarizeCounts(PathLengths, 16));
+	}
+}
+
+int32 AIGVGraphActor::AddNode(FString const& Label, int32 ParentClusterIdx)
+{
+	if (!IsValidParentCluster(ParentClusterIdx))
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to add a node to cluster %d"), ParentClusterIdx);
+		return INDEX_NONE;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_IGV_GraphEdit);
+	BeginGraphEdit();
+
+	AIGVNodeActor* const Node = SpawnNodeActor();
+	Node->Idx = Nodes.Add(Node);
+	Node->SetText(Label);
+	Adjacency.AddNode();
+	PickRayDistSortedNodes.Add(Node);
+
+	// May reallocate Clusters
+	FIGVCluster& Leaf = AddLeafCluster(Node);
+	FIGVCluster& Parent = Clusters[ParentClusterIdx];
+	AttachLeafCluster(Leaf, Parent);
+	SemanticZoom.UpdateNode(Node);
+	RelayoutCluster(Parent);
+
+	EndGraphEdit();
+	return Node->Idx;
+}
+
+bool AIGVGraphActor::RemoveNode(int32 NodeIdx)
+{
+	if (!Nodes.IsValidIndex(NodeIdx))
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to remove node %d"), NodeIdx);
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_IGV_GraphEdit);
+	BeginGraphEdit();
+
+	AIGVNodeActor* const Node = Nodes[NodeIdx];
+	if (Node->bIsHighlighted) Node->EndHighlighted();
+
+	while (Adjacency.GetDegree(NodeIdx) > 0)
+	{
+		TArrayView<int32 const> const NodeEdgeIdxs = Adjacency.GetEdges(NodeIdx);
+		RemoveEdge(NodeEdgeIdxs[NodeEdgeIdxs.Num() - 1]);
+	}
+
+	TransitionManager.RemoveNode(Node);
+
+	FIGVCluster& Leaf = Clusters[Node->ClusterIdx];
+	FIGVCluster& Parent = *Leaf.Parent;
+	DetachLeafCluster(Leaf);
+	Leaf.NodeIdx = -1;
+	Leaf.Node = nullptr;
+	FreeClusterIdxs.Add(Leaf.Idx);
+	RelayoutCluster(Parent);
+
+	// The last node takes the index of the removed one.
+	int32 const LastNodeIdx = Nodes.Num() - 1;
+	if (NodeIdx != LastNodeIdx)
+	{
+		AIGVNodeActor* const LastNode = Nodes[LastNodeIdx];
+		LastNode->Idx = NodeIdx;
+		Clusters[LastNode->ClusterIdx].NodeIdx = NodeIdx;
+
+		for (int32 const EdgeIdx : Adjacency.GetEdges(LastNodeIdx))
+		{
+			FIGVEdge& Edge = Edges[EdgeIdx];
+			if (Edge.SourceIdx == LastNodeIdx)
+			{
+				Edge.SourceIdx = EdgeStore.SourceIdxs[EdgeIdx] = NodeIdx;
+			}
+			if (Edge.TargetIdx == LastNodeIdx)
+			{
+				Edge.TargetIdx = EdgeStore.TargetIdxs[EdgeIdx] = NodeIdx;
+			}
+		}
+
+		Nodes[NodeIdx] = LastNode;
+	}
+	Adjacency.RemoveNodeAtSwap(NodeIdx);
+	Nodes.Pop(false);
+
+	PickRayDistSortedNodes.RemoveSingleSwap(Node, false);
+	if (LastNearestNode == Node) LastNearestNode = nullptr;
+	if (LastPickedNode == Node) LastPickedNode = nullptr;
+	ReleaseNodeActor(Node);
+
+	EndGraphEdit();
+	return true;
+}
+
+int32 AIGVGraphActor::AddEdge(int32 SourceIdx, int32 TargetIdx)
+{
+	if (!Nodes.IsValidIndex(SourceIdx) || !Nodes.IsValidIndex(TargetIdx) || SourceIdx == TargetIdx)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to add an edge from %d to %d"), SourceIdx, TargetIdx);
+		return INDEX_NONE;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_IGV_GraphEdit);
+	BeginGraphEdit();
+
+	int32 const EdgeIdx = Edges.Emplace(this);
+	FIGVEdge& Edge = Edges[EdgeIdx];
+	Edge.Idx = EdgeIdx;
+	Edge.SourceIdx = SourceIdx;
+	Edge.TargetIdx = TargetIdx;
+	Edge.SourceNode = Nodes[SourceIdx];
+	Edge.TargetNode = Nodes[TargetIdx];
+
+	EdgeStore.Add(Edge);
+	Edge.InitHighlightState();
+	DefaultEdgeGroupMeshComponent->AddEdge();
+	Adjacency.AddEdge(SourceIdx, TargetIdx, EdgeIdx);
+	RefreshEdge(EdgeIdx);
+	SemanticZoom.AddEdge(EdgeIdx);
+
+	// After the edge has its path, the transitions begun here include it.
+	if (Edge.SourceNode->bIsHighlighted) Edge.TargetNode->BeginNeighborHighlighted();
+	if (Edge.TargetNode->bIsHighlighted) Edge.SourceNode->BeginNeighborHighlighted();
+
+	EndGraphEdit();
+	return EdgeIdx;
+}
+
+bool AIGVGraphActor::RemoveEdge(int32 EdgeIdx)
+{
+	if (!Edges.IsValidIndex(EdgeIdx))
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to remove edge %d"), EdgeIdx);
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_IGV_GraphEdit);
+	BeginGraphEdit();
+
+	SemanticZoom.RemoveEdge(EdgeIdx);
+
+	FIGVEdge const& Edge = Edges[EdgeIdx];
+	if (Edge.SourceNode->bIsHighlighted) Edge.TargetNode->EndNeighborHighlighted();
+	if (Edge.TargetNode->bIsHighlighted) Edge.SourceNode->EndNeighborHighlighted();
+
+	TransitionManager.RemoveEdge(EdgeIdx);
+
+	// Every edge is in the default mesh, the others are rebuilt without it.
+	DefaultEdgeGroupMeshComponent->RemoveEdge(EdgeIdx);
+	if (EdgeStore.GetRenderGroup(EdgeIdx) != EIGVEdgeRenderGroup::Default)
+	{
+		bUpdateHighlightedEdgeMeshesRequired = true;
+	}
+
+	Adjacency.RemoveEdge(Edge.SourceIdx, Edge.TargetIdx, EdgeIdx);
+
+	// The last edge takes the index of the removed one.
+	int32 const LastEdgeIdx = Edges.Num() - 1;
+	Edges.RemoveAtSwap(EdgeIdx, 1, false);
+	EdgeStore.RemoveAtSwap(EdgeIdx);
+	if (EdgeIdx != LastEdgeIdx)
+	{
+		FIGVEdge& MovedEdge = Edges[EdgeIdx];
+		MovedEdge.Idx = EdgeIdx;
+
+		// An update of the default mesh in progress may have passed its new index already.
+		if (DefaultEdgeGroupMeshComponent->IsIncrementalUpdateInProgress())
+		{
+			EdgeStore.SetFlags(EdgeIdx, EIGVEdgeFlags::UpdateDefaultMeshRequired);
+		}
+		Adjacency.RenameEdge(MovedEdge.SourceIdx, MovedEdge.TargetIdx, LastEdgeIdx, EdgeIdx);
+		TransitionManager.RenameEdge(LastEdgeIdx, EdgeIdx);
+	}
+
+	EndGraphEdit();
+	return true;
+}
+
+bool AIGVGraphActor::MoveNode(int32 NodeIdx, int32 ParentClusterIdx)
+{
+	if (!Nodes.IsValidIndex(NodeIdx) || !IsValidParentCluster(ParentClusterIdx) ||
+		Clusters[Nodes[NodeIdx]->ClusterIdx].ParentIdx == ParentClusterIdx)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to move node %d to cluster %d"), NodeIdx,
+				  ParentClusterIdx);
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_IGV_GraphEdit);
+	BeginGraphEdit();
+
+	FIGVCluster& Leaf = Clusters[Nodes[NodeIdx]->ClusterIdx];
+	FIGVCluster& OldParent = *Leaf.Parent;
+	FIGVCluster& NewParent = Clusters[ParentClusterIdx];
+
+	// Merged by the clusters the node leaves, and then by those it joins
+	for (int32 const EdgeIdx : Adjacency.GetEdges(NodeIdx))
+	{
+		SemanticZoom.RemoveEdge(EdgeIdx);
+	}
+
+	DetachLeafCluster(Leaf);
+	AttachLeafCluster(Leaf, NewParent);
+	SemanticZoom.UpdateNode(Nodes[NodeIdx]);
+
+	for (int32 const EdgeIdx : Adjacency.GetEdges(NodeIdx))
+	{
+		RefreshEdge(EdgeIdx);
+		SemanticZoom.AddEdge(EdgeIdx);
+	}
+
+	RelayoutCluster(OldParent);
+	RelayoutCluster(NewParent);
+
+	EndGraphEdit();
+	return true;
+}
+
+bool AIGVGraphActor::SetNodeColor(int32 NodeIdx, FLinearColor Color)
+{
+	if (!Nodes.IsValidIndex(NodeIdx))
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to set the color of node %d"), NodeIdx);
+		return false;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_IGV_GraphEdit);
+	BeginGraphEdit();
+
+	Nodes[NodeIdx]->SetColor(Color);
+	for (int32 const EdgeIdx : Adjacency.GetEdges(NodeIdx))
+	{
+		EdgeStore.SetFlags(EdgeIdx, EIGVEdgeFlags::UpdateMeshRequired |
+										EIGVEdgeFlags::UpdateDefaultMeshRequired);
+	}
+
+	EndGraphEdit();
+	return true;
+}
+
+bool AIGVGraphActor::SetNodeLabel(int32 NodeIdx, FString const& Label)
+{
+	if (!Nodes.IsValidIndex(NodeIdx))
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to set the label of node %d"), NodeIdx);
+		return false;
+	}
+
+	AIGVNodeActor* const Node = Nodes[NodeIdx];
+	Node->SetText(Label);
+	return true;
+}
+
+int32 AIGVGraphActor::FindEdge(int32 NodeIdx, int32 OtherNodeIdx) const
+{
+	if (!Nodes.IsValidIndex(NodeIdx) || !Nodes.IsValidIndex(OtherNodeIdx)) return INDEX_NONE;
+
+	TArrayView<int32 const> const Neighbors = Adjacency.GetNeighbors(NodeIdx);
+	for (int32 Idx = 0; Idx < Neighbors.Num(); Idx++)
+	{
+		if (Neighbors[Idx] == OtherNodeIdx) return Adjacency.GetEdges(NodeIdx)[Idx];
+	}
+	return INDEX_NONE;
+}
+
+int32 AIGVGraphActor::GetNumTemporalSteps() const
+{
+	return TemporalPlayer.Dataset.NumSteps();
+}
+
+float AIGVGraphActor::GetTemporalTime() const
+{
+	return TemporalPlayer.Time;
+}
+
+void AIGVGraphActor::SeekTemporal(float Time)
+{
+	TemporalPlayer.Rate = 0.f;
+	TemporalPlayer.Seek(Time);
+}
+
+void AIGVGraphActor::PlayTemporal(float StepsPerSecond)
+{
+	TemporalPlayer.Rate = StepsPerSecond;
+}
+
+bool AIGVGraphActor::CollapseCluster(int32 ClusterIdx)
+{
+	return SemanticZoom.CollapseCluster(ClusterIdx);
+}
+
+bool AIGVGraphActor::ExpandCluster(int32 ClusterIdx)
+{
+	return SemanticZoom.ExpandCluster(ClusterIdx);
+}
+
+bool AIGVGraphActor::CollapseClusters(int32 Height)
+{
+	return SemanticZoom.CollapseClusters(Height);
+}
+
+void AIGVGraphActor::ExpandAllClusters()
+{
+	SemanticZoom.ExpandAll();
+}
+
+void AIGVGraphActor::BeginGraphEdit()
+{
+	// An update of the default mesh in progress goes on within its budget. Only its tasks in
+	// flight, which read the graph, are waited for. See UpdateEdgeMeshes.
+	DefaultEdgeGroupMeshComponent->WaitForPendingTasks();
+}
+
+void AIGVGraphActor::EndGraphEdit()
+{
+	EdgeStore.CompactIfRequired();
+	SemanticZoom.MarkLayoutChanged();
+	TrimNodeActorPool();
+
+	SET_DWORD_STAT(STAT_IGV_NumNodes, Nodes.Num());
+	SET_DWORD_STAT(STAT_IGV_NumEdges, Edges.Num());
+	SET_DWORD_STAT(STAT_IGV_NumClusters, Clusters.Num() - FreeClusterIdxs.Num());
+}
+
+bool AIGVGraphActor::IsValidParentCluster(int32 const ClusterIdx) const
+{
+	// Keeps all leaves at the same depth, see FIGVEdge::FindLowestCommonAncestor
+	return Clusters.IsValidIndex(ClusterIdx) && Clusters[ClusterIdx].Height == 1;
+}
+
+FIGVCluster& AIGVGraphActor::AddLeafCluster(AIGVNodeActor* const Node)
+{
+	int32 ClusterIdx;
+	if (FreeClusterIdxs.Num() > 0)
+	{
+		ClusterIdx = FreeClusterIdxs.Pop(false);
+	}
+	else
+	{
+		FIGVCluster const* const OldClusters = Clusters.GetData();
+		ClusterIdx = Clusters.Emplace(this);
+		if (Clusters.GetData() != OldClusters) RebaseClusterPointers(OldClusters);
+	}
+
+	FIGVCluster& Leaf = Clusters[ClusterIdx];
+	Leaf.Idx = ClusterIdx;
+	Leaf.NodeIdx = Node->Idx;
+	Leaf.Height = 0;
+	Leaf.Node = Node;
+	Leaf.NumDescendantNodes = 1;
+	Leaf.TreemapWeight = 0.f;  // Weighted by the next layout
+
+	Node->ClusterIdx = ClusterIdx;
+	return Leaf;
+}
+
+void AIGVGraphActor::AttachLeafCluster(FIGVCluster& Leaf, FIGVCluster& Parent)
+{
+	// Colors follow the leaf order of UpdateColors, so a sibling has about the right one.
+	if (Parent.Children.Num() > 0) Leaf.Node->SetColor(Parent.Children[0]->Node->Color);
+
+	Leaf.Parent = &Parent;
+	Leaf.ParentIdx = Parent.Idx;
+	Parent.Children.Add(GraphArena, &Leaf);
+
+	TArray<int32>& AncIdxs = Leaf.Node->AncIdxs;
+	AncIdxs.Reset();
+	for (FIGVCluster* Cluster = &Parent; Cluster != nullptr; Cluster = Cluster->Parent)
+	{
+		Cluster->NumDescendantNodes++;
+		if (!Cluster->IsRoot()) AncIdxs.Add(Cluster->Idx);
+	}
+}
+
+void AIGVGraphActor::DetachLeafCluster(FIGVCluster& Leaf)
+{
+	FIGVCluster* const Parent = Leaf.Parent;
+	Parent->Children.RemoveAtSwap(Parent->Children.Find(&Leaf));
+
+	for (FIGVCluster* Cluster = Parent; Cluster != nullptr; Cluster = Cluster->Parent)
+	{
+		Cluster->NumDescendantNodes--;
+	}
+
+	Leaf.Parent = nullptr;
+	Leaf.ParentIdx = -1;
+}
+
+void AIGVGraphActor::RebaseClusterPointers(FIGVCluster const* const OldClusters)
+{
+	FIGVCluster* const NewClusters = Clusters.GetData();
+	auto Rebase = [OldClusters, NewClusters](FIGVCluster*& Cluster) {
+		if (Cluster != nullptr) Cluster = NewClusters + (Cluster - OldClusters);
+	};
+
+	Rebase(RootCluster);
+
+	for (FIGVCluster& Cluster : Clusters)
+	{
+		Rebase(Cluster.Parent);
+		for (FIGVCluster*& Child : Cluster.Children)
+		{
+			Rebase(Child);
+		}
+	}
+
+	for (FIGVEdge& Edge : Edges)
+	{
+		Rebase(Edge.LowestCommonAncestor);
+	}
+
+	// Unused pool elements are rebased as well, they are never read.
+	for (FIGVCluster*& Cluster : EdgeStore.PathClusters)
+	{
+		Rebase(Cluster);
+	}
+}
+
+void AIGVGraphActor::RelayoutCluster(FIGVCluster& Cluster)
+{
+	if (Cluster.Children.Num() == 0) return;
+
+	FIGVTreemapLayout Layout(this);
+	Layout.ComputeSubtree(Cluster);
+
+	// As in NormalizeNodePosition, with the bounds of the last full layout
+	TArray<AIGVNodeActor*, TInlineAllocator<64>> LeafNodes;
+	Cluster.ForEachDescendantFirst([this, &LeafNodes](FIGVCluster& Descendant) {
+		if (!Descendant.IsLeaf()) return;
+
+		AIGVNodeActor* const Node = Descendant.Node;
+		FVector2D& P = Node->Pos2D;
+		P -= NormalizedBoundCenter;
+		P /= NormalizedBoundExtent;
+		P *= PlanarExtent;
+		LeafNodes.Add(Node);
+
+		for (int32 const EdgeIdx : Adjacency.GetEdges(Node->Idx))
+		{
+			EdgeStore.SetFlags(EdgeIdx, EIGVEdgeFlags::UpdateMeshRequired |
+											EIGVEdgeFlags::UpdateDefaultMeshRequired);
+		}
+	});
+	UpdateNodeTransforms(LeafNodes);
+
+	Cluster.SetPosNonLeaf();
+}
+
+void AIGVGraphActor::RefreshEdge(int32 const EdgeIdx)
+{
+	FIGVEdge& Edge = Edges[EdgeIdx];
+	Edge.FindLowestCommonAncestor();
+	EdgeStore.AllocatePath(EdgeIdx, Edge.NumClusters(), Edge.NumSplineControlPoints());
+	Edge.SetupClusters();
+
+	EdgeStore.SetFlags(EdgeIdx, EIGVEdgeFlags::UpdateMeshRequired |
+									EIGVEdgeFlags::UpdateDefaultMeshRequired);
+
+	// SetupClusters resets the levels to the default ones.
+	if (Edge.HasHighlightedNode() || Edge.HasNeighborHighlightedNode())
+	{
+		Edge.BeginTransition();
+		TransitionManager.BeginEdgeTransition(EdgeIdx);
+	}
+}
+
+AIGVNodeActor* AIGVGraphActor::SpawnNodeActor(bool const bDeferConstruction)
+{
+	while (NodeActorPool.Num() > 0)
+	{
+		AIGVNodeActor* const Node = NodeActorPool.Pop(false);
+		SET_DWORD_STAT(STAT_IGV_NumPooledNodeActors, NodeActorPool.Num());
+
+		// NodeActorClass may have been changed since.
+		if (Node->IsPendingKill() || Node->GetClass() != *NodeActorClass)
+		{
+			Node->Destroy();
+			continue;
+		}
+
+		Node->Activate();
+		Node->Init(this);
+		return Node;
+	}
+
+	AIGVNodeActor* Node;
+	if (bDeferConstruction)
+	{
+		Node = GetWorld()->SpawnActorDeferred<AIGVNodeActor>(NodeActorClass, FTransform::Identity,
+															 this, Instigator);
+		Node->bIsSpawnDeferred = true;
+	}
+	else
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.Owner = this;
+		SpawnParams.Instigator = Instigator;
+
+		Node = GetWorld()->SpawnActor<AIGVNodeActor>(NodeActorClass, FVector::ZeroVector,
+													 FRotator::ZeroRotator, SpawnParams);
+		Node->AttachToActor(this, FAttachmentTransformRules::KeepRelativeTransform);
+	}
+
+	Node->Init(this);
+	return Node;
+}
+
+void AIGVGraphActor::ReleaseNodeActor(AIGVNodeActor* const Node)
+{
+	if (NodeActorPoolSlack <= 0.f)
+	{
+		Node->Destroy();
+		return;
+	}
+
+	TransitionManager.RemoveNode(Node);
+	Node->Deactivate();
+	NodeActorPool.Add(Node);
+	SET_DWORD_STAT(STAT_IGV_NumPooledNodeActors, NodeActorPool.Num());
+}
+
+void AIGVGraphActor::UpdateNodeTransforms(TArrayView<AIGVNodeActor* const> const InNodes)
+{
+	IGV_TRACE_SCOPE("UpdateNodeTransforms");
+
+	// The default edge mesh tasks read the positions of nodes and clusters.
+	DefaultEdgeGroupMeshComponent->WaitForPendingTasks();
+
+	int32 const NumNodes = InNodes.Num();
+	TArray<FVector> Locations;
+	TArray<FRotator> Rotations;
+	Locations.SetNumUninitialized(NumNodes);
+	Rotations.SetNumUninitialized(NumNodes);
+
+	auto ComputeTransforms = [this, &InNodes, &Locations, &Rotations](int32 const BeginIdx,
+																	  int32 const EndIdx) {
+		for (int32 Idx = BeginIdx; Idx < EndIdx; Idx++)
+		{
+			AIGVNodeActor* const Node = InNodes[Idx];
+			Node->Pos3D = Project(Node->Pos2D);
+			Node->ComputeTransform(Locations[Idx], Rotations[Idx]);
+		}
+	};
+
+	static int32 const NumNodesPerTask = 1024;
+	if (NumNodes <= NumNodesPerTask)
+	{
+		ComputeTransforms(0, NumNodes);
+	}
+	else
+	{
+		FGraphEventArray Tasks;
+		for (int32 BeginIdx = 0; BeginIdx < NumNodes; BeginIdx += NumNodesPerTask)
+		{
+			int32 const EndIdx = FMath::Min(BeginIdx + NumNodesPerTask, NumNodes);
+			Tasks.Add(FKWTask<>::ConstructAndDispatchWhenReady(
+				[&ComputeTransforms, BeginIdx, EndIdx]() { ComputeTransforms(BeginIdx, EndIdx); }));
+		}
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(Tasks);
+	}
+
+	// Components are only touched here. Their render transforms are sent once at the end of the
+	// frame, however many nodes moved.
+	for (int32 Idx = 0; Idx < NumNodes; Idx++)
+	{
+		InNodes[Idx]->ApplyTransform(Locations[Idx], Rotations[Idx]);
+	}
+}
+
+void AIGVGraphActor::TrimNodeActorPool()
+{
+	int32 const MaxNumPooled =
+		NodeActorPoolSlack > 0.f ? FMath::CeilToInt(Nodes.Num() * NodeActorPoolSlack) : 0;
+	if (NodeActorPool.Num() <= MaxNumPooled) return;
+
+	for (int32 PoolIdx = MaxNumPooled; PoolIdx < NodeActorPool.Num(); PoolIdx++)
+	{
+		NodeActorPool[PoolIdx]->Destroy();
+	}
+	NodeActorPool.RemoveAt(MaxNumPooled, NodeActorPool.Num() - MaxNumPooled);
+	SET_DWORD_STAT(STAT_IGV_NumPooledNodeActors, NodeActorPool.Num());
+}
+
+FString AIGVGraphActor::SummarizeCounts(TArray<int32> const& Counts, int32 const NumBins)
+{
+	if (Counts.Num() == 0) return TEXT("n/a");
+
+	int32 Min = MAX_int32;
+	int32 Max = 0;
+	int64 Sum = 0;
+	for (int32 const Count : Counts)
+	{
+		Min = FMath::Min(Min, Count);
+		Max = FMath::Max(Max, Count);
+		Sum += Count;
+	}
+
+	// Equal-width bins, one per value if the range is small enough
+	int32 const BinWidth = FMath::Max(1, FMath::DivideAndRoundUp(Max - Min + 1, NumBins));
+	TArray<int32> Bins;
+	Bins.SetNumZeroed(FMath::DivideAndRoundUp(Max - Min + 1, BinWidth));
+	for (int32 const Count : Counts)
+	{
+		Bins[(Count - Min) / BinWidth]++;
+	}
+
+	TArray<FString> BinStrs;
+	for (int32 BinIdx = 0; BinIdx < Bins.Num(); BinIdx++)
+	{
+		int32 const BinMin = Min + BinIdx * BinWidth;
+		BinStrs.Add(BinWidth == 1
+						? FString::Printf(TEXT("%d:%d"), BinMin, Bins[BinIdx])
+						: FString::Printf(TEXT("%d-%d:%d"), BinMin, BinMin + BinWidth - 1,
+										  Bins[BinIdx]));
+	}
+
+	return FString::Printf(TEXT("min=%d mean=%.2f max=%d [%s]"), Min, double(Sum) / Counts.Num(),
+						   Max, *FString::Join(BinStrs, TEXT(" ")));
 }
 
 float AIGVGraphActor::GetSphereRadius() const
@@ -231,6 +1057,14 @@ void AIGVGraphActor::SetSphereRadius(float Radius)
 	SphereComponent->InitSphereRadius(Radius);
 }
 
+void AIGVGraphActor::SetEdgeBundleLODHeight(int32 Height)
+{
+	if (EdgeBundleLODHeight == Height) return;
+
+	EdgeBundleLODHeight = Height;
+	bUpdateDefaultEdgeMeshRequired = true;
+}
+
 FVector AIGVGraphActor::Project(FVector2D const& P) const
 {
 	switch (ProjectionMode)
@@ -262,6 +1096,8 @@ void AIGVGraphActor::UpdatePlanarExtent()
 
 void AIGVGraphActor::NormalizeNodePosition()
 {
+	SCOPE_CYCLE_COUNTER(STAT_IGV_Projection);
+
 	UpdatePlanarExtent();
 
 	FBox2D Bounds(ForceInitToZero);
@@ -270,19 +1106,20 @@ void AIGVGraphActor::NormalizeNodePosition()
 		Bounds += Node->Pos2D;
 	}
 
-	FVector2D const BoundCenter = Bounds.GetCenter();
-	FVector2D const BoundExtent = Bounds.GetExtent();
+	NormalizedBoundCenter = Bounds.GetCenter();
+	NormalizedBoundExtent = Bounds.GetExtent();
 
 	for (AIGVNodeActor* const Node : Nodes)
 	{
 		FVector2D& P = Node->Pos2D;
-		P -= BoundCenter;
-		P /= BoundExtent;
+		P -= NormalizedBoundCenter;
+		P /= NormalizedBoundExtent;
 		P *= PlanarExtent;
-		Node->SetPos3D();
 	}
+	UpdateNodeTransforms(Nodes);
 
 	RootCluster->SetPosNonLeaf();
+	SemanticZoom.MarkLayoutChanged();
 
 	bUpdateDefaultEdgeMeshRequired = true;
 }
@@ -297,18 +1134,22 @@ void AIGVGraphActor::UpdateTreemapLayout()
 	NormalizeNodePosition();
 }
 
-void AIGVGraphActor::SetupEdgeMeshes()
+void AIGVGraphActor::UpdateSplineControlPoints()
 {
+	IGV_TRACE_SCOPE("UpdateSplineControlPoints");
+
 	FGraphEventArray Tasks;
 	for (FIGVEdge& Edge : Edges)
 	{
 		Tasks.Add(FKWTask<>::ConstructAndDispatchWhenReady([&]() {
-			// Edge.UpdateRenderGroup();
 			Edge.UpdateSplineControlPoints();
 		}));
 	}
 	FTaskGraphInterface::Get().WaitUntilTasksComplete(Tasks);
+}
 
+void AIGVGraphActor::SetupEdgeMeshes()
+{
 	DefaultEdgeGroupMeshComponent->Setup();
 	bUpdateDefaultEdgeMeshRequired = false;
 
@@ -318,54 +1159,113 @@ void AIGVGraphActor::SetupEdgeMeshes()
 
 void AIGVGraphActor::UpdateEdgeMeshes()
 {
+	SCOPE_CYCLE_COUNTER(STAT_IGV_EdgeMeshUpdate);
+	IGV_TRACE_SCOPE("UpdateEdgeMeshes");
+
 	EdgeUpdateTasks.Reset();
+	DirtyEdgeIdxs.Reset();
+	PatchedEdgeIdxs.Reset();
+
+	uint8* const EdgeFlags = EdgeStore.Flags.GetData();
+	int32 const NumEdges = EdgeStore.Num();
 
 	if (bUpdateDefaultEdgeMeshRequired)
 	{
-		for (FIGVEdge& Edge : Edges)
-		{
-			EdgeUpdateTasks.Add(FKWTask<>::ConstructAndDispatchWhenReady(
-				[&]() { Edge.UpdateDefaultSplineControlPoints(); }));
-		}
-		FTaskGraphInterface::Get().WaitUntilTasksComplete(EdgeUpdateTasks);
-		DefaultEdgeGroupMeshComponent->Update();
+		// The default mesh is rebuilt over several frames, and shown as is until then. Its tasks
+		// take the default control points of the edges as they go, so only the edges of the other
+		// groups, whose control points are kept in the edge store, are updated right away.
+		DefaultEdgeGroupMeshComponent->BeginIncrementalUpdate();
 		bUpdateDefaultEdgeMeshRequired = false;
 
-		EdgeUpdateTasks.Reset();
+		for (int32 EdgeIdx = 0; EdgeIdx < NumEdges; EdgeIdx++)
+		{
+			EdgeFlags[EdgeIdx] &= ~EIGVEdgeFlags::UpdateDefaultMeshRequired;
+		}
 
-		for (FIGVEdge& Edge : Edges)
+		for (int32 const EdgeIdx :
+			 EdgeStore.GetRenderGroupEdgeIdxs(EIGVEdgeRenderGroup::Highlighted))
 		{
-			EdgeUpdateTasks.Add(FKWTask<>::ConstructAndDispatchWhenReady([&]() {
-				Edge.UpdateRenderGroup();
-				Edge.UpdateSplineControlPoints();
-				Edge.bUpdateMeshRequired = false;
-			}));
+			EdgeFlags[EdgeIdx] |= EIGVEdgeFlags::UpdateMeshRequired;
+		}
+		for (int32 const EdgeIdx : EdgeStore.GetRenderGroupEdgeIdxs(EIGVEdgeRenderGroup::Remained))
+		{
+			EdgeFlags[EdgeIdx] |= EIGVEdgeFlags::UpdateMeshRequired;
 		}
-		FTaskGraphInterface::Get().WaitUntilTasksComplete(EdgeUpdateTasks);
-		HighlightedEdgeGroupMeshComponent->Update();
-		RemainedEdgeGroupMeshComponent->Update();
 	}
-	else
+
+	DefaultEdgeGroupMeshComponent->TickIncrementalUpdate(EdgeMeshUpdateBudget * 0.001);
+
+	// Edges edited while the default mesh is rebuilt keep their flag, and are patched in once it
+	// is shown. The update may have passed them already.
+	bool const bPatchDefaultEdgeMesh =
+		!DefaultEdgeGroupMeshComponent->IsIncrementalUpdateInProgress();
+
+	// One pass over the flags. Tasks then only touch the edges that changed. The render groups
+	// of these follow from their highlight state and transition flag, and are updated here rather
+	// than in the tasks, since that moves the edges between the group lists.
+	for (int32 EdgeIdx = 0; EdgeIdx < NumEdges; EdgeIdx++)
 	{
-		for (FIGVEdge& Edge : Edges)
+		if (EdgeFlags[EdgeIdx] & EIGVEdgeFlags::UpdateMeshRequired)
 		{
-			if (Edge.bUpdateMeshRequired)
+			EdgeFlags[EdgeIdx] &= ~EIGVEdgeFlags::UpdateMeshRequired;
+			if (EdgeStore.UpdateRenderGroup(EdgeIdx))
 			{
-				EdgeUpdateTasks.Add(FKWTask<>::ConstructAndDispatchWhenReady([&]() {
-					Edge.UpdateRenderGroup();
-					Edge.UpdateSplineControlPoints();
-					Edge.bUpdateMeshRequired = false;
-				}));
+				DefaultEdgeGroupMeshComponent->MarkDrawStateDirty();
 			}
+			DirtyEdgeIdxs.Add(EdgeIdx);
 		}
-		FTaskGraphInterface::Get().WaitUntilTasksComplete(EdgeUpdateTasks);
 
-		if (EdgeUpdateTasks.Num() > 0)
+		if (bPatchDefaultEdgeMesh &&
+			(EdgeFlags[EdgeIdx] & EIGVEdgeFlags::UpdateDefaultMeshRequired))
 		{
-			HighlightedEdgeGroupMeshComponent->Update();
-			RemainedEdgeGroupMeshComponent->Update();
+			EdgeFlags[EdgeIdx] &= ~EIGVEdgeFlags::UpdateDefaultMeshRequired;
+			PatchedEdgeIdxs.Add(EdgeIdx);
 		}
 	}
+
+	static int32 const NumEdgesPerTask = 64;
+	for (int32 BeginIdx = 0; BeginIdx < DirtyEdgeIdxs.Num(); BeginIdx += NumEdgesPerTask)
+	{
+		int32 const EndIdx = FMath::Min(BeginIdx + NumEdgesPerTask, DirtyEdgeIdxs.Num());
+		EdgeUpdateTasks.Add(FKWTask<>::ConstructAndDispatchWhenReady([this, BeginIdx, EndIdx]() {
+			SCOPE_CYCLE_COUNTER(STAT_IGV_ControlPointUpdate);
+			IGV_TRACE_SCOPE("Edge Update Task");
+			for (int32 Idx = BeginIdx; Idx < EndIdx; Idx++)
+			{
+				Edges[DirtyEdgeIdxs[Idx]].UpdateSplineControlPoints();
+			}
+		}));
+	}
+	{
+		IGV_TRACE_SCOPE("Wait Edge Update Tasks");
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(EdgeUpdateTasks);
+	}
+	INC_DWORD_STAT_BY(STAT_IGV_NumEdgesUpdated, DirtyEdgeIdxs.Num());
+
+	// Edges changed by incremental edits. If they cannot be patched in, the whole default mesh is
+	// rebuilt from the next frame on.
+	if (PatchedEdgeIdxs.Num() > 0 && !DefaultEdgeGroupMeshComponent->PatchEdges(PatchedEdgeIdxs))
+	{
+		bUpdateDefaultEdgeMeshRequired = true;
+	}
+
+	if (DirtyEdgeIdxs.Num() > 0 || bUpdateHighlightedEdgeMeshesRequired)
+	{
+		HighlightedEdgeGroupMeshComponent->TransitionAlpha = TransitionManager.Alpha;
+		HighlightedEdgeGroupMeshComponent->Update();
+		RemainedEdgeGroupMeshComponent->TransitionAlpha = TransitionManager.Alpha;
+		RemainedEdgeGroupMeshComponent->Update();
+		bUpdateHighlightedEdgeMeshesRequired = false;
+	}
+	else
+	{
+		// In transition, only the interpolation alpha of spline levels changes.
+		HighlightedEdgeGroupMeshComponent->SetTransitionAlpha(TransitionManager.Alpha);
+		RemainedEdgeGroupMeshComponent->SetTransitionAlpha(TransitionManager.Alpha);
+	}
+
+	// Edges that left or joined the default group this frame
+	DefaultEdgeGroupMeshComponent->UpdateDrawState();
 }
 
 void AIGVGraphActor::UpdateColors()
@@ -383,6 +1283,7 @@ void AIGVGraphActor::UpdateColors()
 			Idx++;
 		}
 	});
+	SemanticZoom.MarkLayoutChanged();
 
 	bUpdateDefaultEdgeMeshRequired = true;
 }
@@ -423,6 +1324,9 @@ void AIGVGraphActor::UpdateInteraction()
 {
 	if (PickRayDistSortedNodes.Num() == 0) return;
 
+	SCOPE_CYCLE_COUNTER(STAT_IGV_PickUpdate);
+	IGV_TRACE_SCOPE("UpdateInteraction");
+
 	UpdateNodeDistanceToPickRay();
 	AIGVNodeActor* const NearestNode = PickRayDistSortedNodes[0];
 
@@ -477,8 +1381,11 @@ void AIGVGraphActor::UpdateNodeDistanceToPickRay()
 
 	for (AIGVNodeActor* const Node : Nodes)
 	{
-		Node->DistanceToPickRay = FMath::PointDistToLine(
-			Node->GetActorLocation(), Pawn->PickRayDirection, Pawn->PickRayOrigin);
+		// Nodes within a collapsed cluster are not picked.
+		Node->DistanceToPickRay =
+			Node->bHidden ? FLT_MAX : FMath::PointDistToLine(Node->GetActorLocation(),
+															 Pawn->PickRayDirection,
+															 Pawn->PickRayOrigin);
 	}
 
 	PickRayDistSortedNodes.Sort([](AIGVNodeActor const& A, AIGVNodeActor const& B) {
@@ -488,6 +1395,14 @@ void AIGVGraphActor::UpdateNodeDistanceToPickRay()
 
 void AIGVGraphActor::OnLeftMouseButtonReleased()
 {
+	// A meta-node is expanded one level on click.
+	int32 const PickedClusterIdx = SemanticZoom.FindPickedMetaNode();
+	if (PickedClusterIdx != INDEX_NONE)
+	{
+		SemanticZoom.ExpandCluster(PickedClusterIdx);
+		return;
+	}
+
 	if (LastPickedNode != nullptr)
 	{
 		LastPickedNode->OnLeftMouseButtonReleased();
@@ -503,3 +1418,13 @@ void AIGVGraphActor::SetHalo(bool const bValue)
 		PostProcessComponent->Settings.AddBlendable(OutlineMaterialInstance, 1.0);
 	}
 }
+
+void AIGVGraphActor::UpdateMemoryStats() const
+{
+	FIGVMemoryUsage const MemoryUsage(this);
+	SET_MEMORY_STAT(STAT_IGV_NodeMemory, MemoryUsage.Nodes);
+	SET_MEMORY_STAT(STAT_IGV_EdgeMemory, MemoryUsage.Edges);
+	SET_MEMORY_STAT(STAT_IGV_ClusterMemory, MemoryUsage.Clusters);
+	SET_MEMORY_STAT(STAT_IGV_ArenaMemory, MemoryUsage.Arena);
+	SET_DWORD_STAT(STAT_IGV_NumArenaAllocations, GraphArena.GetNumAllocations());
+}
@@ -5,9 +5,18 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 
+#include "IGVAdjacency.h"
+#include "IGVArena.h"
 #include "IGVCluster.h"
+#include "IGVDeltaIngestion.h"
+#include "IGVDeltaProducer.h"
 #include "IGVEdge.h"
+#include "IGVEdgeStore.h"
+#include "IGVLabelPool.h"
 #include "IGVProjection.h"
+#include "IGVSemanticZoom.h"
+#include "IGVTemporalPlayer.h"
+#include "IGVTransitionManager.h"
 
 #include "IGVGraphActor.generated.h"
 
@@ -41,17 +50,44 @@ public:
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadWrite, Category = ImmersiveGraphVisualization)
 	class UIGVEdgeMeshComponent* RemainedEdgeGroupMeshComponent;
 
+	// Meta-edges of SemanticZoom
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadWrite, Category = ImmersiveGraphVisualization)
+	class ULineBatchComponent* MetaEdgeLineBatchComponent;
+
+	// Node actors without a halo
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadWrite, Category = ImmersiveGraphVisualization)
+	class UIGVNodeMeshComponent* NodeMeshComponent;
+
+	// Node actors with a halo, rendering custom depth
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadWrite, Category = ImmersiveGraphVisualization)
+	class UIGVNodeMeshComponent* HaloNodeMeshComponent;
+
+	// Labels of the picked and highlighted nodes
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadWrite, Category = ImmersiveGraphVisualization)
+	class UIGVLabelComponent* LabelComponent;
+
 	UPROPERTY()
 	class UMaterialInstanceDynamic* OutlineMaterialInstance;
 
 public:
 	TArray<class AIGVNodeActor*> Nodes;
 	TArray<FIGVEdge> Edges;
+	FIGVEdgeStore EdgeStore;  // Per-frame data of Edges
+	FIGVAdjacency Adjacency;  // Neighbors and incident edges of Nodes
+	FIGVLabelPool LabelPool;  // Labels of Nodes, see AIGVNodeActor::LabelId
 	TArray<FIGVCluster> Clusters;
 	FIGVCluster* RootCluster;
+	TArray<int32> FreeClusterIdxs;  // Detached leaf clusters of removed nodes, reused by AddNode
+
+	// Backs the children arrays of Clusters; released by EmptyGraph
+	FIGVArena GraphArena;
 
 	FVector2D PlanarExtent;
 
+	// Treemap bounds mapped to PlanarExtent by NormalizeNodePosition, reused by incremental edits
+	FVector2D NormalizedBoundCenter;
+	FVector2D NormalizedBoundExtent;
+
 	UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, SaveGame,
 			  Category = ImmersiveGraphVisualization,
 			  meta = (UIMin = "1.0", UIMax = "360", ClampMin = "1", ClampMax = "360.0"))
@@ -99,6 +135,45 @@ public:
 			  Category = ImmersiveGraphVisualization)
 	float EdgeBundlingStrength;
 
+	// Game thread time spent per frame on rebuilding the default edge mesh. Zero or less rebuilds
+	// it within a single frame.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame,
+			  Category = ImmersiveGraphVisualization)
+	float EdgeMeshUpdateBudget;  // in milliseconds
+
+	// Level of detail of the default edge mesh. Edges whose lowest common ancestor is at least
+	// this high (and at least 2) are drawn as one tube per pair of clusters below the ancestor,
+	// see UIGVEdgeMeshComponent. Zero or less draws every edge.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, SaveGame, Category = ImmersiveGraphVisualization)
+	int32 EdgeBundleLODHeight;
+
+	// Game thread time spent per frame on applying ingested deltas, see FIGVDeltaIngestion. Zero
+	// or less applies all pending deltas within a single frame.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame,
+			  Category = ImmersiveGraphVisualization)
+	float DeltaIngestionBudget;  // in milliseconds
+
+	// Points of a temporal step at which the edges of the moving nodes are updated, see
+	// FIGVTemporalPlayer. Zero or less updates them every frame.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame,
+			  Category = ImmersiveGraphVisualization)
+	int32 TemporalEdgeSamplesPerStep;
+
+	// Clusters of height h are collapsed into meta-nodes farther than h times this angle from the
+	// view direction, see FIGVSemanticZoom. Zero or less keeps the cut, to be changed by
+	// CollapseCluster and ExpandCluster.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame,
+			  Category = ImmersiveGraphVisualization)
+	float SemanticZoomFocusAngle;  // in degrees
+
+	// Node actors kept for reuse after the graph is emptied or a node removed, at most this many
+	// times the number of nodes; trimmed after a load or an incremental edit. Zero or less
+	// destroys them instead.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ImmersiveGraphVisualization)
+	float NodeActorPoolSlack;
+
+	TArray<class AIGVNodeActor*> NodeActorPool;  // Deactivated, see ReleaseNodeActor
+
 	UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, SaveGame,
 			  Category = ImmersiveGraphVisualization)
 	float ColorHueMin;
@@ -136,17 +211,42 @@ public:
 	UPROPERTY(Interp, EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraph)
 	float NeighborHighlightedLevelScale;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = ImmersiveGraph,
+			  meta = (ClampMin = "0.0", UIMin = "0.0", UIMax = "2.0"))
+	float HighlightTransitionDuration;  // in seconds
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ImmersiveGraph)
+	class UCurveFloat* HighlightTransitionCurve;  // Ease-in-out if not specified
+
+	FIGVTransitionManager TransitionManager;
+
+	FIGVDeltaIngestion DeltaIngestion;
+	TUniquePtr<FIGVDeltaProducer> DeltaProducer;  // Stand-in producer for DeltaIngestion
+
+	FIGVTemporalPlayer TemporalPlayer;  // Of a graph loaded from a .igvt.json file
+
+	FIGVSemanticZoom SemanticZoom;
+
 	FGraphEventArray EdgeUpdateTasks;
+	TArray<int32> DirtyEdgeIdxs;  // Edges updated by EdgeUpdateTasks
+	TArray<int32> PatchedEdgeIdxs;  // Edges patched into the default mesh after incremental edits
 	bool bUpdateDefaultEdgeMeshRequired;
+	bool bUpdateHighlightedEdgeMeshesRequired;
 
 public:
 	AIGVGraphActor();
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(EEndPlayReason::Type const EndPlayReason) override;
 
 public:
 	virtual void Tick(float DeltaTime) override;
+	virtual void Destroyed() override;
+
+	// Begin UObject interface.
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+	// End UObject interface.
 
 	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
 	void EmptyGraph();
@@ -154,12 +254,80 @@ public:
 	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
 	void SetupGraph();
 
+	// Incremental edits of a loaded graph. Only the affected adjacency rows, edge cluster paths,
+	// treemap subtree and edge mesh ranges are updated; ancestors of the re-laid out subtree keep
+	// their positions until the next full layout. A node is a leaf of a cluster of height 1.
+	// Edge and node indices are kept dense: a removed edge or node is replaced by the last one.
+
+	// Returns the index of the new node, or INDEX_NONE if the parent cluster is not valid.
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	int32 AddNode(FString const& Label, int32 ParentClusterIdx);
+
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	bool RemoveNode(int32 NodeIdx);
+
+	// Returns the index of the new edge, or INDEX_NONE for invalid endpoints or a self-loop.
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	int32 AddEdge(int32 SourceIdx, int32 TargetIdx);
+
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	bool RemoveEdge(int32 EdgeIdx);
+
+	// Moves the node to another cluster of height 1, and re-routes its edges.
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	bool MoveNode(int32 NodeIdx, int32 ParentClusterIdx);
+
+	// Also recolors the edges of the node, which are shaded by the colors of their endpoints.
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	bool SetNodeColor(int32 NodeIdx, FLinearColor Color);
+
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	bool SetNodeLabel(int32 NodeIdx, FString const& Label);
+
+	// Returns an edge between the nodes in either direction, or INDEX_NONE if there is none.
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	int32 FindEdge(int32 NodeIdx, int32 OtherNodeIdx) const;
+
+	// Playback of a temporal dataset, in steps from the first keyframe
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	int32 GetNumTemporalSteps() const;
+
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	float GetTemporalTime() const;
+
+	// Pauses the playback
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	void SeekTemporal(float Time);
+
+	// A negative rate plays backward, zero pauses.
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	void PlayTemporal(float StepsPerSecond);
+
+	// Semantic zoom, see FIGVSemanticZoom. The view replaces the cut while SemanticZoomFocusAngle
+	// is positive.
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	bool CollapseCluster(int32 ClusterIdx);
+
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	bool ExpandCluster(int32 ClusterIdx);
+
+	// Collapses every cluster of the given height, expanding all others
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	bool CollapseClusters(int32 Height);
+
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	void ExpandAllClusters();
+
 	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
 	float GetSphereRadius() const;
 
 	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
 	void SetSphereRadius(float Radius);
 
+	// Rebuilds the default edge mesh with the new level of detail
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	void SetEdgeBundleLODHeight(int32 Height);
+
 	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
 	FVector Project(FVector2D const& P) const;
 
@@ -178,18 +346,48 @@ public:
 	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
 	void SetHalo(bool const bValue);
 
-protected:
+	void UpdateMemoryStats() const;
+
+	// Spawned attached to this actor, or taken from NodeActorPool, but not added to Nodes. A
+	// spawn with deferred construction is finished when the node is first positioned, see
+	// AIGVNodeActor::ApplyTransform.
+	class AIGVNodeActor* SpawnNodeActor(bool const bDeferConstruction = false);
+	// Deactivates the node actor into NodeActorPool, or destroys it if pooling is disabled. The
+	// node actor must no longer be in Nodes.
+	void ReleaseNodeActor(class AIGVNodeActor* const Node);
+	// Destroys the pooled node actors beyond NodeActorPoolSlack
+	void TrimNodeActorPool();
+
+	// Projects Pos2D of the nodes in parallel tasks, then moves them in one pass on the game
+	// thread. Waits for the default edge mesh tasks, so the clusters can be moved afterward.
+	void UpdateNodeTransforms(TArrayView<class AIGVNodeActor* const> const InNodes);
+
+	// Stages of SetupGraph and Tick, also run one by one by UIGVBenchmarkCommandlet
 	void SetupNodes();
 	void SetupEdges();
 	void SetupClusters();
-
+	void UpdateColors();
+	void UpdateSplineControlPoints();
 	void SetupEdgeMeshes();
 	void UpdateEdgeMeshes();
 
-	void UpdateColors();
+protected:
+	// Parts of the incremental edits
+	void BeginGraphEdit();
+	void EndGraphEdit();
+	bool IsValidParentCluster(int32 const ClusterIdx) const;
+	FIGVCluster& AddLeafCluster(class AIGVNodeActor* const Node);
+	void AttachLeafCluster(FIGVCluster& Leaf, FIGVCluster& Parent);
+	void DetachLeafCluster(FIGVCluster& Leaf);
+	void RebaseClusterPointers(FIGVCluster const* const OldClusters);
+	void RelayoutCluster(FIGVCluster& Cluster);
+	void RefreshEdge(int32 const EdgeIdx);
 
 	void ResetAmbientOcclusion();
 
 	void UpdateInteraction();
 	void UpdateNodeDistanceToPickRay();
+
+	// Min, mean, max and a histogram of NumBins equal-width bins, for setup logs
+	static FString SummarizeCounts(TArray<int32> const& Counts, int32 const NumBins);
 };
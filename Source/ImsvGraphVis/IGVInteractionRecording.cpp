@@ -0,0 +1,111 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVInteractionRecording.h"
+
+#include "FileHelper.h"
+#include "Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "IGVLog.h"
+
+static uint32 const IGVInteractionRecordingMagic = 0x52564749;  // "IGVR"
+static int32 const IGVInteractionRecordingVersion = 1;
+
+FArchive& operator<<(FArchive& Ar, FIGVInteractionFrame& Frame)
+{
+	uint8 Flags = Frame.bLeftMouseButtonReleased ? 1 : 0;
+
+	Ar << Frame.Time << Frame.PickRayRotation << Frame.PickRayOrigin << Flags;
+
+	Frame.bLeftMouseButtonReleased = (Flags & 1) != 0;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FIGVInteractionRecording& Recording)
+{
+	uint32 Magic = IGVInteractionRecordingMagic;
+	int32 Version = IGVInteractionRecordingVersion;
+
+	Ar << Magic << Version;
+	if (Ar.IsLoading() &&
+		(Magic != IGVInteractionRecordingMagic || Version != IGVInteractionRecordingVersion))
+	{
+		Ar.SetError();
+		return Ar;
+	}
+
+	Ar << Recording.NumNodes << Recording.NumEdges << Recording.Frames;
+	return Ar;
+}
+
+FIGVInteractionRecording::FIGVInteractionRecording() : NumNodes(0), NumEdges(0), Frames()
+{
+}
+
+void FIGVInteractionRecording::Reset()
+{
+	NumNodes = 0;
+	NumEdges = 0;
+	Frames.Reset();
+}
+
+float FIGVInteractionRecording::Duration() const
+{
+	return Frames.Num() > 0 ? Frames.Last().Time : 0.f;
+}
+
+bool FIGVInteractionRecording::Save(FString const& FilePath) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Writer << const_cast<FIGVInteractionRecording&>(*this);
+
+	if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+	{
+		IGV_LOG_S(Error, TEXT("Unable to write %s"), *FilePath);
+		return false;
+	}
+
+	IGV_LOG(Log, TEXT("Saved %d frames (%.1f s) to %s"), Frames.Num(), Duration(), *FilePath);
+	return true;
+}
+
+bool FIGVInteractionRecording::Load(FString const& FilePath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		IGV_LOG_S(Error, TEXT("Unable to read %s"), *FilePath);
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	Reader << *this;
+	if (Reader.IsError())
+	{
+		IGV_LOG_S(Error, TEXT("%s is not an interaction recording of this version"), *FilePath);
+		Reset();
+		return false;
+	}
+
+	IGV_LOG(Log, TEXT("Loaded %d frames (%.1f s) from %s"), Frames.Num(), Duration(), *FilePath);
+	return true;
+}
+
+FString FIGVInteractionRecording::DefaultDirPath()
+{
+	return FPaths::Combine(*FPaths::GameSavedDir(), TEXT("Recordings/"));
+}
+
+FString FIGVInteractionRecording::ResolveFilePath(FString const& FileName)
+{
+	FString FilePath = FPaths::IsRelative(FileName)
+						   ? FPaths::Combine(*DefaultDirPath(), *FileName)
+						   : FileName;
+	if (FPaths::GetExtension(FilePath).IsEmpty())
+	{
+		FilePath += TEXT(".igvrec");
+	}
+	return FilePath;
+}
@@ -0,0 +1,51 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace EIGVInteractionMode
+{
+enum Type
+{
+	Live,
+	Recording,
+	Replaying
+};
+}
+
+// Pick ray and button state of one pawn tick
+struct IMSVGRAPHVIS_API FIGVInteractionFrame
+{
+	float Time;  // Since the beginning of the recording, in seconds
+	FRotator PickRayRotation;
+	FVector PickRayOrigin;
+	bool bLeftMouseButtonReleased;
+
+	friend FArchive& operator<<(FArchive& Ar, FIGVInteractionFrame& Frame);
+};
+
+// Input of an interaction session, recorded and replayed by AIGVPawn. The graph is not stored;
+// replaying against a different graph is allowed but logged.
+struct IMSVGRAPHVIS_API FIGVInteractionRecording
+{
+	int32 NumNodes;
+	int32 NumEdges;
+	TArray<FIGVInteractionFrame> Frames;
+
+	FIGVInteractionRecording();
+
+	void Reset();
+
+	float Duration() const;
+
+	bool Save(FString const& FilePath) const;
+	bool Load(FString const& FilePath);
+
+	static FString DefaultDirPath();
+
+	// Relative paths and bare names are resolved against DefaultDirPath, with an .igvrec extension
+	static FString ResolveFilePath(FString const& FileName);
+
+	friend FArchive& operator<<(FArchive& Ar, FIGVInteractionRecording& Recording);
+};
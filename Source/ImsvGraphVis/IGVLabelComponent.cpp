@@ -0,0 +1,363 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVLabelComponent.h"
+
+#include "DynamicMeshBuilder.h"
+#include "Engine/Font.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Runtime/CoreUObject/Public/UObject/ConstructorHelpers.h"
+
+#include "IGVGraphActor.h"
+#include "IGVLabelSceneProxy.h"
+#include "IGVLog.h"
+#include "IGVNodeActor.h"
+#include "IGVStats.h"
+#include "IGVTrace.h"
+
+UFont* GetLabelFont()
+{
+	static ConstructorHelpers::FObjectFinder<UFont> FontAsset(
+		TEXT("/Engine/EngineFonts/RobotoDistanceField"));
+	return FontAsset.Succeeded() ? FontAsset.Object : nullptr;
+}
+
+UMaterialInterface* GetLabelMaterial()
+{
+	static ConstructorHelpers::FObjectFinder<UMaterial> MaterialAsset(
+		TEXT("/Engine/EngineMaterials/DefaultTextMaterialOpaque"));
+	return MaterialAsset.Succeeded() ? MaterialAsset.Object->GetMaterial() : nullptr;
+}
+
+uint32 FIGVLabelFrame::GetAllocatedSize() const
+{
+	return Labels.GetAllocatedSize() + Glyphs.GetAllocatedSize();
+}
+
+UIGVLabelComponent::UIGVLabelComponent()
+	: GraphActor(nullptr),
+	  Font(nullptr),
+	  TextMaterial(nullptr),
+	  WorldSize(20.f),
+	  LabelOffset(20.f, 12.f),
+	  MaxNumCachedLabels(64),
+	  Frame(nullptr),
+	  Nodes(),
+	  Labels(),
+	  Glyphs(),
+	  CachedLabels(),
+	  NumUnusedGlyphs(0)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	CastShadow = false;
+
+	Font = GetLabelFont();
+	TextMaterial = GetLabelMaterial();
+}
+
+void UIGVLabelComponent::Init(AIGVGraphActor* const InGraphActor)
+{
+	GraphActor = InGraphActor;
+
+	if (Font == nullptr || TextMaterial == nullptr) return;
+
+	if (Font->FontCacheType != EFontCacheType::Offline)
+	{
+		IGV_LOG(Warning, TEXT("Label font %s has no glyph atlas"), *Font->GetName());
+		return;
+	}
+
+	TArray<FName> FontParameterNames;
+	TArray<FGuid> FontParameterIds;
+	TextMaterial->GetMaterial()->GetAllFontParameterNames(FontParameterNames, FontParameterIds);
+
+	for (int32 Page = 0; Page < Font->Textures.Num(); Page++)
+	{
+		UMaterialInstanceDynamic* const MaterialInstance =
+			UMaterialInstanceDynamic::Create(TextMaterial, this);
+		if (MaterialInstance == nullptr) continue;
+
+		for (FName const& FontParameterName : FontParameterNames)
+		{
+			MaterialInstance->SetFontParameterValue(FontParameterName, Font, Page);
+		}
+		SetMaterial(Page, MaterialInstance);
+	}
+}
+
+void UIGVLabelComponent::Reset()
+{
+	for (AIGVNodeActor* const Node : Nodes)
+	{
+		Node->LabelIdx = INDEX_NONE;
+	}
+
+	// Label ids are those of the graph, emptied along with it.
+	Nodes.Reset();
+	Labels.Reset();
+	Glyphs.Reset();
+	CachedLabels.Reset();
+	NumUnusedGlyphs = 0;
+
+	MarkRenderDynamicDataDirty();
+	SET_DWORD_STAT(STAT_IGV_NumShownLabels, 0);
+}
+
+uint32 UIGVLabelComponent::GetAllocatedSize() const
+{
+	return Nodes.GetAllocatedSize() + Labels.GetAllocatedSize() + Glyphs.GetAllocatedSize() +
+		   CachedLabels.GetAllocatedSize() + (Frame.IsValid() ? Frame->GetAllocatedSize() : 0);
+}
+
+uint32 UIGVLabelComponent::GetGPUMemorySize() const
+{
+	uint32 NumGlyphs = 0;
+	for (FIGVLabel const& Label : Labels)
+	{
+		NumGlyphs += Label.NumGlyphs;
+	}
+
+	// Four vertices and two triangles each, see FIGVLabelSceneProxy
+	return NumGlyphs * (4 * sizeof(FDynamicMeshVertex) + 6 * sizeof(int32));
+}
+
+void UIGVLabelComponent::ShowLabel(AIGVNodeActor* const Node)
+{
+	if (Node->LabelIdx != INDEX_NONE) return;
+
+	FIGVLabel Label;
+	Label.Anchor = GetAnchor(Node);
+	SetGlyphs(Label, Node);
+
+	Node->LabelIdx = Labels.Add(Label);
+	Nodes.Add(Node);
+
+	MarkRenderDynamicDataDirty();
+	SET_DWORD_STAT(STAT_IGV_NumShownLabels, Labels.Num());
+}
+
+void UIGVLabelComponent::HideLabel(AIGVNodeActor* const Node)
+{
+	int32 const LabelIdx = Node->LabelIdx;
+	if (LabelIdx == INDEX_NONE) return;
+
+	CacheGlyphs(Labels[LabelIdx]);
+
+	Labels.RemoveAtSwap(LabelIdx, 1, false);
+	Nodes.RemoveAtSwap(LabelIdx, 1, false);
+	if (Nodes.IsValidIndex(LabelIdx))
+	{
+		Nodes[LabelIdx]->LabelIdx = LabelIdx;
+	}
+	Node->LabelIdx = INDEX_NONE;
+
+	CompactIfRequired();
+
+	MarkRenderDynamicDataDirty();
+	SET_DWORD_STAT(STAT_IGV_NumShownLabels, Labels.Num());
+}
+
+void UIGVLabelComponent::UpdateText(AIGVNodeActor* const Node)
+{
+	if (Node->LabelIdx == INDEX_NONE) return;
+
+	FIGVLabel& Label = Labels[Node->LabelIdx];
+	if (Label.LabelId == Node->LabelId) return;
+
+	CacheGlyphs(Label);
+	SetGlyphs(Label, Node);
+	CompactIfRequired();
+
+	MarkRenderDynamicDataDirty();
+}
+
+void UIGVLabelComponent::UpdateAnchor(AIGVNodeActor* const Node)
+{
+	if (Node->LabelIdx == INDEX_NONE) return;
+
+	Labels[Node->LabelIdx].Anchor = GetAnchor(Node);
+
+	MarkRenderDynamicDataDirty();
+}
+
+FVector UIGVLabelComponent::GetAnchor(AIGVNodeActor const* const Node) const
+{
+	// Node actors are attached to the graph actor as this component is.
+	FVector const Location = Node->GetRootComponent()->RelativeLocation;
+	return Location - Location.GetSafeNormal() * LabelOffset.X;
+}
+
+void UIGVLabelComponent::SetGlyphs(FIGVLabel& Label, AIGVNodeActor const* const Node)
+{
+	Label.LabelId = Node->LabelId;
+	if (!TakeCachedGlyphs(Label)) LayOutGlyphs(Node->GetLabel(), Label);
+}
+
+void UIGVLabelComponent::LayOutGlyphs(TCHAR const* const Text, FIGVLabel& Label)
+{
+	Label.GlyphOffset = Glyphs.Num();
+	Label.NumGlyphs = 0;
+
+	if (Font == nullptr || Font->Characters.Num() == 0) return;
+
+	float const Scale = WorldSize / FMath::Max(1.f, Font->GetMaxCharHeight());
+	float X = 0.f;
+
+	for (TCHAR const* Cursor = Text; *Cursor != 0; Cursor++)
+	{
+		int32 const CharIdx = Font->RemapChar(*Cursor);
+		if (!Font->Characters.IsValidIndex(CharIdx)) continue;
+
+		FFontCharacter const& Char = Font->Characters[CharIdx];
+		UTexture2D const* const Texture = Font->Textures.IsValidIndex(Char.TextureIndex)
+											  ? Font->Textures[Char.TextureIndex]
+											  : nullptr;
+
+		if (Texture != nullptr && Char.USize > 0 && Char.VSize > 0)
+		{
+			FVector2D const InvTextureSize(1.f / Texture->GetSurfaceWidth(),
+										   1.f / Texture->GetSurfaceHeight());
+
+			FIGVLabelGlyph& Glyph = Glyphs[Glyphs.AddUninitialized()];
+			Glyph.Min = FVector2D(X, LabelOffset.Y + Char.VerticalOffset * Scale);
+			Glyph.Max = Glyph.Min + FVector2D(Char.USize, Char.VSize) * Scale;
+			Glyph.UVMin = FVector2D(Char.StartU, Char.StartV) * InvTextureSize;
+			Glyph.UVMax =
+				FVector2D(Char.StartU + Char.USize, Char.StartV + Char.VSize) * InvTextureSize;
+			Glyph.Page = Char.TextureIndex;
+			Label.NumGlyphs++;
+		}
+
+		X += (Char.USize + Font->Kerning) * Scale;
+	}
+
+	FVector2D const Center(.5f * X, 0.f);
+	for (int32 GlyphIdx = Label.GlyphOffset; GlyphIdx < Glyphs.Num(); GlyphIdx++)
+	{
+		Glyphs[GlyphIdx].Min -= Center;
+		Glyphs[GlyphIdx].Max -= Center;
+	}
+}
+
+void UIGVLabelComponent::ReleaseGlyphs(FIGVLabel const& Label)
+{
+	NumUnusedGlyphs += Label.NumGlyphs;
+}
+
+bool UIGVLabelComponent::TakeCachedGlyphs(FIGVLabel& Label)
+{
+	for (int32 CachedIdx = CachedLabels.Num() - 1; CachedIdx >= 0; CachedIdx--)
+	{
+		FIGVLabel const& CachedLabel = CachedLabels[CachedIdx];
+		if (CachedLabel.LabelId == Label.LabelId)
+		{
+			Label.GlyphOffset = CachedLabel.GlyphOffset;
+			Label.NumGlyphs = CachedLabel.NumGlyphs;
+			CachedLabels.RemoveAt(CachedIdx, 1, false);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UIGVLabelComponent::CacheGlyphs(FIGVLabel const& Label)
+{
+	bool const bIsCached = CachedLabels.ContainsByPredicate(
+		[&Label](FIGVLabel const& CachedLabel) { return CachedLabel.LabelId == Label.LabelId; });
+
+	if (bIsCached || MaxNumCachedLabels <= 0)
+	{
+		ReleaseGlyphs(Label);
+		return;
+	}
+
+	if (CachedLabels.Num() >= MaxNumCachedLabels)
+	{
+		ReleaseGlyphs(CachedLabels[0]);
+		CachedLabels.RemoveAt(0, 1, false);
+	}
+
+	CachedLabels.Add(Label);
+}
+
+void UIGVLabelComponent::CompactIfRequired()
+{
+	if (Labels.Num() == 0 && CachedLabels.Num() == 0)
+	{
+		Glyphs.Reset();
+		NumUnusedGlyphs = 0;
+		return;
+	}
+
+	if (NumUnusedGlyphs * 2 <= Glyphs.Num()) return;
+
+	TArray<FIGVLabelGlyph> CompactGlyphs;
+	CompactGlyphs.Reserve(Glyphs.Num() - NumUnusedGlyphs);
+
+	for (TArray<FIGVLabel>* const LabelArray : {&Labels, &CachedLabels})
+	{
+		for (FIGVLabel& Label : *LabelArray)
+		{
+			int32 const GlyphOffset = CompactGlyphs.Num();
+			CompactGlyphs.Append(Glyphs.GetData() + Label.GlyphOffset, Label.NumGlyphs);
+			Label.GlyphOffset = GlyphOffset;
+		}
+	}
+
+	Glyphs = MoveTemp(CompactGlyphs);
+	NumUnusedGlyphs = 0;
+}
+
+FIGVLabelFrameConstPtr UIGVLabelComponent::MakeFrame() const
+{
+	TSharedPtr<FIGVLabelFrame, ESPMode::ThreadSafe> const NewFrame =
+		MakeShareable(new FIGVLabelFrame());
+	NewFrame->Labels = Labels;
+	NewFrame->Glyphs = Glyphs;
+	return NewFrame;
+}
+
+void UIGVLabelComponent::SendRenderDynamicData_Concurrent()
+{
+	IGV_TRACE_SCOPE("SendLabelRenderDynamicData");
+
+	Frame = MakeFrame();
+
+	if (SceneProxy)
+	{
+		((FIGVLabelSceneProxy*)SceneProxy)->SendRenderDynamicData();
+	}
+}
+
+FBoxSphereBounds UIGVLabelComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	FBoxSphereBounds NewBounds;
+	NewBounds.Origin = FVector::ZeroVector;
+	NewBounds.BoxExtent = FVector(HALF_WORLD_MAX, HALF_WORLD_MAX, HALF_WORLD_MAX);
+	NewBounds.SphereRadius = FMath::Sqrt(3.0f * FMath::Square(HALF_WORLD_MAX));
+	return NewBounds;
+}
+
+FPrimitiveSceneProxy* UIGVLabelComponent::CreateSceneProxy()
+{
+	if (!Frame.IsValid()) Frame = MakeFrame();
+
+	return new FIGVLabelSceneProxy(this);
+}
+
+int32 UIGVLabelComponent::GetNumMaterials() const
+{
+	return Font != nullptr ? FMath::Max(1, Font->Textures.Num()) : 1;
+}
+
+void UIGVLabelComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetAllocatedSize());
+	CumulativeResourceSize.AddDedicatedVideoMemoryBytes(GetGPUMemorySize());
+}
@@ -0,0 +1,133 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "Components/MeshComponent.h"
+#include "CoreMinimal.h"
+
+#include "IGVLabelComponent.generated.h"
+
+// A glyph quad, in world units from the anchor of its label: X to the right and Y downward
+struct IMSVGRAPHVIS_API FIGVLabelGlyph
+{
+	FVector2D Min;
+	FVector2D Max;
+	FVector2D UVMin;
+	FVector2D UVMax;
+	int32 Page;  // Texture of the font, and material of the component
+};
+
+// The glyphs of a label are NumGlyphs elements from GlyphOffset of the glyph pool.
+struct IMSVGRAPHVIS_API FIGVLabel
+{
+	int32 LabelId;   // Text in AIGVGraphActor::LabelPool
+	FVector Anchor;  // Top center, in component space
+	int32 GlyphOffset;
+	int32 NumGlyphs;
+};
+
+// Shown labels as handed to the scene proxy, never modified afterward
+struct IMSVGRAPHVIS_API FIGVLabelFrame
+{
+	TArray<FIGVLabel> Labels;
+	TArray<FIGVLabelGlyph> Glyphs;
+
+	uint32 GetAllocatedSize() const;
+};
+
+typedef TSharedPtr<FIGVLabelFrame const, ESPMode::ThreadSafe> FIGVLabelFrameConstPtr;
+
+// Draws the labels of all node actors of a graph, as quads textured by the pages of an offline
+// cached font. Every page is a material of the component sharing the same glyph atlas, so the
+// labels are drawn in one draw call per page and view, facing the viewer.
+//
+// Only shown labels are kept: a node refers to its label by AIGVNodeActor::LabelIdx, and a
+// hidden label is swapped out of Labels. Glyphs are laid out when a label is shown or its text
+// changes; a node moving only updates the anchor of its label. The glyphs of the last
+// MaxNumCachedLabels hidden labels are kept by label id, so that a label shown again, such as
+// that of a node the pick ray passes over back and forth, is not laid out again. Glyphs of
+// labels evicted from the cache are left unused in the pool until it is compacted.
+UCLASS()
+class IMSVGRAPHVIS_API UIGVLabelComponent : public UMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	class AIGVGraphActor* GraphActor;
+
+	UPROPERTY(EditAnywhere, Category = ImmersiveGraphVisualization)
+	class UFont* Font;
+
+	UPROPERTY(EditAnywhere, Category = ImmersiveGraphVisualization)
+	class UMaterialInterface* TextMaterial;  // With a font parameter, instanced per font page
+
+	UPROPERTY(EditAnywhere, Category = ImmersiveGraphVisualization)
+	float WorldSize;  // Height of a line of text
+
+	UPROPERTY(EditAnywhere, Category = ImmersiveGraphVisualization)
+	FVector2D LabelOffset;  // From the node toward the center of the sphere, and downward
+
+	UPROPERTY(EditAnywhere, Category = ImmersiveGraphVisualization)
+	int32 MaxNumCachedLabels;  // Hidden labels whose glyphs are kept
+
+	FIGVLabelFrameConstPtr Frame;  // Shown by the scene proxy
+
+	TArray<class AIGVNodeActor*> Nodes;  // By label index
+	TArray<FIGVLabel> Labels;
+	TArray<FIGVLabelGlyph> Glyphs;
+
+protected:
+	TArray<FIGVLabel> CachedLabels;  // Hidden, least recently hidden first
+	int32 NumUnusedGlyphs;			 // Pool elements no longer in the range of any label
+
+public:
+	UIGVLabelComponent();
+
+	void Init(class AIGVGraphActor* const InGraphActor);
+	// Hides all labels
+	void Reset();
+
+	uint32 GetAllocatedSize() const;
+	// Of the quads of the shown glyphs, built per view and frame in the dynamic buffers of the
+	// renderer. The font textures are shared assets and not counted.
+	uint32 GetGPUMemorySize() const;
+
+	void ShowLabel(class AIGVNodeActor* const Node);
+	void HideLabel(class AIGVNodeActor* const Node);
+
+	// Lays out the text of a shown label again
+	void UpdateText(class AIGVNodeActor* const Node);
+	// Follows the node of a shown label
+	void UpdateAnchor(class AIGVNodeActor* const Node);
+
+	// Begin USceneComponent interface.
+	virtual void SendRenderDynamicData_Concurrent() override;
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+	// Begin USceneComponent interface.
+
+	// Begin UPrimitiveComponent interface.
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+	// End UPrimitiveComponent interface.
+
+	// Begin UMeshComponent interface.
+	virtual int32 GetNumMaterials() const override;
+	// End UMeshComponent interface.
+
+	// Begin UObject interface.
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+	// End UObject interface.
+
+protected:
+	FVector GetAnchor(class AIGVNodeActor const* const Node) const;
+	// Appends the glyphs of the text to the pool, centered horizontally.
+	void LayOutGlyphs(TCHAR const* const Text, FIGVLabel& Label);
+	void ReleaseGlyphs(FIGVLabel const& Label);
+	// Takes the glyphs of the label id from the cache, returns false if they are not cached.
+	bool TakeCachedGlyphs(FIGVLabel& Label);
+	// Keeps the glyphs of a hidden label, evicting the least recently hidden one if full
+	void CacheGlyphs(FIGVLabel const& Label);
+	void SetGlyphs(FIGVLabel& Label, class AIGVNodeActor const* const Node);
+	void CompactIfRequired();
+
+	FIGVLabelFrameConstPtr MakeFrame() const;
+};
@@ -0,0 +1,54 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVLabelPool.h"
+
+FIGVLabelPool::FIGVLabelPool() : Chars(), LabelIdsByHash()
+{
+}
+
+int32 FIGVLabelPool::Intern(TCHAR const* const Label)
+{
+	int32 const FoundLabelId = Find(Label);
+	if (FoundLabelId != INDEX_NONE) return FoundLabelId;
+
+	int32 const Len = FCString::Strlen(Label);
+	int32 const LabelId = Chars.AddUninitialized(Len + 1);
+	FMemory::Memcpy(Chars.GetData() + LabelId, Label, (Len + 1) * sizeof(TCHAR));
+
+	LabelIdsByHash.Add(FCrc::StrCrc32(Label), LabelId);
+	return LabelId;
+}
+
+int32 FIGVLabelPool::Find(TCHAR const* const Label) const
+{
+	TArray<int32, TInlineAllocator<4>> LabelIds;
+	LabelIdsByHash.MultiFind(FCrc::StrCrc32(Label), LabelIds);
+
+	for (int32 const LabelId : LabelIds)
+	{
+		if (FCString::Strcmp(Get(LabelId), Label) == 0) return LabelId;
+	}
+
+	return INDEX_NONE;
+}
+
+int32 FIGVLabelPool::Num() const
+{
+	return LabelIdsByHash.Num();
+}
+
+void FIGVLabelPool::Reserve(int32 const NumChars)
+{
+	Chars.Reserve(NumChars);
+}
+
+void FIGVLabelPool::Empty()
+{
+	Chars.Empty();
+	LabelIdsByHash.Empty();
+}
+
+uint32 FIGVLabelPool::GetAllocatedSize() const
+{
+	return Chars.GetAllocatedSize() + LabelIdsByHash.GetAllocatedSize();
+}
@@ -0,0 +1,37 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Node labels, interned as null-terminated strings back to back in one array. A label is
+// referred to by its id, the offset of its first character, so equal labels share an id and
+// nodes hold no string of their own. Labels are only added; the pool is emptied along with the
+// graph, see AIGVGraphActor::EmptyGraph.
+struct IMSVGRAPHVIS_API FIGVLabelPool
+{
+	TArray<TCHAR> Chars;
+
+	// Ids of the labels by the hash of their characters
+	TMultiMap<uint32, int32> LabelIdsByHash;
+
+public:
+	FIGVLabelPool();
+
+	// Id of the label, added if it is not in the pool yet. Case-sensitive.
+	int32 Intern(TCHAR const* const Label);
+	// INDEX_NONE if the label is not in the pool
+	int32 Find(TCHAR const* const Label) const;
+
+	FORCEINLINE TCHAR const* Get(int32 const LabelId) const
+	{
+		return Chars.GetData() + LabelId;
+	}
+
+	int32 Num() const;
+
+	void Reserve(int32 const NumChars);
+	void Empty();
+
+	uint32 GetAllocatedSize() const;
+};
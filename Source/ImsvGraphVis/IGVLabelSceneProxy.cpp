@@ -0,0 +1,136 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVLabelSceneProxy.h"
+
+#include "DynamicMeshBuilder.h"
+#include "Materials/Material.h"
+
+#include "IGVLog.h"
+#include "IGVStats.h"
+#include "IGVTrace.h"
+
+FIGVLabelSceneProxy::FIGVLabelSceneProxy(UIGVLabelComponent* const Component)
+	: FPrimitiveSceneProxy(Component),
+	  IGVLabelComponent(Component),
+	  Frame(Component->Frame),
+	  Materials(),
+	  MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
+{
+	for (int32 Page = 0; Page < Component->GetNumMaterials(); Page++)
+	{
+		UMaterialInterface* Material = Component->GetMaterial(Page);
+		if (Material == nullptr)
+		{
+			IGV_LOG(Warning, TEXT("Unable to find a material for font page %d"), Page);
+			Material = UMaterial::GetDefaultMaterial(MD_Surface);
+		}
+		Materials.Add(Material);
+	}
+}
+
+uint32 FIGVLabelSceneProxy::GetAllocatedSize() const
+{
+	return FPrimitiveSceneProxy::GetAllocatedSize() + Materials.GetAllocatedSize() +
+		   (Frame.IsValid() ? Frame->GetAllocatedSize() : 0);
+}
+
+uint32 FIGVLabelSceneProxy::GetMemoryFootprint() const
+{
+	return sizeof(*this) + GetAllocatedSize();
+}
+
+void FIGVLabelSceneProxy::SendRenderDynamicData()
+{
+	ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
+		FSendIGVLabelSceneProxyDynamicData, FIGVLabelSceneProxy&, Self, *this,
+		FIGVLabelFrameConstPtr, NewFrame, IGVLabelComponent->Frame,
+		{ Self.SendRenderDynamicData_RenderThread(NewFrame); });
+}
+
+void FIGVLabelSceneProxy::SendRenderDynamicData_RenderThread(FIGVLabelFrameConstPtr const& NewFrame)
+{
+	Frame = NewFrame;
+}
+
+void FIGVLabelSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
+												 const FSceneViewFamily& ViewFamily,
+												 uint32 VisibilityMap,
+												 class FMeshElementCollector& Collector) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_IGV_BatchAssembly);
+
+	if (!Frame.IsValid() || Frame->Labels.Num() == 0) return;
+
+	FMatrix const& LocalToWorld = GetLocalToWorld();
+	FMatrix const WorldToLocal = LocalToWorld.InverseFast();
+
+	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
+	{
+		if (!(VisibilityMap & (1 << ViewIndex))) continue;
+
+		FSceneView const* const View = Views[ViewIndex];
+		FVector const ViewOrigin =
+			WorldToLocal.TransformPosition(View->ViewMatrices.GetViewOrigin());
+		FVector const ViewUp = WorldToLocal.TransformVector(View->GetViewUp()).GetSafeNormal();
+
+		// All pages share the glyph layout, but not the texture.
+		for (int32 Page = 0; Page < Materials.Num(); Page++)
+		{
+			FDynamicMeshBuilder MeshBuilder;
+			int32 NumGlyphs = 0;
+
+			for (FIGVLabel const& Label : Frame->Labels)
+			{
+				// Facing the view origin, upright in the view
+				FVector const Normal = (ViewOrigin - Label.Anchor).GetSafeNormal();
+				FMatrix const Basis = FRotationMatrix::MakeFromXZ(-Normal, ViewUp);
+				FVector const Right = Basis.GetScaledAxis(EAxis::Y);
+				FVector const Down = -Basis.GetScaledAxis(EAxis::Z);
+
+				for (int32 GlyphIdx = Label.GlyphOffset,
+						   EndGlyphIdx = Label.GlyphOffset + Label.NumGlyphs;
+					 GlyphIdx < EndGlyphIdx; GlyphIdx++)
+				{
+					FIGVLabelGlyph const& Glyph = Frame->Glyphs[GlyphIdx];
+					if (Glyph.Page != Page) continue;
+
+					int32 const BaseIdx = MeshBuilder.AddVertex(
+						Label.Anchor + Right * Glyph.Min.X + Down * Glyph.Min.Y,
+						FVector2D(Glyph.UVMin.X, Glyph.UVMin.Y), Right, Down, Normal,
+						FColor::White);
+					MeshBuilder.AddVertex(Label.Anchor + Right * Glyph.Max.X + Down * Glyph.Min.Y,
+										  FVector2D(Glyph.UVMax.X, Glyph.UVMin.Y), Right, Down,
+										  Normal, FColor::White);
+					MeshBuilder.AddVertex(Label.Anchor + Right * Glyph.Min.X + Down * Glyph.Max.Y,
+										  FVector2D(Glyph.UVMin.X, Glyph.UVMax.Y), Right, Down,
+										  Normal, FColor::White);
+					MeshBuilder.AddVertex(Label.Anchor + Right * Glyph.Max.X + Down * Glyph.Max.Y,
+										  FVector2D(Glyph.UVMax.X, Glyph.UVMax.Y), Right, Down,
+										  Normal, FColor::White);
+
+					MeshBuilder.AddTriangle(BaseIdx, BaseIdx + 2, BaseIdx + 1);
+					MeshBuilder.AddTriangle(BaseIdx + 1, BaseIdx + 2, BaseIdx + 3);
+					NumGlyphs++;
+				}
+			}
+
+			if (NumGlyphs > 0)
+			{
+				MeshBuilder.GetMesh(LocalToWorld, Materials[Page]->GetRenderProxy(IsSelected()),
+									SDPG_World, true, false, ViewIndex, Collector);
+				INC_DWORD_STAT(STAT_IGV_NumBatchElements);
+			}
+		}
+	}
+}
+
+FPrimitiveViewRelevance FIGVLabelSceneProxy::GetViewRelevance(const FSceneView* View) const
+{
+	FPrimitiveViewRelevance Result;
+	Result.bDrawRelevance = IsShown(View);
+	Result.bShadowRelevance = false;
+	Result.bDynamicRelevance = true;
+	Result.bStaticRelevance = false;
+	MaterialRelevance.SetPrimitiveViewRelevance(Result);
+	return Result;
+}
@@ -0,0 +1,36 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "PrimitiveSceneProxy.h"
+
+#include "IGVLabelComponent.h"
+
+// Builds the quads of the shown labels per view, so that they face the view origin, and draws
+// them with one mesh per font page.
+class IMSVGRAPHVIS_API FIGVLabelSceneProxy : public FPrimitiveSceneProxy
+{
+public:
+	class UIGVLabelComponent* IGVLabelComponent;
+
+	// Shared with the component, never modified once shown
+	FIGVLabelFrameConstPtr Frame;
+
+	TArray<UMaterialInterface*> Materials;  // By font page
+	FMaterialRelevance MaterialRelevance;
+
+public:
+	FIGVLabelSceneProxy(class UIGVLabelComponent* const Component);
+
+	uint32 GetAllocatedSize() const;
+	virtual uint32 GetMemoryFootprint() const override;
+
+public:
+	void SendRenderDynamicData();
+	void SendRenderDynamicData_RenderThread(FIGVLabelFrameConstPtr const& NewFrame);
+
+	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
+										const FSceneViewFamily& ViewFamily, uint32 VisibilityMap,
+										class FMeshElementCollector& Collector) const override;
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override;
+};
@@ -7,3 +7,5 @@ DECLARE_LOG_CATEGORY_EXTERN(LogIGV, Log, All);
 
 #define IGV_LOG(LogVerbosity, FormatString, ...) \
 	KW_LOG(LogIGV, LogVerbosity, FormatString, ##__VA_ARGS__)
+
+#define IGV_LOG_ACTIVE(LogVerbosity) KW_LOG_ACTIVE(LogIGV, LogVerbosity)
@@ -0,0 +1,130 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVMemoryUsage.h"
+
+#include "IGVCluster.h"
+#include "IGVEdge.h"
+#include "IGVEdgeMeshComponent.h"
+#include "IGVGraphActor.h"
+#include "IGVLabelComponent.h"
+#include "IGVLog.h"
+#include "IGVNodeActor.h"
+#include "IGVNodeMeshComponent.h"
+
+SIZE_T GetObjectMemorySize(UObject* const Object)
+{
+	if (Object == nullptr) return 0;
+
+	return Object->GetClass()->GetStructureSize() +
+		   Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+}
+
+SIZE_T GetNodeActorMemorySize(AIGVNodeActor* const Node)
+{
+	// Includes the graph data of the node, see AIGVNodeActor::GetResourceSizeEx
+	SIZE_T Size = GetObjectMemorySize(Node);
+
+	TInlineComponentArray<UActorComponent*> Components;
+	Node->GetComponents(Components);
+	for (UActorComponent* const Component : Components)
+	{
+		Size += GetObjectMemorySize(Component);
+	}
+
+	return Size;
+}
+
+FIGVMemoryUsage::FIGVMemoryUsage(AIGVGraphActor const* const GraphActor)
+	: Nodes(0),
+	  Edges(0),
+	  Clusters(0),
+	  Arena(0),
+	  GraphState(0),
+	  NodeMeshGPUBuffers(0),
+	  LabelGPUBuffers(0)
+{
+	for (AIGVNodeActor* const Node : GraphActor->Nodes)
+	{
+		Nodes += GetNodeActorMemorySize(Node);
+	}
+	for (AIGVNodeActor* const Node : GraphActor->NodeActorPool)
+	{
+		Nodes += GetNodeActorMemorySize(Node);
+	}
+	Nodes += GraphActor->LabelPool.GetAllocatedSize();
+
+	Edges = GraphActor->Edges.GetAllocatedSize() + GraphActor->EdgeStore.GetAllocatedSize() +
+			GraphActor->Adjacency.GetAllocatedSize();
+	Clusters = GraphActor->Clusters.GetAllocatedSize();
+	Arena = GraphActor->GraphArena.GetAllocatedSize();
+
+	GraphState = GraphActor->Nodes.GetAllocatedSize() +
+				 GraphActor->PickRayDistSortedNodes.GetAllocatedSize() +
+				 GraphActor->TransitionManager.GetAllocatedSize() +
+				 GraphActor->SemanticZoom.GetAllocatedSize() +
+				 GraphActor->LabelComponent->GetAllocatedSize() +
+				 GraphActor->NodeMeshComponent->GetAllocatedSize() +
+				 GraphActor->HaloNodeMeshComponent->GetAllocatedSize() +
+				 GraphActor->EdgeUpdateTasks.GetAllocatedSize() +
+				 GraphActor->DirtyEdgeIdxs.GetAllocatedSize();
+
+	UIGVEdgeMeshComponent const* const EdgeMeshComponents[EIGVEdgeRenderGroup::NumGroups] = {
+		GraphActor->DefaultEdgeGroupMeshComponent,  //
+		GraphActor->HighlightedEdgeGroupMeshComponent,
+		GraphActor->RemainedEdgeGroupMeshComponent};
+
+	for (int32 Group = 0; Group < EIGVEdgeRenderGroup::NumGroups; Group++)
+	{
+		UIGVEdgeMeshComponent const* const Component = EdgeMeshComponents[Group];
+		EdgeMeshBuffers[Group] = Component ? Component->GetCPUMemorySize() : 0;
+		EdgeMeshGPUBuffers[Group] = Component ? Component->GetGPUMemorySize() : 0;
+	}
+
+	NodeMeshGPUBuffers = GraphActor->NodeMeshComponent->GetGPUMemorySize() +
+						 GraphActor->HaloNodeMeshComponent->GetGPUMemorySize();
+	LabelGPUBuffers = GraphActor->LabelComponent->GetGPUMemorySize();
+}
+
+SIZE_T FIGVMemoryUsage::TotalCPU() const
+{
+	SIZE_T Total = Nodes + Edges + Clusters + Arena + GraphState;
+	for (int32 Group = 0; Group < EIGVEdgeRenderGroup::NumGroups; Group++)
+	{
+		Total += EdgeMeshBuffers[Group];
+	}
+	return Total;
+}
+
+SIZE_T FIGVMemoryUsage::TotalGPU() const
+{
+	SIZE_T Total = NodeMeshGPUBuffers + LabelGPUBuffers;
+	for (int32 Group = 0; Group < EIGVEdgeRenderGroup::NumGroups; Group++)
+	{
+		Total += EdgeMeshGPUBuffers[Group];
+	}
+	return Total;
+}
+
+void FIGVMemoryUsage::Log() const
+{
+	auto MB = [](SIZE_T const Bytes) { return double(Bytes) / (1024.0 * 1024.0); };
+
+	static TCHAR const* const GroupNames[EIGVEdgeRenderGroup::NumGroups] = {
+		TEXT("Default"), TEXT("Highlighted"), TEXT("Remained")};
+
+	IGV_LOG(Log, TEXT("Nodes: %.2f MB"), MB(Nodes));
+	IGV_LOG(Log, TEXT("Edges: %.2f MB"), MB(Edges));
+	IGV_LOG(Log, TEXT("Clusters: %.2f MB"), MB(Clusters));
+	IGV_LOG(Log, TEXT("Arena: %.2f MB"), MB(Arena));
+	IGV_LOG(Log, TEXT("GraphState: %.2f MB"), MB(GraphState));
+
+	for (int32 Group = 0; Group < EIGVEdgeRenderGroup::NumGroups; Group++)
+	{
+		IGV_LOG(Log, TEXT("EdgeMesh %s: %.2f MB CPU, %.2f MB GPU"), GroupNames[Group],
+				MB(EdgeMeshBuffers[Group]), MB(EdgeMeshGPUBuffers[Group]));
+	}
+	IGV_LOG(Log, TEXT("NodeMesh: %.2f MB GPU"), MB(NodeMeshGPUBuffers));
+	IGV_LOG(Log, TEXT("Labels: %.2f MB GPU"), MB(LabelGPUBuffers));
+
+	IGV_LOG_S(Log, TEXT("Total: %.2f MB CPU, %.2f MB GPU"), MB(TotalCPU()), MB(TotalGPU()));
+}
@@ -0,0 +1,28 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "IGVEdgeMeshData.h"
+
+// Breakdown of the CPU and GPU memory used by a loaded graph, see IGV_PrintMemoryUsage
+struct IMSVGRAPHVIS_API FIGVMemoryUsage
+{
+	SIZE_T Nodes;  // Node actors, pooled ones too, their components and the label pool
+	SIZE_T Edges;
+	SIZE_T Clusters;
+	SIZE_T Arena;  // Children of clusters, see FIGVArena
+	SIZE_T GraphState;  // Interaction and transition state
+	SIZE_T EdgeMeshBuffers[EIGVEdgeRenderGroup::NumGroups];
+	SIZE_T EdgeMeshGPUBuffers[EIGVEdgeRenderGroup::NumGroups];
+	SIZE_T NodeMeshGPUBuffers;  // Both node mesh components
+	SIZE_T LabelGPUBuffers;     // Per view and frame
+
+	FIGVMemoryUsage(class AIGVGraphActor const* const GraphActor);
+
+	SIZE_T TotalCPU() const;
+	SIZE_T TotalGPU() const;
+
+	void Log() const;
+};
@@ -3,13 +3,15 @@
 #include "IGVNodeActor.h"
 
 #include "Components/StaticMeshComponent.h"
-#include "Components/TextRenderComponent.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceDynamic.h"
 #include "Runtime/CoreUObject/Public/UObject/ConstructorHelpers.h"
-#include "Runtime/Engine/Classes/Materials/Material.h"
-#include "Runtime/Engine/Classes/Materials/MaterialInstanceDynamic.h"
 
+#include "IGVEdgeMeshComponent.h"
 #include "IGVGraphActor.h"
+#include "IGVLabelComponent.h"
 #include "IGVLog.h"
+#include "IGVNodeMeshComponent.h"
 
 UMaterialInterface* GetNodeMaterial()
 {
@@ -20,9 +22,10 @@ UMaterialInterface* GetNodeMaterial()
 
 AIGVNodeActor::AIGVNodeActor()
 	: GraphActor(nullptr),
-	  Label("Unknown"),
+	  LabelId(INDEX_NONE),
 	  Pos2D(FVector2D::ZeroVector),
 	  Pos3D(FVector::ZeroVector),
+	  ClusterIdx(INDEX_NONE),
 	  LevelScale(1.f),
 	  LevelScaleBeforeTransition(1.f),
 	  LevelScaleAfterTransition(1.f),
@@ -30,6 +33,11 @@ AIGVNodeActor::AIGVNodeActor()
 	  DistanceToPickRay(FLT_MAX),
 	  bIsHighlighted(false),
 	  NumHighlightedNeighbors(0),
+	  TransitionIdx(INDEX_NONE),
+	  LabelIdx(INDEX_NONE),
+	  MeshInstanceIdx(INDEX_NONE),
+	  bHasHalo(false),
+	  bIsSpawnDeferred(false),
 	  MeshMaterialInstance(nullptr)
 {
 	PrimaryActorTick.bCanEverTick = true;
@@ -37,15 +45,6 @@ AIGVNodeActor::AIGVNodeActor()
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Node Mesh"));
 	RootComponent = MeshComponent;
 
-	TextRenderComponent = CreateDefaultSubobject<UTextRenderComponent>(TEXT("Node Text"));
-	TextRenderComponent->AttachToComponent(RootComponent,
-										   FAttachmentTransformRules::KeepRelativeTransform);
-	TextRenderComponent->SetHorizontalAlignment(EHorizTextAligment::EHTA_Center);
-	TextRenderComponent->VerticalAlignment = EVerticalTextAligment::EVRTA_TextTop;
-	TextRenderComponent->SetRelativeLocation(FVector(20, 0, -12));
-	TextRenderComponent->SetWorldSize(20);
-	TextRenderComponent->SetVisibility(false);
-
 	GetNodeMaterial();
 }
 
@@ -53,11 +52,42 @@ void AIGVNodeActor::Init(AIGVGraphActor* const InGraphActor)
 {
 	GraphActor = InGraphActor;
 
-	MeshMaterialInstance = UMaterialInstanceDynamic::Create(GetNodeMaterial(), this);
-	if (MeshMaterialInstance) MeshComponent->SetMaterial(0, MeshMaterialInstance);
-
 	LevelScale = LevelScaleBeforeTransition = LevelScaleAfterTransition =
 		GraphActor->DefaultLevelScale;
+
+	MeshComponent->SetVisibility(false);
+
+	// A deferred spawn is shown once at its transform, see ApplyTransform.
+	if (!bIsSpawnDeferred) SetMeshVisibility(true);
+}
+
+void AIGVNodeActor::Deactivate()
+{
+	check(TransitionIdx == INDEX_NONE);
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	SetHalo(false);
+	SetActorRelativeScale3D(FVector(1.f));  // Meta-nodes are scaled
+
+	Idx = INDEX_NONE;
+	LabelId = INDEX_NONE;
+	Pos2D = FVector2D::ZeroVector;
+	Pos3D = FVector::ZeroVector;
+	AncIdxs.Reset();
+	ClusterIdx = INDEX_NONE;
+	Color = FLinearColor::White;
+	DistanceToPickRay = FLT_MAX;
+	bIsHighlighted = false;
+	NumHighlightedNeighbors = 0;
+}
+
+void AIGVNodeActor::Activate()
+{
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
 }
 
 void AIGVNodeActor::BeginPlay()
@@ -70,41 +100,206 @@ void AIGVNodeActor::Tick(float DeltaTime)
 	Super::Tick(DeltaTime);
 }
 
+void AIGVNodeActor::Destroyed()
+{
+	SetLabelVisibility(false);
+	SetMeshVisibility(false);
+
+	Super::Destroyed();
+}
+
+void AIGVNodeActor::SetActorHiddenInGame(bool bNewHidden)
+{
+	Super::SetActorHiddenInGame(bNewHidden);
+
+	SetMeshVisibility(!bNewHidden);
+	if (bNewHidden || bIsHighlighted) SetLabelVisibility(!bNewHidden);
+}
+
 FString AIGVNodeActor::ToString() const
 {
 	TArray<FString> AncStrs;
-	for (int32 const ClusterIdx : AncIdxs)
+	for (int32 const AncIdx : AncIdxs)
 	{
-		AncStrs.Add(FString::FromInt(ClusterIdx));
+		AncStrs.Add(FString::FromInt(AncIdx));
 	}
 
 	return FString::Printf(TEXT("Idx=%d Label=%s Pos2D=(%s) Pos3D=(%s) Ancestors=[%s]"), Idx,
-						   *Label, *Pos2D.ToString(), *Pos3D.ToString(),
+						   GetLabel(), *Pos2D.ToString(), *Pos3D.ToString(),
 						   *FString::Join(AncStrs, TEXT(" ")));
 }
 
+uint32 AIGVNodeActor::GetAllocatedSize() const
+{
+	// The label is in the pool of the graph actor.
+	return AncIdxs.GetAllocatedSize();
+}
+
+void AIGVNodeActor::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetAllocatedSize());
+}
+
 void AIGVNodeActor::SetPos3D()
 {
-	Pos3D = GraphActor->Project(Pos2D);
-	RootComponent->SetRelativeLocation(Pos3D * LevelScale * GraphActor->GetSphereRadius());
-	UpdateRotation();
+	SetPos3D(GraphActor->Project(Pos2D));
+}
+
+void AIGVNodeActor::SetPos3D(FVector const& P)
+{
+	// Read by the default edge mesh tasks
+	GraphActor->DefaultEdgeGroupMeshComponent->WaitForPendingTasks();
+	Pos3D = P;
+
+	FVector Location;
+	FRotator Rotation;
+	ComputeTransform(Location, Rotation);
+	ApplyTransform(Location, Rotation);
+}
+
+void AIGVNodeActor::ComputeTransform(FVector& OutLocation, FRotator& OutRotation) const
+{
+	OutLocation = Pos3D * LevelScale * GraphActor->GetSphereRadius();
+	OutRotation = (FVector::ZeroVector - Pos3D).Rotation();
+}
+
+void AIGVNodeActor::ApplyTransform(FVector const& Location, FRotator const& Rotation)
+{
+	if (bIsSpawnDeferred)
+	{
+		// The construction script runs and the components are registered at the final
+		// transform, rather than at the origin first.
+		bIsSpawnDeferred = false;
+		FinishSpawning(FTransform(Rotation, Location) * GraphActor->GetActorTransform());
+		AttachToActor(GraphActor, FAttachmentTransformRules::KeepWorldTransform);
+
+		// Init ran before the construction script, which may set another mesh.
+		MeshComponent->SetVisibility(false);
+		SetMeshVisibility(true);
+	}
+	else
+	{
+		RootComponent->SetRelativeLocationAndRotation(Location, Rotation);
+		UpdateMeshInstance();
+	}
+
+	if (LabelIdx != INDEX_NONE) GraphActor->LabelComponent->UpdateAnchor(this);
 }
 
 void AIGVNodeActor::SetColor(FLinearColor const& C)
 {
 	Color = C;
 	if (MeshMaterialInstance != nullptr)
+	{
 		MeshMaterialInstance->SetVectorParameterValue(TEXT("Base Color"), Color);
+	}
+	UpdateMeshInstance();
 }
 
 void AIGVNodeActor::SetHalo(bool const bValue)
 {
-	MeshComponent->SetRenderCustomDepth(bValue);
+	if (bHasHalo == bValue) return;
+
+	if (!IsDrawnByNodeMeshComponents())
+	{
+		bHasHalo = bValue;
+		MeshComponent->SetRenderCustomDepth(bValue);
+		return;
+	}
+
+	bool const bIsShown = MeshInstanceIdx != INDEX_NONE;
+	SetMeshVisibility(false);
+	bHasHalo = bValue;
+	if (bIsShown) SetMeshVisibility(true);
+}
+
+TCHAR const* AIGVNodeActor::GetLabel() const
+{
+	return LabelId != INDEX_NONE ? GraphActor->LabelPool.Get(LabelId) : TEXT("Unknown");
 }
 
 void AIGVNodeActor::SetText(FString const& Value)
 {
-	TextRenderComponent->SetText(FText::FromString(Value));
+	LabelId = GraphActor->LabelPool.Intern(*Value);
+	if (LabelIdx != INDEX_NONE) GraphActor->LabelComponent->UpdateText(this);
+}
+
+void AIGVNodeActor::SetLabelVisibility(bool const bValue)
+{
+	if (GraphActor == nullptr || GraphActor->LabelComponent == nullptr) return;
+
+	if (bValue && !bHidden)
+	{
+		GraphActor->LabelComponent->ShowLabel(this);
+	}
+	else
+	{
+		GraphActor->LabelComponent->HideLabel(this);
+	}
+}
+
+void AIGVNodeActor::SetMeshVisibility(bool const bValue)
+{
+	if (!IsDrawnByNodeMeshComponents())
+	{
+		SetOwnMeshVisibility(bValue && !bHidden);
+		return;
+	}
+
+	UIGVNodeMeshComponent* const NodeMeshComponent = GetNodeMeshComponent();
+	if (NodeMeshComponent == nullptr) return;
+
+	if (bValue && !bHidden)
+	{
+		NodeMeshComponent->ShowNode(this);
+	}
+	else
+	{
+		NodeMeshComponent->HideNode(this);
+	}
+}
+
+bool AIGVNodeActor::IsDrawnByNodeMeshComponents()
+{
+	return UIGVNodeMeshComponent::GetVertexColorMaterial() != nullptr;
+}
+
+void AIGVNodeActor::SetOwnMeshVisibility(bool const bValue)
+{
+	if (bValue)
+	{
+		if (MeshMaterialInstance == nullptr)
+		{
+			MeshMaterialInstance = UMaterialInstanceDynamic::Create(GetNodeMaterial(), this);
+		}
+
+		if (MeshMaterialInstance != nullptr)
+		{
+			// Also after the construction script of a deferred spawn, which may set another one
+			if (MeshComponent->GetMaterial(0) != MeshMaterialInstance)
+			{
+				MeshComponent->SetMaterial(0, MeshMaterialInstance);
+			}
+			MeshMaterialInstance->SetVectorParameterValue(TEXT("Base Color"), Color);
+		}
+	}
+
+	MeshComponent->SetRenderCustomDepth(bHasHalo);
+	MeshComponent->SetVisibility(bValue);
+}
+
+UIGVNodeMeshComponent* AIGVNodeActor::GetNodeMeshComponent() const
+{
+	if (GraphActor == nullptr) return nullptr;
+
+	return bHasHalo ? GraphActor->HaloNodeMeshComponent : GraphActor->NodeMeshComponent;
+}
+
+void AIGVNodeActor::UpdateMeshInstance()
+{
+	if (MeshInstanceIdx != INDEX_NONE) GetNodeMeshComponent()->UpdateNode(this);
 }
 
 void AIGVNodeActor::UpdateRotation()
@@ -127,33 +322,35 @@ void AIGVNodeActor::EndNearest()
 
 void AIGVNodeActor::BeginPicked()
 {
-	TextRenderComponent->SetVisibility(true);
+	SetLabelVisibility(true);
 }
 
 void AIGVNodeActor::EndPicked()
 {
-	if (!bIsHighlighted) TextRenderComponent->SetVisibility(false);
+	if (!bIsHighlighted) SetLabelVisibility(false);
 }
 
 void AIGVNodeActor::BeginHighlighted()
 {
 	bIsHighlighted = true;
+	UpdateEdgeHighlightStates();
 	SetHalo(true);
-	TextRenderComponent->SetVisibility(true);
+	SetLabelVisibility(true);
 
 	LevelScaleAfterTransition = GraphActor->HighlightedLevelScale;
 	BeginTransition();
 
-	for (AIGVNodeActor* const Neighbor : Neighbors)
+	for (int32 const NeighborIdx : GraphActor->Adjacency.GetNeighbors(Idx))
 	{
-		Neighbor->BeginNeighborHighlighted();
+		GraphActor->Nodes[NeighborIdx]->BeginNeighborHighlighted();
 	}
 }
 
 void AIGVNodeActor::EndHighlighted()
 {
 	bIsHighlighted = false;
-	TextRenderComponent->SetVisibility(false);
+	UpdateEdgeHighlightStates();
+	SetLabelVisibility(false);
 
 	if (HasHighlightedNeighbor())
 	{
@@ -168,9 +365,9 @@ void AIGVNodeActor::EndHighlighted()
 
 	BeginTransition();
 
-	for (AIGVNodeActor* const Neighbor : Neighbors)
+	for (int32 const NeighborIdx : GraphActor->Adjacency.GetNeighbors(Idx))
 	{
-		Neighbor->EndNeighborHighlighted();
+		GraphActor->Nodes[NeighborIdx]->EndNeighborHighlighted();
 	}
 }
 
@@ -179,6 +376,7 @@ void AIGVNodeActor::BeginNeighborHighlighted()
 	bool const TransionRequired = !(bIsHighlighted || HasHighlightedNeighbor());
 
 	NumHighlightedNeighbors++;
+	if (NumHighlightedNeighbors == 1) UpdateEdgeHighlightStates();
 
 	if (TransionRequired)
 	{
@@ -192,6 +390,7 @@ void AIGVNodeActor::EndNeighborHighlighted()
 {
 	NumHighlightedNeighbors--;
 	check(NumHighlightedNeighbors >= 0);
+	if (NumHighlightedNeighbors == 0) UpdateEdgeHighlightStates();
 
 	bool const TransionRequired = !(bIsHighlighted || HasHighlightedNeighbor());
 
@@ -208,16 +407,32 @@ bool AIGVNodeActor::HasHighlightedNeighbor() const
 	return NumHighlightedNeighbors > 0;
 }
 
-void AIGVNodeActor::BeginTransition()
+void AIGVNodeActor::UpdateEdgeHighlightStates() const
 {
-	LevelScaleBeforeTransition = LevelScale;
+	FIGVEdgeStore& Store = GraphActor->EdgeStore;
+	bool const bHasHighlightedNeighbor = HasHighlightedNeighbor();
 
-	for (FIGVEdge* const Edge : Edges)
+	for (int32 const EdgeIdx : GraphActor->Adjacency.GetEdges(Idx))
 	{
-		Edge->BeginTransition();
+		Store.SetEndpointHighlightState(EdgeIdx, Idx, bIsHighlighted, bHasHighlightedNeighbor);
 	}
+}
+
+void AIGVNodeActor::BeginTransition()
+{
+	GraphActor->TransitionManager.BeginNodeTransition(this);
+}
+
+void AIGVNodeActor::UpdateTransition(float const Alpha)
+{
+	LevelScale = FMath::Lerp(LevelScaleBeforeTransition, LevelScaleAfterTransition, Alpha);
+	SetPos3D();
+}
 
-	PlayFromStartHighlightTransitionTimeline();
+void AIGVNodeActor::EndTransition()
+{
+	LevelScale = LevelScaleBeforeTransition = LevelScaleAfterTransition;
+	SetPos3D();
 }
 
 void AIGVNodeActor::OnLeftMouseButtonReleased()
@@ -237,19 +452,8 @@ void AIGVNodeActor::OnLeftMouseButtonReleased()
 void AIGVNodeActor::OnHighlightTransitionTimelineUpdate(ETimelineDirection::Type const Direction,
 														float const Alpha)
 {
-	LevelScale = FMath::Lerp(LevelScaleBeforeTransition, LevelScaleAfterTransition, Alpha);
-	SetPos3D();
-
-	for (FIGVEdge* const Edge : Edges)
-	{
-		Edge->OnHighlightTransitionTimelineUpdate(Direction, Alpha);
-	}
 }
 
 void AIGVNodeActor::OnHighlightTransitionTimelineFinished(ETimelineDirection::Type const Direction)
 {
-	for (FIGVEdge* const Edge : Edges)
-	{
-		Edge->OnHighlightTransitionTimelineFinished(Direction);
-	}
 }
@@ -19,8 +19,7 @@ public:
 	UPROPERTY(VisibleAnywhere, SaveGame, Category = ImmersiveGraphVisualization)
 	int32 Idx;
 
-	UPROPERTY(BlueprintReadOnly, SaveGame, Category = ImmersiveGraphVisualization)
-	FString Label;
+	int32 LabelId;  // In AIGVGraphActor::LabelPool, INDEX_NONE if the node has no label
 
 	UPROPERTY(BlueprintReadOnly, SaveGame, Category = ImmersiveGraphVisualization)
 	FVector2D Pos2D;
@@ -31,6 +30,8 @@ public:
 	UPROPERTY(BlueprintReadOnly, SaveGame, Category = ImmersiveGraphVisualization)
 	TArray<int32> AncIdxs;  // Ancestors in the clustering hierarchy excluding the root
 
+	int32 ClusterIdx;  // Leaf cluster of the node, kept by AIGVGraphActor
+
 	UPROPERTY(BlueprintReadOnly, Category = ImmersiveGraphVisualization)
 	float LevelScale;
 	float LevelScaleBeforeTransition;
@@ -41,39 +42,78 @@ public:
 
 	float DistanceToPickRay;
 
-	TArray<struct FIGVEdge*> Edges;
-	TArray<AIGVNodeActor*> Neighbors;
-
 	bool bIsHighlighted;
 	int32 NumHighlightedNeighbors;
 
+	int32 TransitionIdx;	// Index in FIGVTransitionManager, INDEX_NONE if not in transition
+	int32 LabelIdx;			// Index in UIGVLabelComponent, INDEX_NONE if the label is hidden
+	int32 MeshInstanceIdx;  // Index in UIGVNodeMeshComponent, INDEX_NONE if the node is hidden
+
+	bool bHasHalo;  // Drawn by AIGVGraphActor::HaloNodeMeshComponent, or with custom depth
+
+	// Spawned by AIGVGraphActor::SpawnNodeActor with deferred construction, finished by the first
+	// ApplyTransform
+	bool bIsSpawnDeferred;
+
 public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = ImmersiveGraphVisualization)
 	class UStaticMeshComponent* MeshComponent;
 
-	UPROPERTY(BlueprintReadWrite, Category = ImmersiveGraphVisualization)
+	// Only created while the node mesh components have no material, see
+	// UIGVNodeMeshComponent::GetVertexColorMaterial. The node then draws its own mesh component.
+	UPROPERTY()
 	class UMaterialInstanceDynamic* MeshMaterialInstance;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = ImmersiveGraphVisualization)
-	class UTextRenderComponent* TextRenderComponent;
-
 public:
 	AIGVNodeActor();
 
+	// Also run on a node actor taken from the pool of the graph actor. Hides the static mesh
+	// component, which is drawn by a node mesh component of the graph actor instead, if they have
+	// their material.
 	void Init(class AIGVGraphActor* const InGraphActor);
 
+	// Hides the node and its label, and resets its graph data for reuse, see
+	// AIGVGraphActor::ReleaseNodeActor
+	void Deactivate();
+	void Activate();
+
 protected:
 	virtual void BeginPlay() override;
 
 public:
 	virtual void Tick(float DeltaTime) override;
+	virtual void Destroyed() override;
+	// The mesh instance and the label of a hidden node are hidden too.
+	virtual void SetActorHiddenInGame(bool bNewHidden) override;
 
 	FString ToString() const;
 
+	// Heap memory of the graph data held by the node, excluding its components
+	uint32 GetAllocatedSize() const;
+
+	// Begin UObject interface.
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+	// End UObject interface.
+
+	// For many nodes at once, see AIGVGraphActor::UpdateNodeTransforms
 	void SetPos3D();
+	void SetPos3D(FVector const& P);  // Not projected from Pos2D, as for meta-nodes
+
+	// Relative transform of the root component for Pos3D. Only reads the node and the graph
+	// actor, so it can be run off the game thread.
+	void ComputeTransform(FVector& OutLocation, FRotator& OutRotation) const;
+	// Moves the root component in one update, finishing a deferred spawn
+	void ApplyTransform(FVector const& Location, FRotator const& Rotation);
 
 	void SetColor(FLinearColor const& C);
+	// In the label pool of the graph actor, valid until another label is added
+	TCHAR const* GetLabel() const;
+	// Interns the label, drawn by the label component of the graph actor
 	void SetText(FString const& Value);
+	void SetLabelVisibility(bool const bValue);
+	void SetMeshVisibility(bool const bValue);
+	// Moves the mesh instance to the node mesh component rendering the halo, or renders custom
+	// depth for a node drawing its own mesh
 	void SetHalo(bool const bValue);
 
 	void UpdateRotation();
@@ -93,21 +133,41 @@ public:
 	void EndNeighborHighlighted();
 
 	bool HasHighlightedNeighbor() const;
+	// Mirrors bIsHighlighted and HasHighlightedNeighbor into the highlight state of the incident
+	// edges, from which their render groups are classified. See FIGVEdgeStore.
+	void UpdateEdgeHighlightStates() const;
 
 	void BeginTransition();
+	void UpdateTransition(float const Alpha);
+	void EndTransition();
 
 	void OnLeftMouseButtonReleased();
 
-	UFUNCTION(BlueprintImplementableEvent, Category = ImmersiveGraphVisualization)
+	// Highlight transitions are driven by FIGVTransitionManager of AIGVGraphActor. The timeline
+	// hooks below are only kept so that existing node Blueprints still compile.
+	UFUNCTION(BlueprintImplementableEvent, Category = ImmersiveGraphVisualization,
+			  meta = (DeprecatedFunction, DeprecationMessage = "Driven by AIGVGraphActor"))
 	void PlayFromStartHighlightTransitionTimeline();
 
-	UFUNCTION(BlueprintImplementableEvent, Category = ImmersiveGraphVisualization)
+	UFUNCTION(BlueprintImplementableEvent, Category = ImmersiveGraphVisualization,
+			  meta = (DeprecatedFunction, DeprecationMessage = "Driven by AIGVGraphActor"))
 	void StopHighlightTransitionTimeline();
 
-	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization,
+			  meta = (DeprecatedFunction, DeprecationMessage = "Driven by AIGVGraphActor"))
 	void OnHighlightTransitionTimelineUpdate(ETimelineDirection::Type const Direction,
 											 float const Alpha);
 
-	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization)
+	UFUNCTION(BlueprintCallable, Category = ImmersiveGraphVisualization,
+			  meta = (DeprecatedFunction, DeprecationMessage = "Driven by AIGVGraphActor"))
 	void OnHighlightTransitionTimelineFinished(ETimelineDirection::Type const Direction);
+
+protected:
+	// False while M_NodeVertexColor is missing
+	static bool IsDrawnByNodeMeshComponents();
+	class UIGVNodeMeshComponent* GetNodeMeshComponent() const;
+	// With a material instance of M_Node, as before the node mesh components
+	void SetOwnMeshVisibility(bool const bValue);
+	// Follows the transform and color of the node, if shown
+	void UpdateMeshInstance();
 };
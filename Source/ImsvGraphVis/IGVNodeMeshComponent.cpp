@@ -0,0 +1,238 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVNodeMeshComponent.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/Material.h"
+
+#include "IGVGraphActor.h"
+#include "IGVLog.h"
+#include "IGVNodeActor.h"
+#include "IGVNodeMeshSceneProxy.h"
+#include "IGVStats.h"
+#include "IGVTrace.h"
+
+uint32 FIGVNodeMeshFrame::GetAllocatedSize() const
+{
+	return Instances.GetAllocatedSize();
+}
+
+UIGVNodeMeshComponent::UIGVNodeMeshComponent()
+	: GraphActor(nullptr),
+	  NumSides(8),
+	  StaticMesh(nullptr),
+	  Frame(nullptr),
+	  Nodes(),
+	  Instances(),
+	  NumAllocatedInstances(0),
+	  DirtyBeginIdx(MAX_int32),
+	  DirtyEndIdx(0)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+
+	GetVertexColorMaterial();
+}
+
+UMaterialInterface* UIGVNodeMeshComponent::GetVertexColorMaterial()
+{
+	// M_Node with the base color taken from the vertex color instead of its color parameter.
+	// Loaded quietly, as it may not exist yet, and kept loaded as by ConstructorHelpers.
+	static UMaterial* const Material = []() {
+		UMaterial* const Asset = LoadObject<UMaterial>(
+			nullptr, TEXT("/Game/Materials/M_NodeVertexColor.M_NodeVertexColor"), nullptr,
+			LOAD_NoWarn | LOAD_Quiet);
+		if (Asset != nullptr) Asset->AddToRoot();
+		return Asset;
+	}();
+	return Material;
+}
+
+void UIGVNodeMeshComponent::Init(AIGVGraphActor* const InGraphActor, bool const bInRenderHalo)
+{
+	GraphActor = InGraphActor;
+
+	SetMaterial(0, GetVertexColorMaterial());
+	SetRenderCustomDepth(bInRenderHalo);
+}
+
+void UIGVNodeMeshComponent::Reset()
+{
+	for (AIGVNodeActor* const Node : Nodes)
+	{
+		Node->MeshInstanceIdx = INDEX_NONE;
+	}
+
+	Nodes.Empty();
+	Instances.Empty();
+
+	// The buffers of the next graph are allocated for its size, and its nodes may have another
+	// mesh.
+	StaticMesh = nullptr;
+	NumAllocatedInstances = 0;
+	MarkRenderStateDirty();
+}
+
+uint32 UIGVNodeMeshComponent::GetAllocatedSize() const
+{
+	return Nodes.GetAllocatedSize() + Instances.GetAllocatedSize() +
+		   (Frame.IsValid() ? Frame->GetAllocatedSize() : 0);
+}
+
+uint32 UIGVNodeMeshComponent::GetGPUMemorySize() const
+{
+	return SceneProxy ? ((FIGVNodeMeshSceneProxy*)SceneProxy)->GetGPUMemorySize() : 0;
+}
+
+int32 UIGVNodeMeshComponent::GetNumAllocatedInstances() const
+{
+	return NumAllocatedInstances;
+}
+
+void UIGVNodeMeshComponent::ShowNode(AIGVNodeActor* const Node)
+{
+	if (Node->MeshInstanceIdx != INDEX_NONE) return;
+
+	// Nothing is drawn for a node without a mesh, as before.
+	UStaticMesh* const NodeMesh = Node->MeshComponent->GetStaticMesh();
+	if (NodeMesh == nullptr) return;
+
+	if (StaticMesh == nullptr)
+	{
+		StaticMesh = NodeMesh;
+		MarkRenderStateDirty();
+	}
+	else if (NodeMesh != StaticMesh)
+	{
+		IGV_LOG(Verbose, TEXT("Node %s is drawn with %s instead of its mesh %s"),
+				*Node->GetName(), *StaticMesh->GetName(), *NodeMesh->GetName());
+	}
+
+	Node->MeshInstanceIdx = Instances.Add(MakeInstance(Node));
+	Nodes.Add(Node);
+	MarkInstanceDirty(Node->MeshInstanceIdx);
+
+	if (Instances.Num() > NumAllocatedInstances)
+	{
+		NumAllocatedInstances = FMath::Max(64, int32(FMath::RoundUpToPowerOfTwo(Instances.Num())));
+		MarkRenderStateDirty();
+	}
+	else
+	{
+		MarkRenderDynamicDataDirty();
+	}
+}
+
+void UIGVNodeMeshComponent::HideNode(AIGVNodeActor* const Node)
+{
+	int32 const InstanceIdx = Node->MeshInstanceIdx;
+	if (InstanceIdx == INDEX_NONE) return;
+
+	Instances.RemoveAtSwap(InstanceIdx, 1, false);
+	Nodes.RemoveAtSwap(InstanceIdx, 1, false);
+	if (Nodes.IsValidIndex(InstanceIdx))
+	{
+		Nodes[InstanceIdx]->MeshInstanceIdx = InstanceIdx;
+		MarkInstanceDirty(InstanceIdx);
+	}
+	Node->MeshInstanceIdx = INDEX_NONE;
+
+	MarkRenderDynamicDataDirty();
+}
+
+void UIGVNodeMeshComponent::UpdateNode(AIGVNodeActor* const Node)
+{
+	check(Nodes.IsValidIndex(Node->MeshInstanceIdx) && Nodes[Node->MeshInstanceIdx] == Node);
+
+	Instances[Node->MeshInstanceIdx] = MakeInstance(Node);
+	MarkInstanceDirty(Node->MeshInstanceIdx);
+	MarkRenderDynamicDataDirty();
+}
+
+void UIGVNodeMeshComponent::MarkInstanceDirty(int32 const InstanceIdx)
+{
+	DirtyBeginIdx = FMath::Min(DirtyBeginIdx, InstanceIdx);
+	DirtyEndIdx = FMath::Max(DirtyEndIdx, InstanceIdx + 1);
+}
+
+FIGVNodeMeshInstance UIGVNodeMeshComponent::MakeInstance(AIGVNodeActor const* const Node) const
+{
+	// Node actors are attached to the graph actor, as is this component.
+	USceneComponent const* const Root = Node->GetRootComponent();
+
+	FIGVNodeMeshInstance Instance;
+	Instance.Transform = Root->GetRelativeTransform();
+	Instance.Color = Node->Color.ToFColor(false);
+	return Instance;
+}
+
+FIGVNodeMeshFrameConstPtr UIGVNodeMeshComponent::MakeFrame(bool const bAllInstances)
+{
+	if (bAllInstances)
+	{
+		DirtyBeginIdx = 0;
+		DirtyEndIdx = Instances.Num();
+	}
+
+	// Hidden nodes may have left the end of the span.
+	int32 const BeginIdx = FMath::Min(DirtyBeginIdx, Instances.Num());
+	int32 const EndIdx = FMath::Max(BeginIdx, FMath::Min(DirtyEndIdx, Instances.Num()));
+
+	TSharedPtr<FIGVNodeMeshFrame, ESPMode::ThreadSafe> const NewFrame =
+		MakeShareable(new FIGVNodeMeshFrame());
+	NewFrame->NumInstances = Instances.Num();
+	NewFrame->FirstInstanceIdx = BeginIdx;
+	NewFrame->Instances.Append(Instances.GetData() + BeginIdx, EndIdx - BeginIdx);
+
+	DirtyBeginIdx = MAX_int32;
+	DirtyEndIdx = 0;
+
+	return NewFrame;
+}
+
+void UIGVNodeMeshComponent::SendRenderDynamicData_Concurrent()
+{
+	IGV_TRACE_SCOPE("SendNodeMeshRenderDynamicData");
+
+	Frame = MakeFrame(false);
+
+	if (SceneProxy)
+	{
+		((FIGVNodeMeshSceneProxy*)SceneProxy)->SendRenderDynamicData();
+	}
+}
+
+FBoxSphereBounds UIGVNodeMeshComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	FBoxSphereBounds NewBounds;
+	NewBounds.Origin = FVector::ZeroVector;
+	NewBounds.BoxExtent = FVector(HALF_WORLD_MAX, HALF_WORLD_MAX, HALF_WORLD_MAX);
+	NewBounds.SphereRadius = FMath::Sqrt(3.0f * FMath::Square(HALF_WORLD_MAX));
+	return NewBounds;
+}
+
+FPrimitiveSceneProxy* UIGVNodeMeshComponent::CreateSceneProxy()
+{
+	// Also when the buffers are grown, after instances were changed in the same frame
+	Frame = MakeFrame(true);
+
+	if (NumAllocatedInstances == 0 || StaticMesh == nullptr) return nullptr;
+
+	return new FIGVNodeMeshSceneProxy(this);
+}
+
+int32 UIGVNodeMeshComponent::GetNumMaterials() const
+{
+	return 1;
+}
+
+void UIGVNodeMeshComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetAllocatedSize());
+	CumulativeResourceSize.AddDedicatedVideoMemoryBytes(GetGPUMemorySize());
+}
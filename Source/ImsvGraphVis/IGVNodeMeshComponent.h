@@ -0,0 +1,115 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "Components/MeshComponent.h"
+#include "CoreMinimal.h"
+
+#include "IGVNodeMeshComponent.generated.h"
+
+// A shown node, in component space
+struct IMSVGRAPHVIS_API FIGVNodeMeshInstance
+{
+	FTransform Transform;  // Of the node actor
+	FColor Color;          // Linear, as read by the VertexColor material expression
+};
+
+// Instances changed since the last frame, as handed to the scene proxy, never modified afterward
+struct IMSVGRAPHVIS_API FIGVNodeMeshFrame
+{
+	int32 NumInstances;      // Shown
+	int32 FirstInstanceIdx;  // Of Instances
+	TArray<FIGVNodeMeshInstance> Instances;
+
+	uint32 GetAllocatedSize() const;
+};
+
+typedef TSharedPtr<FIGVNodeMeshFrame const, ESPMode::ThreadSafe> FIGVNodeMeshFrameConstPtr;
+
+// Draws the node actors of a graph as copies of their static mesh in one vertex buffer with a
+// single material, M_Node with its color parameter replaced by the vertex color. All nodes of the
+// component are then drawn in one draw call, instead of one per node actor with a material
+// instance of its own. The nodes are drawn with the mesh of the first node shown, which a node
+// actor class shares between its nodes.
+//
+// Only shown nodes have an instance: a node refers to its instance by
+// AIGVNodeActor::MeshInstanceIdx, and a hidden node is swapped out of Instances. The span of the
+// instances changed in a frame is sent to the scene proxy, which writes only that span into the
+// vertex buffer in one upload, so recoloring the whole graph costs a single upload and moving a
+// node costs the upload of its own vertices. The buffers are allocated
+// for NumAllocatedInstances, doubled when exceeded, so that showing and hiding nodes does not
+// create a new scene proxy every time.
+//
+// The graph actor has two of these: custom depth is per primitive, so nodes with a halo are moved
+// to a second component rendering it, see AIGVNodeActor::SetHalo.
+UCLASS()
+class IMSVGRAPHVIS_API UIGVNodeMeshComponent : public UMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	class AIGVGraphActor* GraphActor;
+
+	UPROPERTY(EditAnywhere, Category = ImmersiveGraphVisualization,
+			  meta = (ClampMin = "4", ClampMax = "32", UIMin = "4", UIMax = "32"))
+	int32 NumSides;  // Of the sphere drawn if the mesh of the nodes can not be read on the CPU
+
+	UPROPERTY()
+	class UStaticMesh* StaticMesh;  // Of the nodes, see ShowNode
+
+	FIGVNodeMeshFrameConstPtr Frame;  // Shown by the scene proxy
+
+	TArray<class AIGVNodeActor*> Nodes;  // By instance index
+	TArray<FIGVNodeMeshInstance> Instances;
+
+protected:
+	int32 NumAllocatedInstances;  // Capacity of the buffers of the scene proxy
+
+	// Instances changed since the last frame, empty if DirtyEndIdx is not after DirtyBeginIdx
+	int32 DirtyBeginIdx;
+	int32 DirtyEndIdx;
+
+public:
+	UIGVNodeMeshComponent();
+
+	// M_NodeVertexColor, null until the asset is saved from the editor. The nodes are then drawn
+	// by their own static mesh components instead, see AIGVNodeActor::SetMeshVisibility.
+	static UMaterialInterface* GetVertexColorMaterial();
+
+	void Init(class AIGVGraphActor* const InGraphActor, bool const bInRenderHalo);
+	// Hides all nodes
+	void Reset();
+
+	uint32 GetAllocatedSize() const;
+	// Of the buffers of the scene proxy
+	uint32 GetGPUMemorySize() const;
+	int32 GetNumAllocatedInstances() const;
+
+	void ShowNode(class AIGVNodeActor* const Node);
+	void HideNode(class AIGVNodeActor* const Node);
+	// Follows the location, scale and color of a shown node
+	void UpdateNode(class AIGVNodeActor* const Node);
+
+	// Begin USceneComponent interface.
+	virtual void SendRenderDynamicData_Concurrent() override;
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+	// Begin USceneComponent interface.
+
+	// Begin UPrimitiveComponent interface.
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+	// End UPrimitiveComponent interface.
+
+	// Begin UMeshComponent interface.
+	virtual int32 GetNumMaterials() const override;
+	// End UMeshComponent interface.
+
+	// Begin UObject interface.
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+	// End UObject interface.
+
+protected:
+	FIGVNodeMeshInstance MakeInstance(class AIGVNodeActor const* const Node) const;
+	void MarkInstanceDirty(int32 const InstanceIdx);
+	// Takes the changed instances, all of them for a new scene proxy
+	FIGVNodeMeshFrameConstPtr MakeFrame(bool const bAllInstances);
+};
@@ -0,0 +1,321 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVNodeMeshSceneProxy.h"
+
+#include "Engine/StaticMesh.h"
+#include "Materials/Material.h"
+#include "StaticMeshResources.h"
+
+#include "IGVLog.h"
+#include "IGVStats.h"
+#include "IGVTrace.h"
+
+FIGVNodeMeshSceneProxy::~FIGVNodeMeshSceneProxy()
+{
+	DEC_MEMORY_STAT_BY(STAT_IGV_NodeMeshGPUMemory, GetGPUMemorySize());
+
+	VertexBuffer.ReleaseResource();
+	IndexBuffer.ReleaseResource();
+	VertexFactory.ReleaseResource();
+}
+
+FIGVNodeMeshSceneProxy::FIGVNodeMeshSceneProxy(UIGVNodeMeshComponent* const Component)
+	: FPrimitiveSceneProxy(Component),
+	  IGVNodeMeshComponent(Component),
+	  NumInstances(Component->Frame->NumInstances),
+	  NumAllocatedInstances(Component->GetNumAllocatedInstances()),
+	  TemplateVertices(MakeTemplateVertices(Component)),
+	  TemplateIndices(MakeTemplateIndices(Component)),
+	  // Not dynamic, whose locks would discard the instances out of the uploaded span
+	  VertexBuffer(NumAllocatedInstances * TemplateVertices.Num(), FMeshVertexArray(),
+				   BUF_Static),
+	  IndexBuffer(MakeIndices(NumAllocatedInstances), BUF_Static),
+	  Material(Component->GetMaterial(0)),
+	  MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
+{
+	// All instances, uploaded by InitRHI
+	check(Component->Frame->FirstInstanceIdx == 0);
+	MakeVertices(*Component->Frame, VertexBuffer.Vertices);
+
+	VertexFactory.Init(&VertexBuffer);
+	BeginInitResource(&VertexBuffer);
+	BeginInitResource(&IndexBuffer);
+	BeginInitResource(&VertexFactory);
+	INC_MEMORY_STAT_BY(STAT_IGV_NodeMeshGPUMemory, GetGPUMemorySize());
+
+	if (Material == nullptr)
+	{
+		IGV_LOG(Warning, TEXT("Unable to find a material from UIGVNodeMeshComponent"));
+		Material = UMaterial::GetDefaultMaterial(MD_Surface);
+	}
+}
+
+void FIGVNodeMeshSceneProxy::OnTransformChanged()
+{
+	PrimitiveUniformBuffer = CreatePrimitiveUniformBufferImmediate(
+		GetLocalToWorld(), GetBounds(), GetLocalBounds(), true, UseEditorDepthTest());
+}
+
+bool FIGVNodeMeshSceneProxy::CanBeOccluded() const
+{
+	return !MaterialRelevance.bDisableDepthTest;
+}
+
+uint32 FIGVNodeMeshSceneProxy::GetAllocatedSize() const
+{
+	return FPrimitiveSceneProxy::GetAllocatedSize() + TemplateVertices.GetAllocatedSize() +
+		   TemplateIndices.GetAllocatedSize() + VertexBuffer.Vertices.GetAllocatedSize() +
+		   IndexBuffer.Indices.GetAllocatedSize();
+}
+
+uint32 FIGVNodeMeshSceneProxy::GetMemoryFootprint() const
+{
+	return sizeof(*this) + GetAllocatedSize();
+}
+
+uint32 FIGVNodeMeshSceneProxy::GetGPUMemorySize() const
+{
+	return VertexBuffer.NumElements * sizeof(FDynamicMeshVertex) +
+		   IndexBuffer.NumElements * sizeof(int32);
+}
+
+void FIGVNodeMeshSceneProxy::SendRenderDynamicData()
+{
+	// More instances require a new proxy. See UIGVNodeMeshComponent.
+	FIGVNodeMeshFrameConstPtr const& NewFrame = IGVNodeMeshComponent->Frame;
+	if (!NewFrame.IsValid() || NewFrame->NumInstances > NumAllocatedInstances) return;
+
+	ENQUEUE_UNIQUE_RENDER_COMMAND_TWOPARAMETER(
+		FSendIGVNodeMeshSceneProxyDynamicData, FIGVNodeMeshSceneProxy&, Self, *this,
+		FIGVNodeMeshFrameConstPtr, NewFrame, NewFrame,
+		{ Self.SendRenderDynamicData_RenderThread(NewFrame); });
+}
+
+void FIGVNodeMeshSceneProxy::SendRenderDynamicData_RenderThread(
+	FIGVNodeMeshFrameConstPtr const& NewFrame)
+{
+	SCOPE_CYCLE_COUNTER(STAT_IGV_NodeBufferUpload);
+	IGV_TRACE_SCOPE("SendNodeMeshRenderDynamicData_RenderThread");
+
+	NumInstances = NewFrame->NumInstances;
+
+	// The changed span in one upload, the other instances stay as uploaded before
+	MakeVertices(*NewFrame, VertexBuffer.Vertices);
+	VertexBuffer.BufferData(NewFrame->FirstInstanceIdx * TemplateVertices.Num());
+}
+
+void FIGVNodeMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
+													const FSceneViewFamily& ViewFamily,
+													uint32 VisibilityMap,
+													class FMeshElementCollector& Collector) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_IGV_BatchAssembly);
+
+	if (NumInstances == 0) return;
+
+	for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++)
+	{
+		if (!(VisibilityMap & (1 << ViewIndex))) continue;
+
+		FMeshBatch& Mesh = Collector.AllocateMesh();
+		Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+		Mesh.Type = PT_TriangleList;
+		Mesh.DepthPriorityGroup = SDPG_World;
+		Mesh.bCanApplyViewModeOverrides = false;
+		Mesh.VertexFactory = &VertexFactory;
+		Mesh.MaterialRenderProxy = Material->GetRenderProxy(IsSelected());
+
+		FMeshBatchElement& BatchElement = Mesh.Elements[0];
+		BatchElement.IndexBuffer = &IndexBuffer;
+		BatchElement.PrimitiveUniformBuffer = PrimitiveUniformBuffer;
+		BatchElement.FirstIndex = 0;
+		BatchElement.NumPrimitives = NumInstances * TemplateIndices.Num() / 3;
+		BatchElement.MinVertexIndex = 0;
+		BatchElement.MaxVertexIndex = NumInstances * TemplateVertices.Num() - 1;
+
+		Collector.AddMesh(ViewIndex, Mesh);
+		INC_DWORD_STAT(STAT_IGV_NumBatchElements);
+	}
+}
+
+FPrimitiveViewRelevance FIGVNodeMeshSceneProxy::GetViewRelevance(const FSceneView* View) const
+{
+	FPrimitiveViewRelevance Result;
+	Result.bDrawRelevance = IsShown(View);
+	Result.bRenderCustomDepth = ShouldRenderCustomDepth();
+	Result.bShadowRelevance = IsShadowCast(View);
+	Result.bDynamicRelevance = true;
+	Result.bStaticRelevance = false;
+	MaterialRelevance.SetPrimitiveViewRelevance(Result);
+	return Result;
+}
+
+FStaticMeshLODResources const* FIGVNodeMeshSceneProxy::GetMeshLOD(UStaticMesh const* const Mesh)
+{
+	if (Mesh == nullptr || Mesh->RenderData == nullptr ||
+		Mesh->RenderData->LODResources.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	if (FPlatformProperties::RequiresCookedData() && !Mesh->bAllowCPUAccess) return nullptr;
+
+	return &Mesh->RenderData->LODResources[0];
+}
+
+FMeshVertexArray FIGVNodeMeshSceneProxy::MakeTemplateVertices(
+	UIGVNodeMeshComponent const* const Component)
+{
+	FStaticMeshLODResources const* const LOD = GetMeshLOD(Component->StaticMesh);
+	if (LOD == nullptr)
+	{
+		IGV_LOG(Warning, TEXT("Allow CPU Access of %s to draw it for nodes instead of a sphere"),
+				*GetNameSafe(Component->StaticMesh));
+
+		// Of the size of the mesh
+		FMeshVertexArray Vertices = MakeSphereVertices(Component->NumSides);
+		float const Radius = Component->StaticMesh->GetBounds().BoxExtent.GetMax();
+		for (FDynamicMeshVertex& Vertex : Vertices)
+		{
+			Vertex.Position *= Radius;
+		}
+		return Vertices;
+	}
+
+	int32 const NumVertices = LOD->GetNumVertices();
+
+	FMeshVertexArray Vertices;
+	Vertices.Reserve(NumVertices);
+
+	for (int32 VertexIdx = 0; VertexIdx < NumVertices; VertexIdx++)
+	{
+		FDynamicMeshVertex Vertex;
+		Vertex.Position = LOD->PositionVertexBuffer.VertexPosition(VertexIdx);
+		Vertex.TextureCoordinate = LOD->VertexBuffer.GetVertexUV(VertexIdx, 0);
+		Vertex.SetTangents(LOD->VertexBuffer.VertexTangentX(VertexIdx),
+						   LOD->VertexBuffer.VertexTangentY(VertexIdx),
+						   LOD->VertexBuffer.VertexTangentZ(VertexIdx));
+		Vertex.Color = FColor::White;
+		Vertices.Add(Vertex);
+	}
+
+	return Vertices;
+}
+
+FMeshIndexArray FIGVNodeMeshSceneProxy::MakeTemplateIndices(
+	UIGVNodeMeshComponent const* const Component)
+{
+	FStaticMeshLODResources const* const LOD = GetMeshLOD(Component->StaticMesh);
+	if (LOD == nullptr) return MakeSphereIndices(Component->NumSides);
+
+	// All sections, drawn with the single material of the component
+	FIndexArrayView const MeshIndices = LOD->IndexBuffer.GetArrayView();
+
+	FMeshIndexArray Indices;
+	Indices.SetNumUninitialized(MeshIndices.Num());
+	for (int32 Idx = 0; Idx < MeshIndices.Num(); Idx++)
+	{
+		Indices[Idx] = MeshIndices[Idx];
+	}
+
+	return Indices;
+}
+
+FMeshVertexArray FIGVNodeMeshSceneProxy::MakeSphereVertices(int32 const NumSides)
+{
+	int32 const NumRings = FMath::Max(2, NumSides / 2);
+
+	// As the sphere of DrawSphere: an arc from the top to the bottom, swept around the Z axis
+	FMeshVertexArray Vertices;
+	Vertices.Reserve((NumSides + 1) * (NumRings + 1));
+
+	for (int32 Side = 0; Side <= NumSides; Side++)
+	{
+		float const Theta = 2.f * PI * Side / NumSides;
+		FVector const TangentX(-FMath::Cos(Theta), -FMath::Sin(Theta), 0.f);
+
+		for (int32 Ring = 0; Ring <= NumRings; Ring++)
+		{
+			float const Phi = PI * Ring / NumRings;
+			FVector const Normal(-FMath::Sin(Phi) * FMath::Sin(Theta),
+								 FMath::Sin(Phi) * FMath::Cos(Theta), FMath::Cos(Phi));
+
+			FDynamicMeshVertex Vertex(Normal, FVector2D(float(Side) / NumSides,
+														float(Ring) / NumRings),
+									  FColor::White);
+			Vertex.SetTangents(TangentX, Normal ^ TangentX, Normal);
+			Vertices.Add(Vertex);
+		}
+	}
+
+	return Vertices;
+}
+
+FMeshIndexArray FIGVNodeMeshSceneProxy::MakeSphereIndices(int32 const NumSides)
+{
+	int32 const NumRings = FMath::Max(2, NumSides / 2);
+
+	FMeshIndexArray Indices;
+	Indices.Reserve(NumSides * NumRings * 6);
+
+	for (int32 Side = 0; Side < NumSides; Side++)
+	{
+		int32 const Start0 = Side * (NumRings + 1);
+		int32 const Start1 = (Side + 1) * (NumRings + 1);
+
+		for (int32 Ring = 0; Ring < NumRings; Ring++)
+		{
+			Indices.Add(Start0 + Ring);
+			Indices.Add(Start1 + Ring);
+			Indices.Add(Start0 + Ring + 1);
+
+			Indices.Add(Start1 + Ring);
+			Indices.Add(Start1 + Ring + 1);
+			Indices.Add(Start0 + Ring + 1);
+		}
+	}
+
+	return Indices;
+}
+
+FMeshIndexArray FIGVNodeMeshSceneProxy::MakeIndices(int32 const InNumInstances) const
+{
+	FMeshIndexArray Indices;
+	Indices.SetNumUninitialized(InNumInstances * TemplateIndices.Num());
+
+	int32* Index = Indices.GetData();
+	for (int32 InstanceIdx = 0; InstanceIdx < InNumInstances; InstanceIdx++)
+	{
+		int32 const BaseIdx = InstanceIdx * TemplateVertices.Num();
+		for (int32 const TemplateIndex : TemplateIndices)
+		{
+			*Index++ = BaseIdx + TemplateIndex;
+		}
+	}
+
+	return Indices;
+}
+
+void FIGVNodeMeshSceneProxy::MakeVertices(FIGVNodeMeshFrame const& InFrame,
+										  FMeshVertexArray& OutVertices) const
+{
+	int32 const NumTemplateVertices = TemplateVertices.Num();
+	OutVertices.SetNumUninitialized(InFrame.Instances.Num() * NumTemplateVertices, false);
+
+	FDynamicMeshVertex* Vertex = OutVertices.GetData();
+	for (FIGVNodeMeshInstance const& Instance : InFrame.Instances)
+	{
+		FTransform const& Transform = Instance.Transform;
+		for (FDynamicMeshVertex const& TemplateVertex : TemplateVertices)
+		{
+			// Tangents are only rotated, as the scale of a node is uniform.
+			FVector4 const TangentZ = TemplateVertex.TangentZ;
+			Vertex->Position = Transform.TransformPosition(TemplateVertex.Position);
+			Vertex->TextureCoordinate = TemplateVertex.TextureCoordinate;
+			Vertex->TangentX = Transform.TransformVectorNoScale(TemplateVertex.TangentX);
+			Vertex->TangentZ = FVector4(Transform.TransformVectorNoScale(TangentZ), TangentZ.W);
+			Vertex->Color = Instance.Color;
+			Vertex++;
+		}
+	}
+}
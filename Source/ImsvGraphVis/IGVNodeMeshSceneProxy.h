@@ -0,0 +1,70 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "KWMeshElement.h"
+
+#include "IGVNodeMeshComponent.h"
+
+// Expands the changed instances of a frame into copies of the mesh of the nodes, and writes them
+// over their span of the vertex buffer. The index buffer only depends on the number of allocated
+// instances, and is written once.
+class IMSVGRAPHVIS_API FIGVNodeMeshSceneProxy : public FPrimitiveSceneProxy
+{
+public:
+	class UIGVNodeMeshComponent* IGVNodeMeshComponent;
+
+	int32 NumInstances;  // Drawn, from the start of the vertex buffer
+	int32 const NumAllocatedInstances;
+
+	// LOD 0 of the mesh of the nodes, or a unit sphere if it can not be read on the CPU. Copied for
+	// every instance.
+	FMeshVertexArray TemplateVertices;
+	FMeshIndexArray TemplateIndices;
+
+	FSimpleVertexBuffer VertexBuffer;  // Vertices holds the last uploaded instances only
+	FSimpleIndexBuffer IndexBuffer;
+	FMeshVertexFactory VertexFactory;
+
+	UMaterialInterface* Material;
+	FMaterialRelevance MaterialRelevance;
+	TUniformBufferRef<FPrimitiveUniformShaderParameters> PrimitiveUniformBuffer;
+
+public:
+	virtual ~FIGVNodeMeshSceneProxy();
+
+	FIGVNodeMeshSceneProxy(class UIGVNodeMeshComponent* const Component);
+
+public:
+	virtual void OnTransformChanged() override;
+	virtual bool CanBeOccluded() const override;
+	uint32 GetAllocatedSize() const;
+	virtual uint32 GetMemoryFootprint() const override;
+	// A copy of the template per allocated instance
+	uint32 GetGPUMemorySize() const;
+
+public:
+	void SendRenderDynamicData();
+	void SendRenderDynamicData_RenderThread(FIGVNodeMeshFrameConstPtr const& NewFrame);
+
+	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
+										const FSceneViewFamily& ViewFamily, uint32 VisibilityMap,
+										class FMeshElementCollector& Collector) const override;
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override;
+
+private:
+	// Null if the vertices of the mesh are not kept on the CPU, as in cooked builds without
+	// bAllowCPUAccess
+	static struct FStaticMeshLODResources const* GetMeshLOD(UStaticMesh const* const Mesh);
+	static FMeshVertexArray MakeTemplateVertices(UIGVNodeMeshComponent const* const Component);
+	static FMeshIndexArray MakeTemplateIndices(UIGVNodeMeshComponent const* const Component);
+
+	// UV sphere of NumSides segments and NumSides / 2 rings
+	static FMeshVertexArray MakeSphereVertices(int32 const NumSides);
+	static FMeshIndexArray MakeSphereIndices(int32 const NumSides);
+
+	// One copy of the template per instance
+	FMeshIndexArray MakeIndices(int32 const InNumInstances) const;
+	// Of the instances of the frame only
+	void MakeVertices(FIGVNodeMeshFrame const& InFrame, FMeshVertexArray& OutVertices) const;
+};
@@ -4,13 +4,29 @@
 
 #include "Components/StaticMeshComponent.h"
 #include "Components/TextRenderComponent.h"
+#include "FileHelper.h"
 #include "GameFramework/Controller.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
 #include "Runtime/Engine/Classes/Camera/CameraComponent.h"
 
 #include "IGVGraphActor.h"
 #include "IGVLog.h"
+#include "IGVTrace.h"
 
-AIGVPawn::AIGVPawn() : CursorDistanceScale(0.4)
+AIGVPawn::AIGVPawn()
+	: CursorDistanceScale(0.4),
+	  InteractionMode(EIGVInteractionMode::Live),
+	  Recording(),
+	  InteractionTime(0.f),
+	  ReplayFrameIdx(0),
+	  ReplayFixedDeltaTime(0.f),
+	  ReplayFilePath(),
+	  bExitAfterReplay(false),
+	  bReplayPending(false),
+	  LastReplayTickTime(0.0),
+	  ReplayFrameTimes(),
+	  bLeftMouseButtonReleasedInFrame(false)
 {
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.bStartWithTickEnabled = true;
@@ -51,13 +67,43 @@ AIGVPawn::AIGVPawn() : CursorDistanceScale(0.4)
 void AIGVPawn::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// -IGVReplay=Name [-IGVFixedTimestep=Seconds] [-IGVExitAfterReplay]
+	FString FileName;
+	if (FParse::Value(FCommandLine::Get(), TEXT("IGVReplay="), FileName))
+	{
+		ReplayFilePath = FIGVInteractionRecording::ResolveFilePath(FileName);
+		FParse::Value(FCommandLine::Get(), TEXT("IGVFixedTimestep="), ReplayFixedDeltaTime);
+		bExitAfterReplay = FParse::Param(FCommandLine::Get(), TEXT("IGVExitAfterReplay"));
+		bReplayPending = true;
+	}
 }
 
 void AIGVPawn::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	if (bReplayPending && GraphActor)
+	{
+		bReplayPending = false;
+		if (!BeginReplay(ReplayFilePath, ReplayFixedDeltaTime) && bExitAfterReplay)
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+	}
+
+	// Replayed input takes the place of input devices, before the cursor is updated.
+	if (InteractionMode == EIGVInteractionMode::Replaying)
+	{
+		TickReplay(DeltaTime);
+	}
+
 	UpdateCursor();
+
+	if (InteractionMode == EIGVInteractionMode::Recording)
+	{
+		TickRecording(DeltaTime);
+	}
 }
 
 void AIGVPawn::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -73,6 +119,8 @@ void AIGVPawn::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 
 void AIGVPawn::AddControllerYawInput(float Value)
 {
+	if (InteractionMode == EIGVInteractionMode::Replaying) return;
+
 	APlayerController* const PlayerController = Cast<APlayerController>(Controller);
 	if (PlayerController)
 	{
@@ -82,6 +130,8 @@ void AIGVPawn::AddControllerYawInput(float Value)
 
 void AIGVPawn::AddControllerPitchInput(float Value)
 {
+	if (InteractionMode == EIGVInteractionMode::Replaying) return;
+
 	APlayerController* const PlayerController = Cast<APlayerController>(Controller);
 	if (PlayerController)
 	{
@@ -122,8 +172,189 @@ void AIGVPawn::UpdateCursor()
 
 void AIGVPawn::OnLeftMouseButtonReleased()
 {
+	if (InteractionMode == EIGVInteractionMode::Replaying) return;
+
+	bLeftMouseButtonReleasedInFrame = true;
+
 	if (GraphActor)
 	{
 		GraphActor->OnLeftMouseButtonReleased();
 	}
 }
+
+void AIGVPawn::BeginRecording()
+{
+	if (InteractionMode == EIGVInteractionMode::Replaying) EndReplay();
+
+	Recording.Reset();
+	if (GraphActor)
+	{
+		Recording.NumNodes = GraphActor->Nodes.Num();
+		Recording.NumEdges = GraphActor->Edges.Num();
+	}
+
+	InteractionMode = EIGVInteractionMode::Recording;
+	InteractionTime = 0.f;
+	bLeftMouseButtonReleasedInFrame = false;
+
+	IGV_LOG(Log, TEXT("Recording interaction"));
+}
+
+void AIGVPawn::EndRecording(FString const& FilePath)
+{
+	if (InteractionMode != EIGVInteractionMode::Recording)
+	{
+		IGV_LOG_S(Warning, TEXT("Not recording"));
+		return;
+	}
+
+	InteractionMode = EIGVInteractionMode::Live;
+	Recording.Save(FilePath);
+}
+
+void AIGVPawn::TickRecording(float DeltaTime)
+{
+	InteractionTime += DeltaTime;
+
+	Recording.Frames.Emplace(FIGVInteractionFrame{InteractionTime, PickRayRotation, PickRayOrigin,
+												  bLeftMouseButtonReleasedInFrame});
+	bLeftMouseButtonReleasedInFrame = false;
+}
+
+bool AIGVPawn::BeginReplay(FString const& FilePath, float const FixedDeltaTime)
+{
+	if (InteractionMode == EIGVInteractionMode::Recording)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to replay while recording"));
+		return false;
+	}
+
+	if (!Recording.Load(FilePath)) return false;
+
+	if (GraphActor &&
+		(Recording.NumNodes != GraphActor->Nodes.Num() ||
+		 Recording.NumEdges != GraphActor->Edges.Num()))
+	{
+		IGV_LOG_S(Warning, TEXT("Recorded with %d nodes and %d edges, replaying with %d and %d"),
+				  Recording.NumNodes, Recording.NumEdges, GraphActor->Nodes.Num(),
+				  GraphActor->Edges.Num());
+	}
+
+	ReplayFilePath = FilePath;
+	ReplayFixedDeltaTime = FixedDeltaTime;
+	if (ReplayFixedDeltaTime > 0.f)
+	{
+		FApp::SetFixedDeltaTime(ReplayFixedDeltaTime);
+		FApp::SetUseFixedTimeStep(true);
+	}
+
+	InteractionMode = EIGVInteractionMode::Replaying;
+	InteractionTime = 0.f;
+	ReplayFrameIdx = 0;
+	LastReplayTickTime = FPlatformTime::Seconds();
+	ReplayFrameTimes.Reset(Recording.Frames.Num());
+
+	IGV_LOG(Log, TEXT("Replaying %s"), *FilePath);
+	return true;
+}
+
+void AIGVPawn::EndReplay()
+{
+	if (InteractionMode != EIGVInteractionMode::Replaying) return;
+
+	InteractionMode = EIGVInteractionMode::Live;
+	if (ReplayFixedDeltaTime > 0.f)
+	{
+		FApp::SetUseFixedTimeStep(false);
+	}
+
+	LogReplayFrameTimes();
+
+	FIGVTracer& Tracer = FIGVTracer::Get();
+	if (Tracer.IsEnabled())
+	{
+		Tracer.Stop();
+		Tracer.Write(FPaths::ChangeExtension(ReplayFilePath, TEXT("trace.json")));
+	}
+
+	if (bExitAfterReplay)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+void AIGVPawn::TickReplay(float DeltaTime)
+{
+	double const CurrentTime = FPlatformTime::Seconds();
+	ReplayFrameTimes.Add(CurrentTime - LastReplayTickTime);
+	LastReplayTickTime = CurrentTime;
+
+	TArray<FIGVInteractionFrame> const& Frames = Recording.Frames;
+
+	if (ReplayFixedDeltaTime > 0.f)
+	{
+		if (ReplayFrameIdx < Frames.Num())
+		{
+			ApplyReplayFrame(Frames[ReplayFrameIdx++]);
+		}
+	}
+	else
+	{
+		// Clicks of the frames skipped by a long tick are still applied.
+		InteractionTime += DeltaTime;
+		while (ReplayFrameIdx < Frames.Num() && Frames[ReplayFrameIdx].Time <= InteractionTime)
+		{
+			ApplyReplayFrame(Frames[ReplayFrameIdx++]);
+		}
+	}
+
+	if (ReplayFrameIdx >= Frames.Num())
+	{
+		EndReplay();
+	}
+}
+
+void AIGVPawn::ApplyReplayFrame(FIGVInteractionFrame const& Frame)
+{
+	PickRayRotation = Frame.PickRayRotation;
+	SetActorLocation(Frame.PickRayOrigin);
+
+	if (Frame.bLeftMouseButtonReleased && GraphActor)
+	{
+		GraphActor->OnLeftMouseButtonReleased();
+	}
+}
+
+void AIGVPawn::LogReplayFrameTimes() const
+{
+	// The first tick includes loading the recording.
+	TArray<float> FrameTimes(ReplayFrameTimes);
+	if (FrameTimes.Num() > 1) FrameTimes.RemoveAt(0);
+	if (FrameTimes.Num() == 0) return;
+
+	float Total = 0.f;
+	for (float const FrameTime : FrameTimes)
+	{
+		Total += FrameTime;
+	}
+	FrameTimes.Sort();
+
+	int32 const Num = FrameTimes.Num();
+	IGV_LOG(Display,
+			TEXT("Replayed %d frames in %.3f s: mean %.2f ms, median %.2f ms, 95th %.2f ms, ")
+				TEXT("max %.2f ms"),
+			Num, Total, Total / Num * 1000.f, FrameTimes[Num / 2] * 1000.f,
+			FrameTimes[FMath::Min(Num * 95 / 100, Num - 1)] * 1000.f, FrameTimes.Last() * 1000.f);
+
+	FString Csv = TEXT("frame,frame_ms\n");
+	for (int32 FrameIdx = 0; FrameIdx < ReplayFrameTimes.Num(); FrameIdx++)
+	{
+		Csv += FString::Printf(TEXT("%d,%f\n"), FrameIdx, ReplayFrameTimes[FrameIdx] * 1000.f);
+	}
+
+	FString const CsvFilePath = FPaths::ChangeExtension(ReplayFilePath, TEXT("frames.csv"));
+	if (FFileHelper::SaveStringToFile(Csv, *CsvFilePath))
+	{
+		IGV_LOG(Display, TEXT("Wrote %s"), *CsvFilePath);
+	}
+}
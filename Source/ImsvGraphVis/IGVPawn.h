@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
 
+#include "IGVInteractionRecording.h"
+
 #include "IGVPawn.generated.h"
 
 UCLASS()
@@ -39,6 +41,21 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = ImmersiveGraphVisualization)
 	FVector PickRayDirection;
 
+	EIGVInteractionMode::Type InteractionMode;
+	FIGVInteractionRecording Recording;
+	float InteractionTime;  // Since the beginning of the recording or replay, in seconds
+
+	// Replay
+	int32 ReplayFrameIdx;
+	float ReplayFixedDeltaTime;  // One recorded frame per tick if positive
+	FString ReplayFilePath;
+	bool bExitAfterReplay;
+	bool bReplayPending;  // Requested on the command line, started once GraphActor is set
+	double LastReplayTickTime;
+	TArray<float> ReplayFrameTimes;  // Game thread frame times, in seconds
+
+	bool bLeftMouseButtonReleasedInFrame;
+
 public:
 	AIGVPawn();
 
@@ -56,4 +73,18 @@ public:
 	void UpdateCursor();
 
 	void OnLeftMouseButtonReleased();
+
+	void BeginRecording();
+	void EndRecording(FString const& FilePath);
+
+	// Drives the pick ray and clicks from a recording instead of input devices. A positive
+	// FixedDeltaTime also fixes the engine timestep, so every replay runs the same frames.
+	bool BeginReplay(FString const& FilePath, float const FixedDeltaTime);
+	void EndReplay();
+
+protected:
+	void TickRecording(float DeltaTime);
+	void TickReplay(float DeltaTime);
+	void ApplyReplayFrame(FIGVInteractionFrame const& Frame);
+	void LogReplayFrameTimes() const;
 };
@@ -9,6 +9,9 @@
 #include "IGVData.h"
 #include "IGVGraphActor.h"
 #include "IGVLog.h"
+#include "IGVMemoryUsage.h"
+#include "IGVPawn.h"
+#include "IGVTrace.h"
 
 AIGVPlayerController::AIGVPlayerController()
 {
@@ -117,3 +120,202 @@ void AIGVPlayerController::IGV_SetHalo(bool const Value)
 
 	GraphActor->SetHalo(Value);
 }
+
+void AIGVPlayerController::IGV_SetEdgeBundleLOD(int32 Height)
+{
+	if (GraphActor == nullptr)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to find GraphActor instance"));
+		return;
+	}
+
+	GraphActor->SetEdgeBundleLODHeight(Height);
+}
+
+void AIGVPlayerController::IGV_PrintMemoryUsage()
+{
+	if (GraphActor == nullptr)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to find GraphActor instance"));
+		return;
+	}
+
+	FIGVMemoryUsage(GraphActor).Log();
+	GraphActor->UpdateMemoryStats();
+}
+
+AIGVPawn* AIGVPlayerController::GetIGVPawn() const
+{
+	AIGVPawn* const IGVPawn = Cast<AIGVPawn>(GetPawn());
+	if (IGVPawn == nullptr)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to find Pawn instance"));
+	}
+	return IGVPawn;
+}
+
+void AIGVPlayerController::IGV_StartRecording()
+{
+	AIGVPawn* const IGVPawn = GetIGVPawn();
+	if (IGVPawn == nullptr) return;
+
+	IGVPawn->BeginRecording();
+}
+
+void AIGVPlayerController::IGV_StopRecording(FString const& Name)
+{
+	AIGVPawn* const IGVPawn = GetIGVPawn();
+	if (IGVPawn == nullptr) return;
+
+	FString const FileName =
+		Name.IsEmpty() ? FDateTime::Now().ToString(TEXT("Interaction-%Y%m%d-%H%M%S")) : Name;
+	IGVPawn->EndRecording(FIGVInteractionRecording::ResolveFilePath(FileName));
+}
+
+void AIGVPlayerController::IGV_Replay(FString const& Name, float FixedDeltaTime)
+{
+	AIGVPawn* const IGVPawn = GetIGVPawn();
+	if (IGVPawn == nullptr) return;
+
+	if (FixedDeltaTime < 0)
+	{
+		IGV_LOG_S(Warning,
+				  TEXT("Input value is too small. Timestep should be 0 (variable) or more."));
+		FixedDeltaTime = 0;
+	}
+
+	IGVPawn->BeginReplay(FIGVInteractionRecording::ResolveFilePath(Name), FixedDeltaTime);
+}
+
+void AIGVPlayerController::IGV_StartTrace()
+{
+	FIGVTracer::Get().Start();
+}
+
+void AIGVPlayerController::IGV_StopTrace(FString const& Name)
+{
+	FIGVTracer& Tracer = FIGVTracer::Get();
+	Tracer.Stop();
+
+	FString FileName =
+		Name.IsEmpty() ? FDateTime::Now().ToString(TEXT("Trace-%Y%m%d-%H%M%S")) : Name;
+	if (FPaths::GetExtension(FileName).IsEmpty())
+	{
+		FileName += TEXT(".json");
+	}
+	Tracer.Write(FPaths::IsRelative(FileName)
+					 ? FPaths::Combine(*FIGVTracer::DefaultDirPath(), *FileName)
+					 : FileName);
+}
+
+void AIGVPlayerController::IGV_StartIngest(FString const& Source)
+{
+	if (GraphActor == nullptr)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to find GraphActor instance"));
+		return;
+	}
+
+	GraphActor->DeltaIngestion.Begin(Source.IsEmpty() ? TEXT("tcp:7777") : Source);
+}
+
+void AIGVPlayerController::IGV_StopIngest()
+{
+	if (GraphActor == nullptr)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to find GraphActor instance"));
+		return;
+	}
+
+	GraphActor->DeltaIngestion.End();
+}
+
+void AIGVPlayerController::IGV_ProduceDeltas(FString const& Target, float DeltasPerSecond,
+											 float Duration)
+{
+	if (GraphActor == nullptr)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to find GraphActor instance"));
+		return;
+	}
+
+	// Stops the running one, if any
+	GraphActor->DeltaProducer.Reset();
+	if (DeltasPerSecond <= 0) return;
+
+	GraphActor->DeltaProducer = MakeUnique<FIGVDeltaProducer>(
+		GraphActor, Target.IsEmpty() ? TEXT("tcp:7777") : Target, DeltasPerSecond, Duration,
+		FMath::Rand());
+	if (!GraphActor->DeltaProducer->Begin()) GraphActor->DeltaProducer.Reset();
+}
+
+void AIGVPlayerController::IGV_SeekTemporal(float Time)
+{
+	if (GraphActor == nullptr)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to find GraphActor instance"));
+		return;
+	}
+
+	if (GraphActor->GetNumTemporalSteps() == 0)
+	{
+		IGV_LOG_S(Warning, TEXT("The loaded graph has no temporal steps"));
+		return;
+	}
+
+	GraphActor->SeekTemporal(Time);
+}
+
+void AIGVPlayerController::IGV_PlayTemporal(float StepsPerSecond)
+{
+	if (GraphActor == nullptr)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to find GraphActor instance"));
+		return;
+	}
+
+	if (GraphActor->GetNumTemporalSteps() == 0)
+	{
+		IGV_LOG_S(Warning, TEXT("The loaded graph has no temporal steps"));
+		return;
+	}
+
+	GraphActor->PlayTemporal(StepsPerSecond);
+}
+
+void AIGVPlayerController::IGV_SemanticZoom(float FocusAngle)
+{
+	if (GraphActor == nullptr)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to find GraphActor instance"));
+		return;
+	}
+
+	GraphActor->SemanticZoomFocusAngle = FocusAngle;
+	if (FocusAngle <= 0.f) GraphActor->ExpandAllClusters();
+}
+
+void AIGVPlayerController::IGV_CollapseClusters(int32 Height)
+{
+	if (GraphActor == nullptr)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to find GraphActor instance"));
+		return;
+	}
+
+	// Otherwise replaced by the view-driven cut
+	GraphActor->SemanticZoomFocusAngle = 0.f;
+	GraphActor->CollapseClusters(Height);
+}
+
+void AIGVPlayerController::IGV_ExpandClusters()
+{
+	if (GraphActor == nullptr)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to find GraphActor instance"));
+		return;
+	}
+
+	GraphActor->SemanticZoomFocusAngle = 0.f;
+	GraphActor->ExpandAllClusters();
+}
@@ -35,4 +35,56 @@ public:
 
 	UFUNCTION(exec)
 	void IGV_SetHalo(bool const Value);
+
+	// Draws the edges below clusters of the given height as bundles, 0 draws every edge.
+	UFUNCTION(exec)
+	void IGV_SetEdgeBundleLOD(int32 Height);
+
+	UFUNCTION(exec)
+	void IGV_PrintMemoryUsage();
+
+	UFUNCTION(exec)
+	void IGV_StartRecording();
+
+	UFUNCTION(exec)
+	void IGV_StopRecording(FString const& Name);
+
+	UFUNCTION(exec)
+	void IGV_Replay(FString const& Name, float FixedDeltaTime);
+
+	UFUNCTION(exec)
+	void IGV_StartTrace();
+
+	UFUNCTION(exec)
+	void IGV_StopTrace(FString const& Name);
+
+	// Source is "tcp:<port>" or a file, see FIGVDeltaIngestion
+	UFUNCTION(exec)
+	void IGV_StartIngest(FString const& Source);
+
+	UFUNCTION(exec)
+	void IGV_StopIngest();
+
+	// Runs a stand-in producer of random deltas, see FIGVDeltaProducer
+	UFUNCTION(exec)
+	void IGV_ProduceDeltas(FString const& Target, float DeltasPerSecond, float Duration);
+
+	UFUNCTION(exec)
+	void IGV_SeekTemporal(float Time);
+
+	UFUNCTION(exec)
+	void IGV_PlayTemporal(float StepsPerSecond);
+
+	// Collapses the clusters away from the view direction, see FIGVSemanticZoom. Zero turns it off.
+	UFUNCTION(exec)
+	void IGV_SemanticZoom(float FocusAngle);
+
+	UFUNCTION(exec)
+	void IGV_CollapseClusters(int32 Height);
+
+	UFUNCTION(exec)
+	void IGV_ExpandClusters();
+
+protected:
+	class AIGVPawn* GetIGVPawn() const;
 };
@@ -0,0 +1,553 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVSemanticZoom.h"
+
+#include "Components/LineBatchComponent.h"
+
+#include "IGVEdgeMeshComponent.h"
+#include "IGVFunctionLibrary.h"
+#include "IGVGraphActor.h"
+#include "IGVLog.h"
+#include "IGVNodeActor.h"
+#include "IGVPawn.h"
+#include "IGVStats.h"
+
+// In degrees. A collapsed cluster is expanded this much closer to the focus than it was
+// collapsed at, so that clusters on the boundary do not flicker as the view moves.
+static float const CollapseHysteresis = 5.f;
+
+// The cut is updated once the view turned by a degree.
+static float const MinViewTurnCos = 0.99984769515f;  // cos 1 deg
+
+static int32 const NumMetaEdgeSegments = 8;
+static float const MetaNodeScalePerDoubling = .25f;  // Of the number of nodes
+static float const MetaEdgeWidthPerDoubling = .5f;	 // Of the number of merged edges
+
+FIGVSemanticZoom::FIGVSemanticZoom()
+	: GraphActor(nullptr),
+	  MetaNodes(),
+	  MetaEdges(),
+	  bUpdateMetaNodesRequired(false),
+	  bUpdateMetaEdgesRequired(false),
+	  NodeMarks(),
+	  LastFocusAngle(0.f),
+	  LastViewDirection(FVector::ZeroVector),
+	  bWasInTransition(false)
+{
+}
+
+void FIGVSemanticZoom::Init(AIGVGraphActor* const InGraphActor)
+{
+	GraphActor = InGraphActor;
+}
+
+void FIGVSemanticZoom::Reset()
+{
+	for (auto const& Pair : MetaNodes)
+	{
+		GraphActor->ReleaseNodeActor(Pair.Value);
+	}
+	MetaNodes.Empty();
+	MetaEdges.Empty();
+	NodeMarks.Empty();
+
+	// The next graph is cut on its first tick.
+	LastViewDirection = FVector::ZeroVector;
+
+	GraphActor->MetaEdgeLineBatchComponent->Flush();
+	bUpdateMetaNodesRequired = false;
+	bUpdateMetaEdgesRequired = false;
+
+	SET_DWORD_STAT(STAT_IGV_NumMetaNodes, 0);
+	SET_DWORD_STAT(STAT_IGV_NumMetaEdges, 0);
+}
+
+uint32 FIGVSemanticZoom::GetAllocatedSize() const
+{
+	return MetaNodes.GetAllocatedSize() + MetaEdges.GetAllocatedSize() +
+		   NodeMarks.GetAllocatedSize();
+}
+
+void FIGVSemanticZoom::Tick()
+{
+	FIGVCluster* const RootCluster = GraphActor->RootCluster;
+	if (RootCluster == nullptr) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_IGV_SemanticZoom);
+
+	float const FocusAngle = GraphActor->SemanticZoomFocusAngle;
+	AIGVPawn const* const Pawn = UIGVFunctionLibrary::GetPawn(GraphActor);
+	if (FocusAngle > 0.f && Pawn != nullptr)
+	{
+		FVector const ViewDirection = GraphActor->GetActorTransform().InverseTransformVectorNoScale(
+			Pawn->GetViewRotation().Vector());
+
+		if (FocusAngle != LastFocusAngle || (ViewDirection | LastViewDirection) < MinViewTurnCos)
+		{
+			LastFocusAngle = FocusAngle;
+			LastViewDirection = ViewDirection;
+
+			for (FIGVCluster* const Child : RootCluster->Children)
+			{
+				UpdateCut(*Child, ViewDirection);
+			}
+		}
+	}
+	else if (FocusAngle <= 0.f)
+	{
+		// The last cut is kept, and recomputed once turned on again.
+		LastFocusAngle = 0.f;
+	}
+
+	if (bUpdateMetaNodesRequired) UpdateMetaNodes();
+
+	// Drawn nodes move in highlight transitions, and the meta-edges follow until the last frame.
+	bool const bIsInTransition = GraphActor->TransitionManager.IsActive();
+	if (bUpdateMetaEdgesRequired || (IsActive() && (bIsInTransition || bWasInTransition)))
+	{
+		UpdateMetaEdges();
+	}
+	bWasInTransition = bIsInTransition;
+}
+
+bool FIGVSemanticZoom::CollapseCluster(int32 const ClusterIdx)
+{
+	TArray<FIGVCluster>& Clusters = GraphActor->Clusters;
+
+	auto IsCollapsible = [&Clusters, ClusterIdx]() {
+		// Detached leaf clusters are roots of height 0.
+		if (!Clusters.IsValidIndex(ClusterIdx)) return false;
+		FIGVCluster const& Cluster = Clusters[ClusterIdx];
+		if (Cluster.Height == 0 || Cluster.IsRoot()) return false;
+
+		for (FIGVCluster const* Ancestor = &Cluster; Ancestor; Ancestor = Ancestor->Parent)
+		{
+			if (Ancestor->bIsCollapsed) return false;
+		}
+		return true;
+	};
+
+	if (!IsCollapsible())
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to collapse cluster %d"), ClusterIdx);
+		return false;
+	}
+
+	Recut(Clusters[ClusterIdx], TArray<int32>{ClusterIdx});
+	return true;
+}
+
+bool FIGVSemanticZoom::ExpandCluster(int32 const ClusterIdx)
+{
+	TArray<FIGVCluster>& Clusters = GraphActor->Clusters;
+	if (!Clusters.IsValidIndex(ClusterIdx) || !Clusters[ClusterIdx].bIsCollapsed)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to expand cluster %d"), ClusterIdx);
+		return false;
+	}
+
+	FIGVCluster& Cluster = Clusters[ClusterIdx];
+
+	TArray<int32> ChildIdxs;
+	for (FIGVCluster const* const Child : Cluster.Children)
+	{
+		if (!Child->IsLeaf()) ChildIdxs.Add(Child->Idx);
+	}
+
+	Recut(Cluster, ChildIdxs);
+	return true;
+}
+
+bool FIGVSemanticZoom::CollapseClusters(int32 const Height)
+{
+	FIGVCluster* const RootCluster = GraphActor->RootCluster;
+	if (RootCluster == nullptr || Height < 1 || Height >= RootCluster->Height)
+	{
+		IGV_LOG_S(Warning, TEXT("Unable to collapse the clusters of height %d"), Height);
+		return false;
+	}
+
+	TArray<int32> ClusterIdxs;
+	for (FIGVCluster const& Cluster : GraphActor->Clusters)
+	{
+		if (Cluster.Height == Height) ClusterIdxs.Add(Cluster.Idx);
+	}
+
+	Recut(*RootCluster, ClusterIdxs);
+	return true;
+}
+
+void FIGVSemanticZoom::ExpandAll()
+{
+	if (!IsActive() || GraphActor->RootCluster == nullptr) return;
+
+	Recut(*GraphActor->RootCluster, TArray<int32>());
+}
+
+int32 FIGVSemanticZoom::FindPickedMetaNode() const
+{
+	AIGVPawn const* const Pawn = UIGVFunctionLibrary::GetPawn(GraphActor);
+	if (Pawn == nullptr) return INDEX_NONE;
+
+	int32 PickedClusterIdx = INDEX_NONE;
+	float MinDistance = GraphActor->PickDistanceThreshold;
+
+	for (auto const& Pair : MetaNodes)
+	{
+		FVector const Location = Pair.Value->GetActorLocation();
+		if (((Location - Pawn->PickRayOrigin) | Pawn->PickRayDirection) <= 0.f) continue;
+
+		// Relative to the size of the meta-node, so that a large one is as easy to pick as a node
+		float const Distance =
+			FMath::PointDistToLine(Location, Pawn->PickRayDirection, Pawn->PickRayOrigin) /
+			Pair.Value->GetActorScale3D().X;
+
+		if (Distance < MinDistance)
+		{
+			MinDistance = Distance;
+			PickedClusterIdx = Pair.Key;
+		}
+	}
+
+	return PickedClusterIdx;
+}
+
+int32 FIGVSemanticZoom::FindCollapsedAncestor(AIGVNodeActor const* const Node) const
+{
+	if (!IsActive()) return INDEX_NONE;
+
+	// At most one ancestor is collapsed.
+	for (int32 const AncIdx : Node->AncIdxs)
+	{
+		if (GraphActor->Clusters[AncIdx].bIsCollapsed) return AncIdx;
+	}
+	return INDEX_NONE;
+}
+
+void FIGVSemanticZoom::AddEdge(int32 const EdgeIdx)
+{
+	if (IsActive()) MergeEdge(EdgeIdx, 1);
+}
+
+void FIGVSemanticZoom::RemoveEdge(int32 const EdgeIdx)
+{
+	if (IsActive()) MergeEdge(EdgeIdx, -1);
+}
+
+void FIGVSemanticZoom::UpdateNode(AIGVNodeActor* const Node)
+{
+	if (IsActive()) Node->SetActorHiddenInGame(FindCollapsedAncestor(Node) != INDEX_NONE);
+}
+
+void FIGVSemanticZoom::MarkLayoutChanged()
+{
+	if (IsActive()) bUpdateMetaNodesRequired = true;
+}
+
+uint64 FIGVSemanticZoom::MakeMetaEdgeKey(int32 const ClusterIdx, int32 const OtherClusterIdx)
+{
+	// Undirected, the lower index first
+	return (uint64(FMath::Min(ClusterIdx, OtherClusterIdx)) << 32) |
+		   uint32(FMath::Max(ClusterIdx, OtherClusterIdx));
+}
+
+bool FIGVSemanticZoom::ShouldCollapse(FIGVCluster const& Cluster,
+									  FVector const& ViewDirection) const
+{
+	if (Cluster.IsLeaf()) return false;
+
+	// A cluster is collapsed SemanticZoomFocusAngle farther from the focus than its children.
+	float const Angle = FMath::RadiansToDegrees(
+		FMath::Acos(FMath::Clamp(Cluster.Pos3D | ViewDirection, -1.f, 1.f)));
+	float const Threshold = GraphActor->SemanticZoomFocusAngle * Cluster.Height -
+							(Cluster.bIsCollapsed ? CollapseHysteresis : 0.f);
+
+	return Angle > Threshold;
+}
+
+void FIGVSemanticZoom::UpdateCut(FIGVCluster& Cluster, FVector const& ViewDirection)
+{
+	if (Cluster.IsLeaf()) return;
+
+	bool const bCollapse = ShouldCollapse(Cluster, ViewDirection);
+
+	if (Cluster.bIsCollapsed)
+	{
+		if (bCollapse) return;
+
+		TArray<int32> ClusterIdxs;
+		for (FIGVCluster* const Child : Cluster.Children)
+		{
+			FindCut(*Child, ViewDirection, ClusterIdxs);
+		}
+		Recut(Cluster, ClusterIdxs);
+	}
+	else if (bCollapse)
+	{
+		Recut(Cluster, TArray<int32>{Cluster.Idx});
+	}
+	else if (Cluster.Height > 1)
+	{
+		// Only visits the expanded clusters, not the drawn nodes.
+		for (FIGVCluster* const Child : Cluster.Children)
+		{
+			UpdateCut(*Child, ViewDirection);
+		}
+	}
+}
+
+void FIGVSemanticZoom::FindCut(FIGVCluster& Cluster, FVector const& ViewDirection,
+							   TArray<int32>& OutClusterIdxs) const
+{
+	if (Cluster.IsLeaf()) return;
+
+	if (ShouldCollapse(Cluster, ViewDirection))
+	{
+		OutClusterIdxs.Add(Cluster.Idx);
+	}
+	else if (Cluster.Height > 1)
+	{
+		for (FIGVCluster* const Child : Cluster.Children)
+		{
+			FindCut(*Child, ViewDirection, OutClusterIdxs);
+		}
+	}
+}
+
+void FIGVSemanticZoom::Recut(FIGVCluster& Subtree, TArray<int32> const& ClusterIdxs)
+{
+	SCOPE_CYCLE_COUNTER(STAT_IGV_SemanticZoom);
+
+	TArray<AIGVNodeActor*> const& Nodes = GraphActor->Nodes;
+	FIGVAdjacency const& Adjacency = GraphActor->Adjacency;
+
+	if (NodeMarks.Num() != Nodes.Num()) NodeMarks.Init(false, Nodes.Num());
+
+	TArray<AIGVNodeActor*> SubtreeNodes;
+	SubtreeNodes.Reserve(Subtree.NumDescendantNodes);
+	Subtree.ForEachDescendantFirst([this, &SubtreeNodes](FIGVCluster& Cluster) {
+		if (!Cluster.IsLeaf()) return;
+		SubtreeNodes.Add(Cluster.Node);
+		NodeMarks[Cluster.NodeIdx] = true;
+	});
+
+	// An edge within the subtree is taken once, from its endpoint of the lower index.
+	TArray<int32> EdgeIdxs;
+	for (AIGVNodeActor const* const Node : SubtreeNodes)
+	{
+		TArrayView<int32 const> const Neighbors = Adjacency.GetNeighbors(Node->Idx);
+		TArrayView<int32 const> const NodeEdgeIdxs = Adjacency.GetEdges(Node->Idx);
+		for (int32 Idx = 0; Idx < Neighbors.Num(); Idx++)
+		{
+			if (!NodeMarks[Neighbors[Idx]] || Neighbors[Idx] > Node->Idx)
+			{
+				EdgeIdxs.Add(NodeEdgeIdxs[Idx]);
+			}
+		}
+	}
+
+	for (int32 const EdgeIdx : EdgeIdxs)
+	{
+		MergeEdge(EdgeIdx, -1);
+	}
+
+	Subtree.ForEachDescendantFirst([this](FIGVCluster& Cluster) {
+		if (!Cluster.bIsCollapsed) return;
+		Cluster.bIsCollapsed = false;
+		GraphActor->ReleaseNodeActor(MetaNodes.FindAndRemoveChecked(Cluster.Idx));
+	});
+
+	for (int32 const ClusterIdx : ClusterIdxs)
+	{
+		FIGVCluster& Cluster = GraphActor->Clusters[ClusterIdx];
+		check(!Cluster.IsLeaf() && !Cluster.IsRoot());
+		Cluster.bIsCollapsed = true;
+
+		AIGVNodeActor* const MetaNode = GraphActor->SpawnNodeActor();
+		MetaNode->Idx = INDEX_NONE;
+		MetaNode->ClusterIdx = ClusterIdx;
+		PlaceMetaNode(Cluster, MetaNode);
+		MetaNodes.Add(ClusterIdx, MetaNode);
+	}
+
+	for (AIGVNodeActor* const Node : SubtreeNodes)
+	{
+		NodeMarks[Node->Idx] = false;
+		Node->SetActorHiddenInGame(FindCollapsedAncestor(Node) != INDEX_NONE);
+	}
+
+	for (int32 const EdgeIdx : EdgeIdxs)
+	{
+		MergeEdge(EdgeIdx, 1);
+	}
+
+	bUpdateMetaEdgesRequired = true;
+
+	IGV_LOG(Verbose, TEXT("Cluster %d cut into %d meta-nodes: %d nodes and %d edges visited, %d "
+						  "meta-nodes and %d meta-edges in total"),
+			Subtree.Idx, ClusterIdxs.Num(), SubtreeNodes.Num(), EdgeIdxs.Num(), MetaNodes.Num(),
+			MetaEdges.Num());
+}
+
+void FIGVSemanticZoom::MergeEdge(int32 const EdgeIdx, int32 const Weight)
+{
+	FIGVEdgeStore& EdgeStore = GraphActor->EdgeStore;
+	AIGVNodeActor const* const SourceNode = GraphActor->Nodes[EdgeStore.SourceIdxs[EdgeIdx]];
+	AIGVNodeActor const* const TargetNode = GraphActor->Nodes[EdgeStore.TargetIdxs[EdgeIdx]];
+	int32 const SourceClusterIdx = FindCollapsedAncestor(SourceNode);
+	int32 const TargetClusterIdx = FindCollapsedAncestor(TargetNode);
+
+	if (Weight > 0)
+	{
+		bool const bIsAggregated =
+			SourceClusterIdx != INDEX_NONE || TargetClusterIdx != INDEX_NONE;
+		if (EdgeStore.HasFlags(EdgeIdx, EIGVEdgeFlags::Aggregated) != bIsAggregated)
+		{
+			if (bIsAggregated)
+			{
+				EdgeStore.SetFlags(EdgeIdx, EIGVEdgeFlags::Aggregated);
+			}
+			else
+			{
+				EdgeStore.ClearFlags(EdgeIdx, EIGVEdgeFlags::Aggregated);
+			}
+
+			// Merged edges are left out of the meshes of the other groups, and are not drawn
+			// from that of the default group.
+			if (EdgeStore.GetRenderGroup(EdgeIdx) != EIGVEdgeRenderGroup::Default)
+			{
+				GraphActor->bUpdateHighlightedEdgeMeshesRequired = true;
+			}
+			else
+			{
+				GraphActor->DefaultEdgeGroupMeshComponent->MarkDrawStateDirty();
+			}
+		}
+	}
+
+	// Drawn as is, or within a meta-node
+	if (SourceClusterIdx == TargetClusterIdx) return;
+
+	uint64 const Key = MakeMetaEdgeKey(
+		SourceClusterIdx != INDEX_NONE ? SourceClusterIdx : SourceNode->ClusterIdx,
+		TargetClusterIdx != INDEX_NONE ? TargetClusterIdx : TargetNode->ClusterIdx);
+
+	int32& NumMerged = MetaEdges.FindOrAdd(Key);
+	NumMerged += Weight;
+	if (NumMerged <= 0) MetaEdges.Remove(Key);
+
+	bUpdateMetaEdgesRequired = true;
+}
+
+void FIGVSemanticZoom::PlaceMetaNode(FIGVCluster& Cluster, AIGVNodeActor* const MetaNode) const
+{
+	int32 const NumNodes = FMath::Max(1, Cluster.NumDescendantNodes);
+
+	FLinearColor Color(0.f, 0.f, 0.f, 0.f);
+	Cluster.ForEachDescendantFirst([&Color](FIGVCluster& Descendant) {
+		if (Descendant.IsLeaf()) Color += Descendant.Node->Color;
+	});
+
+	MetaNode->SetText(FString::Printf(TEXT("%d nodes"), Cluster.NumDescendantNodes));
+	MetaNode->SetColor(Color / NumNodes);
+	MetaNode->SetActorRelativeScale3D(
+		FVector(1.f + MetaNodeScalePerDoubling * FMath::Log2(float(NumNodes))));
+	MetaNode->SetPos3D(Cluster.Pos3D);
+}
+
+void FIGVSemanticZoom::UpdateMetaNodes()
+{
+	for (auto const& Pair : MetaNodes)
+	{
+		PlaceMetaNode(GraphActor->Clusters[Pair.Key], Pair.Value);
+	}
+
+	bUpdateMetaNodesRequired = false;
+	bUpdateMetaEdgesRequired = true;
+}
+
+void FIGVSemanticZoom::UpdateMetaEdges()
+{
+	bUpdateMetaEdgesRequired = false;
+
+	SET_DWORD_STAT(STAT_IGV_NumMetaNodes, MetaNodes.Num());
+	SET_DWORD_STAT(STAT_IGV_NumMetaEdges, MetaEdges.Num());
+
+	ULineBatchComponent* const LineBatchComponent = GraphActor->MetaEdgeLineBatchComponent;
+	LineBatchComponent->Flush();
+	if (MetaEdges.Num() == 0) return;
+
+	TArray<FIGVCluster> const& Clusters = GraphActor->Clusters;
+	FTransform const& Transform = GraphActor->GetActorTransform();
+	float const Radius = GraphActor->GetSphereRadius();
+	float const BundlingStrength = GraphActor->EdgeBundlingStrength;
+
+	auto FindEndpoint = [this, &Clusters](int32 const ClusterIdx) -> AIGVNodeActor const* {
+		FIGVCluster const& Cluster = Clusters[ClusterIdx];
+		return Cluster.IsLeaf() ? Cluster.Node : MetaNodes.FindChecked(ClusterIdx);
+	};
+
+	// As in the spline compute shader
+	auto Slerp = [](FVector const& A, FVector const& B, float const Alpha) {
+		return FMath::Lerp(A, B, Alpha).GetSafeNormal();
+	};
+
+	TArray<FBatchedLine> Lines;
+	Lines.Reserve(MetaEdges.Num() * NumMetaEdgeSegments);
+
+	for (auto const& Pair : MetaEdges)
+	{
+		int32 const SourceClusterIdx = int32(Pair.Key >> 32);
+		int32 const TargetClusterIdx = int32(Pair.Key & 0xFFFFFFFF);
+		AIGVNodeActor const* const Source = FindEndpoint(SourceClusterIdx);
+		AIGVNodeActor const* const Target = FindEndpoint(TargetClusterIdx);
+
+		// Bent toward the lowest common ancestor of the endpoints, as a bundled edge is toward
+		// the clusters of its path. All leaves are at the same depth.
+		FIGVCluster const* Ancestor = &Clusters[SourceClusterIdx];
+		FIGVCluster const* Other = &Clusters[TargetClusterIdx];
+		while (Ancestor != Other)
+		{
+			if (Ancestor->Height <= Other->Height) Ancestor = Ancestor->Parent;
+			if (Other->Height < Ancestor->Height) Other = Other->Parent;
+		}
+		bool const bIsBent = !Ancestor->IsRoot();
+		float const AncestorLevel = Ancestor->DefaultLevel();
+
+		float const Width = GraphActor->EdgeWidth *
+							(1.f + MetaEdgeWidthPerDoubling * FMath::Log2(float(Pair.Value)));
+
+		FVector LastPosition = FVector::ZeroVector;
+		for (int32 SampleIdx = 0; SampleIdx <= NumMetaEdgeSegments; SampleIdx++)
+		{
+			float const Alpha = float(SampleIdx) / NumMetaEdgeSegments;
+
+			FVector Direction = Slerp(Source->Pos3D, Target->Pos3D, Alpha);
+			float Level = FMath::Lerp(Source->LevelScale, Target->LevelScale, Alpha);
+			if (bIsBent)
+			{
+				FVector const BentDirection =
+					Slerp(Slerp(Source->Pos3D, Ancestor->Pos3D, Alpha),
+						  Slerp(Ancestor->Pos3D, Target->Pos3D, Alpha), Alpha);
+				float const BentLevel =
+					FMath::Lerp(FMath::Lerp(Source->LevelScale, AncestorLevel, Alpha),
+								FMath::Lerp(AncestorLevel, Target->LevelScale, Alpha), Alpha);
+
+				Direction = Slerp(Direction, BentDirection, BundlingStrength);
+				Level = FMath::Lerp(Level, BentLevel, BundlingStrength);
+			}
+
+			FVector const Position = Transform.TransformPosition(Direction * Level * Radius);
+			if (SampleIdx > 0)
+			{
+				float const ColorAlpha = (SampleIdx - .5f) / NumMetaEdgeSegments;
+				Lines.Emplace(LastPosition, Position,
+							  FMath::Lerp(Source->Color, Target->Color, ColorAlpha), 0.f, Width,
+							  uint8(SDPG_World));
+			}
+			LastPosition = Position;
+		}
+	}
+
+	LineBatchComponent->DrawLines(Lines);
+}
@@ -0,0 +1,97 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Semantic zoom over the clustering hierarchy, driven from AIGVGraphActor::Tick. A collapsed
+// cluster is drawn as one meta-node at its Pos3D instead of its nodes, and the edges leaving it
+// are merged into meta-edges: one per pair of drawn endpoints, weighted by the number of edges
+// merged. Edges within a collapsed cluster are not drawn at all.
+//
+// The collapsed clusters form a cut of the hierarchy, none is an ancestor of another. The cut
+// follows the view direction while SemanticZoomFocusAngle is positive, and is otherwise changed
+// by CollapseCluster and ExpandCluster. Either way only a subtree whose cut changed is visited:
+// the edges of its nodes are taken out of the meta-edges of the old cut and merged into those of
+// the new one. Merged edges stay in the default edge mesh and are skipped by its scene proxy, see
+// EIGVEdgeFlags::Aggregated. Meta-edges are few, and are drawn as polylines by
+// AIGVGraphActor::MetaEdgeLineBatchComponent.
+class IMSVGRAPHVIS_API FIGVSemanticZoom
+{
+public:
+	class AIGVGraphActor* GraphActor;
+
+	// Spawned by AIGVGraphActor::SpawnNodeActor, but not added to Nodes
+	TMap<int32, class AIGVNodeActor*> MetaNodes;  // By collapsed cluster
+
+	// Number of merged edges by their pair of drawn endpoints, see MakeMetaEdgeKey. An endpoint
+	// is a collapsed cluster or the leaf cluster of a drawn node.
+	TMap<uint64, int32> MetaEdges;
+
+	bool bUpdateMetaNodesRequired;
+	bool bUpdateMetaEdgesRequired;
+
+public:
+	FIGVSemanticZoom();
+
+	void Init(class AIGVGraphActor* const InGraphActor);
+	// Forgets the cut of a graph that is emptied
+	void Reset();
+
+	FORCEINLINE bool IsActive() const
+	{
+		return MetaNodes.Num() > 0;
+	}
+
+	uint32 GetAllocatedSize() const;
+
+	void Tick();
+
+	// A cluster within a collapsed one cannot be collapsed on its own, nor can the root.
+	bool CollapseCluster(int32 const ClusterIdx);
+	// One level: the children of the cluster are collapsed instead, and its leaves drawn.
+	bool ExpandCluster(int32 const ClusterIdx);
+	// Replaces the whole cut with the clusters of the given height
+	bool CollapseClusters(int32 const Height);
+	void ExpandAll();
+
+	// Collapsed cluster whose meta-node is under the pick ray, INDEX_NONE if there is none
+	int32 FindPickedMetaNode() const;
+
+	// The cluster a node is merged into, INDEX_NONE if it is drawn
+	int32 FindCollapsedAncestor(class AIGVNodeActor const* const Node) const;
+
+	// Incremental edits, see AIGVGraphActor. An edge is merged once it has its endpoints, and
+	// taken out before it is removed or one of its endpoints leaves its cluster. UpdateNode hides
+	// or shows a node that joined a cluster.
+	void AddEdge(int32 const EdgeIdx);
+	void RemoveEdge(int32 const EdgeIdx);
+	void UpdateNode(class AIGVNodeActor* const Node);
+
+	// Cluster positions, node colors or the number of nodes of a cluster changed.
+	void MarkLayoutChanged();
+
+protected:
+	TBitArray<> NodeMarks;  // Nodes of the subtree being re-cut, cleared afterward
+
+	float LastFocusAngle;
+	FVector LastViewDirection;
+
+	bool bWasInTransition;  // The meta-edges follow the drawn nodes until a transition ends.
+
+	static uint64 MakeMetaEdgeKey(int32 const ClusterIdx, int32 const OtherClusterIdx);
+
+	bool ShouldCollapse(struct FIGVCluster const& Cluster, FVector const& ViewDirection) const;
+	void UpdateCut(struct FIGVCluster& Cluster, FVector const& ViewDirection);
+	void FindCut(struct FIGVCluster& Cluster, FVector const& ViewDirection,
+				 TArray<int32>& OutClusterIdxs) const;
+
+	// Replaces the collapsed clusters within Subtree, Subtree included, with ClusterIdxs.
+	void Recut(struct FIGVCluster& Subtree, TArray<int32> const& ClusterIdxs);
+	// Weight is 1 to merge the edge into the current cut, and -1 to take it out.
+	void MergeEdge(int32 const EdgeIdx, int32 const Weight);
+
+	void PlaceMetaNode(struct FIGVCluster& Cluster, class AIGVNodeActor* const MetaNode) const;
+	void UpdateMetaNodes();
+	void UpdateMetaEdges();
+};
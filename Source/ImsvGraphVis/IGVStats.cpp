@@ -0,0 +1,56 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVStats.h"
+
+DEFINE_STAT(STAT_IGV_ParseJson);
+DEFINE_STAT(STAT_IGV_SpawnNodes);
+DEFINE_STAT(STAT_IGV_SetupClusters);
+DEFINE_STAT(STAT_IGV_TreemapLayout);
+DEFINE_STAT(STAT_IGV_Projection);
+
+DEFINE_STAT(STAT_IGV_PickUpdate);
+DEFINE_STAT(STAT_IGV_TransitionUpdate);
+DEFINE_STAT(STAT_IGV_EdgeMeshUpdate);
+DEFINE_STAT(STAT_IGV_EdgeMeshLayout);
+DEFINE_STAT(STAT_IGV_GraphEdit);
+DEFINE_STAT(STAT_IGV_DeltaIngestion);
+DEFINE_STAT(STAT_IGV_TemporalPlayback);
+DEFINE_STAT(STAT_IGV_SemanticZoom);
+
+DEFINE_STAT(STAT_IGV_ControlPointUpdate);
+DEFINE_STAT(STAT_IGV_IndexBuild);
+
+DEFINE_STAT(STAT_IGV_EdgeBufferUpload);
+DEFINE_STAT(STAT_IGV_NodeBufferUpload);
+DEFINE_STAT(STAT_IGV_ComputeDispatch);
+DEFINE_STAT(STAT_IGV_BatchAssembly);
+
+DEFINE_STAT(STAT_IGV_NumEdgesUpdated);
+DEFINE_STAT(STAT_IGV_NumDefaultEdgesLaidOut);
+DEFINE_STAT(STAT_IGV_NumEdgeMeshUploads);
+DEFINE_STAT(STAT_IGV_NumComputeDispatches);
+DEFINE_STAT(STAT_IGV_NumBatchElements);
+DEFINE_STAT(STAT_IGV_NumDeltasReceived);
+DEFINE_STAT(STAT_IGV_NumDeltasCoalesced);
+DEFINE_STAT(STAT_IGV_NumDeltasApplied);
+DEFINE_STAT(STAT_IGV_NumDeltasDropped);
+
+DEFINE_STAT(STAT_IGV_NumNodes);
+DEFINE_STAT(STAT_IGV_NumEdges);
+DEFINE_STAT(STAT_IGV_NumClusters);
+DEFINE_STAT(STAT_IGV_NumArenaAllocations);
+DEFINE_STAT(STAT_IGV_NumPendingDeltas);
+DEFINE_STAT(STAT_IGV_NumMetaNodes);
+DEFINE_STAT(STAT_IGV_NumMetaEdges);
+DEFINE_STAT(STAT_IGV_NumEdgeBundles);
+DEFINE_STAT(STAT_IGV_NumBundledEdges);
+DEFINE_STAT(STAT_IGV_NumShownLabels);
+DEFINE_STAT(STAT_IGV_NumPooledNodeActors);
+
+DEFINE_STAT(STAT_IGV_NodeMemory);
+DEFINE_STAT(STAT_IGV_EdgeMemory);
+DEFINE_STAT(STAT_IGV_ClusterMemory);
+DEFINE_STAT(STAT_IGV_ArenaMemory);
+DEFINE_STAT(STAT_IGV_EdgeMeshBufferMemory);
+DEFINE_STAT(STAT_IGV_EdgeMeshGPUMemory);
+DEFINE_STAT(STAT_IGV_NodeMeshGPUMemory);
@@ -0,0 +1,114 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "Engine.h"
+
+// stat ImsvGraphVis
+DECLARE_STATS_GROUP(TEXT("ImsvGraphVis"), STATGROUP_ImsvGraphVis, STATCAT_Advanced);
+
+// Loading
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse JSON"), STAT_IGV_ParseJson, STATGROUP_ImsvGraphVis,
+						  IMSVGRAPHVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spawn Nodes"), STAT_IGV_SpawnNodes, STATGROUP_ImsvGraphVis,
+						  IMSVGRAPHVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Setup Clusters"), STAT_IGV_SetupClusters, STATGROUP_ImsvGraphVis,
+						  IMSVGRAPHVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Treemap Layout"), STAT_IGV_TreemapLayout, STATGROUP_ImsvGraphVis,
+						  IMSVGRAPHVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projection"), STAT_IGV_Projection, STATGROUP_ImsvGraphVis,
+						  IMSVGRAPHVIS_API);
+
+// Game thread, per frame
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pick Update"), STAT_IGV_PickUpdate, STATGROUP_ImsvGraphVis,
+						  IMSVGRAPHVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Transition Update"), STAT_IGV_TransitionUpdate,
+						  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Edge Mesh Update"), STAT_IGV_EdgeMeshUpdate,
+						  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Edge Mesh Layout"), STAT_IGV_EdgeMeshLayout,
+						  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Graph Edit"), STAT_IGV_GraphEdit, STATGROUP_ImsvGraphVis,
+						  IMSVGRAPHVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Delta Ingestion"), STAT_IGV_DeltaIngestion,
+						  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Temporal Playback"), STAT_IGV_TemporalPlayback,
+						  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Semantic Zoom"), STAT_IGV_SemanticZoom, STATGROUP_ImsvGraphVis,
+						  IMSVGRAPHVIS_API);
+
+// Worker threads
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Control Point Update"), STAT_IGV_ControlPointUpdate,
+						  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Index Build"), STAT_IGV_IndexBuild, STATGROUP_ImsvGraphVis,
+						  IMSVGRAPHVIS_API);
+
+// Render thread
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Edge Buffer Upload"), STAT_IGV_EdgeBufferUpload,
+						  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Node Buffer Upload"), STAT_IGV_NodeBufferUpload,
+						  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Compute Dispatch"), STAT_IGV_ComputeDispatch,
+						  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batch Assembly"), STAT_IGV_BatchAssembly, STATGROUP_ImsvGraphVis,
+						  IMSVGRAPHVIS_API);
+
+// Counters, reset every frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Edges Updated"), STAT_IGV_NumEdgesUpdated,
+								  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Default Edges Laid Out"), STAT_IGV_NumDefaultEdgesLaidOut,
+								  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Edge Mesh Uploads"), STAT_IGV_NumEdgeMeshUploads,
+								  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Compute Dispatches"), STAT_IGV_NumComputeDispatches,
+								  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Batch Elements"), STAT_IGV_NumBatchElements,
+								  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deltas Received"), STAT_IGV_NumDeltasReceived,
+								  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deltas Coalesced"), STAT_IGV_NumDeltasCoalesced,
+								  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deltas Applied"), STAT_IGV_NumDeltasApplied,
+								  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deltas Dropped"), STAT_IGV_NumDeltasDropped,
+								  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+
+// Graph size
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Nodes"), STAT_IGV_NumNodes, STATGROUP_ImsvGraphVis,
+									  IMSVGRAPHVIS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Edges"), STAT_IGV_NumEdges, STATGROUP_ImsvGraphVis,
+									  IMSVGRAPHVIS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Clusters"), STAT_IGV_NumClusters,
+									  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Arena Allocations"), STAT_IGV_NumArenaAllocations,
+									  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Deltas"), STAT_IGV_NumPendingDeltas,
+									  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Meta-Nodes"), STAT_IGV_NumMetaNodes,
+									  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Meta-Edges"), STAT_IGV_NumMetaEdges,
+									  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Edge Bundles"), STAT_IGV_NumEdgeBundles,
+									  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Bundled Edges"), STAT_IGV_NumBundledEdges,
+									  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Shown Labels"), STAT_IGV_NumShownLabels,
+									  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pooled Node Actors"), STAT_IGV_NumPooledNodeActors,
+									  STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+
+// Memory
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Nodes"), STAT_IGV_NodeMemory, STATGROUP_ImsvGraphVis,
+						   IMSVGRAPHVIS_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Edges"), STAT_IGV_EdgeMemory, STATGROUP_ImsvGraphVis,
+						   IMSVGRAPHVIS_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Clusters"), STAT_IGV_ClusterMemory, STATGROUP_ImsvGraphVis,
+						   IMSVGRAPHVIS_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Graph Arena"), STAT_IGV_ArenaMemory, STATGROUP_ImsvGraphVis,
+						   IMSVGRAPHVIS_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Edge Mesh Buffers"), STAT_IGV_EdgeMeshBufferMemory,
+						   STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Edge Mesh GPU Buffers"), STAT_IGV_EdgeMeshGPUMemory,
+						   STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Node Mesh GPU Buffers"), STAT_IGV_NodeMeshGPUMemory,
+						   STATGROUP_ImsvGraphVis, IMSVGRAPHVIS_API);
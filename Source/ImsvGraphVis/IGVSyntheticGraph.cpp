@@ -0,0 +1,335 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVSyntheticGraph.h"
+
+#include "IGVLog.h"
+
+FIGVSyntheticGraphParams::FIGVSyntheticGraphParams()
+	: Type(EIGVSyntheticGraph::StochasticBlockModel),
+	  NumNodes(1000),
+	  AverageDegree(8.f),
+	  Branching(8),
+	  Depth(3),
+	  Locality(.8f),
+	  Seed(0)
+{
+}
+
+FString FIGVSyntheticGraphParams::ToString() const
+{
+	return FString::Printf(
+		TEXT("Type=%s NumNodes=%d AverageDegree=%g Branching=%d Depth=%d Locality=%g Seed=%d"),
+		TypeName(Type), NumNodes, AverageDegree, Branching, Depth, Locality, Seed);
+}
+
+bool FIGVSyntheticGraphParams::ParseType(FString const& Name, EIGVSyntheticGraph::Type& OutType)
+{
+	for (int32 Type = EIGVSyntheticGraph::StochasticBlockModel; Type <= EIGVSyntheticGraph::Grid;
+		 Type++)
+	{
+		if (Name.Equals(TypeName(EIGVSyntheticGraph::Type(Type)), ESearchCase::IgnoreCase))
+		{
+			OutType = EIGVSyntheticGraph::Type(Type);
+			return true;
+		}
+	}
+	return false;
+}
+
+TCHAR const* FIGVSyntheticGraphParams::TypeName(EIGVSyntheticGraph::Type const Type)
+{
+	switch (Type)
+	{
+		case EIGVSyntheticGraph::StochasticBlockModel: return TEXT("sbm");
+		case EIGVSyntheticGraph::PowerLaw: return TEXT("powerlaw");
+		case EIGVSyntheticGraph::Grid: return TEXT("grid");
+		default: checkNoEntry(); break;
+	}
+	return TEXT("");
+}
+
+FIGVSyntheticGraph::FIGVSyntheticGraph(FIGVSyntheticGraphParams const& InParams)
+	: Params(InParams), NumEdges(0), NumClusters(0), Random(InParams.Seed), Depth(0)
+{
+}
+
+TSharedRef<FJsonObject> FIGVSyntheticGraph::Generate()
+{
+	Random.Initialize(Params.Seed);
+	Edges.Reset();
+	EdgeKeys.Reset();
+
+	SetupHierarchy();
+
+	switch (Params.Type)
+	{
+		case EIGVSyntheticGraph::StochasticBlockModel: GenerateStochasticBlockModel(); break;
+		case EIGVSyntheticGraph::PowerLaw: GeneratePowerLaw(); break;
+		case EIGVSyntheticGraph::Grid: GenerateGrid(); break;
+		default: checkNoEntry(); break;
+	}
+
+	NumEdges = Edges.Num();
+	EdgeKeys.Empty();
+
+	TSharedRef<FJsonObject> GraphJsonObj = MakeShareable(new FJsonObject());
+	GraphJsonObj->SetArrayField(TEXT("nodes"), NodesToJson());
+	GraphJsonObj->SetArrayField(TEXT("links"), EdgesToJson());
+	GraphJsonObj->SetArrayField(TEXT("clusters"), ClustersToJson());
+
+	IGV_LOG(Log, TEXT("%s: %d nodes, %d edges, %d clusters"), *Params.ToString(), Params.NumNodes,
+			NumEdges, NumClusters);
+
+	return GraphJsonObj;
+}
+
+void FIGVSyntheticGraph::SetupHierarchy()
+{
+	int32 const N = Params.NumNodes;
+	int32 const B = FMath::Max(Params.Branching, 2);
+
+	// Every block needs at least one node, otherwise it would be taken for a leaf cluster.
+	check(N >= B);
+
+	Depth = FMath::Max(Params.Depth, 1);
+	while (Depth > 1 && FMath::Pow(B, Depth) > N)
+	{
+		Depth--;
+	}
+
+	NumBlocks.SetNum(Depth);
+	BlockOffset.SetNum(Depth);
+
+	int32 NumBottomBlocks = 1;
+	for (int32 Height = 1; Height <= Depth; Height++)
+	{
+		NumBottomBlocks *= B;
+	}
+
+	int32 Offset = N;  // Leaf clusters come first, one per node
+	for (int32 Height = 1, Num = NumBottomBlocks; Height <= Depth; Height++, Num /= B)
+	{
+		NumBlocks[Height - 1] = Num;
+		BlockOffset[Height - 1] = Offset;
+		Offset += Num;
+	}
+
+	NumClusters = Offset + 1;  // Root
+}
+
+int32 FIGVSyntheticGraph::BlockOf(int32 const NodeIdx, int32 const Height) const
+{
+	int64 const NumBottomBlocks = NumBlocks[0];
+	int32 const BottomBlock = int32(NodeIdx * NumBottomBlocks / Params.NumNodes);
+	return BottomBlock / (NumBottomBlocks / NumBlocks[Height - 1]);
+}
+
+int32 FIGVSyntheticGraph::FirstNodeOf(int32 const Block, int32 const Height) const
+{
+	int64 const NumBottomBlocks = NumBlocks[0];
+	int64 const BottomBlock = Block * (NumBottomBlocks / NumBlocks[Height - 1]);
+	return int32((BottomBlock * Params.NumNodes + NumBottomBlocks - 1) / NumBottomBlocks);
+}
+
+bool FIGVSyntheticGraph::AddEdge(int32 const SourceIdx, int32 const TargetIdx)
+{
+	if (SourceIdx == TargetIdx) return false;
+
+	uint64 const Key = (uint64(FMath::Min(SourceIdx, TargetIdx)) << 32) |
+					   uint64(FMath::Max(SourceIdx, TargetIdx));
+
+	bool bIsAlreadyInSet = false;
+	EdgeKeys.Add(Key, &bIsAlreadyInSet);
+	if (bIsAlreadyInSet) return false;
+
+	Edges.Emplace(SourceIdx, TargetIdx);
+	return true;
+}
+
+void FIGVSyntheticGraph::GenerateStochasticBlockModel()
+{
+	int32 const N = Params.NumNodes;
+	int64 const MaxNumEdges = int64(N) * (N - 1) / 2;
+	int32 const TargetNumEdges =
+		int32(FMath::Min<int64>(int64(N * Params.AverageDegree * 0.5), MaxNumEdges));
+
+	Edges.Reserve(TargetNumEdges);
+	EdgeKeys.Reserve(TargetNumEdges);
+
+	// Sampled per edge rather than per node pair, so the cost is linear in the number of edges.
+	int64 const MaxNumAttempts = int64(TargetNumEdges) * 10 + 100;
+	for (int64 Attempt = 0; Attempt < MaxNumAttempts && Edges.Num() < TargetNumEdges; Attempt++)
+	{
+		int32 const SourceIdx = Random.RandRange(0, N - 1);
+
+		int32 Height = 1;
+		while (Height <= Depth && Random.FRand() >= Params.Locality)
+		{
+			Height++;
+		}
+
+		int32 FirstIdx = 0;
+		int32 EndIdx = N;
+		if (Height <= Depth)
+		{
+			int32 const Block = BlockOf(SourceIdx, Height);
+			FirstIdx = FirstNodeOf(Block, Height);
+			EndIdx = FirstNodeOf(Block + 1, Height);
+		}
+
+		AddEdge(SourceIdx, Random.RandRange(FirstIdx, EndIdx - 1));
+	}
+}
+
+void FIGVSyntheticGraph::GeneratePowerLaw()
+{
+	int32 const N = Params.NumNodes;
+	int32 const M = FMath::Clamp(FMath::RoundToInt(Params.AverageDegree * 0.5f), 1, N - 1);
+
+	Edges.Reserve(N * M);
+	EdgeKeys.Reserve(N * M);
+
+	// Every edge adds both endpoints, so a uniform pick is proportional to degree.
+	TArray<int32> Endpoints;
+	Endpoints.Reserve(N * M * 2);
+
+	for (int32 SourceIdx = 0; SourceIdx <= M; SourceIdx++)
+	{
+		for (int32 TargetIdx = SourceIdx + 1; TargetIdx <= M; TargetIdx++)
+		{
+			AddEdge(SourceIdx, TargetIdx);
+			Endpoints.Add(SourceIdx);
+			Endpoints.Add(TargetIdx);
+		}
+	}
+
+	for (int32 SourceIdx = M + 1; SourceIdx < N; SourceIdx++)
+	{
+		int32 NumAdded = 0;
+		for (int32 Attempt = 0; Attempt < M * 10 && NumAdded < M; Attempt++)
+		{
+			int32 const TargetIdx = Endpoints[Random.RandRange(0, Endpoints.Num() - 1)];
+			if (AddEdge(SourceIdx, TargetIdx))
+			{
+				Endpoints.Add(SourceIdx);
+				Endpoints.Add(TargetIdx);
+				NumAdded++;
+			}
+		}
+	}
+
+	// Hubs are the oldest nodes. Spread them over the planted hierarchy.
+	TArray<int32> Permutation;
+	Permutation.SetNumUninitialized(N);
+	for (int32 Idx = 0; Idx < N; Idx++)
+	{
+		Permutation[Idx] = Idx;
+	}
+	for (int32 Idx = N - 1; Idx > 0; Idx--)
+	{
+		Permutation.Swap(Idx, Random.RandRange(0, Idx));
+	}
+	for (TPair<int32, int32>& Edge : Edges)
+	{
+		Edge.Key = Permutation[Edge.Key];
+		Edge.Value = Permutation[Edge.Value];
+	}
+}
+
+void FIGVSyntheticGraph::GenerateGrid()
+{
+	int32 const N = Params.NumNodes;
+	int32 const Width = FMath::CeilToInt(FMath::Sqrt(float(N)));
+
+	Edges.Reserve(N * 2);
+	EdgeKeys.Reserve(N * 2);
+
+	// Row-major, so the planted blocks are bands of rows.
+	for (int32 Idx = 0; Idx < N; Idx++)
+	{
+		if ((Idx % Width) + 1 < Width && Idx + 1 < N) AddEdge(Idx, Idx + 1);
+		if (Idx + Width < N) AddEdge(Idx, Idx + Width);
+	}
+}
+
+TArray<TSharedPtr<FJsonValue>> FIGVSyntheticGraph::NodesToJson() const
+{
+	TArray<TSharedPtr<FJsonValue>> NodeJsonObjs;
+	NodeJsonObjs.Reserve(Params.NumNodes);
+
+	for (int32 NodeIdx = 0; NodeIdx < Params.NumNodes; NodeIdx++)
+	{
+		// Nearest ancestor first, excluding the root
+		TArray<TSharedPtr<FJsonValue>> AncIdxs;
+		for (int32 Height = 1; Height <= Depth; Height++)
+		{
+			AncIdxs.Add(MakeShareable(
+				new FJsonValueNumber(BlockOffset[Height - 1] + BlockOf(NodeIdx, Height))));
+		}
+
+		TSharedRef<FJsonObject> NodeJsonObj = MakeShareable(new FJsonObject());
+		NodeJsonObj->SetStringField(TEXT("label"), FString::FromInt(NodeIdx));
+		NodeJsonObj->SetArrayField(TEXT("ancIdxs"), AncIdxs);
+		NodeJsonObj->SetNumberField(TEXT("idx"), NodeIdx);
+		NodeJsonObjs.Add(MakeShareable(new FJsonValueObject(NodeJsonObj)));
+	}
+
+	return NodeJsonObjs;
+}
+
+TArray<TSharedPtr<FJsonValue>> FIGVSyntheticGraph::EdgesToJson() const
+{
+	TArray<TSharedPtr<FJsonValue>> EdgeJsonObjs;
+	EdgeJsonObjs.Reserve(Edges.Num());
+
+	for (TPair<int32, int32> const& Edge : Edges)
+	{
+		TSharedRef<FJsonObject> EdgeJsonObj = MakeShareable(new FJsonObject());
+		EdgeJsonObj->SetNumberField(TEXT("sourceIdx"), Edge.Key);
+		EdgeJsonObj->SetNumberField(TEXT("targetIdx"), Edge.Value);
+		EdgeJsonObjs.Add(MakeShareable(new FJsonValueObject(EdgeJsonObj)));
+	}
+
+	return EdgeJsonObjs;
+}
+
+TArray<TSharedPtr<FJsonValue>> FIGVSyntheticGraph::ClustersToJson() const
+{
+	TArray<TSharedPtr<FJsonValue>> ClusterJsonObjs;
+	ClusterJsonObjs.Reserve(NumClusters);
+
+	int32 const RootIdx = NumClusters - 1;
+	int32 const B = FMath::Max(Params.Branching, 2);
+
+	// Leaves first, where the cluster index equals the node index, and the root last
+	for (int32 NodeIdx = 0; NodeIdx < Params.NumNodes; NodeIdx++)
+	{
+		TSharedRef<FJsonObject> ClusterJsonObj = MakeShareable(new FJsonObject());
+		ClusterJsonObj->SetNumberField(TEXT("idx"), NodeIdx);
+		ClusterJsonObj->SetNumberField(TEXT("nodeIdx"), NodeIdx);
+		ClusterJsonObj->SetNumberField(TEXT("parentIdx"), BlockOffset[0] + BlockOf(NodeIdx, 1));
+		ClusterJsonObj->SetNumberField(TEXT("height"), 0);
+		ClusterJsonObjs.Add(MakeShareable(new FJsonValueObject(ClusterJsonObj)));
+	}
+
+	for (int32 Height = 1; Height <= Depth; Height++)
+	{
+		for (int32 Block = 0; Block < NumBlocks[Height - 1]; Block++)
+		{
+			int32 const ParentIdx = Height < Depth ? BlockOffset[Height] + Block / B : RootIdx;
+
+			TSharedRef<FJsonObject> ClusterJsonObj = MakeShareable(new FJsonObject());
+			ClusterJsonObj->SetNumberField(TEXT("idx"), BlockOffset[Height - 1] + Block);
+			ClusterJsonObj->SetNumberField(TEXT("parentIdx"), ParentIdx);
+			ClusterJsonObj->SetNumberField(TEXT("height"), Height);
+			ClusterJsonObjs.Add(MakeShareable(new FJsonValueObject(ClusterJsonObj)));
+		}
+	}
+
+	TSharedRef<FJsonObject> RootJsonObj = MakeShareable(new FJsonObject());
+	RootJsonObj->SetNumberField(TEXT("idx"), RootIdx);
+	RootJsonObj->SetNumberField(TEXT("height"), Depth + 1);
+	ClusterJsonObjs.Add(MakeShareable(new FJsonValueObject(RootJsonObj)));
+
+	return ClusterJsonObjs;
+}
@@ -0,0 +1,81 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "Core.h"
+#include "Json.h"
+
+namespace EIGVSyntheticGraph
+{
+enum Type
+{
+	StochasticBlockModel,  // Edges mostly within blocks of a planted hierarchy
+	PowerLaw,			   // Preferential attachment
+	Grid				   // 4-neighborhood of a square lattice
+};
+}
+
+struct IMSVGRAPHVIS_API FIGVSyntheticGraphParams
+{
+	EIGVSyntheticGraph::Type Type;
+	int32 NumNodes;
+	float AverageDegree;  // Ignored by Grid
+
+	// Planted clustering hierarchy. Every node gets Depth ancestors, excluding the root, as
+	// required by FIGVEdge::SetupClusters.
+	int32 Branching;
+	int32 Depth;
+
+	// StochasticBlockModel: probability that an edge stays within the current block when
+	// stepping up the hierarchy from the leaves
+	float Locality;
+
+	int32 Seed;
+
+	FIGVSyntheticGraphParams();
+
+	FString ToString() const;
+
+	static bool ParseType(FString const& Name, EIGVSyntheticGraph::Type& OutType);
+	static TCHAR const* TypeName(EIGVSyntheticGraph::Type const Type);
+};
+
+// Generates graphs in the .igv.json format read by UIGVData, so loading them exercises the same
+// code paths as the bundled datasets.
+class IMSVGRAPHVIS_API FIGVSyntheticGraph
+{
+public:
+	FIGVSyntheticGraphParams const Params;
+
+	int32 NumEdges;
+	int32 NumClusters;
+
+public:
+	FIGVSyntheticGraph(FIGVSyntheticGraphParams const& InParams);
+
+	TSharedRef<FJsonObject> Generate();
+
+protected:
+	FRandomStream Random;
+
+	int32 Depth;
+	TArray<int32> NumBlocks;	// Per height, from 1 (bottom) to Depth
+	TArray<int32> BlockOffset;  // Cluster index of the first block per height
+
+	TArray<TPair<int32, int32>> Edges;
+	TSet<uint64> EdgeKeys;
+
+	void SetupHierarchy();
+	int32 BlockOf(int32 const NodeIdx, int32 const Height) const;
+	int32 FirstNodeOf(int32 const Block, int32 const Height) const;
+
+	bool AddEdge(int32 const SourceIdx, int32 const TargetIdx);
+
+	void GenerateStochasticBlockModel();
+	void GeneratePowerLaw();
+	void GenerateGrid();
+
+	TArray<TSharedPtr<FJsonValue>> NodesToJson() const;
+	TArray<TSharedPtr<FJsonValue>> EdgesToJson() const;
+	TArray<TSharedPtr<FJsonValue>> ClustersToJson() const;
+};
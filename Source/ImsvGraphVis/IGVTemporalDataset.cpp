@@ -0,0 +1,255 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVTemporalDataset.h"
+
+#include "IGVGraphActor.h"
+#include "IGVLog.h"
+#include "IGVNodeActor.h"
+
+int32 FIGVTemporalDiff::Num() const
+{
+	return RemovedEdges.Num() + RemovedNodes.Num() + AddedNodes.Num() + MovedNodes.Num() +
+		   AddedEdges.Num();
+}
+
+FIGVTemporalDataset::FIGVTemporalDataset()
+	: Labels(), ForwardDiffs(), BackwardDiffs(), LabelIdxs()
+{
+}
+
+bool FIGVTemporalDataset::Deserialize(TArray<TSharedPtr<FJsonValue>> const& StepJsonVals,
+									  AIGVGraphActor const* const GraphActor)
+{
+	Reset();
+
+	// The first node of a duplicate label is the one named by the steps.
+	for (AIGVNodeActor const* const Node : GraphActor->Nodes)
+	{
+		FindOrAddLabel(Node->GetLabel());
+	}
+
+	ForwardDiffs.SetNum(StepJsonVals.Num());
+	for (int32 StepIdx = 0; StepIdx < StepJsonVals.Num(); StepIdx++)
+	{
+		TSharedPtr<FJsonObject> const StepJsonObj = StepJsonVals[StepIdx]->AsObject();
+		if (!StepJsonObj.IsValid() || !DeserializeDiff(*StepJsonObj, ForwardDiffs[StepIdx]))
+		{
+			IGV_LOG_S(Error, TEXT("Unable to deserialize step %d"), StepIdx);
+			Reset();
+			return false;
+		}
+	}
+
+	if (!ComputeBackwardDiffs(GraphActor))
+	{
+		Reset();
+		return false;
+	}
+
+	IGV_LOG(Log, TEXT("Temporal dataset: %d steps, %d labels"), NumSteps(), Labels.Num());
+	return true;
+}
+
+void FIGVTemporalDataset::Reset()
+{
+	Labels.Empty();
+	ForwardDiffs.Empty();
+	BackwardDiffs.Empty();
+	LabelIdxs.Empty();
+}
+
+int32 FIGVTemporalDataset::FindLabel(FString const& Label) const
+{
+	int32 const* const LabelIdx = LabelIdxs.Find(Label);
+	return LabelIdx ? *LabelIdx : INDEX_NONE;
+}
+
+int32 FIGVTemporalDataset::FindOrAddLabel(FString const& Label)
+{
+	if (int32 const* const LabelIdx = LabelIdxs.Find(Label)) return *LabelIdx;
+
+	int32 const LabelIdx = Labels.Add(Label);
+	LabelIdxs.Add(Label, LabelIdx);
+	return LabelIdx;
+}
+
+bool FIGVTemporalDataset::DeserializeDiff(FJsonObject const& StepJsonObj,
+										  FIGVTemporalDiff& OutDiff)
+{
+	TArray<TSharedPtr<FJsonValue>> const* RemovedNodeJsonVals;
+	if (StepJsonObj.TryGetArrayField(TEXT("removeNodes"), RemovedNodeJsonVals))
+	{
+		for (TSharedPtr<FJsonValue> const& JsonVal : *RemovedNodeJsonVals)
+		{
+			FString Label;
+			if (!JsonVal->TryGetString(Label)) return false;
+			OutDiff.RemovedNodes.Add(FindOrAddLabel(Label));
+		}
+	}
+
+	return DeserializeEdges(StepJsonObj, TEXT("removeLinks"), OutDiff.RemovedEdges) &&
+		   DeserializeNodes(StepJsonObj, TEXT("addNodes"), OutDiff.AddedNodes) &&
+		   DeserializeNodes(StepJsonObj, TEXT("moveNodes"), OutDiff.MovedNodes) &&
+		   DeserializeEdges(StepJsonObj, TEXT("addLinks"), OutDiff.AddedEdges);
+}
+
+bool FIGVTemporalDataset::DeserializeNodes(FJsonObject const& StepJsonObj,
+										   FString const& FieldName,
+										   TArray<FIGVTemporalNode>& OutNodes)
+{
+	TArray<TSharedPtr<FJsonValue>> const* NodeJsonVals;
+	if (!StepJsonObj.TryGetArrayField(FieldName, NodeJsonVals)) return true;
+
+	OutNodes.Reserve(NodeJsonVals->Num());
+	for (TSharedPtr<FJsonValue> const& JsonVal : *NodeJsonVals)
+	{
+		TSharedPtr<FJsonObject> const* NodeJsonObj;
+		FString Label;
+		int32 ClusterIdx;
+		if (!JsonVal->TryGetObject(NodeJsonObj) ||
+			!(*NodeJsonObj)->TryGetStringField(TEXT("label"), Label) ||
+			!(*NodeJsonObj)->TryGetNumberField(TEXT("cluster"), ClusterIdx))
+		{
+			return false;
+		}
+
+		OutNodes.Add({FindOrAddLabel(Label), ClusterIdx});
+	}
+	return true;
+}
+
+bool FIGVTemporalDataset::DeserializeEdges(FJsonObject const& StepJsonObj,
+										   FString const& FieldName,
+										   TArray<FIGVTemporalEdge>& OutEdges)
+{
+	TArray<TSharedPtr<FJsonValue>> const* EdgeJsonVals;
+	if (!StepJsonObj.TryGetArrayField(FieldName, EdgeJsonVals)) return true;
+
+	OutEdges.Reserve(EdgeJsonVals->Num());
+	for (TSharedPtr<FJsonValue> const& JsonVal : *EdgeJsonVals)
+	{
+		TArray<TSharedPtr<FJsonValue>> const* EndJsonVals;
+		FString SourceLabel;
+		FString TargetLabel;
+		if (!JsonVal->TryGetArray(EndJsonVals) || EndJsonVals->Num() != 2 ||
+			!(*EndJsonVals)[0]->TryGetString(SourceLabel) ||
+			!(*EndJsonVals)[1]->TryGetString(TargetLabel))
+		{
+			return false;
+		}
+
+		OutEdges.Add({FindOrAddLabel(SourceLabel), FindOrAddLabel(TargetLabel)});
+	}
+	return true;
+}
+
+bool FIGVTemporalDataset::ComputeBackwardDiffs(AIGVGraphActor const* const GraphActor)
+{
+	// Parent cluster and neighbors of each label in the current keyframe, INDEX_NONE if absent
+	TArray<int32> ClusterIdxs;
+	TArray<TArray<int32>> Neighbors;
+	ClusterIdxs.Init(INDEX_NONE, Labels.Num());
+	Neighbors.SetNum(Labels.Num());
+
+	TArray<int32> NodeLabelIdxs;
+	NodeLabelIdxs.SetNumUninitialized(GraphActor->Nodes.Num());
+	for (AIGVNodeActor const* const Node : GraphActor->Nodes)
+	{
+		int32 const LabelIdx = FindLabel(Node->GetLabel());
+		NodeLabelIdxs[Node->Idx] = LabelIdx;
+		ClusterIdxs[LabelIdx] = GraphActor->Clusters[Node->ClusterIdx].ParentIdx;
+	}
+
+	FIGVEdgeStore const& EdgeStore = GraphActor->EdgeStore;
+	for (int32 EdgeIdx = 0; EdgeIdx < EdgeStore.Num(); EdgeIdx++)
+	{
+		int32 const SourceLabelIdx = NodeLabelIdxs[EdgeStore.SourceIdxs[EdgeIdx]];
+		int32 const TargetLabelIdx = NodeLabelIdxs[EdgeStore.TargetIdxs[EdgeIdx]];
+		Neighbors[SourceLabelIdx].Add(TargetLabelIdx);
+		Neighbors[TargetLabelIdx].Add(SourceLabelIdx);
+	}
+
+	auto IsValidCluster = [GraphActor](int32 const ClusterIdx) {
+		return GraphActor->Clusters.IsValidIndex(ClusterIdx) &&
+			   GraphActor->Clusters[ClusterIdx].Height == 1;
+	};
+
+	BackwardDiffs.SetNum(ForwardDiffs.Num());
+	for (int32 StepIdx = 0; StepIdx < ForwardDiffs.Num(); StepIdx++)
+	{
+		FIGVTemporalDiff const& Forward = ForwardDiffs[StepIdx];
+		FIGVTemporalDiff& Backward = BackwardDiffs[StepIdx];
+
+		auto Fail = [this, StepIdx](TCHAR const* const What, int32 const LabelIdx) {
+			IGV_LOG_S(Error, TEXT("Step %d: %s %s"), StepIdx, What, *Labels[LabelIdx]);
+			return false;
+		};
+
+		for (FIGVTemporalEdge const& Edge : Forward.RemovedEdges)
+		{
+			if (Neighbors[Edge.SourceLabelIdx].RemoveSingleSwap(Edge.TargetLabelIdx, false) == 0)
+			{
+				return Fail(TEXT("no edge to remove from"), Edge.SourceLabelIdx);
+			}
+			Neighbors[Edge.TargetLabelIdx].RemoveSingleSwap(Edge.SourceLabelIdx, false);
+		}
+		Backward.AddedEdges = Forward.RemovedEdges;
+
+		for (int32 const LabelIdx : Forward.RemovedNodes)
+		{
+			if (ClusterIdxs[LabelIdx] == INDEX_NONE)
+			{
+				return Fail(TEXT("unable to remove"), LabelIdx);
+			}
+
+			Backward.AddedNodes.Add({LabelIdx, ClusterIdxs[LabelIdx]});
+			for (int32 const NeighborLabelIdx : Neighbors[LabelIdx])
+			{
+				Backward.AddedEdges.Add({LabelIdx, NeighborLabelIdx});
+				Neighbors[NeighborLabelIdx].RemoveSingleSwap(LabelIdx, false);
+			}
+			Neighbors[LabelIdx].Empty();
+			ClusterIdxs[LabelIdx] = INDEX_NONE;
+		}
+
+		for (FIGVTemporalNode const& Node : Forward.AddedNodes)
+		{
+			if (ClusterIdxs[Node.LabelIdx] != INDEX_NONE || !IsValidCluster(Node.ClusterIdx))
+			{
+				return Fail(TEXT("unable to add"), Node.LabelIdx);
+			}
+
+			Backward.RemovedNodes.Add(Node.LabelIdx);
+			ClusterIdxs[Node.LabelIdx] = Node.ClusterIdx;
+		}
+
+		for (FIGVTemporalNode const& Node : Forward.MovedNodes)
+		{
+			int32 const OldClusterIdx = ClusterIdxs[Node.LabelIdx];
+			if (OldClusterIdx == INDEX_NONE || OldClusterIdx == Node.ClusterIdx ||
+				!IsValidCluster(Node.ClusterIdx))
+			{
+				return Fail(TEXT("unable to move"), Node.LabelIdx);
+			}
+
+			Backward.MovedNodes.Add({Node.LabelIdx, OldClusterIdx});
+			ClusterIdxs[Node.LabelIdx] = Node.ClusterIdx;
+		}
+
+		for (FIGVTemporalEdge const& Edge : Forward.AddedEdges)
+		{
+			if (ClusterIdxs[Edge.SourceLabelIdx] == INDEX_NONE ||
+				ClusterIdxs[Edge.TargetLabelIdx] == INDEX_NONE ||
+				Edge.SourceLabelIdx == Edge.TargetLabelIdx)
+			{
+				return Fail(TEXT("unable to add an edge from"), Edge.SourceLabelIdx);
+			}
+
+			Neighbors[Edge.SourceLabelIdx].Add(Edge.TargetLabelIdx);
+			Neighbors[Edge.TargetLabelIdx].Add(Edge.SourceLabelIdx);
+		}
+		Backward.RemovedEdges = Forward.AddedEdges;
+	}
+
+	return true;
+}
@@ -0,0 +1,88 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+struct FIGVTemporalNode
+{
+	int32 LabelIdx;
+	int32 ClusterIdx;  // Parent cluster of height 1
+};
+
+struct FIGVTemporalEdge
+{
+	int32 SourceLabelIdx;
+	int32 TargetLabelIdx;
+};
+
+// Changes from one keyframe to the next, applied in the order of the members
+struct IMSVGRAPHVIS_API FIGVTemporalDiff
+{
+	TArray<FIGVTemporalEdge> RemovedEdges;
+	TArray<int32> RemovedNodes;  // With their remaining edges
+	TArray<FIGVTemporalNode> AddedNodes;
+	TArray<FIGVTemporalNode> MovedNodes;
+	TArray<FIGVTemporalEdge> AddedEdges;
+
+	int32 Num() const;
+};
+
+// A graph that changes over time: the graph of a .igv.json file as the first keyframe, and the
+// diffs to each next keyframe, in a .igvt.json file:
+//
+//   {
+//     "graph": { "nodes": [...], "links": [...], "clusters": [...] },
+//     "steps": [
+//       {
+//         "removeLinks": [["A", "B"]],
+//         "removeNodes": ["C"],
+//         "addNodes": [{"label": "D", "cluster": 12}],
+//         "moveNodes": [{"label": "E", "cluster": 7}],
+//         "addLinks": [["D", "E"]]
+//       }
+//     ]
+//   }
+//
+// Nodes are named by label, and every key of a step is optional. The cluster hierarchy itself
+// is the same for all keyframes; nodes join, leave or move between its clusters of height 1.
+//
+// The diffs back from each keyframe are computed on load, by replaying the steps on the labels
+// and edges alone, so that the dataset is checked before playback and can be scrubbed backward.
+class IMSVGRAPHVIS_API FIGVTemporalDataset
+{
+public:
+	TArray<FString> Labels;
+	TArray<FIGVTemporalDiff> ForwardDiffs;   // Keyframe i to i + 1
+	TArray<FIGVTemporalDiff> BackwardDiffs;  // Keyframe i + 1 to i
+
+public:
+	FIGVTemporalDataset();
+
+	// Reads the "steps" of the file, once its "graph" has been loaded into GraphActor
+	bool Deserialize(TArray<TSharedPtr<FJsonValue>> const& StepJsonVals,
+					 class AIGVGraphActor const* const GraphActor);
+
+	void Reset();
+
+	FORCEINLINE int32 NumSteps() const
+	{
+		return ForwardDiffs.Num();
+	}
+
+	int32 FindLabel(FString const& Label) const;
+
+protected:
+	TMap<FString, int32> LabelIdxs;
+
+	int32 FindOrAddLabel(FString const& Label);
+
+	bool DeserializeDiff(FJsonObject const& StepJsonObj, FIGVTemporalDiff& OutDiff);
+	bool DeserializeNodes(FJsonObject const& StepJsonObj, FString const& FieldName,
+						  TArray<FIGVTemporalNode>& OutNodes);
+	bool DeserializeEdges(FJsonObject const& StepJsonObj, FString const& FieldName,
+						  TArray<FIGVTemporalEdge>& OutEdges);
+
+	bool ComputeBackwardDiffs(class AIGVGraphActor const* const GraphActor);
+};
@@ -0,0 +1,256 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVTemporalPlayer.h"
+
+#include "IGVGraphActor.h"
+#include "IGVLog.h"
+#include "IGVNodeActor.h"
+#include "IGVStats.h"
+
+FIGVTemporalPlayer::FIGVTemporalPlayer()
+	: GraphActor(nullptr),
+	  Dataset(),
+	  Time(0.f),
+	  Rate(0.f),
+	  NodesByLabelIdx(),
+	  Interpolations(),
+	  Keyframe(0),
+	  InterpolatedStep(INDEX_NONE),
+	  EdgeSample(INDEX_NONE)
+{
+}
+
+void FIGVTemporalPlayer::Init(AIGVGraphActor* const InGraphActor)
+{
+	GraphActor = InGraphActor;
+}
+
+void FIGVTemporalPlayer::Setup(FIGVTemporalDataset&& InDataset)
+{
+	Reset();
+	Dataset = MoveTemp(InDataset);
+
+	NodesByLabelIdx.Init(nullptr, Dataset.Labels.Num());
+	for (AIGVNodeActor* const Node : GraphActor->Nodes)
+	{
+		int32 const LabelIdx = Dataset.FindLabel(Node->GetLabel());
+		if (NodesByLabelIdx[LabelIdx] == nullptr) NodesByLabelIdx[LabelIdx] = Node;
+	}
+
+	Interpolations.SetNum(Dataset.NumSteps());
+}
+
+void FIGVTemporalPlayer::Reset()
+{
+	Dataset.Reset();
+	Time = 0.f;
+	Rate = 0.f;
+	NodesByLabelIdx.Empty();
+	Interpolations.Empty();
+	Keyframe = 0;
+	InterpolatedStep = INDEX_NONE;
+	EdgeSample = INDEX_NONE;
+}
+
+void FIGVTemporalPlayer::Tick(float const DeltaTime)
+{
+	if (!IsLoaded() || Rate == 0.f) return;
+
+	Seek(Time + Rate * DeltaTime);
+
+	// Stops at either end
+	if ((Rate > 0.f && Time >= Dataset.NumSteps()) || (Rate < 0.f && Time <= 0.f))
+	{
+		Rate = 0.f;
+	}
+}
+
+void FIGVTemporalPlayer::Seek(float const InTime)
+{
+	if (!IsLoaded()) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_IGV_TemporalPlayback);
+
+	Time = FMath::Clamp(InTime, 0.f, float(Dataset.NumSteps()));
+	int32 const TargetKeyframe = FMath::CeilToInt(Time);
+	int32 const TargetStep = float(TargetKeyframe) != Time ? TargetKeyframe - 1 : INDEX_NONE;
+
+	// The nodes of a step that is left are placed at the keyframe it is left for.
+	if (InterpolatedStep != INDEX_NONE && InterpolatedStep != TargetStep)
+	{
+		Interpolate(InterpolatedStep, Time > InterpolatedStep ? 1.f : 0.f, true);
+		InterpolatedStep = INDEX_NONE;
+	}
+
+	while (Keyframe < TargetKeyframe)
+	{
+		StepForward();
+	}
+	while (Keyframe > TargetKeyframe)
+	{
+		StepBackward();
+	}
+
+	if (TargetStep != INDEX_NONE)
+	{
+		float const Alpha = Time - TargetStep;
+		int32 const NumSamples = GraphActor->TemporalEdgeSamplesPerStep;
+		int32 const Sample = NumSamples > 0 ? FMath::FloorToInt(Alpha * NumSamples) : INDEX_NONE;
+
+		Interpolate(TargetStep, Alpha,
+					InterpolatedStep != TargetStep || NumSamples <= 0 || Sample != EdgeSample);
+		InterpolatedStep = TargetStep;
+		EdgeSample = Sample;
+	}
+}
+
+void FIGVTemporalPlayer::StepForward()
+{
+	int32 const StepIdx = Keyframe;
+	FInterpolation& Interpolation = Interpolations[StepIdx];
+
+	TArray<AIGVNodeActor*> BeginNodes;
+	TArray<FVector2D> BeginPositions;
+	if (!Interpolation.bIsRecorded)
+	{
+		BeginNodes = NodesByLabelIdx;
+		BeginPositions.SetNumUninitialized(BeginNodes.Num());
+		for (int32 LabelIdx = 0; LabelIdx < BeginNodes.Num(); LabelIdx++)
+		{
+			if (BeginNodes[LabelIdx]) BeginPositions[LabelIdx] = BeginNodes[LabelIdx]->Pos2D;
+		}
+	}
+
+	ApplyDiff(Dataset.ForwardDiffs[StepIdx]);
+	Keyframe++;
+
+	if (Interpolation.bIsRecorded) return;
+
+	// Nodes the step adds appear in place, only nodes kept by the step move.
+	TSet<int32> ClusterIdxs;
+	for (int32 LabelIdx = 0; LabelIdx < BeginNodes.Num(); LabelIdx++)
+	{
+		AIGVNodeActor const* const Node = NodesByLabelIdx[LabelIdx];
+		if (Node == nullptr || Node != BeginNodes[LabelIdx] ||
+			Node->Pos2D.Equals(BeginPositions[LabelIdx]))
+		{
+			continue;
+		}
+
+		Interpolation.LabelIdxs.Add(LabelIdx);
+		Interpolation.BeginPositions.Add(BeginPositions[LabelIdx]);
+		Interpolation.EndPositions.Add(Node->Pos2D);
+		ClusterIdxs.Add(GraphActor->Clusters[Node->ClusterIdx].ParentIdx);
+	}
+	Interpolation.ClusterIdxs = ClusterIdxs.Array();
+	Interpolation.bIsRecorded = true;
+
+	IGV_LOG(Verbose, TEXT("Step %d: %d changes, %d nodes moved in %d clusters"), StepIdx,
+			Dataset.ForwardDiffs[StepIdx].Num(), Interpolation.LabelIdxs.Num(),
+			Interpolation.ClusterIdxs.Num());
+}
+
+void FIGVTemporalPlayer::StepBackward()
+{
+	Keyframe--;
+	check(Interpolations[Keyframe].bIsRecorded);
+
+	ApplyDiff(Dataset.BackwardDiffs[Keyframe]);
+}
+
+void FIGVTemporalPlayer::ApplyDiff(FIGVTemporalDiff const& Diff)
+{
+	// The dataset was checked on load, so a failure means the graph was edited by other means.
+	int32 NumFailed = 0;
+
+	auto FindNodeIdx = [this](int32 const LabelIdx) {
+		AIGVNodeActor const* const Node = NodesByLabelIdx[LabelIdx];
+		return Node ? Node->Idx : INDEX_NONE;
+	};
+
+	for (FIGVTemporalEdge const& Edge : Diff.RemovedEdges)
+	{
+		int32 const EdgeIdx = GraphActor->FindEdge(FindNodeIdx(Edge.SourceLabelIdx),
+												   FindNodeIdx(Edge.TargetLabelIdx));
+		if (EdgeIdx == INDEX_NONE || !GraphActor->RemoveEdge(EdgeIdx)) NumFailed++;
+	}
+
+	for (int32 const LabelIdx : Diff.RemovedNodes)
+	{
+		if (!GraphActor->RemoveNode(FindNodeIdx(LabelIdx))) NumFailed++;
+		NodesByLabelIdx[LabelIdx] = nullptr;
+	}
+
+	for (FIGVTemporalNode const& Node : Diff.AddedNodes)
+	{
+		int32 const NodeIdx = GraphActor->AddNode(Dataset.Labels[Node.LabelIdx], Node.ClusterIdx);
+		if (NodeIdx == INDEX_NONE)
+		{
+			NumFailed++;
+			continue;
+		}
+		NodesByLabelIdx[Node.LabelIdx] = GraphActor->Nodes[NodeIdx];
+	}
+
+	for (FIGVTemporalNode const& Node : Diff.MovedNodes)
+	{
+		if (!GraphActor->MoveNode(FindNodeIdx(Node.LabelIdx), Node.ClusterIdx)) NumFailed++;
+	}
+
+	for (FIGVTemporalEdge const& Edge : Diff.AddedEdges)
+	{
+		if (GraphActor->AddEdge(FindNodeIdx(Edge.SourceLabelIdx),
+								FindNodeIdx(Edge.TargetLabelIdx)) == INDEX_NONE)
+		{
+			NumFailed++;
+		}
+	}
+
+	if (NumFailed > 0)
+	{
+		IGV_LOG_S(Warning, TEXT("%d of %d changes to keyframe %d failed"), NumFailed, Diff.Num(),
+				  Keyframe);
+	}
+}
+
+void FIGVTemporalPlayer::Interpolate(int32 const StepIdx, float const Alpha,
+									 bool const bUpdateEdges)
+{
+	FInterpolation const& Interpolation = Interpolations[StepIdx];
+	check(Interpolation.bIsRecorded);
+
+	TArray<AIGVNodeActor*, TInlineAllocator<64>> MovedNodes;
+	for (int32 Idx = 0; Idx < Interpolation.LabelIdxs.Num(); Idx++)
+	{
+		AIGVNodeActor* const Node = NodesByLabelIdx[Interpolation.LabelIdxs[Idx]];
+		if (Node == nullptr) continue;
+
+		Node->Pos2D = FMath::Lerp(Interpolation.BeginPositions[Idx],
+								  Interpolation.EndPositions[Idx], Alpha);
+		MovedNodes.Add(Node);
+	}
+	GraphActor->UpdateNodeTransforms(MovedNodes);
+
+	if (!bUpdateEdges) return;
+
+	// As in AIGVGraphActor::RelayoutCluster, the control points follow the cluster positions.
+	// The edge mesh tasks reading them were waited for by UpdateNodeTransforms.
+	for (int32 const ClusterIdx : Interpolation.ClusterIdxs)
+	{
+		GraphActor->Clusters[ClusterIdx].SetPosNonLeaf();
+	}
+	GraphActor->SemanticZoom.MarkLayoutChanged();
+
+	FIGVEdgeStore& EdgeStore = GraphActor->EdgeStore;
+	for (int32 const LabelIdx : Interpolation.LabelIdxs)
+	{
+		AIGVNodeActor const* const Node = NodesByLabelIdx[LabelIdx];
+		if (Node == nullptr) continue;
+
+		for (int32 const EdgeIdx : GraphActor->Adjacency.GetEdges(Node->Idx))
+		{
+			EdgeStore.SetFlags(EdgeIdx, EIGVEdgeFlags::UpdateMeshRequired |
+											EIGVEdgeFlags::UpdateDefaultMeshRequired);
+		}
+	}
+}
@@ -0,0 +1,71 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "IGVTemporalDataset.h"
+
+// Plays a FIGVTemporalDataset on the loaded graph from AIGVGraphActor::Tick. Time is in steps:
+// keyframe i is shown at time i, and between i and i + 1 the graph has the nodes and edges of
+// keyframe i + 1, with the nodes moving from their positions in keyframe i to those in i + 1.
+//
+// Keyframes are reached by applying the diffs with the incremental edits of AIGVGraphActor, one
+// step at a time in either direction, so the node actors, edge arrays and edge mesh buffers are
+// kept across steps. The positions of the nodes that a step moves are recorded the first time it
+// is applied forward, which is always before it can be played backward. Nodes are moved every
+// frame; their edges follow at TemporalEdgeSamplesPerStep points of a step, since each update
+// patches the default edge mesh.
+class IMSVGRAPHVIS_API FIGVTemporalPlayer
+{
+public:
+	class AIGVGraphActor* GraphActor;
+
+	FIGVTemporalDataset Dataset;
+
+	float Time;  // in steps
+	float Rate;  // in steps per second, negative plays backward
+
+public:
+	FIGVTemporalPlayer();
+
+	void Init(class AIGVGraphActor* const InGraphActor);
+	// Starts at the first keyframe, which is the loaded graph
+	void Setup(FIGVTemporalDataset&& InDataset);
+	void Reset();
+
+	FORCEINLINE bool IsLoaded() const
+	{
+		return Dataset.NumSteps() > 0;
+	}
+
+	void Tick(float const DeltaTime);
+	void Seek(float const InTime);
+
+protected:
+	struct FInterpolation
+	{
+		TArray<int32> LabelIdxs;
+		TArray<FVector2D> BeginPositions;
+		TArray<FVector2D> EndPositions;
+		TArray<int32> ClusterIdxs;  // Parents of the nodes, placed from their positions
+		bool bIsRecorded;
+
+		FInterpolation() : bIsRecorded(false)
+		{
+		}
+	};
+
+	TArray<class AIGVNodeActor*> NodesByLabelIdx;  // nullptr if not in the current keyframe
+	TArray<FInterpolation> Interpolations;		   // Per step
+
+	int32 Keyframe;			// Whose nodes and edges are shown
+	int32 InterpolatedStep;  // Whose nodes are in between, INDEX_NONE if none
+	int32 EdgeSample;		// Of InterpolatedStep the edges were last updated at
+
+	void StepForward();
+	void StepBackward();
+	void ApplyDiff(FIGVTemporalDiff const& Diff);
+
+	void Interpolate(int32 const StepIdx, float const Alpha, bool const bUpdateEdges);
+};
@@ -0,0 +1,194 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVTrace.h"
+
+#include "FileHelper.h"
+#include "Paths.h"
+#include "RenderingThread.h"
+
+#include "IGVLog.h"
+
+// 24 bytes each, about 1.5 MB per thread
+int32 const FIGVTracer::NumZonesPerThread = 64 * 1024;
+
+FIGVTracer& FIGVTracer::Get()
+{
+	static FIGVTracer Tracer;
+	return Tracer;
+}
+
+FIGVTracer::FIGVTracer()
+	: bEnabled(false),
+	  StartCycles(0),
+	  TlsSlot(FPlatformTLS::AllocTlsSlot()),
+	  ThreadBuffers(),
+	  ThreadBuffersCriticalSection()
+{
+}
+
+FIGVTracer::~FIGVTracer()
+{
+	for (FThreadBuffer* const ThreadBuffer : ThreadBuffers)
+	{
+		delete ThreadBuffer;
+	}
+	FPlatformTLS::FreeTlsSlot(TlsSlot);
+}
+
+void FIGVTracer::Start()
+{
+	if (bEnabled) return;
+
+	{
+		FScopeLock Lock(&ThreadBuffersCriticalSection);
+		for (FThreadBuffer* const ThreadBuffer : ThreadBuffers)
+		{
+			ThreadBuffer->NumAdded.Reset();
+		}
+	}
+
+	StartCycles = FPlatformTime::Cycles64();
+	bEnabled = true;
+
+	IGV_LOG(Log, TEXT("Tracing"));
+}
+
+void FIGVTracer::Stop()
+{
+	if (!bEnabled) return;
+
+	bEnabled = false;
+
+	// Zones enqueued on the render thread are still to be closed.
+	FlushRenderingCommands();
+
+	IGV_LOG(Log, TEXT("Tracing stopped"));
+}
+
+void FIGVTracer::AddZone(TCHAR const* const Name, uint64 const BeginCycles,
+						 uint64 const EndCycles)
+{
+	FThreadBuffer* const ThreadBuffer = GetThreadBuffer();
+
+	int64 const ZoneIdx = ThreadBuffer->NumAdded.GetValue();
+	ThreadBuffer->Zones[ZoneIdx % NumZonesPerThread] = FZone{Name, BeginCycles, EndCycles};
+
+	// Publish the zone after it is written
+	FPlatformMisc::MemoryBarrier();
+	ThreadBuffer->NumAdded.Increment();
+}
+
+FIGVTracer::FThreadBuffer* FIGVTracer::GetThreadBuffer()
+{
+	FThreadBuffer* ThreadBuffer = static_cast<FThreadBuffer*>(FPlatformTLS::GetTlsValue(TlsSlot));
+	if (ThreadBuffer != nullptr) return ThreadBuffer;
+
+	uint32 const ThreadId = FPlatformTLS::GetCurrentThreadId();
+
+	ThreadBuffer = new FThreadBuffer();
+	ThreadBuffer->ThreadId = ThreadId;
+	ThreadBuffer->ThreadName = IsInGameThread()
+								   ? FString(TEXT("GameThread"))
+								   : IsInActualRenderingThread()
+										 ? FString(TEXT("RenderThread"))
+										 : FString::Printf(TEXT("Worker %u"), ThreadId);
+	ThreadBuffer->Zones.SetNumUninitialized(NumZonesPerThread);
+
+	{
+		FScopeLock Lock(&ThreadBuffersCriticalSection);
+		ThreadBuffers.Add(ThreadBuffer);
+	}
+
+	FPlatformTLS::SetTlsValue(TlsSlot, ThreadBuffer);
+	return ThreadBuffer;
+}
+
+void FIGVTracer::FThreadBuffer::GetZones(TArray<FZone>& OutZones) const
+{
+	int64 const Num = NumAdded.GetValue();
+	int64 const First = FMath::Max<int64>(Num - NumZonesPerThread, 0);
+
+	OutZones.Reset(Num - First);
+	for (int64 ZoneIdx = First; ZoneIdx < Num; ZoneIdx++)
+	{
+		OutZones.Add(Zones[ZoneIdx % NumZonesPerThread]);
+	}
+}
+
+double FIGVTracer::ToMicroseconds(uint64 const Cycles) const
+{
+	return (double(Cycles) - double(StartCycles)) * FPlatformTime::GetSecondsPerCycle64() * 1e6;
+}
+
+FString FIGVTracer::ToChromeTrace() const
+{
+	FScopeLock Lock(&ThreadBuffersCriticalSection);
+
+	TArray<FString> Events;
+	TArray<FZone> Zones;
+	for (FThreadBuffer const* const ThreadBuffer : ThreadBuffers)
+	{
+		ThreadBuffer->GetZones(Zones);
+		if (Zones.Num() == 0) continue;
+
+		Events.Add(FString::Printf(
+			TEXT("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,")
+				TEXT("\"args\":{\"name\":\"%s\"}}"),
+			ThreadBuffer->ThreadId, *ThreadBuffer->ThreadName));
+
+		for (FZone const& Zone : Zones)
+		{
+			Events.Add(FString::Printf(
+				TEXT("{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,")
+					TEXT("\"ts\":%.3f,\"dur\":%.3f}"),
+				Zone.Name, ThreadBuffer->ThreadId, ToMicroseconds(Zone.BeginCycles),
+				ToMicroseconds(Zone.EndCycles) - ToMicroseconds(Zone.BeginCycles)));
+		}
+	}
+
+	return TEXT("{\"traceEvents\":[\n") + FString::Join(Events, TEXT(",\n")) + TEXT("\n]}\n");
+}
+
+FString FIGVTracer::ToCsv() const
+{
+	FScopeLock Lock(&ThreadBuffersCriticalSection);
+
+	FString Csv = TEXT("thread,zone,begin_us,duration_us\n");
+	TArray<FZone> Zones;
+	for (FThreadBuffer const* const ThreadBuffer : ThreadBuffers)
+	{
+		ThreadBuffer->GetZones(Zones);
+		for (FZone const& Zone : Zones)
+		{
+			Csv += FString::Printf(TEXT("%s,%s,%.3f,%.3f\n"), *ThreadBuffer->ThreadName, Zone.Name,
+								   ToMicroseconds(Zone.BeginCycles),
+								   ToMicroseconds(Zone.EndCycles) -
+									   ToMicroseconds(Zone.BeginCycles));
+		}
+	}
+	return Csv;
+}
+
+bool FIGVTracer::Write(FString const& FilePath) const
+{
+	if (bEnabled)
+	{
+		IGV_LOG_S(Warning, TEXT("Stop tracing before writing the trace"));
+		return false;
+	}
+
+	bool const bChromeTrace = FPaths::GetExtension(FilePath) == TEXT("json");
+	if (!FFileHelper::SaveStringToFile(bChromeTrace ? ToChromeTrace() : ToCsv(), *FilePath))
+	{
+		IGV_LOG_S(Error, TEXT("Unable to write %s"), *FilePath);
+		return false;
+	}
+
+	IGV_LOG(Display, TEXT("Wrote %s"), *FilePath);
+	return true;
+}
+
+FString FIGVTracer::DefaultDirPath()
+{
+	return FPaths::Combine(*FPaths::GameSavedDir(), TEXT("Traces/"));
+}
@@ -0,0 +1,94 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter64.h"
+
+// Opt-in tracer of scoped zones on the game, worker and render threads, written as Chrome trace
+// events (chrome://tracing) or CSV. Unlike stats it keeps every zone with its thread, so the
+// overlap of the threads can be inspected without a profiler.
+//
+// Each thread writes its zones to its own ring buffer without locks; only the first zone of a
+// thread takes a lock to register the buffer. Buffers are read once tracing has stopped.
+class IMSVGRAPHVIS_API FIGVTracer
+{
+public:
+	static FIGVTracer& Get();
+
+	FORCEINLINE bool IsEnabled() const
+	{
+		return bEnabled;
+	}
+
+	void Start();
+	void Stop();
+
+	// Chrome trace events if the extension is .json, CSV otherwise
+	bool Write(FString const& FilePath) const;
+
+	void AddZone(TCHAR const* const Name, uint64 const BeginCycles, uint64 const EndCycles);
+
+	static FString DefaultDirPath();
+
+protected:
+	struct FZone
+	{
+		TCHAR const* Name;  // Static string
+		uint64 BeginCycles;
+		uint64 EndCycles;
+	};
+
+	struct FThreadBuffer
+	{
+		uint32 ThreadId;
+		FString ThreadName;
+		TArray<FZone> Zones;		  // Ring of NumZonesPerThread
+		FThreadSafeCounter64 NumAdded;  // Written by the owning thread only
+
+		void GetZones(TArray<FZone>& OutZones) const;
+	};
+
+	static int32 const NumZonesPerThread;
+
+	FThreadSafeBool bEnabled;
+	uint64 StartCycles;
+
+	uint32 TlsSlot;
+	TArray<FThreadBuffer*> ThreadBuffers;
+	mutable FCriticalSection ThreadBuffersCriticalSection;
+
+	FIGVTracer();
+	~FIGVTracer();
+
+	FThreadBuffer* GetThreadBuffer();
+
+	double ToMicroseconds(uint64 const Cycles) const;
+
+	FString ToChromeTrace() const;
+	FString ToCsv() const;
+};
+
+struct FIGVTraceScope
+{
+	TCHAR const* const Name;
+	uint64 const BeginCycles;
+
+	FORCEINLINE FIGVTraceScope(TCHAR const* const InName)
+		: Name(InName), BeginCycles(FIGVTracer::Get().IsEnabled() ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	FORCEINLINE ~FIGVTraceScope()
+	{
+		if (BeginCycles != 0)
+		{
+			FIGVTracer::Get().AddZone(Name, BeginCycles, FPlatformTime::Cycles64());
+		}
+	}
+};
+
+// IGV_TRACE_SCOPE("Name") traces the enclosing scope while the tracer is enabled.
+#define IGV_TRACE_SCOPE(Name) \
+	FIGVTraceScope const PREPROCESSOR_JOIN(IGVTraceScope_, __LINE__)(TEXT(Name))
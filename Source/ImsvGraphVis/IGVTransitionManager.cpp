@@ -0,0 +1,183 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#include "IGVTransitionManager.h"
+
+#include "Curves/CurveFloat.h"
+
+#include "IGVEdge.h"
+#include "IGVEdgeStore.h"
+#include "IGVGraphActor.h"
+#include "IGVLog.h"
+#include "IGVNodeActor.h"
+#include "IGVStats.h"
+
+FIGVTransitionManager::FIGVTransitionManager()
+	: GraphActor(nullptr), Nodes(), EdgeIdxs(), ElapsedTime(0.f), Alpha(1.f)
+{
+}
+
+void FIGVTransitionManager::Init(AIGVGraphActor* const InGraphActor)
+{
+	GraphActor = InGraphActor;
+}
+
+void FIGVTransitionManager::Reset()
+{
+	for (AIGVNodeActor* const Node : Nodes)
+	{
+		Node->TransitionIdx = INDEX_NONE;
+	}
+
+	for (int32 const EdgeIdx : EdgeIdxs)
+	{
+		GraphActor->Edges[EdgeIdx].TransitionIdx = INDEX_NONE;
+	}
+
+	Nodes.Reset();
+	EdgeIdxs.Reset();
+
+	ElapsedTime = 0.f;
+	Alpha = 1.f;
+}
+
+bool FIGVTransitionManager::IsActive() const
+{
+	return Nodes.Num() > 0 || EdgeIdxs.Num() > 0;
+}
+
+uint32 FIGVTransitionManager::GetAllocatedSize() const
+{
+	return Nodes.GetAllocatedSize() + EdgeIdxs.GetAllocatedSize();
+}
+
+void FIGVTransitionManager::BeginNodeTransition(AIGVNodeActor* const Node)
+{
+	if (ElapsedTime > 0.f)
+	{
+		Rebase();
+	}
+
+	Node->LevelScaleBeforeTransition = Node->LevelScale;
+
+	if (Node->TransitionIdx == INDEX_NONE)
+	{
+		Node->TransitionIdx = Nodes.Add(Node);
+	}
+
+	for (int32 const EdgeIdx : GraphActor->Adjacency.GetEdges(Node->Idx))
+	{
+		GraphActor->Edges[EdgeIdx].BeginTransition();
+		BeginEdgeTransition(EdgeIdx);
+	}
+}
+
+void FIGVTransitionManager::BeginEdgeTransition(int32 const EdgeIdx)
+{
+	FIGVEdge& Edge = GraphActor->Edges[EdgeIdx];
+
+	// An edge between two transitioning nodes is registered once.
+	if (Edge.TransitionIdx == INDEX_NONE)
+	{
+		Edge.TransitionIdx = EdgeIdxs.Add(EdgeIdx);
+	}
+
+	GraphActor->EdgeStore.SetFlags(EdgeIdx, EIGVEdgeFlags::InTransition |
+												EIGVEdgeFlags::UpdateMeshRequired);
+}
+
+void FIGVTransitionManager::RemoveNode(AIGVNodeActor* const Node)
+{
+	int32 const TransitionIdx = Node->TransitionIdx;
+	if (TransitionIdx == INDEX_NONE) return;
+
+	Nodes.RemoveAtSwap(TransitionIdx, 1, false);
+	if (Nodes.IsValidIndex(TransitionIdx))
+	{
+		Nodes[TransitionIdx]->TransitionIdx = TransitionIdx;
+	}
+	Node->TransitionIdx = INDEX_NONE;
+}
+
+void FIGVTransitionManager::RemoveEdge(int32 const EdgeIdx)
+{
+	int32 const TransitionIdx = GraphActor->Edges[EdgeIdx].TransitionIdx;
+	if (TransitionIdx == INDEX_NONE) return;
+
+	EdgeIdxs.RemoveAtSwap(TransitionIdx, 1, false);
+	if (EdgeIdxs.IsValidIndex(TransitionIdx))
+	{
+		GraphActor->Edges[EdgeIdxs[TransitionIdx]].TransitionIdx = TransitionIdx;
+	}
+	GraphActor->Edges[EdgeIdx].TransitionIdx = INDEX_NONE;
+	GraphActor->EdgeStore.ClearFlags(EdgeIdx, EIGVEdgeFlags::InTransition);
+}
+
+void FIGVTransitionManager::RenameEdge(int32 const OldEdgeIdx, int32 const NewEdgeIdx)
+{
+	// FIGVEdge::TransitionIdx moves along with the edge.
+	int32 const TransitionIdx = GraphActor->Edges[NewEdgeIdx].TransitionIdx;
+	if (TransitionIdx == INDEX_NONE) return;
+
+	check(EdgeIdxs[TransitionIdx] == OldEdgeIdx);
+	EdgeIdxs[TransitionIdx] = NewEdgeIdx;
+}
+
+void FIGVTransitionManager::Tick(float const DeltaTime)
+{
+	if (!IsActive()) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_IGV_TransitionUpdate);
+
+	ElapsedTime += DeltaTime;
+	Alpha = Ease(ElapsedTime);
+
+	for (AIGVNodeActor* const Node : Nodes)
+	{
+		Node->UpdateTransition(Alpha);
+	}
+
+	if (ElapsedTime >= GraphActor->HighlightTransitionDuration)
+	{
+		End();
+	}
+}
+
+float FIGVTransitionManager::Ease(float const InElapsedTime) const
+{
+	float const Duration = GraphActor->HighlightTransitionDuration;
+	float const T = Duration > 0.f ? FMath::Clamp(InElapsedTime / Duration, 0.f, 1.f) : 1.f;
+
+	UCurveFloat const* const Curve = GraphActor->HighlightTransitionCurve;
+	return Curve != nullptr ? Curve->GetFloatValue(T) : FMath::InterpEaseInOut(0.f, 1.f, T, 2.f);
+}
+
+void FIGVTransitionManager::Rebase()
+{
+	for (AIGVNodeActor* const Node : Nodes)
+	{
+		Node->LevelScaleBeforeTransition = Node->LevelScale;
+	}
+
+	for (int32 const EdgeIdx : EdgeIdxs)
+	{
+		GraphActor->Edges[EdgeIdx].RebaseTransition(Alpha);
+	}
+
+	ElapsedTime = 0.f;
+	Alpha = 0.f;
+}
+
+void FIGVTransitionManager::End()
+{
+	for (AIGVNodeActor* const Node : Nodes)
+	{
+		Node->EndTransition();
+	}
+
+	for (int32 const EdgeIdx : EdgeIdxs)
+	{
+		GraphActor->Edges[EdgeIdx].EndTransition();
+	}
+
+	Reset();
+}
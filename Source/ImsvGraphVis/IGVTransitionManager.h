@@ -0,0 +1,53 @@
+// Copyright 2017 Oh-Hyun Kwon. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Drives all in-flight highlight transitions of a graph from AIGVGraphActor::Tick. Nodes and edges
+// are kept in flat arrays, so a transition touching many nodes is advanced in a single pass and an
+// edge shared by two transitioning nodes is registered only once.
+//
+// All transitions share one clock. Edges are not touched per frame at all: their spline levels
+// before and after the transition are uploaded once, and the edge mesh compute shader
+// interpolates them with Alpha. Starting a new transition while others are in flight rebases the
+// latter on their current state, so every transition starts and ends together.
+class IMSVGRAPHVIS_API FIGVTransitionManager
+{
+public:
+	class AIGVGraphActor* GraphActor;
+
+	TArray<class AIGVNodeActor*> Nodes;
+	TArray<int32> EdgeIdxs;
+
+	float ElapsedTime;
+	float Alpha;
+
+public:
+	FIGVTransitionManager();
+
+	void Init(class AIGVGraphActor* const InGraphActor);
+	void Reset();
+
+	bool IsActive() const;
+
+	uint32 GetAllocatedSize() const;
+
+	// (Re)starts the transition of the node, and of all its incident edges.
+	void BeginNodeTransition(class AIGVNodeActor* const Node);
+	void BeginEdgeTransition(int32 const EdgeIdx);
+
+	// Incremental edits, see AIGVGraphActor. A removed node or edge leaves its transition as is;
+	// RenameEdge follows an edge that moved to another index.
+	void RemoveNode(class AIGVNodeActor* const Node);
+	void RemoveEdge(int32 const EdgeIdx);
+	void RenameEdge(int32 const OldEdgeIdx, int32 const NewEdgeIdx);
+
+	void Tick(float const DeltaTime);
+
+protected:
+	float Ease(float const InElapsedTime) const;
+
+	void Rebase();
+	void End();
+};
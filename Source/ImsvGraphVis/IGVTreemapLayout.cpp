@@ -5,6 +5,7 @@
 
 #include "IGVGraphActor.h"
 #include "IGVLog.h"
+#include "IGVStats.h"
 
 FIGVTreemapNode::FIGVTreemapNode(FIGVCluster* const InCluster)
 	: Cluster(InCluster), Children(), Rect(), Weight(1.f)
@@ -49,46 +50,99 @@ FIGVTreemapLayout::FIGVTreemapLayout(AIGVGraphActor* const InGraphActor)
 
 void FIGVTreemapLayout::Compute()
 {
-	SetupTreemapNodes();
+	SCOPE_CYCLE_COUNTER(STAT_IGV_TreemapLayout);
+
+	SetupTreemapNodes(*RootCluster);
 
 	RootTreemapNode->SetRandomWeights();
 	RootTreemapNode->Rect = FBox2D(-GraphActor->PlanarExtent, GraphActor->PlanarExtent);
 
-	float const Nesting = GraphActor->TreemapNesting;
-	RootTreemapNode->ForEachAncestorFirst([Nesting](FIGVTreemapNode& Node) {
-		if (!Node.IsLeaf())
+	Layout();
+
+	for (FIGVTreemapNode const& TreemapNode : TreemapNodes)
+	{
+		PlaceCluster(TreemapNode);
+	}
+}
+
+void FIGVTreemapLayout::ComputeSubtree(FIGVCluster& SubtreeRootCluster)
+{
+	SCOPE_CYCLE_COUNTER(STAT_IGV_TreemapLayout);
+
+	SetupTreemapNodes(SubtreeRootCluster);
+
+	// Leaves added since the last layout are weighted as in SetRandomWeights.
+	RootTreemapNode->ForEachDescendantFirst([](FIGVTreemapNode& Node) {
+		if (Node.IsLeaf())
 		{
-			Squarified(Node, Nesting);
+			float const Weight = Node.Cluster->TreemapWeight;
+			Node.Weight = Weight > 0.f ? Weight : FMath::FRandRange(1.f, 2.f);
+		}
+		else
+		{
+			for (FIGVTreemapNode* const Child : Node.Children)
+			{
+				Node.Weight += Child->Weight;
+			}
 		}
 	});
+	RootTreemapNode->Rect = SubtreeRootCluster.TreemapRect;
+
+	Layout();
 
-	for (FIGVTreemapNode& TreemapNode : TreemapNodes)
+	// The first node is the subtree root
+	for (int32 Idx = 1; Idx < TreemapNodes.Num(); Idx++)
 	{
-		FVector2D Center, Extents;
-		TreemapNode.Rect.GetCenterAndExtents(Center, Extents);
-		Center.Y *= -1;
-		FVector2D const Offset = 0.5 * FVector2D(FMath::FRandRange(-Extents.X, Extents.X),
-												 FMath::FRandRange(-Extents.Y, Extents.Y));
-		TreemapNode.Cluster->SetPos2D(Center + Offset);
+		PlaceCluster(TreemapNodes[Idx]);
 	}
 }
 
-void FIGVTreemapLayout::SetupTreemapNodes()
+void FIGVTreemapLayout::SetupTreemapNodes(FIGVCluster& SubtreeRootCluster)
+{
+	int32 NumClusters = 0;
+	SubtreeRootCluster.ForEachDescendantFirst([&NumClusters](FIGVCluster&) { NumClusters++; });
+
+	// Treemap nodes point to each other, so the array must not grow.
+	TreemapNodes.Reset(NumClusters);
+	RootTreemapNode = AddTreemapNodes(SubtreeRootCluster);
+	check(TreemapNodes.Num() == NumClusters);
+}
+
+FIGVTreemapNode* FIGVTreemapLayout::AddTreemapNodes(FIGVCluster& Cluster)
 {
-	for (FIGVCluster& Cluster : GraphActor->Clusters)
+	FIGVTreemapNode* const TreemapNode = &TreemapNodes[TreemapNodes.Emplace(&Cluster)];
+	for (FIGVCluster* const Child : Cluster.Children)
 	{
-		TreemapNodes.Emplace(&Cluster);
+		TreemapNode->Children.Add(AddTreemapNodes(*Child));
 	}
+	return TreemapNode;
+}
 
-	for (FIGVCluster& Cluster : GraphActor->Clusters)
-	{
-		if (!Cluster.IsRoot())
+void FIGVTreemapLayout::Layout()
+{
+	float const Nesting = GraphActor->TreemapNesting;
+	RootTreemapNode->ForEachAncestorFirst([Nesting](FIGVTreemapNode& Node) {
+		if (!Node.IsLeaf())
 		{
-			TreemapNodes[Cluster.ParentIdx].Children.Add(&TreemapNodes[Cluster.Idx]);
+			Squarified(Node, Nesting);
 		}
+	});
+
+	for (FIGVTreemapNode const& TreemapNode : TreemapNodes)
+	{
+		TreemapNode.Cluster->TreemapRect = TreemapNode.Rect;
+		TreemapNode.Cluster->TreemapWeight = TreemapNode.Weight;
 	}
+}
 
-	RootTreemapNode = &TreemapNodes.Last();
+void FIGVTreemapLayout::PlaceCluster(FIGVTreemapNode const& TreemapNode)
+{
+	FVector2D Center, Extents;
+	TreemapNode.Rect.GetCenterAndExtents(Center, Extents);
+	Center.Y *= -1;
+	FVector2D const Offset = 0.5 * FVector2D(FMath::FRandRange(-Extents.X, Extents.X),
+											 FMath::FRandRange(-Extents.Y, Extents.Y));
+	TreemapNode.Cluster->SetPos2D(Center + Offset);
 }
 
 void FIGVTreemapLayout::SliceAndDice(FIGVTreemapNode& ParentNode, int32 const FirstIdx,
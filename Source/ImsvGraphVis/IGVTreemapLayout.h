@@ -56,7 +56,11 @@ class IMSVGRAPHVIS_API FIGVTreemapLayout
 public:
 	FIGVTreemapLayout(class AIGVGraphActor* const InGraphActor);
 
+	// Lays out the whole hierarchy with random leaf weights.
 	void Compute();
+	// Lays out the descendants of the cluster again within its rectangle of the last layout,
+	// after an incremental edit. Leaves keep their weights, and the cluster keeps its position.
+	void ComputeSubtree(struct FIGVCluster& SubtreeRootCluster);
 
 public:
 	static void SliceAndDice(FIGVTreemapNode& ParentNode, int32 const FirstIdx, int32 const LastIdx,
@@ -75,7 +79,12 @@ public:
 	static void Squarified(FIGVTreemapNode& ParentNode);
 
 protected:
-	void SetupTreemapNodes();
+	void SetupTreemapNodes(struct FIGVCluster& SubtreeRootCluster);
+	FIGVTreemapNode* AddTreemapNodes(struct FIGVCluster& Cluster);
+
+	// Squarifies the children of every node, and keeps the result in the clusters.
+	void Layout();
+	static void PlaceCluster(FIGVTreemapNode const& TreemapNode);
 
 	static double AccumulateWeight(FIGVTreemapNode& ParentNode, int32 const FirstIdx,
 								   int32 const LastIdx);
@@ -17,6 +17,8 @@ public class ImsvGraphVis : ModuleRules
             "Http",
             "Json",
             "JsonUtilities",
+            "Sockets",
+            "Networking",
 			"RenderCore",
 			"Renderer",
 			"RHI",
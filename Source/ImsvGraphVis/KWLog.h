@@ -18,15 +18,27 @@
 
 #define __KW_CURRENT_FUNCSIG__ (FString(__FUNCSIG__))
 
-#define KW_LOG_S(LogCategory, LogVerbosity, FormatString, ...)                    \
-	{                                                                             \
-		FString const __Message__ =                                               \
-			*FString::Printf(TEXT("%s %s"), *__KW_CURRENT_CLASS_LINE__,           \
-							 *FString::Printf(FormatString, ##__VA_ARGS__));      \
-		UE_LOG(LogCategory, LogVerbosity, TEXT("%s"), *__Message__);              \
-		GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Yellow, *__Message__); \
+// Whether LogCategory is compiled in and enabled at LogVerbosity. The log macros below evaluate
+// their arguments only then; use it to guard messages built before logging.
+#define KW_LOG_ACTIVE(LogCategory, LogVerbosity) UE_LOG_ACTIVE(LogCategory, LogVerbosity)
+
+#define KW_LOG_S(LogCategory, LogVerbosity, FormatString, ...)                        \
+	{                                                                                 \
+		if (KW_LOG_ACTIVE(LogCategory, LogVerbosity))                                 \
+		{                                                                             \
+			FString const __Message__ =                                               \
+				*FString::Printf(TEXT("%s %s"), *__KW_CURRENT_CLASS_LINE__,           \
+								 *FString::Printf(FormatString, ##__VA_ARGS__));      \
+			UE_LOG(LogCategory, LogVerbosity, TEXT("%s"), *__Message__);              \
+			GEngine->AddOnScreenDebugMessage(-1, 10.f, FColor::Yellow, *__Message__); \
+		}                                                                             \
 	}
 
-#define KW_LOG(LogCategory, LogVerbosity, FormatString, ...)                     \
-	UE_LOG(LogCategory, LogVerbosity, TEXT("%s %s"), *__KW_CURRENT_CLASS_LINE__, \
-		   *FString::Printf(FormatString, ##__VA_ARGS__))
+#define KW_LOG(LogCategory, LogVerbosity, FormatString, ...)                             \
+	{                                                                                    \
+		if (KW_LOG_ACTIVE(LogCategory, LogVerbosity))                                    \
+		{                                                                                \
+			UE_LOG(LogCategory, LogVerbosity, TEXT("%s %s"), *__KW_CURRENT_CLASS_LINE__, \
+				   *FString::Printf(FormatString, ##__VA_ARGS__));                       \
+		}                                                                                \
+	}
@@ -75,12 +75,17 @@ public:
 		BufferData();
 	}
 
-	void BufferData()
+	// Writes Vertices from the given element on. The rest of the buffer is kept only if it is not
+	// dynamic, whose locks discard the whole buffer.
+	void BufferData(int32 const FirstElement = 0)
 	{
 		if (Vertices.Num() > 0)
 		{
-			void* Buffer = RHILockVertexBuffer(
-				VertexBufferRHI, 0, Vertices.Num() * sizeof(FDynamicMeshVertex), RLM_WriteOnly);
+			check(FirstElement + Vertices.Num() <= NumElements);
+			void* Buffer = RHILockVertexBuffer(VertexBufferRHI,
+											   FirstElement * sizeof(FDynamicMeshVertex),
+											   Vertices.Num() * sizeof(FDynamicMeshVertex),
+											   RLM_WriteOnly);
 			FMemory::Memcpy(Buffer, Vertices.GetData(),
 							Vertices.Num() * sizeof(FDynamicMeshVertex));
 			RHIUnlockVertexBuffer(VertexBufferRHI);